@@ -0,0 +1,103 @@
+#pragma once
+
+#include "Component.h"
+
+#ifndef CONFIG_UI_CHART_CAPACITY
+#define CONFIG_UI_CHART_CAPACITY 256
+#endif
+
+namespace MinimalUI {
+namespace Components {
+
+/**
+ * @brief 图表的绘制统计，用于确认每个采样只重绘一列
+ */
+struct ChartStats {
+    uint32_t columns_drawn = 0;   // 栅格化的列数
+    uint32_t shifts = 0;          // 通过shiftRect()平移绘图区的次数
+    uint32_t full_redraws = 0;    // 整个绘图区重绘的次数
+};
+
+/**
+ * @class Chart
+ * @brief 流式折线图（sparkline），采样保存在固定容量的环形缓冲区中
+ *
+ * 每个像素列对应samplesPerColumn()个采样，按列内的最小/最大值画成一条竖线，
+ * 并延伸到前一列的最后一个采样，使相邻列连成折线。新采样开始一列时，
+ * 已绘制的内容通过驱动的shiftRect()左移一列，只栅格化最新的一列，
+ * 每个采样的绘制开销与历史长度无关。驱动不支持平移时退化为重绘整个绘图区。
+ *
+ * 单色屏上的抖动图案与列坐标相关，平移后的列保留原位置的图案相位，
+ * 因此单色屏上宜使用纯黑/纯白。
+ */
+class Chart : public Component {
+public:
+    static constexpr uint16_t CAPACITY = CONFIG_UI_CHART_CAPACITY;
+
+    Chart(int16_t x, int16_t y, int16_t width, int16_t height, int16_t min_value, int16_t max_value,
+          Color color = Colors::WHITE, Color bg = Colors::BLACK);
+
+    /**
+     * @brief 追加一个采样，超出[min, max]的值绘制时截断到边缘
+     * 环形缓冲区满时覆盖最旧的采样
+     */
+    void push(int16_t sample);
+
+    // 与Animator/WidgetPool的数值接口一致：setValue()等同于push()
+    void setValue(int32_t value) override;
+
+    /**
+     * @brief 设置纵轴范围，之后整个绘图区重绘
+     */
+    void setRange(int16_t min_value, int16_t max_value);
+
+    /**
+     * @brief 设置整个绘图区显示的采样数
+     * 超过宽度时每列合并多个采样（最小/最大值抽取）；重绘时能恢复的历史受CAPACITY限制
+     */
+    void setWindow(uint16_t samples);
+    uint16_t samplesPerColumn() const { return samples_per_column_; }
+
+    // 清空所有采样
+    void clear();
+
+    uint16_t count() const { return count_; }
+    /**
+     * @brief 按时间倒序读取采样，age为0时是最新的采样
+     */
+    int16_t sample(uint16_t age) const;
+
+    void setColor(Color color) override;
+    void setColors(Color color, Color bg);
+
+    const ChartStats& stats() const { return stats_; }
+
+    void render(GraphicsDriver* driver) override;
+
+protected:
+    void invalidateLayout() override;
+
+private:
+    int16_t samples_[CAPACITY];
+    uint16_t head_ = 0;               // 下一个写入位置
+    uint16_t count_ = 0;
+    int16_t min_;
+    int16_t max_;
+    Color color_;
+    Color bg_;
+    uint16_t window_ = 0;             // 0表示每列一个采样
+    uint16_t samples_per_column_ = 1;
+    uint16_t column_fill_ = 0;        // 最新一列已有的采样数
+    uint16_t drawn_fill_ = 0;         // 最新一列上次绘制时的采样数
+    int16_t pending_columns_ = 0;     // 上次绘制后新开始的列数
+    bool full_redraw_ = true;
+    bool painted_ = false;            // 屏幕上有本组件绘制的内容，隐藏时需要擦除
+    ChartStats stats_;
+
+    void updateSamplesPerColumn();
+    int16_t rowFor(int16_t value) const;
+    void drawColumn(GraphicsDriver* driver, int16_t column);
+};
+
+} // namespace Components
+} // namespace MinimalUI
@@ -0,0 +1,93 @@
+#pragma once
+
+#include "Component.h"
+
+// 标签文本的最大字节数（UTF-8）。CJK字符每个占3字节，默认容量只够约10个汉字；
+// 中文界面可设为96（32个汉字），每个标签增加约5 * (N - 32)字节，
+// 在WidgetPool中创建时还需相应增大CONFIG_UI_WIDGET_SLOT_SIZE
+#ifndef CONFIG_UI_LABEL_MAX_LENGTH
+#define CONFIG_UI_LABEL_MAX_LENGTH 32
+#endif
+
+namespace MinimalUI {
+namespace Components {
+
+/**
+ * @class Label
+ * @brief 单行文本标签，文本变化时只重绘变化的字符格
+ *
+ * 标签记录上一次绘制的字符格（编码、位置、宽度），setText()后的render()
+ * 按位置把新排版与旧字符格逐一比较，只重绘编码或位置改变的字符格，并清除旧文本
+ * 超出新文本的部分。像"23.4 °C"这类读数每秒只变一两个字符，
+ * 单色屏上只需传输这几个字符格所在的列。
+ *
+ * 开启等宽数字后，所有数字占用相同宽度的字符格，数值变化不会引起
+ * 后续字符移动，从而保持字符格稳定。
+ */
+class Label : public Component {
+public:
+    // 文本最大字节数（UTF-8），见CONFIG_UI_LABEL_MAX_LENGTH
+    static constexpr uint8_t MAX_LENGTH = CONFIG_UI_LABEL_MAX_LENGTH;
+    static_assert(CONFIG_UI_LABEL_MAX_LENGTH > 0 && CONFIG_UI_LABEL_MAX_LENGTH < 256,
+                  "CONFIG_UI_LABEL_MAX_LENGTH must fit in uint8_t");
+
+    enum class Align : uint8_t {
+        LEFT,
+        CENTER,
+        RIGHT
+    };
+
+    Label(int16_t x, int16_t y, int16_t width, int16_t height, const char* text = "",
+          Color color = Colors::WHITE, Color bg = Colors::BLACK);
+
+    /**
+     * @brief 设置文本，超出MAX_LENGTH字节的部分在字符边界处截断
+     * 文本未变化时不标记重绘
+     */
+    void setText(const char* text);
+    const char* getText() const { return text_; }
+
+    // 以下样式变化都会导致整体重绘
+    void setColors(Color color, Color bg);
+    void setColor(Color color) override { setColors(color, bg_); }
+    void setFont(const Font* font);
+    void setScale(uint8_t scale);
+    void setAlign(Align align);
+    void setTabularDigits(bool enabled);
+
+    void render(GraphicsDriver* driver) override;
+
+    /**
+     * @brief 文本宽度和字体高度（按当前字体和缩放）
+     */
+    Size preferredSize(GraphicsDriver* driver) override;
+
+protected:
+    void invalidateLayout() override;
+
+private:
+    // 屏幕上一个字符格。不保存宽度：码点相同且排版设置未变时宽度必然相同，设置变化时会整体重绘
+    struct Cell {
+        int16_t x;       // 左边界
+        uint16_t code;   // 码点，超出BMP的字符按U+FFFD保存
+    };
+
+    char text_[MAX_LENGTH + 1];
+    Color color_;
+    Color bg_;
+    const Font* font_ = nullptr;   // nullptr表示使用驱动的当前字体
+    uint8_t scale_ = 1;
+    Align align_ = Align::LEFT;
+    bool tabular_digits_ = false;
+
+    Cell cells_[MAX_LENGTH];       // 上一次绘制的字符格
+    int16_t cells_right_ = 0;      // 上一次绘制的最后一个字符格的右边界
+    uint8_t cell_count_ = 0;
+    bool full_redraw_ = true;      // 下一次render()需要整体重绘
+
+    // 按当前文本排版，返回字符格数量
+    uint8_t layout(GraphicsDriver* driver, const Font& font, Cell* cells, uint8_t* widths);
+};
+
+} // namespace Components
+} // namespace MinimalUI
@@ -0,0 +1,370 @@
+#pragma once
+
+#include "WidgetPool.h"
+#include "Trace.h"
+#include <cstdint>
+
+namespace MinimalUI {
+namespace Components {
+
+// 容器排列子组件的方式
+enum class LayoutKind : uint8_t {
+    NONE,    // 不是容器，子组件保持自己的位置
+    ROW,     // 水平排列
+    COLUMN,  // 垂直排列
+    STACK    // 叠放，每个子组件单独对齐
+};
+
+// 单个轴上的尺寸来源
+enum class SizeMode : uint8_t {
+    CONTENT,  // 内容（首选尺寸或子组件）决定
+    FIXED,    // 固定值
+    FILL      // 按权重分配父容器的剩余空间（交叉轴上为拉伸）
+};
+
+// 子组件在交叉轴（STACK为两个轴）上的对齐
+enum class LayoutAlign : uint8_t {
+    START,
+    CENTER,
+    END
+};
+
+/**
+ * @brief 组件的布局参数
+ */
+struct LayoutParams {
+    LayoutKind kind = LayoutKind::NONE;
+    SizeMode width_mode = SizeMode::CONTENT;
+    SizeMode height_mode = SizeMode::CONTENT;
+    int16_t width = 0;       // FIXED时的宽度
+    int16_t height = 0;      // FIXED时的高度
+    uint8_t weight = 1;      // FILL时分配剩余空间的权重
+    uint8_t padding = 0;     // 容器内边距
+    uint8_t gap = 0;         // 相邻子组件的间距
+    LayoutAlign align = LayoutAlign::START;
+};
+
+/**
+ * @brief 最近一次update()的工作量
+ */
+struct LayoutStats {
+    uint16_t measured = 0;   // 重新测量的组件数
+    uint16_t arranged = 0;   // 重新排列的组件数
+    uint16_t moved = 0;      // 位置或尺寸发生变化的组件数
+};
+
+/**
+ * @class LayoutEngine
+ * @brief 组件池上的行/列/叠放布局（类似flex：固定、内容、填充、权重、内边距）
+ *
+ * 每个组件的测量结果缓存在数组中。update()只处理池中有变化位的组件：
+ * 重新测量后尺寸不变则到此为止（例如等宽数字的标签数值变化）；
+ * 尺寸改变时沿父链向上重新测量，直到某个容器的尺寸不再变化，
+ * 只重新排列该容器的子树。组件的新位置和尺寸通过setBounds()写回，
+ * 池据此把旧区域记为损坏区，因此布局结果直接转化为重绘区域。
+ *
+ * 顶层组件只有调用过set()时才由引擎放置（在update()给出的屏幕区域内），
+ * 布局容器的子组件总是由引擎放置。
+ */
+template <typename Pool>
+class LayoutEngine {
+public:
+    using Handle = typename Pool::Handle;
+
+    explicit LayoutEngine(Pool& pool) : pool_(pool) {
+        for (Handle i = 0; i < Pool::capacity(); i++) {
+            state_[i] = 0;
+            measured_[i] = Size{0, 0};
+        }
+    }
+
+    /**
+     * @brief 设置组件的布局参数
+     */
+    void set(Handle handle, const LayoutParams& params) {
+        if (!pool_.valid(handle)) {
+            return;
+        }
+        // 新加入标记在此处消费，避免下一次update()把参数重置为默认值
+        pool_.takeChanges(handle);
+        params_[handle] = params;
+        state_[handle] = (state_[handle] & HIDDEN) | MANAGED | MEASURE | ARRANGE;
+    }
+
+    const LayoutParams& params(Handle handle) const { return params_[handle]; }
+
+    // 缓存的测量结果
+    Size measured(Handle handle) const { return measured_[handle]; }
+
+    /**
+     * @brief 测量并排列有变化的组件，每帧在池的render()之前调用
+     * @param screen 顶层组件的可用区域
+     * @return 是否有组件的位置或尺寸发生变化
+     */
+    bool update(GraphicsDriver* driver, const Rect& screen) {
+        MUI_TRACE_SCOPE("layout");
+        stats_ = LayoutStats();
+        const bool screen_changed = screen.x != screen_.x || screen.y != screen_.y || screen.w != screen_.w ||
+                                    screen.h != screen_.h;
+        screen_ = screen;
+
+        // 测量：线性扫描变化位
+        for (Handle h = 0; h < Pool::capacity(); h++) {
+            if (!pool_.valid(h)) {
+                continue;
+            }
+            const uint8_t changes = pool_.takeChanges(h);
+            if (changes & Pool::CHANGE_CREATED) {
+                params_[h] = LayoutParams();
+                state_[h] = ARRANGE;
+            }
+            if (screen_changed && (state_[h] & MANAGED) && pool_.parent(h) == Pool::NONE) {
+                state_[h] |= ARRANGE;
+            }
+            if (changes || (state_[h] & MEASURE)) {
+                remeasure(driver, h);
+            }
+        }
+
+        // 排列：从最上层的待排列组件开始，祖先也待排列时由祖先处理；
+        // 祖先排列时跳过了未变化的中间容器的，下一轮再处理
+        bool pending = true;
+        while (pending) {
+            pending = false;
+            for (Handle h = 0; h < Pool::capacity(); h++) {
+                if (!pool_.valid(h) || !(state_[h] & ARRANGE)) {
+                    continue;
+                }
+                bool covered = false;
+                for (Handle p = pool_.parent(h); p != Pool::NONE; p = pool_.parent(p)) {
+                    if (state_[p] & ARRANGE) {
+                        covered = true;
+                        break;
+                    }
+                }
+                if (covered) {
+                    pending = true;
+                    continue;
+                }
+                const bool root = pool_.parent(h) == Pool::NONE;
+                arrange(h, root && (state_[h] & MANAGED) ? rootRect(h) : pool_.component(h)->bounds());
+            }
+        }
+        return stats_.moved > 0;
+    }
+
+    const LayoutStats& stats() const { return stats_; }
+
+private:
+    static constexpr uint8_t MANAGED = 0x01;  // 顶层组件由引擎放置
+    static constexpr uint8_t MEASURE = 0x02;  // 需要重新测量
+    static constexpr uint8_t ARRANGE = 0x04;  // 需要重新排列子组件
+    static constexpr uint8_t HIDDEN = 0x08;   // 上次测量时组件不可见
+
+    Pool& pool_;
+    LayoutParams params_[Pool::capacity()];
+    Size measured_[Pool::capacity()];
+    uint8_t state_[Pool::capacity()];
+    Rect screen_{0, 0, 0, 0};
+    LayoutStats stats_;
+
+    bool isContainer(Handle h) const { return params_[h].kind != LayoutKind::NONE; }
+
+    // 子组件在父容器中占用的基础尺寸：不可见为0，FILL的轴只按剩余空间分配
+    Size basis(Handle h) const {
+        if (state_[h] & HIDDEN) {
+            return Size{0, 0};
+        }
+        return Size{params_[h].width_mode == SizeMode::FILL ? int16_t(0) : measured_[h].w,
+                    params_[h].height_mode == SizeMode::FILL ? int16_t(0) : measured_[h].h};
+    }
+
+    Size measureNode(GraphicsDriver* driver, Handle h) {
+        const LayoutParams& p = params_[h];
+        Size content{0, 0};
+        if (!isContainer(h)) {
+            content = pool_.component(h)->preferredSize(driver);
+        } else {
+            int16_t count = 0;
+            for (Handle c = pool_.firstChild(h); c != Pool::NONE; c = pool_.nextSibling(c)) {
+                if (state_[c] & HIDDEN) {
+                    continue;
+                }
+                const Size b = basis(c);
+                if (p.kind == LayoutKind::ROW) {
+                    content.w += b.w;
+                    content.h = b.h > content.h ? b.h : content.h;
+                } else if (p.kind == LayoutKind::COLUMN) {
+                    content.h += b.h;
+                    content.w = b.w > content.w ? b.w : content.w;
+                } else {
+                    content.w = b.w > content.w ? b.w : content.w;
+                    content.h = b.h > content.h ? b.h : content.h;
+                }
+                count++;
+            }
+            const int16_t gaps = count > 1 ? static_cast<int16_t>((count - 1) * p.gap) : 0;
+            if (p.kind == LayoutKind::ROW) {
+                content.w += gaps;
+            } else if (p.kind == LayoutKind::COLUMN) {
+                content.h += gaps;
+            }
+            content.w += 2 * p.padding;
+            content.h += 2 * p.padding;
+        }
+        return Size{p.width_mode == SizeMode::FIXED ? p.width : content.w,
+                    p.height_mode == SizeMode::FIXED ? p.height : content.h};
+    }
+
+    // 重新测量，父容器看到的尺寸变化时沿父链向上传播
+    void remeasure(GraphicsDriver* driver, Handle h) {
+        while (true) {
+            const Size old_basis = basis(h);
+            state_[h] &= ~MEASURE;
+            const Size size = measureNode(driver, h);
+            stats_.measured++;
+            if (isContainer(h)) {
+                state_[h] |= ARRANGE;
+            }
+
+            const uint8_t hidden = pool_.component(h)->isVisible() ? 0 : HIDDEN;
+            const bool visibility_changed = (state_[h] & HIDDEN) != hidden;
+            const bool changed = size != measured_[h] || visibility_changed;
+            state_[h] = (state_[h] & ~HIDDEN) | hidden;
+            measured_[h] = size;
+
+            const Handle parent = pool_.parent(h);
+            if (parent == Pool::NONE) {
+                if (changed) {
+                    state_[h] |= ARRANGE;
+                }
+                return;
+            }
+            // FILL的轴由父容器分配，测量结果在该轴上的变化不影响父容器；
+            // 可见性变化则总是影响剩余空间的分配
+            if (!isContainer(parent) || (basis(h) == old_basis && !visibility_changed)) {
+                return;
+            }
+            h = parent;
+        }
+    }
+
+    Rect rootRect(Handle h) const {
+        const LayoutParams& p = params_[h];
+        return Rect{screen_.x, screen_.y, p.width_mode == SizeMode::FILL ? screen_.w : measured_[h].w,
+                    p.height_mode == SizeMode::FILL ? screen_.h : measured_[h].h};
+    }
+
+    static int16_t alignOffset(LayoutAlign align, int16_t space, int16_t size) {
+        if (align == LayoutAlign::CENTER) {
+            return (space - size) / 2;
+        }
+        return align == LayoutAlign::END ? space - size : 0;
+    }
+
+    // 写回组件几何，组件与池各自处理重绘和损坏区
+    void place(Handle h, const Rect& rect) {
+        Component* component = pool_.component(h);
+        const Rect old = component->bounds();
+        if (old.x == rect.x && old.y == rect.y && old.w == rect.w && old.h == rect.h) {
+            return;
+        }
+        component->setBounds(rect);
+        // 几何变化引起的通知不是内容变化，不需要再测量
+        pool_.takeChanges(h);
+        stats_.moved++;
+    }
+
+    void arrange(Handle h, const Rect& rect) {
+        place(h, rect);
+        state_[h] &= ~ARRANGE;
+        stats_.arranged++;
+        if (!isContainer(h)) {
+            return;
+        }
+
+        const LayoutParams& p = params_[h];
+        const Rect inner{static_cast<int16_t>(rect.x + p.padding), static_cast<int16_t>(rect.y + p.padding),
+                         static_cast<int16_t>(rect.w - 2 * p.padding), static_cast<int16_t>(rect.h - 2 * p.padding)};
+        const bool row = p.kind == LayoutKind::ROW;
+        const bool column = p.kind == LayoutKind::COLUMN;
+
+        // 主轴上的剩余空间按权重分给FILL子组件
+        int32_t used = 0;
+        uint32_t weights = 0;
+        int16_t count = 0;
+        for (Handle c = pool_.firstChild(h); c != Pool::NONE; c = pool_.nextSibling(c)) {
+            if (state_[c] & HIDDEN) {
+                continue;
+            }
+            const Size b = basis(c);
+            used += row ? b.w : b.h;
+            if ((row && params_[c].width_mode == SizeMode::FILL) ||
+                (column && params_[c].height_mode == SizeMode::FILL)) {
+                weights += params_[c].weight;
+            }
+            count++;
+        }
+        if (count > 1) {
+            used += (count - 1) * p.gap;
+        }
+        int32_t free = (row ? inner.w : inner.h) - used;
+        if (free < 0) {
+            free = 0;
+        }
+
+        int32_t pos = row ? inner.x : inner.y;
+        int32_t remaining_free = free;
+        uint32_t remaining_weights = weights;
+        for (Handle c = pool_.firstChild(h); c != Pool::NONE; c = pool_.nextSibling(c)) {
+            if (state_[c] & HIDDEN) {
+                continue;
+            }
+            const LayoutParams& cp = params_[c];
+            const Size b = basis(c);
+            Rect r;
+            if (row || column) {
+                const bool fill_main = row ? cp.width_mode == SizeMode::FILL : cp.height_mode == SizeMode::FILL;
+                const bool fill_cross = row ? cp.height_mode == SizeMode::FILL : cp.width_mode == SizeMode::FILL;
+                int32_t main = row ? b.w : b.h;
+                if (fill_main && remaining_weights > 0) {
+                    // 最后一个填充组件取走余数，避免取整误差
+                    const int32_t share = remaining_weights == cp.weight
+                                              ? remaining_free
+                                              : remaining_free * cp.weight / remaining_weights;
+                    main += share;
+                    remaining_free -= share;
+                    remaining_weights -= cp.weight;
+                }
+                const int16_t cross_space = row ? inner.h : inner.w;
+                int16_t cross = fill_cross ? cross_space : (row ? measured_[c].h : measured_[c].w);
+                if (cross > cross_space) {
+                    cross = cross_space;
+                }
+                const int16_t cross_pos = (row ? inner.y : inner.x) + alignOffset(p.align, cross_space, cross);
+                if (row) {
+                    r = Rect{static_cast<int16_t>(pos), cross_pos, static_cast<int16_t>(main), cross};
+                } else {
+                    r = Rect{cross_pos, static_cast<int16_t>(pos), cross, static_cast<int16_t>(main)};
+                }
+                pos += main + p.gap;
+            } else {
+                int16_t w = cp.width_mode == SizeMode::FILL ? inner.w : measured_[c].w;
+                int16_t hh = cp.height_mode == SizeMode::FILL ? inner.h : measured_[c].h;
+                w = w > inner.w ? inner.w : w;
+                hh = hh > inner.h ? inner.h : hh;
+                r = Rect{static_cast<int16_t>(inner.x + alignOffset(p.align, inner.w, w)),
+                         static_cast<int16_t>(inner.y + alignOffset(p.align, inner.h, hh)), w, hh};
+            }
+
+            // 几何未变且子树无待排列时跳过
+            const Rect old = pool_.component(c)->bounds();
+            if ((state_[c] & ARRANGE) || old.x != r.x || old.y != r.y || old.w != r.w || old.h != r.h) {
+                arrange(c, r);
+            }
+        }
+    }
+};
+
+} // namespace Components
+} // namespace MinimalUI
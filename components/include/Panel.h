@@ -0,0 +1,33 @@
+#pragma once
+
+#include "Component.h"
+
+namespace MinimalUI {
+namespace Components {
+
+/**
+ * @class Panel
+ * @brief 纯色背景（可带1像素边框）的矩形区域
+ *
+ * 通常作为布局容器，在子组件下方提供背景。面板只在几何或颜色变化时整体重绘；
+ * 颜色变化时子组件需要随后重绘，放在WidgetPool中时可用pool.invalidate(bounds())。
+ */
+class Panel : public Component {
+public:
+    Panel(int16_t x, int16_t y, int16_t width, int16_t height, Color color = Colors::BLACK)
+        : Panel(x, y, width, height, color, color) {}
+    Panel(int16_t x, int16_t y, int16_t width, int16_t height, Color color, Color border);
+
+    void setColors(Color color, Color border);
+    void setColor(Color color) override { setColors(color, border_ == color_ ? color : border_); }
+    Color getColor() const { return color_; }
+
+    void render(GraphicsDriver* driver) override;
+
+private:
+    Color color_;
+    Color border_;   // 与背景色相同时不绘制边框
+};
+
+} // namespace Components
+} // namespace MinimalUI
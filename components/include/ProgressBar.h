@@ -0,0 +1,63 @@
+#pragma once
+
+#include "Component.h"
+
+namespace MinimalUI {
+namespace Components {
+
+/**
+ * @class ProgressBar
+ * @brief 带边框的水平进度条
+ *
+ * 进度变化时只重绘填充长度的变化部分：增长时填充新增的一段，
+ * 缩短时把多出的一段恢复为背景色。配合Animator的VALUE补间，
+ * 每一帧的总线传输量只与这一帧移动的像素列数成正比。
+ */
+class ProgressBar : public Component {
+public:
+    // 进度满值（千分比）
+    static constexpr int32_t MAX_VALUE = 1000;
+
+    ProgressBar(int16_t x, int16_t y, int16_t width, int16_t height,
+                Color color = Colors::BLUE, Color bg = Colors::WHITE, Color border = Colors::BLACK);
+
+    /**
+     * @brief 设置进度（0 ~ MAX_VALUE），超出范围时截断
+     */
+    void setValue(int32_t value) override;
+    int32_t getValue() const { return value_; }
+
+    void setColor(Color color) override;
+    /**
+     * @brief 设置填充色、轨道色（进度未覆盖部分）和边框色
+     */
+    void setColors(Color color, Color bg, Color border);
+
+    /**
+     * @brief 设置隐藏时擦除整个进度条所用的颜色，应与进度条所在的屏幕背景一致（默认黑色）
+     */
+    void setEraseColor(Color color) { erase_ = color; }
+
+    void render(GraphicsDriver* driver) override;
+
+protected:
+    void invalidateLayout() override;
+
+private:
+    int32_t value_ = 0;
+    Color color_;
+    Color bg_;
+    Color border_;
+    Color erase_ = Colors::BLACK;   // 隐藏时擦除用的屏幕背景色
+    int16_t drawn_width_ = 0;   // 已绘制的填充宽度
+    bool full_redraw_ = true;
+    bool painted_ = false;      // 屏幕上有本组件绘制的内容，隐藏时需要擦除
+
+    // 边框内侧留1像素间隙
+    Rect inner() const { return Rect{static_cast<int16_t>(x_ + 2), static_cast<int16_t>(y_ + 2),
+                                     static_cast<int16_t>(width_ - 4), static_cast<int16_t>(height_ - 4)}; }
+    int16_t fillWidth() const;
+};
+
+} // namespace Components
+} // namespace MinimalUI
@@ -0,0 +1,421 @@
+#pragma once
+
+#include "Component.h"
+#include "Trace.h"
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+// 组件池容量，ESP32构建中由组件CMake定义
+#ifndef CONFIG_UI_MAX_ELEMENTS
+#define CONFIG_UI_MAX_ELEMENTS 32
+#endif
+
+// 池内创建的组件每个占用的字节数上限
+#ifndef CONFIG_UI_WIDGET_SLOT_SIZE
+#define CONFIG_UI_WIDGET_SLOT_SIZE 256
+#endif
+
+namespace MinimalUI {
+namespace Components {
+
+/**
+ * @class WidgetPool
+ * @brief 固定容量的组件池，组件树以扁平数组存储
+ *
+ * 每个组件占用一个槽位，父子关系用槽位下标（父、第一个子、下一个兄弟）表示。
+ * 包围盒、标志位（可见、脏）等按字段分别存放在连续数组中（结构体数组转为数组结构体），
+ * 命中测试、损坏区求交和绘制遍历都是对这些数组的线性扫描，不需要访问组件对象，
+ * 只有确实要绘制或处理输入的组件才会被解引用。
+ *
+ * 组件可以用create<T>()直接构造在池内的槽位存储中（无堆分配），
+ * 也可以用add()加入由调用方持有的组件（例如静态对象）。
+ * 组件的invalidate()和几何变化通过ComponentHost接口同步到池的数组。
+ *
+ * 绘制顺序为先序遍历：父组件先于子组件，后加入的兄弟在上层。
+ * 组件移动或隐藏时旧区域记为损坏区，render()先用背景色填充损坏区，
+ * 再整体重绘与之相交的所有可见组件。
+ *
+ * @tparam Capacity 最大组件数（默认CONFIG_UI_MAX_ELEMENTS）
+ * @tparam SlotSize 池内创建的单个组件的最大字节数
+ */
+template <uint16_t Capacity = CONFIG_UI_MAX_ELEMENTS, size_t SlotSize = CONFIG_UI_WIDGET_SLOT_SIZE>
+class WidgetPool : public ComponentHost {
+public:
+    using Handle = uint16_t;
+    static constexpr Handle NONE = 0xFFFF;
+
+    static_assert(Capacity > 0 && Capacity < NONE, "WidgetPool capacity out of range");
+
+    explicit WidgetPool(Color background = Colors::BLACK) : background_(background) {
+        for (Handle i = 0; i < Capacity; i++) {
+            flags_[i] = 0;
+            next_sibling_[i] = i + 1 < Capacity ? static_cast<Handle>(i + 1) : NONE;
+        }
+    }
+
+    ~WidgetPool() override {
+        while (first_root_ != NONE) {
+            remove(first_root_);
+        }
+    }
+
+    WidgetPool(const WidgetPool&) = delete;
+    WidgetPool& operator=(const WidgetPool&) = delete;
+
+    /**
+     * @brief 在池内构造组件
+     * @param parent 父组件，NONE表示顶层
+     * @return 组件句柄，池已满或父组件无效时返回NONE
+     */
+    template <typename T, typename... Args>
+    Handle create(Handle parent, Args&&... args) {
+        static_assert(std::is_base_of<Component, T>::value, "WidgetPool stores Component subclasses");
+        static_assert(sizeof(T) <= SlotSize, "Widget does not fit into a pool slot, increase SlotSize");
+        static_assert(alignof(T) <= alignof(std::max_align_t), "Widget alignment exceeds slot alignment");
+        Handle handle = reserve(parent);
+        if (handle != NONE) {
+            link(handle, parent, new (storage_[handle]) T(std::forward<Args>(args)...), true);
+        }
+        return handle;
+    }
+
+    /**
+     * @brief 加入由调用方持有的组件，组件必须比池或其移除时刻活得更久
+     * @return 组件句柄，池已满或父组件无效时返回NONE
+     */
+    Handle add(Component& component, Handle parent = NONE) {
+        Handle handle = reserve(parent);
+        if (handle != NONE) {
+            link(handle, parent, &component, false);
+        }
+        return handle;
+    }
+
+    /**
+     * @brief 移除组件及其全部子组件，池内构造的组件被析构
+     */
+    void remove(Handle handle) {
+        if (!valid(handle)) {
+            return;
+        }
+        if (order_dirty_) {
+            rebuildOrder();
+        }
+
+        // 先从父组件（或顶层列表）中摘下
+        if (parent_[handle] != NONE) {
+            flags_[parent_[handle]] |= CHANGE_CONTENT;
+        }
+        Handle& head = parent_[handle] == NONE ? first_root_ : first_child_[parent_[handle]];
+        if (head == handle) {
+            head = next_sibling_[handle];
+        } else {
+            Handle prev = head;
+            while (next_sibling_[prev] != handle) {
+                prev = next_sibling_[prev];
+            }
+            next_sibling_[prev] = next_sibling_[handle];
+        }
+
+        // 先序顺序中子树是连续的一段
+        Handle begin = 0;
+        while (order_[begin] != handle) {
+            begin++;
+        }
+        Handle end = begin + 1;
+        while (end < count_ && isDescendant(order_[end], handle)) {
+            end++;
+        }
+        for (Handle i = begin; i < end; i++) {
+            const Handle h = order_[i];
+            if (flags_[h] & SHOWN) {
+                addDamage(bounds_[h]);
+            }
+            components_[h]->attachHost(nullptr, 0);
+            if (flags_[h] & OWNED) {
+                components_[h]->~Component();
+            }
+            components_[h] = nullptr;
+            flags_[h] = 0;
+            next_sibling_[h] = free_head_;
+            free_head_ = h;
+        }
+        count_ -= end - begin;
+        order_dirty_ = true;
+    }
+
+    bool valid(Handle handle) const { return handle < Capacity && (flags_[handle] & USED); }
+
+    Component* component(Handle handle) const { return valid(handle) ? components_[handle] : nullptr; }
+
+    template <typename T>
+    T* get(Handle handle) const { return static_cast<T*>(component(handle)); }
+
+    Handle parent(Handle handle) const { return valid(handle) ? parent_[handle] : NONE; }
+    Handle firstChild(Handle handle) const { return valid(handle) ? first_child_[handle] : NONE; }
+    Handle nextSibling(Handle handle) const { return valid(handle) ? next_sibling_[handle] : NONE; }
+
+    Handle size() const { return count_; }
+    static constexpr Handle capacity() { return Capacity; }
+
+    /**
+     * @brief 自上而下查找包含该点的第一个可见组件
+     * @return 组件句柄，没有时返回NONE
+     */
+    Handle hitTest(int16_t x, int16_t y) {
+        if (order_dirty_) {
+            rebuildOrder();
+        }
+        for (Handle i = count_; i-- > 0;) {
+            const Handle h = order_[i];
+            if ((flags_[h] & SHOWN) && bounds_[h].contains(x, y)) {
+                return h;
+            }
+        }
+        return NONE;
+    }
+
+    /**
+     * @brief 分发输入事件，自上而下直到某个组件处理
+     * 触摸事件只交给包含触摸点的组件，其他事件交给所有可见组件
+     * @return 事件是否已被处理
+     */
+    bool dispatch(const InputEvent& event) {
+        if (order_dirty_) {
+            rebuildOrder();
+        }
+        const bool touch = event.type == InputEventType::TOUCH_DOWN || event.type == InputEventType::TOUCH_MOVE ||
+                           event.type == InputEventType::TOUCH_UP;
+        for (Handle i = count_; i-- > 0;) {
+            const Handle h = order_[i];
+            if (!(flags_[h] & SHOWN) || (touch && !bounds_[h].contains(event.x, event.y))) {
+                continue;
+            }
+            if (components_[h]->handleInput(event)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * @brief 标记需要恢复的区域，下次render()时重绘与之相交的组件
+     */
+    void invalidate(const Rect& area) { addDamage(area); }
+
+    // 当前损坏区（多个损坏矩形的包围盒）
+    const Rect& damage() const { return damage_; }
+
+    void setBackground(Color color) { background_ = color; }
+
+    // 供布局引擎使用的变化位
+    static constexpr uint8_t CHANGE_CONTENT = 0x20;  // 内容、可见性或子组件变化，首选尺寸可能改变
+    static constexpr uint8_t CHANGE_CREATED = 0x40;  // 槽位上是新加入的组件
+
+    /**
+     * @brief 取出并清除组件自上次调用以来的变化位
+     */
+    uint8_t takeChanges(Handle handle) {
+        if (!valid(handle)) {
+            return 0;
+        }
+        const uint8_t changes = flags_[handle] & (CHANGE_CONTENT | CHANGE_CREATED);
+        flags_[handle] &= ~(CHANGE_CONTENT | CHANGE_CREATED);
+        return changes;
+    }
+
+    /**
+     * @brief 绘制损坏区和所有需要重绘的可见组件
+     * @return 调用render()的组件数
+     */
+    Handle render(GraphicsDriver* driver) {
+        if (!driver) {
+            return 0;
+        }
+        MUI_TRACE_SCOPE("paint.pool");
+        if (order_dirty_) {
+            rebuildOrder();
+        }
+
+        if (!damage_.isEmpty()) {
+            driver->fillRect(damage_.x, damage_.y, damage_.w, damage_.h, background_);
+            for (Handle i = 0; i < count_; i++) {
+                const Handle h = order_[i];
+                if ((flags_[h] & SHOWN) && !bounds_[h].intersect(damage_).isEmpty()) {
+                    repaint(h);
+                }
+            }
+            damage_ = Rect{0, 0, 0, 0};
+        }
+
+        Handle painted = 0;
+        for (Handle i = 0; i < count_; i++) {
+            const Handle h = order_[i];
+            if ((flags_[h] & (SHOWN | DIRTY)) != (SHOWN | DIRTY)) {
+                continue;
+            }
+            components_[h]->render(driver);
+            if (!components_[h]->isDirty()) {
+                flags_[h] &= ~DIRTY;
+            }
+            painted++;
+        }
+        return painted;
+    }
+
+    // 实现ComponentHost接口
+    void componentChanged(uint16_t slot, bool geometry) override {
+        if (!valid(slot)) {
+            return;
+        }
+        if (geometry) {
+            if (flags_[slot] & SHOWN) {
+                addDamage(bounds_[slot]);
+            }
+            bounds_[slot] = components_[slot]->bounds();
+            const uint8_t visible = components_[slot]->isVisible() ? VISIBLE : 0;
+            if ((flags_[slot] & VISIBLE) != visible) {
+                flags_[slot] ^= VISIBLE;
+                order_dirty_ = true;
+                // 隐藏的组件在布局中不占空间
+                flags_[slot] |= CHANGE_CONTENT;
+            }
+        }
+        // 池自己要求的整体重绘不是内容变化
+        flags_[slot] |= geometry || repainting_ ? DIRTY : (DIRTY | CHANGE_CONTENT);
+    }
+
+private:
+    // 槽位标志
+    static constexpr uint8_t USED = 0x01;
+    static constexpr uint8_t OWNED = 0x02;    // 组件构造在池内，移除时析构
+    static constexpr uint8_t VISIBLE = 0x04;  // 组件自身可见
+    static constexpr uint8_t SHOWN = 0x08;    // 自身及所有祖先都可见
+    static constexpr uint8_t DIRTY = 0x10;
+    // 0x20、0x40为CHANGE_CONTENT、CHANGE_CREATED
+
+    // 热数据：遍历时顺序访问
+    Rect bounds_[Capacity];
+    uint8_t flags_[Capacity];
+    Handle order_[Capacity];         // 先序遍历顺序（绘制顺序）
+    Handle parent_[Capacity];
+    Handle first_child_[Capacity];
+    Handle next_sibling_[Capacity];  // 空闲槽位借用为空闲链表
+    // 冷数据：只在绘制或分发输入时访问
+    Component* components_[Capacity] = {};
+    alignas(std::max_align_t) unsigned char storage_[Capacity][SlotSize];
+
+    Handle count_ = 0;
+    Handle free_head_ = 0;
+    Handle first_root_ = NONE;
+    bool order_dirty_ = false;
+    bool repainting_ = false;
+    Color background_;
+    Rect damage_{0, 0, 0, 0};
+
+    // 取出一个空闲槽位
+    Handle reserve(Handle parent) {
+        if (free_head_ == NONE || (parent != NONE && !valid(parent))) {
+            return NONE;
+        }
+        const Handle handle = free_head_;
+        free_head_ = next_sibling_[handle];
+        return handle;
+    }
+
+    // 初始化槽位并挂到父组件的子列表末尾（最上层）
+    void link(Handle handle, Handle parent, Component* component, bool owned) {
+        components_[handle] = component;
+        bounds_[handle] = component->bounds();
+        flags_[handle] = USED | DIRTY | CHANGE_CONTENT | CHANGE_CREATED | (owned ? OWNED : 0) |
+                         (component->isVisible() ? VISIBLE : 0);
+        parent_[handle] = parent;
+        first_child_[handle] = NONE;
+        next_sibling_[handle] = NONE;
+
+        if (parent != NONE) {
+            flags_[parent] |= CHANGE_CONTENT;
+        }
+        Handle& head = parent == NONE ? first_root_ : first_child_[parent];
+        if (head == NONE) {
+            head = handle;
+        } else {
+            Handle last = head;
+            while (next_sibling_[last] != NONE) {
+                last = next_sibling_[last];
+            }
+            next_sibling_[last] = handle;
+        }
+        component->attachHost(this, handle);
+        count_++;
+        order_dirty_ = true;
+    }
+
+    void repaint(Handle handle) {
+        repainting_ = true;
+        components_[handle]->repaint();
+        repainting_ = false;
+    }
+
+    bool isDescendant(Handle handle, Handle ancestor) const {
+        for (Handle p = parent_[handle]; p != NONE; p = parent_[p]) {
+            if (p == ancestor) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void addDamage(const Rect& rect) {
+        if (rect.isEmpty()) {
+            return;
+        }
+        if (damage_.isEmpty()) {
+            damage_ = rect;
+            return;
+        }
+        const int16_t x0 = rect.x < damage_.x ? rect.x : damage_.x;
+        const int16_t y0 = rect.y < damage_.y ? rect.y : damage_.y;
+        const int16_t x1 = rect.right() > damage_.right() ? rect.right() : damage_.right();
+        const int16_t y1 = rect.bottom() > damage_.bottom() ? rect.bottom() : damage_.bottom();
+        damage_ = Rect{x0, y0, static_cast<int16_t>(x1 - x0), static_cast<int16_t>(y1 - y0)};
+    }
+
+    // 按链接重建先序顺序，同时计算继承的可见性；结构或可见性变化后才需要
+    void rebuildOrder() {
+        Handle k = 0;
+        Handle n = first_root_;
+        while (n != NONE) {
+            order_[k++] = n;
+            const Handle p = parent_[n];
+            const bool shown = (flags_[n] & VISIBLE) && (p == NONE || (flags_[p] & SHOWN));
+            if (shown != ((flags_[n] & SHOWN) != 0)) {
+                flags_[n] ^= SHOWN;
+                if (shown) {
+                    // 重新显示：被隐藏期间没有绘制，需要整体重绘
+                    repaint(n);
+                } else {
+                    addDamage(bounds_[n]);
+                }
+            }
+
+            if (first_child_[n] != NONE) {
+                n = first_child_[n];
+                continue;
+            }
+            while (n != NONE && next_sibling_[n] == NONE) {
+                n = parent_[n];
+            }
+            if (n != NONE) {
+                n = next_sibling_[n];
+            }
+        }
+        order_dirty_ = false;
+    }
+};
+
+} // namespace Components
+} // namespace MinimalUI
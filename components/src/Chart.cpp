@@ -0,0 +1,192 @@
+#include "Chart.h"
+#include "Trace.h"
+#include <algorithm>
+
+namespace MinimalUI {
+namespace Components {
+
+Chart::Chart(int16_t x, int16_t y, int16_t width, int16_t height, int16_t min_value, int16_t max_value,
+             Color color, Color bg)
+    : Component(x, y, width, height), samples_{}, min_(min_value), max_(max_value), color_(color), bg_(bg) {
+}
+
+void Chart::push(int16_t sample) {
+    samples_[head_] = sample;
+    head_ = static_cast<uint16_t>((head_ + 1) % CAPACITY);
+    if (count_ < CAPACITY) {
+        count_++;
+    }
+
+    // 最新一列填满后开始新的一列，绘制时已有内容左移一列
+    if (column_fill_ == 0 || column_fill_ >= samples_per_column_) {
+        column_fill_ = 1;
+        if (pending_columns_ < width_) {
+            pending_columns_++;
+        }
+    } else {
+        column_fill_++;
+    }
+    invalidate();
+}
+
+void Chart::setValue(int32_t value) {
+    push(static_cast<int16_t>(std::min<int32_t>(std::max<int32_t>(value, INT16_MIN), INT16_MAX)));
+}
+
+void Chart::setRange(int16_t min_value, int16_t max_value) {
+    if (min_value == min_ && max_value == max_) {
+        return;
+    }
+    min_ = min_value;
+    max_ = max_value;
+    invalidateLayout();
+}
+
+void Chart::setWindow(uint16_t samples) {
+    if (samples == window_) {
+        return;
+    }
+    window_ = samples;
+    invalidateLayout();
+}
+
+void Chart::clear() {
+    head_ = 0;
+    count_ = 0;
+    column_fill_ = 0;
+    pending_columns_ = 0;
+    invalidateLayout();
+}
+
+int16_t Chart::sample(uint16_t age) const {
+    if (age >= count_) {
+        return 0;
+    }
+    return samples_[(head_ + CAPACITY - 1 - age) % CAPACITY];
+}
+
+void Chart::setColor(Color color) {
+    setColors(color, bg_);
+}
+
+void Chart::setColors(Color color, Color bg) {
+    if (color == color_ && bg == bg_) {
+        return;
+    }
+    color_ = color;
+    bg_ = bg;
+    invalidateLayout();
+}
+
+void Chart::invalidateLayout() {
+    // 尺寸变化会改变每列的采样数，重绘时按新的列划分从环形缓冲区恢复
+    updateSamplesPerColumn();
+    full_redraw_ = true;
+    invalidate();
+}
+
+void Chart::updateSamplesPerColumn() {
+    uint16_t per_column = 1;
+    if (width_ > 0 && window_ > width_) {
+        per_column = static_cast<uint16_t>((window_ + width_ - 1) / width_);
+    }
+    samples_per_column_ = per_column;
+    column_fill_ = std::min(column_fill_, per_column);
+}
+
+int16_t Chart::rowFor(int16_t value) const {
+    const int16_t bottom = static_cast<int16_t>(y_ + height_ - 1);
+    const int32_t range = static_cast<int32_t>(max_) - min_;
+    if (range <= 0) {
+        return bottom;
+    }
+    const int32_t clamped = std::min<int32_t>(std::max<int32_t>(value, min_), max_);
+    const int32_t offset = ((clamped - min_) * (height_ - 1) + range / 2) / range;
+    return static_cast<int16_t>(bottom - offset);
+}
+
+void Chart::drawColumn(GraphicsDriver* driver, int16_t column) {
+    const int16_t x = static_cast<int16_t>(x_ + column);
+    const int16_t bottom = static_cast<int16_t>(y_ + height_ - 1);
+    stats_.columns_drawn++;
+
+    // 按时间倒序，最右一列是最新的column_fill_个采样，之前每列samples_per_column_个
+    const int32_t age = width_ - 1 - column;
+    const int32_t start = age == 0 ? 0 : column_fill_ + (age - 1) * samples_per_column_;
+    const int32_t end = age == 0 ? column_fill_ : start + samples_per_column_;
+    if (start >= count_) {
+        driver->fillRect(x, y_, 1, height_, bg_);
+        return;
+    }
+
+    // 列内最小/最大值，再包含前一列的最后一个采样，使相邻列连成折线
+    const int32_t last = std::min<int32_t>(end + 1, count_);
+    int16_t low = sample(static_cast<uint16_t>(start));
+    int16_t high = low;
+    for (int32_t i = start + 1; i < last; i++) {
+        const int16_t value = sample(static_cast<uint16_t>(i));
+        low = std::min(low, value);
+        high = std::max(high, value);
+    }
+
+    const int16_t top = rowFor(high);
+    const int16_t base = rowFor(low);
+    if (top > y_) {
+        driver->fillRect(x, y_, 1, top - y_, bg_);
+    }
+    driver->fillRect(x, top, 1, base - top + 1, color_);
+    if (base < bottom) {
+        driver->fillRect(x, base + 1, 1, bottom - base, bg_);
+    }
+}
+
+void Chart::render(GraphicsDriver* driver) {
+    if (!driver || !dirty_) {
+        return;
+    }
+    MUI_TRACE_SCOPE("paint.chart");
+    if (!visible_ || width_ <= 0 || height_ <= 0) {
+        // 隐藏时用背景色擦除已绘制的曲线（只擦一次），重新显示时整体重绘
+        if (painted_ && width_ > 0 && height_ > 0) {
+            driver->fillRect(x_, y_, width_, height_, bg_);
+        }
+        painted_ = false;
+        full_redraw_ = true;
+        markClean();
+        return;
+    }
+
+    const int16_t shift = pending_columns_;
+    bool full = full_redraw_ || shift >= width_;
+    if (!full && shift > 0) {
+        full = !driver->shiftRect(x_, y_, width_, height_, static_cast<int16_t>(-shift));
+        if (!full) {
+            stats_.shifts++;
+        }
+    }
+
+    if (full) {
+        for (int16_t column = 0; column < width_; column++) {
+            drawColumn(driver, column);
+        }
+        stats_.full_redraws++;
+        full_redraw_ = false;
+        painted_ = true;
+    } else {
+        // 只栅格化新开始的列；上次绘制时尚未填满的列平移后也要补画
+        int16_t first = static_cast<int16_t>(width_ - 1 - shift);
+        if (shift > 0 && drawn_fill_ >= samples_per_column_) {
+            first++;
+        }
+        for (int16_t column = first; column < width_; column++) {
+            drawColumn(driver, column);
+        }
+    }
+
+    drawn_fill_ = column_fill_;
+    pending_columns_ = 0;
+    markClean();
+}
+
+} // namespace Components
+} // namespace MinimalUI
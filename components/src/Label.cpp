@@ -0,0 +1,208 @@
+#include "Label.h"
+#include "Trace.h"
+#include <cstring>
+
+namespace MinimalUI {
+namespace Components {
+
+Label::Label(int16_t x, int16_t y, int16_t width, int16_t height, const char* text,
+             Color color, Color bg)
+    : Component(x, y, width, height), color_(color), bg_(bg) {
+    text_[0] = '\0';
+    setText(text);
+}
+
+void Label::setText(const char* text) {
+    if (!text) {
+        text = "";
+    }
+    size_t length = strnlen(text, MAX_LENGTH);
+    // 截断时不能留下半个UTF-8字符
+    if (text[length] != '\0') {
+        while (length > 0 && (static_cast<uint8_t>(text[length]) & 0xC0) == 0x80) {
+            length--;
+        }
+    }
+    // 与截断后的文本比较，超长文本重复设置时同样不会重绘
+    if (text_[length] == '\0' && memcmp(text_, text, length) == 0) {
+        return;
+    }
+    memcpy(text_, text, length);
+    text_[length] = '\0';
+    invalidate();
+}
+
+void Label::setColors(Color color, Color bg) {
+    if (color == color_ && bg == bg_) {
+        return;
+    }
+    color_ = color;
+    bg_ = bg;
+    invalidateLayout();
+}
+
+void Label::setFont(const Font* font) {
+    if (font == font_) {
+        return;
+    }
+    font_ = font;
+    invalidateLayout();
+}
+
+void Label::setScale(uint8_t scale) {
+    if (scale == 0 || scale == scale_) {
+        return;
+    }
+    scale_ = scale;
+    invalidateLayout();
+}
+
+void Label::setAlign(Align align) {
+    if (align == align_) {
+        return;
+    }
+    align_ = align;
+    invalidateLayout();
+}
+
+void Label::setTabularDigits(bool enabled) {
+    if (enabled == tabular_digits_) {
+        return;
+    }
+    tabular_digits_ = enabled;
+    invalidateLayout();
+}
+
+void Label::invalidateLayout() {
+    full_redraw_ = true;
+    invalidate();
+}
+
+uint8_t Label::layout(GraphicsDriver* driver, const Font& font, Cell* cells, uint8_t* widths) {
+    const int16_t total = driver->measureText(text_, scale_, tabular_digits_);
+    int16_t x = x_;
+    if (align_ == Align::CENTER) {
+        x = x_ + (width_ - total) / 2;
+    } else if (align_ == Align::RIGHT) {
+        x = x_ + width_ - total;
+    }
+
+    const uint8_t digit_advance = tabular_digits_ ? font.digitAdvance() : 0;
+    uint8_t count = 0;
+    const char* p = text_;
+    for (uint32_t code = Font::nextCodepoint(p); code != 0 && count < MAX_LENGTH; code = Font::nextCodepoint(p)) {
+        if (code > 0xFFFF) {
+            code = Font::REPLACEMENT;
+        }
+        bool digit = tabular_digits_ && code >= '0' && code <= '9';
+        uint8_t width = digit ? digit_advance : driver->codepointAdvance(code);
+        widths[count] = width;
+        cells[count++] = Cell{x, static_cast<uint16_t>(code)};
+        x += width * scale_;
+    }
+    return count;
+}
+
+Size Label::preferredSize(GraphicsDriver* driver) {
+    if (!driver) {
+        return Size{width_, height_};
+    }
+    const Font* previous_font = &driver->font();
+    const Font& font = font_ ? *font_ : *previous_font;
+    driver->setFont(&font);
+    const int16_t w = driver->measureText(text_, scale_, tabular_digits_);
+    const int16_t h = static_cast<int16_t>(driver->lineHeight() * scale_);
+    driver->setFont(previous_font);
+    return Size{w, h};
+}
+
+void Label::render(GraphicsDriver* driver) {
+    if (!driver || !dirty_) {
+        return;
+    }
+    MUI_TRACE_SCOPE("paint.label");
+
+    const Rect area = bounds();
+    const bool clipped = driver->pushClip(area);
+
+    if (!visible_) {
+        // 隐藏时擦除已绘制的内容，重新显示时整体重绘
+        if (cell_count_ > 0 || !full_redraw_) {
+            driver->fillRect(area.x, area.y, area.w, area.h, bg_);
+        }
+        cell_count_ = 0;
+        full_redraw_ = true;
+        if (clipped) {
+            driver->popClip();
+        }
+        markClean();
+        return;
+    }
+
+    const Font* previous_font = &driver->font();
+    const Font& font = font_ ? *font_ : *previous_font;
+    driver->setFont(&font);
+
+    Cell cells[MAX_LENGTH];
+    uint8_t widths[MAX_LENGTH];
+    const uint8_t count = layout(driver, font, cells, widths);
+    const int16_t right = count > 0 ? cells[count - 1].x + widths[count - 1] * scale_ : 0;
+    const int16_t glyph_h = driver->lineHeight() * scale_;
+    const int16_t glyph_y = y_ + (height_ - glyph_h) / 2;
+
+    if (full_redraw_) {
+        driver->fillRect(area.x, area.y, area.w, area.h, bg_);
+        for (uint8_t i = 0; i < count; i++) {
+            // 背景已清除，字形以透明背景绘制
+            driver->drawCodepoint(cells[i].x, glyph_y, cells[i].code, widths[i], color_, color_, scale_);
+        }
+    } else {
+        // 新字符格之外的旧文本区域（左右两侧）需要清除
+        if (cell_count_ > 0) {
+            const int16_t old_left = cells_[0].x;
+            const int16_t old_right = cells_right_;
+            int16_t new_left = old_right;
+            int16_t new_right = old_right;
+            if (count > 0) {
+                new_left = cells[0].x;
+                new_right = right;
+            }
+            if (new_left > old_left) {
+                int16_t end = new_left < old_right ? new_left : old_right;
+                driver->fillRect(old_left, glyph_y, end - old_left, glyph_h, bg_);
+            }
+            if (new_right < old_right) {
+                int16_t start = new_right > old_left ? new_right : old_left;
+                driver->fillRect(start, glyph_y, old_right - start, glyph_h, bg_);
+            }
+        }
+
+        // 新字符格覆盖的列中，只有与旧字符格完全相同的格子保持原样。
+        // 按位置而不是序号匹配，右对齐数字位数变化时后缀单位仍可复用
+        uint8_t j = 0;
+        for (uint8_t i = 0; i < count; i++) {
+            const Cell& cell = cells[i];
+            while (j < cell_count_ && cells_[j].x < cell.x) {
+                j++;
+            }
+            if (j < cell_count_ && cells_[j].x == cell.x && cells_[j].code == cell.code) {
+                continue;
+            }
+            driver->drawCodepoint(cell.x, glyph_y, cell.code, widths[i], color_, bg_, scale_);
+        }
+    }
+
+    memcpy(cells_, cells, count * sizeof(Cell));
+    cells_right_ = right;
+    cell_count_ = count;
+    full_redraw_ = false;
+
+    driver->setFont(previous_font);
+    if (clipped) {
+        driver->popClip();
+    }
+    markClean();
+}
+
+} // namespace Components
+} // namespace MinimalUI
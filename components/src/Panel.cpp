@@ -0,0 +1,35 @@
+#include "Panel.h"
+#include "Trace.h"
+
+namespace MinimalUI {
+namespace Components {
+
+Panel::Panel(int16_t x, int16_t y, int16_t width, int16_t height, Color color, Color border)
+    : Component(x, y, width, height), color_(color), border_(border) {
+}
+
+void Panel::setColors(Color color, Color border) {
+    if (color == color_ && border == border_) {
+        return;
+    }
+    color_ = color;
+    border_ = border;
+    invalidateLayout();
+}
+
+void Panel::render(GraphicsDriver* driver) {
+    if (!driver || !dirty_) {
+        return;
+    }
+    MUI_TRACE_SCOPE("paint.panel");
+    if (visible_ && width_ > 0 && height_ > 0) {
+        driver->fillRect(x_, y_, width_, height_, color_);
+        if (border_ != color_) {
+            driver->drawRect(x_, y_, width_, height_, border_);
+        }
+    }
+    markClean();
+}
+
+} // namespace Components
+} // namespace MinimalUI
@@ -0,0 +1,95 @@
+#include "ProgressBar.h"
+#include "Trace.h"
+
+namespace MinimalUI {
+namespace Components {
+
+ProgressBar::ProgressBar(int16_t x, int16_t y, int16_t width, int16_t height,
+                         Color color, Color bg, Color border)
+    : Component(x, y, width, height), color_(color), bg_(bg), border_(border) {
+}
+
+void ProgressBar::setValue(int32_t value) {
+    if (value < 0) {
+        value = 0;
+    } else if (value > MAX_VALUE) {
+        value = MAX_VALUE;
+    }
+    if (value == value_) {
+        return;
+    }
+    value_ = value;
+    // 填充宽度按像素取整，宽度未变化的进度更新不产生重绘
+    if (fillWidth() != drawn_width_) {
+        invalidate();
+    }
+}
+
+void ProgressBar::setColor(Color color) {
+    setColors(color, bg_, border_);
+}
+
+void ProgressBar::setColors(Color color, Color bg, Color border) {
+    if (color == color_ && bg == bg_ && border == border_) {
+        return;
+    }
+    color_ = color;
+    bg_ = bg;
+    border_ = border;
+    invalidateLayout();
+}
+
+void ProgressBar::invalidateLayout() {
+    full_redraw_ = true;
+    invalidate();
+}
+
+int16_t ProgressBar::fillWidth() const {
+    const Rect area = inner();
+    if (area.isEmpty()) {
+        return 0;
+    }
+    return static_cast<int16_t>(area.w * value_ / MAX_VALUE);
+}
+
+void ProgressBar::render(GraphicsDriver* driver) {
+    if (!driver || !dirty_) {
+        return;
+    }
+    MUI_TRACE_SCOPE("paint.progress");
+    if (!visible_) {
+        // 隐藏时用屏幕背景色（不是轨道色）擦除已绘制的边框和进度，重新显示时整体重绘
+        if (painted_) {
+            driver->fillRect(x_, y_, width_, height_, erase_);
+            painted_ = false;
+        }
+        full_redraw_ = true;
+        markClean();
+        return;
+    }
+
+    const Rect area = inner();
+    const int16_t width = fillWidth();
+
+    if (full_redraw_) {
+        driver->drawRect(x_, y_, width_, height_, border_);
+        driver->fillRect(x_ + 1, y_ + 1, width_ - 2, height_ - 2, bg_);
+        if (width > 0) {
+            driver->fillRect(area.x, area.y, width, area.h, color_);
+        }
+        full_redraw_ = false;
+        painted_ = true;
+    } else if (width > drawn_width_) {
+        // 只填充新增的一段
+        driver->fillRect(area.x + drawn_width_, area.y, width - drawn_width_, area.h, color_);
+    } else if (width < drawn_width_) {
+        // 只擦除缩短的一段
+        driver->fillRect(area.x + width, area.y, drawn_width_ - width, area.h, bg_);
+    }
+
+    drawn_width_ = width;
+    markClean();
+}
+
+} // namespace Components
+} // namespace MinimalUI
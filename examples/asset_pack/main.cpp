@@ -0,0 +1,122 @@
+#include <chrono>
+#include <cstdio>
+#include <vector>
+#include "AssetPack.h"
+#include "AssetPackBuilder.h"
+#include "GraphicsDriver.h"
+
+using namespace MinimalUI;
+
+enum AssetId : uint16_t {
+    ASSET_FONT = 0,
+    ASSET_FONT_PROPORTIONAL = 1,
+    ASSET_ICON_RGB = 2,
+};
+
+// 128x64 RGB565帧缓冲区，记录drawBitmap读取的像素地址
+class RasterDriver : public GraphicsDriver {
+public:
+    static const int16_t W = 128;
+    static const int16_t H = 64;
+    Color pixels[W * H];
+    const Color* last_bitmap = nullptr;
+
+    RasterDriver() { clear(Colors::BLACK); }
+
+    bool initialize() override { return true; }
+    void drawPixel(int16_t x, int16_t y, Color color) override {
+        if (x >= 0 && x < W && y >= 0 && y < H) {
+            pixels[y * W + x] = color;
+        }
+    }
+    void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, Color color) override {
+        for (int16_t j = y; j < y + h; j++) {
+            for (int16_t i = x; i < x + w; i++) {
+                drawPixel(i, j, color);
+            }
+        }
+    }
+    void drawBitmap(int16_t x, int16_t y, int16_t w, int16_t h, const Color* data) override {
+        last_bitmap = data;
+        GraphicsDriver::drawBitmap(x, y, w, h, data);
+    }
+    void drawHLine(int16_t x, int16_t y, int16_t w, Color color) override { fillRect(x, y, w, 1, color); }
+    void drawVLine(int16_t x, int16_t y, int16_t h, Color color) override { fillRect(x, y, 1, h, color); }
+    void drawLine(int16_t, int16_t, int16_t, int16_t, Color) override {}
+    void drawRect(int16_t, int16_t, int16_t, int16_t, Color) override {}
+    void drawCircle(int16_t, int16_t, int16_t, Color) override {}
+    void fillCircle(int16_t, int16_t, int16_t, Color) override {}
+    void display() override {}
+    void clear(Color color) override {
+        for (Color& pixel : pixels) {
+            pixel = color;
+        }
+    }
+    int16_t width() const override { return W; }
+    int16_t height() const override { return H; }
+};
+
+// 按ID查找图像的平均耗时（主机）
+static double lookupNs(uint16_t count) {
+    AssetPackBuilder builder;
+    const Color pixel = Colors::RED;
+    for (uint16_t i = 0; i < count; i++) {
+        builder.addImage(1, 1, PixelFormat::RGB565, &pixel);
+    }
+    std::vector<uint8_t> bytes = builder.build();
+    AssetPack pack;
+    pack.openMemory(bytes.data(), bytes.size());
+
+    const int iterations = 2000000;
+    uint32_t seed = 7;
+    uint32_t sum = 0;
+    Image image;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; i++) {
+        seed = seed * 1103515245u + 12345u;
+        if (pack.image(static_cast<uint16_t>((seed >> 16) % count), image)) {
+            sum += static_cast<uint32_t>(image.width);
+        }
+    }
+    const double ns =
+        std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / iterations;
+    // 每次查找都应命中，同时防止循环被优化掉
+    return sum == static_cast<uint32_t>(iterations) ? ns : -1.0;
+}
+
+int main(int argc, char** argv) {
+    const char* path = argc > 1 ? argv[1] : "/tmp/minimalui_assets.bin";
+
+    // 16x16 RGB565渐变图标
+    Color icon[16 * 16];
+    for (int i = 0; i < 16 * 16; i++) {
+        icon[i] = static_cast<Color>(((i % 16) << 11) | ((i / 16) << 6) | 0x1F);
+    }
+
+    AssetPackBuilder builder;
+    builder.addFont(FONT_5X7);
+    builder.addFont(FONT_5X7_PROPORTIONAL);
+    builder.addImage(16, 16, PixelFormat::RGB565, icon);
+    AssetPack pack;
+    if (!builder.write(path) || !pack.open(path)) {
+        printf("Failed to write or map %s\n", path);
+        return 1;
+    }
+    printf("%s: %u assets, %zu bytes\n", path, static_cast<unsigned>(pack.count()), pack.size());
+
+    // 字体和图像都直接从映射区读取，不复制到RAM
+    Font font{};
+    Image image{};
+    RasterDriver driver;
+    if (pack.font(ASSET_FONT_PROPORTIONAL, font) && pack.image(ASSET_ICON_RGB, image)) {
+        driver.setFont(&font);
+        driver.drawText(2, 2, "Illuminate 1024 lx", Colors::WHITE, Colors::BLACK);
+        driver.drawImage(10, 20, image);
+        printf("  icon blit %s the mapping\n",
+               driver.last_bitmap == reinterpret_cast<const Color*>(image.data) ? "reads straight from" : "copies");
+    }
+
+    printf("\nLookup cost (host)\n");
+    printf("  10 assets: %.2f ns/lookup, 1000 assets: %.2f ns/lookup\n", lookupNs(10), lookupNs(1000));
+    return 0;
+}
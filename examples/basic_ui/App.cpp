@@ -1,8 +1,36 @@
 #include <iostream>
+#include <chrono>
+#include <thread>
 #include "GraphicsDriver.h"
 #include "DriverFactory.h"
+#include "Animation.h"
+#include "Label.h"
+#include "Layout.h"
+#include "Panel.h"
+#include "ProgressBar.h"
+#include "Trace.h"
+#include "WidgetPool.h"
 
 using namespace MinimalUI;
+using namespace MinimalUI::Components;
+
+// 进度条组件和动画调度器
+static ProgressBar progressBar(0, 0, 0, 0, Colors::BLUE, Colors::WHITE, Colors::BLACK);
+static Animator animator;
+
+// 组件池和布局引擎：界面中的坐标全部由布局计算，适配任意屏幕尺寸
+using UIPool = WidgetPool<>;
+static UIPool uiPool(Colors::WHITE);
+static LayoutEngine<UIPool> uiLayout(uiPool);
+static UIPool::Handle button1 = UIPool::NONE;
+static UIPool::Handle indicator = UIPool::NONE;
+static UIPool::Handle infoArea = UIPool::NONE;
+
+// 单调时钟（毫秒）
+static uint32_t nowMs() {
+    using namespace std::chrono;
+    return static_cast<uint32_t>(duration_cast<milliseconds>(steady_clock::now().time_since_epoch()).count());
+}
 
 // 注册驱动创建函数
 void registerDrivers() {
@@ -12,42 +40,84 @@ void registerDrivers() {
     // 例如: DriverFactory::registerCreator(DriverType::ESP32_SPI, createESP32Driver);
 }
 
+static LayoutParams layoutParams(LayoutKind kind, SizeMode width_mode, SizeMode height_mode, uint8_t padding = 0,
+                                 uint8_t gap = 0, LayoutAlign align = LayoutAlign::START) {
+    LayoutParams p;
+    p.kind = kind;
+    p.width_mode = width_mode;
+    p.height_mode = height_mode;
+    p.padding = padding;
+    p.gap = gap;
+    p.align = align;
+    return p;
+}
+
+// 构建组件树：标题栏、按钮行、状态行、信息区和底部状态栏
+static void buildUI() {
+    UIPool::Handle root = uiPool.create<Panel>(UIPool::NONE, 0, 0, 0, 0, Colors::WHITE);
+    uiLayout.set(root, layoutParams(LayoutKind::COLUMN, SizeMode::FILL, SizeMode::FILL));
+
+    UIPool::Handle title = uiPool.create<Panel>(root, 0, 0, 0, 0, Colors::BLUE);
+    LayoutParams title_params = layoutParams(LayoutKind::STACK, SizeMode::FILL, SizeMode::FIXED, 0, 0,
+                                             LayoutAlign::CENTER);
+    title_params.height = 30;
+    uiLayout.set(title, title_params);
+    uiPool.create<Label>(title, 0, 0, 0, 0, "MinimalUI", Colors::WHITE, Colors::BLUE);
+
+    UIPool::Handle content = uiPool.create<Panel>(root, 0, 0, 0, 0, Colors::WHITE);
+    uiLayout.set(content, layoutParams(LayoutKind::COLUMN, SizeMode::FILL, SizeMode::FILL, 10, 10));
+
+    // 两个等宽按钮
+    UIPool::Handle buttons = uiPool.create<Panel>(content, 0, 0, 0, 0, Colors::WHITE);
+    uiLayout.set(buttons, layoutParams(LayoutKind::ROW, SizeMode::FILL, SizeMode::CONTENT, 0, 20));
+    LayoutParams button_params = layoutParams(LayoutKind::NONE, SizeMode::FILL, SizeMode::FIXED);
+    button_params.height = 40;
+    button1 = uiPool.create<Panel>(buttons, 0, 0, 0, 0, Colors::RED, Colors::BLACK);
+    uiLayout.set(button1, button_params);
+    uiLayout.set(uiPool.create<Panel>(buttons, 0, 0, 0, 0, Colors::GREEN, Colors::BLACK), button_params);
+
+    // 状态指示器和进度条
+    UIPool::Handle status = uiPool.create<Panel>(content, 0, 0, 0, 0, Colors::WHITE);
+    uiLayout.set(status, layoutParams(LayoutKind::ROW, SizeMode::FILL, SizeMode::CONTENT, 0, 10,
+                                      LayoutAlign::CENTER));
+    indicator = uiPool.create<Panel>(status, 0, 0, 0, 0, Colors::GREEN, Colors::BLACK);
+    LayoutParams indicator_params = layoutParams(LayoutKind::NONE, SizeMode::FIXED, SizeMode::FIXED);
+    indicator_params.width = 26;
+    indicator_params.height = 26;
+    uiLayout.set(indicator, indicator_params);
+    LayoutParams bar_params = layoutParams(LayoutKind::NONE, SizeMode::FILL, SizeMode::FIXED);
+    bar_params.height = 20;
+    uiLayout.set(uiPool.add(progressBar, status), bar_params);
+
+    // 信息区域占满剩余高度
+    infoArea = uiPool.create<Panel>(content, 0, 0, 0, 0, Colors::CYAN, Colors::BLACK);
+    uiLayout.set(infoArea, layoutParams(LayoutKind::NONE, SizeMode::FILL, SizeMode::FILL));
+
+    // 底部状态栏
+    UIPool::Handle status_bar = uiPool.create<Panel>(root, 0, 0, 0, 0, Colors::GRAY);
+    LayoutParams status_bar_params = layoutParams(LayoutKind::NONE, SizeMode::FILL, SizeMode::FIXED);
+    status_bar_params.height = 20;
+    uiLayout.set(status_bar, status_bar_params);
+}
+
+// 更新布局并只重绘变化的组件
+static void renderUI(GraphicsDriver* driver) {
+    MUI_TRACE_SCOPE("frame");
+    uiLayout.update(driver, Rect{0, 0, driver->width(), driver->height()});
+    uiPool.render(driver);
+}
+
 // 创建简单的UI布局
 void drawSimpleUI(std::shared_ptr<GraphicsDriver> driver) {
+    if (uiPool.size() == 0) {
+        buildUI();
+    }
     // 清屏为白色背景
     driver->clear(Colors::WHITE);
     
-    // 绘制标题栏
-    driver->fillRect(0, 0, driver->width(), 30, Colors::BLUE);
-    
-    // 绘制两个按钮
-    // 按钮1 - 红色
-    driver->fillRect(20, 50, 80, 40, Colors::RED);
-    driver->drawRect(20, 50, 80, 40, Colors::BLACK); // 边框
-    
-    // 按钮2 - 绿色
-    driver->fillRect(140, 50, 80, 40, Colors::GREEN);
-    driver->drawRect(140, 50, 80, 40, Colors::BLACK); // 边框
-    
-    // 绘制分隔线
-    driver->drawLine(0, 110, driver->width(), 110, Colors::GRAY);
-    
-    // 绘制状态指示器
-    driver->drawCircle(40, 150, 15, Colors::BLACK);
-    driver->fillCircle(40, 150, 13, Colors::GREEN);
-    
-    // 绘制进度条背景
-    driver->drawRect(80, 140, 140, 20, Colors::BLACK);
-    
-    // 绘制进度条（70%进度）
-    driver->fillRect(82, 142, 98, 16, Colors::BLUE);
-    
-    // 绘制信息区域背景
-    driver->fillRect(10, 180, driver->width() - 20, 60, Colors::CYAN);
-    driver->drawRect(10, 180, driver->width() - 20, 60, Colors::BLACK);
-    
-    // 底部状态栏
-    driver->fillRect(0, driver->height() - 20, driver->width(), 20, Colors::GRAY);
+    // 进度条初始为70%
+    progressBar.setValue(700);
+    renderUI(driver.get());
 }
 
 // 绘制交互效果示例
@@ -55,24 +125,31 @@ void simulateInteraction(std::shared_ptr<GraphicsDriver> driver) {
     // 模拟按下按钮1
     std::cout << "Simulating button 1 press..." << std::endl;
     
-    // 改变按钮1外观
-    driver->fillRect(20, 50, 80, 40, Colors::BLUE); // 按下时颜色变化
-    driver->drawRect(20, 50, 80, 40, Colors::BLACK); // 边框
-    
-    // 更新状态指示器
-    driver->fillCircle(40, 150, 13, Colors::RED);
-    
-    // 更新进度条（100%进度）
-    driver->fillRect(82, 142, 136, 16, Colors::BLUE);
-    
-    // 更新信息区域
-    driver->fillRect(10, 180, driver->width() - 20, 60, Colors::YELLOW);
-    driver->drawRect(10, 180, driver->width() - 20, 60, Colors::BLACK);
+    // 改变按钮1外观、状态指示器和信息区域，只有这三个组件会重绘
+    uiPool.get<Panel>(button1)->setColor(Colors::BLUE);
+    uiPool.get<Panel>(indicator)->setColor(Colors::RED);
+    uiPool.get<Panel>(infoArea)->setColor(Colors::YELLOW);
+    renderUI(driver.get());
+    driver->display();
+    
+    // 进度条在400ms内平滑增长到100%，每帧只重绘新增的一段
+    animator.start(&progressBar, TweenProperty::VALUE, progressBar.getValue(), Components::ProgressBar::MAX_VALUE,
+                   400, Easing::EASE_OUT_CUBIC, nowMs());
+    while (animator.update(nowMs()) > 0 || progressBar.isDirty()) {
+        renderUI(driver.get());
+        driver->display();
+        std::this_thread::sleep_for(std::chrono::milliseconds(16));
+    }
 }
 
 int main() {
     std::cout << "MinimalUI Basic UI Example" << std::endl;
     
+#if MINIMALUI_TRACE
+    // 记录整个示例的渲染过程，结束时导出为Chrome trace
+    Trace::enable(true);
+#endif
+    
     // 注册驱动
     registerDrivers();
     
@@ -113,6 +190,13 @@ int main() {
         driver->display();
     }
     
+#if MINIMALUI_TRACE
+    Trace::enable(false);
+    if (Trace::dumpToFile("minimalui_trace.json")) {
+        std::cout << "Trace written to minimalui_trace.json (open in chrome://tracing)" << std::endl;
+    }
+#endif
+    
     std::cout << "UI example completed" << std::endl;
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,76 @@
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <memory>
+#include "Chart.h"
+#include "Linux_SPI_Driver.h"
+#include "SSD1309Controller.h"
+
+using namespace MinimalUI;
+using MinimalUI::Components::Chart;
+
+static const int16_t CHART_X = 20;
+static const int16_t CHART_Y = 13;   // 上下边缘都不在页边界
+static const int16_t CHART_W = 100;
+static const int16_t CHART_H = 46;
+
+// 记录写入/dev/null的SSD1309驱动，只关心帧缓冲区内容
+static std::unique_ptr<Linux_SPI_Driver> makeDriver() {
+    Linux_SPI_Config config;
+    config.device = "/dev/null";
+    config.capture = true;
+    std::unique_ptr<Linux_SPI_Driver> driver(
+        new Linux_SPI_Driver(config, std::unique_ptr<DisplayController>(new SSD1309Controller(SSD1309Config{}))));
+    if (!driver->initialize()) {
+        return nullptr;
+    }
+    return driver;
+}
+
+// 正弦波加噪声，偶尔超出纵轴范围以覆盖截断
+static int16_t wave(uint32_t n) {
+    static uint32_t seed = 1;
+    seed = seed * 1103515245u + 12345u;
+    if (n % 97 == 0) {
+        return 130;
+    }
+    return static_cast<int16_t>(50 + 40 * std::sin(n * 0.15) + static_cast<int32_t>((seed >> 16) % 17) - 8);
+}
+
+// 每个采样的平均绘制耗时（主机），不含总线传输
+static double perSampleUs(Linux_SPI_Driver& driver, uint16_t window, bool full) {
+    Chart chart(CHART_X, CHART_Y, CHART_W, CHART_H, 0, 100);
+    chart.setWindow(window);
+    uint32_t n = 0;
+    for (int i = 0; i < Chart::CAPACITY; i++) {
+        chart.push(wave(n++));
+        chart.render(&driver);
+    }
+
+    const int iterations = 20000;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; i++) {
+        chart.push(wave(n++));
+        if (full) {
+            chart.repaint();
+        }
+        chart.render(&driver);
+    }
+    return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count() / iterations;
+}
+
+int main() {
+    printf("Per-sample cost (host, SSD1309 128x64, %dx%d plot)\n", CHART_W, CHART_H);
+    auto driver = makeDriver();
+    if (!driver) {
+        printf("Failed to initialize capture driver\n");
+        return 1;
+    }
+    const double shift_short = perSampleUs(*driver, CHART_W, false);
+    const double shift_long = perSampleUs(*driver, CHART_W * 2, false);
+    const double redraw = perSampleUs(*driver, CHART_W, true);
+    printf("  shift + 1 column: %.2f us (%u-sample window), %.2f us (%u-sample window)\n", shift_short,
+           static_cast<unsigned>(CHART_W), shift_long, static_cast<unsigned>(CHART_W * 2));
+    printf("  full redraw:      %.2f us (%.1fx)\n", redraw, redraw / shift_short);
+    return 0;
+}
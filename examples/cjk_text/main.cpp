@@ -0,0 +1,154 @@
+#include <chrono>
+#include <cstdio>
+#include <vector>
+#include "AssetPack.h"
+#include "AssetPackBuilder.h"
+#include "GlyphCache.h"
+#include "GraphicsDriver.h"
+
+using namespace MinimalUI;
+
+// 应用的全部界面文本，资源包只包含其中用到的字符
+static const char* const APP_TEXTS[] = {
+    "\xE6\xB8\xA9\xE5\xBA\xA6",                          // 温度
+    "\xE6\xB9\xBF\xE5\xBA\xA6",                          // 湿度
+    "\xE8\xAE\xBE\xE7\xBD\xAE",                          // 设置
+    "\xE8\xBF\x94\xE5\x9B\x9E",                          // 返回
+    "\xE7\x94\xB5\xE6\xB1\xA0\xE7\x94\xB5\xE9\x87\x8F",  // 电池电量
+    "\xE6\xB8\xA9\xE5\xBA\xA6 25\xC2\xB0" "C",           // 温度 25°C
+    "\xF0\x9F\x98\x80",                                  // 表情符号，字体中没有
+};
+
+// 模拟主机上的完整CJK字体：12x12，覆盖U+4E00~U+9FFF，字形由码点确定
+class SyntheticFont : public GlyphSource {
+public:
+    static constexpr uint32_t FIRST = 0x4E00;
+    static constexpr uint32_t LAST = 0x9FFF;
+
+    uint8_t width() const override { return 12; }
+    uint8_t height() const override { return 12; }
+    uint8_t advance() const override { return 12; }
+
+    static bool pixel(uint32_t codepoint, int x, int y) {
+        if (x >= 11 || y >= 11) {
+            return false;   // 右侧和底部留一列（行）字间距
+        }
+        if (x == 0 || y == 0 || x == 10 || y == 10) {
+            return true;
+        }
+        uint32_t hash = (codepoint * 2654435761u) ^ static_cast<uint32_t>(y * 977 + x * 131);
+        hash ^= hash >> 13;
+        return (hash * 0x5bd1e995u) >> 31;
+    }
+
+    bool render(uint32_t codepoint, uint8_t* pages) const override {
+        if (codepoint < FIRST || codepoint > LAST) {
+            return false;
+        }
+        for (int y = 0; y < 12; y++) {
+            for (int x = 0; x < 12; x++) {
+                if (pixel(codepoint, x, y)) {
+                    pages[(y / 8) * 12 + x] |= static_cast<uint8_t>(1 << (y % 8));
+                }
+            }
+        }
+        return true;
+    }
+};
+
+// 160x64 RGB565帧缓冲区
+class RasterDriver : public GraphicsDriver {
+public:
+    static const int16_t W = 160;
+    static const int16_t H = 64;
+    Color pixels[W * H];
+
+    RasterDriver() { clear(Colors::BLACK); }
+
+    bool initialize() override { return true; }
+    void drawPixel(int16_t x, int16_t y, Color color) override {
+        if (x >= 0 && x < W && y >= 0 && y < H) {
+            pixels[y * W + x] = color;
+        }
+    }
+    void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, Color color) override {
+        for (int16_t j = y; j < y + h; j++) {
+            for (int16_t i = x; i < x + w; i++) {
+                drawPixel(i, j, color);
+            }
+        }
+    }
+    void drawBitmap(int16_t x, int16_t y, int16_t w, int16_t h, const Color* data) override {
+        for (int16_t j = 0; j < h; j++) {
+            for (int16_t i = 0; i < w; i++) {
+                drawPixel(x + i, y + j, data[j * w + i]);
+            }
+        }
+    }
+    void drawHLine(int16_t x, int16_t y, int16_t w, Color color) override { fillRect(x, y, w, 1, color); }
+    void drawVLine(int16_t x, int16_t y, int16_t h, Color color) override { fillRect(x, y, 1, h, color); }
+    void drawLine(int16_t, int16_t, int16_t, int16_t, Color) override {}
+    void drawRect(int16_t, int16_t, int16_t, int16_t, Color) override {}
+    void drawCircle(int16_t, int16_t, int16_t, Color) override {}
+    void fillCircle(int16_t, int16_t, int16_t, Color) override {}
+    void display() override {}
+    void clear(Color color) override {
+        for (Color& pixel : pixels) {
+            pixel = color;
+        }
+    }
+    int16_t width() const override { return W; }
+    int16_t height() const override { return H; }
+};
+
+// 每个字符的平均绘制耗时（主机）
+static double drawNs(RasterDriver& driver, const char* text, int glyphs) {
+    const int iterations = 20000;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; i++) {
+        driver.drawText(0, 40, text, Colors::WHITE, Colors::BLACK);
+    }
+    return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() /
+           (static_cast<double>(iterations) * glyphs);
+}
+
+int main(int argc, char** argv) {
+    const char* path = argc > 1 ? argv[1] : "/tmp/minimalui_cjk.bin";
+
+    printf("Subset the font\n");
+    const size_t text_count = sizeof(APP_TEXTS) / sizeof(APP_TEXTS[0]);
+    const std::vector<uint32_t> used = AssetPackBuilder::collectCodepoints(APP_TEXTS, text_count);
+    SyntheticFont source;
+    AssetPackBuilder builder;
+    builder.addFont(FONT_5X7);
+    std::vector<uint32_t> missing;
+    const int glyph_id = builder.addGlyphs(source, used, &missing);
+    printf("  %zu code points used by the app texts, %zu missing from the font\n", used.size(), missing.size());
+
+    AssetPack pack;
+    GlyphSet glyphs{};
+    if (glyph_id < 0 || !builder.write(path) || !pack.open(path) ||
+        !pack.glyphs(static_cast<uint16_t>(glyph_id), glyphs)) {
+        printf("  failed to write %s\n", path);
+        return 1;
+    }
+    const size_t full = (SyntheticFont::LAST - SyntheticFont::FIRST + 1) * (sizeof(uint32_t) + glyphs.glyphBytes());
+    printf("  full font %zu bytes, subset pack %zu bytes (%u glyphs)\n", full, pack.size(),
+           static_cast<unsigned>(glyphs.count));
+
+    printf("\nDraw cost (host)\n");
+    static RasterDriver timing;
+    static GlyphCache warm(glyphs);
+    timing.setGlyphCache(&warm);
+    const char* cjk = "\xE6\xB8\xA9\xE5\xBA\xA6\xE6\xB9\xBF\xE5\xBA\xA6";  // 温度湿度
+    const char* ascii = "Temp";
+    timing.drawText(0, 40, cjk, Colors::WHITE, Colors::BLACK);
+    warm.resetCounters();
+    const double cjk_ns = drawNs(timing, cjk, 4);
+    const double ascii_ns = drawNs(timing, ascii, 4);
+    // 12x12字符格的像素数是6x8 ASCII字符格的144 / 48 = 3倍
+    printf("  CJK 12x12 %.0f ns/glyph, ASCII 6x8 %.0f ns/glyph, %.1f ns/pixel vs %.1f ns/pixel\n", cjk_ns, ascii_ns,
+           cjk_ns / 144, ascii_ns / 48);
+    printf("  glyph cache hit rate %u%%\n", static_cast<unsigned>(warm.stats().hitRatePercent()));
+    return 0;
+}
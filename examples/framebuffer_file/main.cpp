@@ -0,0 +1,62 @@
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include "Jetson_FB_Driver.h"
+
+using namespace MinimalUI;
+
+// 在小屏上绘制几个图形并翻页，结果留在文件中可用图像工具查看
+static void runDemo(const std::string& path, uint8_t bpp) {
+    Jetson_FB_Config config;
+    config.device = path.c_str();
+    config.width = 320;
+    config.height = 240;
+    config.bpp = bpp;
+    Jetson_FB_Driver driver(config);
+    if (!driver.initialize()) {
+        printf("  %s: initialize failed\n", path.c_str());
+        return;
+    }
+
+    driver.fillRect(10, 10, 100, 50, Colors::RED);
+    driver.fillCircle(200, 120, 30, Colors::GREEN);
+    driver.drawLine(0, 239, 319, 0, Colors::WHITE);
+    driver.display();
+    printf("  320x240 %u bpp -> %s (%s, front page %u)\n", bpp, path.c_str(),
+           driver.doubleBuffered() ? "double buffered" : "single buffered", driver.frontPage());
+}
+
+// 高分辨率整屏填充的吞吐量
+static void runThroughput(const std::string& path, uint8_t bpp) {
+    Jetson_FB_Config config;
+    config.device = path.c_str();
+    config.width = 1280;
+    config.height = 720;
+    config.bpp = bpp;
+    Jetson_FB_Driver driver(config);
+    if (!driver.initialize()) {
+        return;
+    }
+
+    const int frames = 60;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < frames; i++) {
+        driver.fillRect(0, 0, 1280, 720, i & 1 ? Colors::BLUE : Colors::GRAY);
+        driver.display();
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    printf("  1280x720 %u bpp: %.2f ms per full-screen fill + flip (%.0f Mpixel/s)\n", bpp,
+           seconds * 1000.0 / frames, 1280.0 * 720.0 * frames / seconds / 1e6);
+}
+
+int main(int argc, char** argv) {
+    const std::string base = argc > 1 ? argv[1] : "/tmp/minimalui_fb";
+    printf("Demo frames\n");
+    runDemo(base + "16.raw", 16);
+    runDemo(base + "32.raw", 32);
+
+    printf("\nThroughput\n");
+    runThroughput(base + "_hd16.raw", 16);
+    runThroughput(base + "_hd32.raw", 32);
+    return 0;
+}
@@ -0,0 +1,179 @@
+#include <chrono>
+#include <cstdio>
+#include "GraphicsDriver.h"
+#include "Label.h"
+#include "Layout.h"
+#include "Panel.h"
+#include "ProgressBar.h"
+#include "WidgetPool.h"
+
+using namespace MinimalUI;
+using namespace MinimalUI::Components;
+
+using Pool = WidgetPool<>;
+using Handle = Pool::Handle;
+
+// 只统计填充像素数的驱动
+class NullDriver : public GraphicsDriver {
+public:
+    NullDriver(int16_t w, int16_t h) : w_(w), h_(h) {}
+
+    uint64_t pixels = 0;
+
+    bool initialize() override { return true; }
+    void drawPixel(int16_t, int16_t, Color) override { pixels++; }
+    void fillRect(int16_t, int16_t, int16_t w, int16_t h, Color) override { pixels += w * h; }
+    void drawHLine(int16_t, int16_t, int16_t w, Color) override { pixels += w; }
+    void drawVLine(int16_t, int16_t, int16_t h, Color) override { pixels += h; }
+    void drawLine(int16_t, int16_t, int16_t, int16_t, Color) override {}
+    void drawRect(int16_t, int16_t, int16_t, int16_t, Color) override {}
+    void drawCircle(int16_t, int16_t, int16_t, Color) override {}
+    void fillCircle(int16_t, int16_t, int16_t, Color) override {}
+    void display() override {}
+    void clear(Color) override {}
+    int16_t width() const override { return w_; }
+    int16_t height() const override { return h_; }
+
+private:
+    int16_t w_;
+    int16_t h_;
+};
+
+// 界面中需要访问的组件
+struct Screen {
+    Handle root, title, row, name, value, progress, body, buttons, ok, cancel;
+};
+
+static LayoutParams params(LayoutKind kind, SizeMode width_mode, SizeMode height_mode, uint8_t padding = 0,
+                           uint8_t gap = 0, LayoutAlign align = LayoutAlign::START) {
+    LayoutParams p;
+    p.kind = kind;
+    p.width_mode = width_mode;
+    p.height_mode = height_mode;
+    p.padding = padding;
+    p.gap = gap;
+    p.align = align;
+    return p;
+}
+
+// 没有任何手算坐标：所有组件以0尺寸创建，由布局引擎放置
+static Screen build(Pool& pool, LayoutEngine<Pool>& layout) {
+    Screen s;
+    s.root = pool.create<Panel>(Pool::NONE, 0, 0, 0, 0, Colors::BLACK);
+    layout.set(s.root, params(LayoutKind::COLUMN, SizeMode::FILL, SizeMode::FILL, 2, 2));
+
+    s.title = pool.create<Panel>(s.root, 0, 0, 0, 0, Colors::BLUE);
+    layout.set(s.title, params(LayoutKind::STACK, SizeMode::FILL, SizeMode::CONTENT, 1, 0, LayoutAlign::CENTER));
+    pool.create<Label>(s.title, 0, 0, 0, 0, "MinimalUI", Colors::WHITE, Colors::BLUE);
+
+    s.row = pool.create<Panel>(s.root, 0, 0, 0, 0, Colors::BLACK);
+    layout.set(s.row, params(LayoutKind::ROW, SizeMode::FILL, SizeMode::CONTENT, 0, 4, LayoutAlign::CENTER));
+    s.name = pool.create<Label>(s.row, 0, 0, 0, 0, "Temp");
+    s.value = pool.create<Label>(s.row, 0, 0, 0, 0, "23.4 C");
+    pool.get<Label>(s.value)->setAlign(Label::Align::RIGHT);
+    pool.get<Label>(s.value)->setTabularDigits(true);
+    layout.set(s.value, params(LayoutKind::NONE, SizeMode::FILL, SizeMode::CONTENT));
+
+    s.progress = pool.create<ProgressBar>(s.root, 0, 0, 0, 0);
+    LayoutParams bar = params(LayoutKind::NONE, SizeMode::FILL, SizeMode::FIXED);
+    bar.height = 6;
+    layout.set(s.progress, bar);
+
+    s.body = pool.create<Panel>(s.root, 0, 0, 0, 0, Colors::GRAY);
+    layout.set(s.body, params(LayoutKind::NONE, SizeMode::FILL, SizeMode::FILL));
+
+    s.buttons = pool.create<Panel>(s.root, 0, 0, 0, 0, Colors::BLACK);
+    layout.set(s.buttons, params(LayoutKind::ROW, SizeMode::FILL, SizeMode::CONTENT, 0, 2));
+    const Handle buttons[2] = {s.ok = pool.create<Panel>(s.buttons, 0, 0, 0, 0, Colors::GREEN, Colors::WHITE),
+                               s.cancel = pool.create<Panel>(s.buttons, 0, 0, 0, 0, Colors::RED, Colors::WHITE)};
+    const char* captions[2] = {"OK", "Cancel"};
+    for (int i = 0; i < 2; i++) {
+        LayoutParams button = params(LayoutKind::STACK, SizeMode::FILL, SizeMode::CONTENT, 2, 0, LayoutAlign::CENTER);
+        button.weight = static_cast<uint8_t>(i + 1);
+        layout.set(buttons[i], button);
+        Color bg = pool.get<Panel>(buttons[i])->getColor();
+        pool.create<Label>(buttons[i], 0, 0, 0, 0, captions[i], Colors::WHITE, bg);
+    }
+    return s;
+}
+
+static Rect boundsOf(Pool& pool, Handle h) {
+    return pool.component(h)->bounds();
+}
+
+static void printStats(const char* label, const LayoutEngine<Pool>& layout) {
+    const LayoutStats& stats = layout.stats();
+    printf("         %-28s measured %2u, arranged %2u, moved %2u\n", label, stats.measured, stats.arranged,
+           stats.moved);
+}
+
+static void printBounds(const char* name, const Rect& r) {
+    printf("         %-10s x %3d  y %3d  w %3d  h %3d\n", name, r.x, r.y, r.w, r.h);
+}
+
+// 打印自动排列的结果，再演示几种变化各自触发的布局工作量
+static void runProduct(int16_t width, int16_t height) {
+    printf("%dx%d\n", width, height);
+    Pool pool;
+    LayoutEngine<Pool> layout(pool);
+    NullDriver driver(width, height);
+    const Rect screen{0, 0, width, height};
+    Screen s = build(pool, layout);
+
+    layout.update(&driver, screen);
+    pool.render(&driver);
+    printBounds("title", boundsOf(pool, s.title));
+    printBounds("row", boundsOf(pool, s.row));
+    printBounds("progress", boundsOf(pool, s.progress));
+    printBounds("body", boundsOf(pool, s.body));
+    printBounds("ok", boundsOf(pool, s.ok));
+    printBounds("cancel", boundsOf(pool, s.cancel));
+
+    pool.get<Label>(s.value)->setText("23.5 C");
+    layout.update(&driver, screen);
+    printStats("tabular value change:", layout);
+    pool.render(&driver);
+
+    pool.get<Label>(s.name)->setText("Temperature");
+    layout.update(&driver, screen);
+    printStats("name width change:", layout);
+    pool.render(&driver);
+
+    pool.component(s.body)->setVisible(false);
+    layout.update(&driver, screen);
+    printStats("hide fill panel:", layout);
+    pool.render(&driver);
+    pool.component(s.body)->setVisible(true);
+    layout.update(&driver, screen);
+    pool.render(&driver);
+
+    // 每帧开销（主机）
+    const int iterations = 20000;
+    auto time = [&](auto&& body) {
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < iterations; i++) {
+            body(i);
+        }
+        return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() /
+               iterations;
+    };
+    const double idle = time([&](int) { layout.update(&driver, screen); });
+    char text[16];
+    const double value = time([&](int i) {
+        snprintf(text, sizeof(text), "%d.%d C", 20 + i % 10, i % 10);
+        pool.get<Label>(s.value)->setText(text);
+        layout.update(&driver, screen);
+    });
+    const double relayout = time([&](int i) {
+        pool.get<Label>(s.name)->setText(i & 1 ? "Temp" : "Temperature");
+        layout.update(&driver, screen);
+    });
+    printf("         update(): idle %.0f ns, label value %.0f ns, row relayout %.0f ns (%u widgets)\n", idle,
+           value, relayout, static_cast<unsigned>(pool.size()));
+}
+
+int main() {
+    runProduct(128, 64);
+    runProduct(240, 320);
+    return 0;
+}
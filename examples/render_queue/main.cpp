@@ -0,0 +1,158 @@
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "GraphicsDriver.h"
+#include "RenderQueue.h"
+
+using namespace MinimalUI;
+
+static const int PRODUCERS = 8;
+static const int COMMANDS_PER_PRODUCER = 100000;
+static const int DISPLAY_EVERY = 1000;
+
+// 只统计收到的命令和display()次数
+class CountingDriver : public GraphicsDriver {
+public:
+    uint32_t received = 0;
+    uint32_t displays = 0;
+
+    bool initialize() override { return true; }
+    void drawPixel(int16_t, int16_t, Color) override {}
+    void fillRect(int16_t, int16_t, int16_t, int16_t, Color) override { received++; }
+    void drawHLine(int16_t, int16_t, int16_t, Color) override {}
+    void drawVLine(int16_t, int16_t, int16_t, Color) override {}
+    void drawLine(int16_t, int16_t, int16_t, int16_t, Color) override {}
+    void drawRect(int16_t, int16_t, int16_t, int16_t, Color) override {}
+    void drawCircle(int16_t, int16_t, int16_t, Color) override {}
+    void fillCircle(int16_t, int16_t, int16_t, Color) override {}
+    void display() override { displays++; }
+    void clear(Color) override {}
+    int16_t width() const override { return 128; }
+    int16_t height() const override { return 64; }
+};
+
+// 队列满时让出CPU后重试，保证每个生产者的命令都能送达
+static void produce(RenderQueue& queue, std::atomic<uint32_t>& retries) {
+    for (uint32_t i = 0; i < COMMANDS_PER_PRODUCER; i++) {
+        while (!queue.fillRect(0, static_cast<int16_t>(i & 0x3F), 1, 1, 0)) {
+            retries.fetch_add(1, std::memory_order_relaxed);
+            std::this_thread::yield();
+        }
+        if (i % DISPLAY_EVERY == DISPLAY_EVERY - 1) {
+            while (!queue.display()) {
+                retries.fetch_add(1, std::memory_order_relaxed);
+                std::this_thread::yield();
+            }
+        }
+    }
+}
+
+// 多个生产者同时写入时渲染线程的吞吐量（顺序和完整性的校验见tests/render_queue_test.cpp）
+static void runThroughput() {
+    printf("Throughput: %d producers x %d commands, queue capacity %u\n", PRODUCERS, COMMANDS_PER_PRODUCER,
+           static_cast<unsigned>(RenderQueue::CAPACITY));
+    static RenderQueue queue;
+    CountingDriver driver;
+    std::atomic<uint32_t> retries{0};
+    std::atomic<int> running{PRODUCERS};
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> producers;
+    for (int id = 0; id < PRODUCERS; id++) {
+        producers.emplace_back([&] {
+            produce(queue, retries);
+            running.fetch_sub(1, std::memory_order_release);
+        });
+    }
+    size_t batches = 0;
+    for (;;) {
+        const bool done = running.load(std::memory_order_acquire) == 0;
+        if (queue.drain(&driver) > 0) {
+            batches++;
+        } else if (done) {
+            break;
+        } else {
+            std::this_thread::yield();
+        }
+    }
+    for (std::thread& producer : producers) {
+        producer.join();
+    }
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    const uint32_t requested = PRODUCERS * (COMMANDS_PER_PRODUCER / DISPLAY_EVERY);
+    printf("  %.1f M commands/s, %zu batches, %u display() for %u requests, %u full-queue retries\n",
+           driver.received / seconds / 1e6, batches, driver.displays, requested, retries.load());
+}
+
+// 模拟较慢的SPI刷新
+class SlowDriver : public CountingDriver {
+public:
+    void display() override { std::this_thread::sleep_for(std::chrono::milliseconds(2)); }
+};
+
+// 生产者最坏等待时间：渲染线程刷新屏幕期间，生产者写入一条命令需要多久
+static void runLatency() {
+    printf("\nWorst-case producer call while the render thread flushes for 2 ms (host)\n");
+    const int commands = 2000;
+    using Clock = std::chrono::steady_clock;
+    auto worst = [&](auto&& render, auto&& draw) {
+        std::atomic<bool> stop{false};
+        std::thread renderer([&] {
+            while (!stop.load(std::memory_order_relaxed)) {
+                render();
+            }
+        });
+        double worst_us = 0;
+        for (int i = 0; i < commands; i++) {
+            auto start = Clock::now();
+            draw(i);
+            const double us = std::chrono::duration<double, std::micro>(Clock::now() - start).count();
+            worst_us = us > worst_us ? us : worst_us;
+            std::this_thread::sleep_for(std::chrono::microseconds(20));
+        }
+        stop.store(true);
+        renderer.join();
+        return worst_us;
+    };
+
+    static RenderQueue queue;
+    SlowDriver queued;
+    const double queue_us = worst(
+        [&] {
+            if (queue.drain(&queued) == 0) {
+                std::this_thread::yield();
+            }
+        },
+        [&](int i) {
+            queue.fillRect(0, static_cast<int16_t>(i & 0x3F), 1, 1, 0);
+            if (i % 50 == 49) {
+                queue.display();
+            }
+        });
+
+    // 对照：各任务加锁后直接调用驱动（原先的做法）
+    std::mutex mutex;
+    SlowDriver locked;
+    const double mutex_us = worst(
+        [&] {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                locked.display();
+            }
+            std::this_thread::yield();
+        },
+        [&](int i) {
+            std::lock_guard<std::mutex> lock(mutex);
+            locked.fillRect(0, static_cast<int16_t>(i & 0x3F), 1, 1, 0);
+        });
+    printf("  enqueue %.1f us, mutex + driver call %.1f us\n", queue_us, mutex_us);
+}
+
+int main() {
+    runThroughput();
+    runLatency();
+    return 0;
+}
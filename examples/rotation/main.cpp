@@ -0,0 +1,101 @@
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+#include "EmulatedBus.h"
+#include "SSD1309Controller.h"
+#include "SSD1309Model.h"
+
+using namespace MinimalUI;
+
+static const int16_t PANEL_W = SSD1309Model::WIDTH;
+static const int16_t PANEL_H = SSD1309Model::HEIGHT;
+
+static int degrees(Rotation rotation) {
+    return static_cast<int>(rotation) * 90;
+}
+
+// 每个方向下整屏刷新和一个4x4小块的局部更新在总线上发送的字节数
+static void runTraffic() {
+    printf("Bus traffic per rotation (SSD1309 128x64)\n");
+    const Rotation rotations[] = {Rotation::ROTATE_0, Rotation::ROTATE_90, Rotation::ROTATE_180,
+                                  Rotation::ROTATE_270};
+    for (Rotation rotation : rotations) {
+        SSD1309Model model;
+        EmulatedBus bus(model, BusTiming());
+        SSD1309Config config;
+        config.rotation = rotation;
+        SSD1309Controller controller(config);
+        if (!controller.initialize(&bus)) {
+            continue;
+        }
+        BusStats before = bus.stats();
+        controller.fillBufferRect(0, 0, controller.getWidth(), controller.getHeight(), Colors::WHITE);
+        controller.refresh();
+        const uint64_t full = bus.stats().data_bytes - before.data_bytes;
+        before = bus.stats();
+        controller.fillBufferRect(10, 20, 4, 4, Colors::BLACK);
+        controller.refresh();
+        const uint64_t partial = bus.stats().data_bytes - before.data_bytes;
+        printf("  %3d deg %3dx%-3d full frame %4llu bytes, 4x4 update %2llu bytes\n", degrees(rotation),
+               controller.getWidth(), controller.getHeight(), static_cast<unsigned long long>(full),
+               static_cast<unsigned long long>(partial));
+    }
+}
+
+// 整屏转换开销（主机）：按8x8块转置与逐像素重映射
+static void runTiming() {
+    printf("\nFull-frame conversion cost (host)\n");
+    std::vector<uint8_t> logical(PANEL_W * PANEL_H / 8);
+    std::vector<uint8_t> panel(logical.size());
+    uint32_t seed = 3;
+    for (uint8_t& byte : logical) {
+        seed = seed * 1103515245u + 12345u;
+        byte = static_cast<uint8_t>(seed >> 24);
+    }
+    const int16_t lw = PANEL_H;   // 旋转后的宽度
+    auto byBlock = [&]() {
+        uint8_t* out = panel.data();
+        for (int16_t page = 0; page < PANEL_H / 8; page++) {
+            for (int16_t col = 0; col < PANEL_W; col += 8) {
+                SSD1309Controller::transpose8x8(logical.data() + (col / 8) * lw + page * 8, out);
+                out += 8;
+            }
+        }
+    };
+    auto byPixel = [&]() {
+        memset(panel.data(), 0, panel.size());
+        for (int16_t py = 0; py < PANEL_H; py++) {
+            for (int16_t px = 0; px < PANEL_W; px++) {
+                // 面板(px, py)对应转置后的逻辑像素(py, px)
+                if ((logical[(px / 8) * lw + py] >> (px % 8)) & 1) {
+                    panel[(py / 8) * PANEL_W + px] |= static_cast<uint8_t>(1 << (py % 8));
+                }
+            }
+        }
+    };
+    // 每次迭代修改一个字节，防止循环被优化掉
+    const int iterations = 20000;
+    uint32_t sink = 0;
+    auto time = [&](auto&& pass) {
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < iterations; i++) {
+            pass();
+            sink += panel[i % panel.size()];
+            logical[i % logical.size()] ^= 1;
+        }
+        return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count() /
+               iterations;
+    };
+    const double block_us = time(byBlock);
+    const double pixel_us = time(byPixel);
+
+    printf("  8x8 block transpose %.2f us, per-pixel remap %.2f us (%.1fx), checksum %u\n", block_us, pixel_us,
+           pixel_us / block_us, static_cast<unsigned>(sink & 0xFF));
+}
+
+int main() {
+    runTraffic();
+    runTiming();
+    return 0;
+}
@@ -0,0 +1,122 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <vector>
+#include "Linux_SPI_Driver.h"
+#include "SSD1309Controller.h"
+#include "ScreenCache.h"
+
+using namespace MinimalUI;
+
+static const uint16_t PAGES = 3;
+
+// 菜单页面的静态内容：标题栏、图标、列表项和分隔线
+static void drawPage(GraphicsDriver& driver, uint16_t page) {
+    static const char* const TITLES[PAGES] = {"Settings", "Sensors", "Network"};
+    static const char* const ITEMS[PAGES][4] = {
+        {"Brightness", "Contrast", "Sleep", "About"},
+        {"Temperature", "Humidity", "Pressure", "Light"},
+        {"WiFi", "Bluetooth", "MQTT", "Status"},
+    };
+    driver.clear(Colors::BLACK);
+    driver.fillRect(0, 0, 128, 11, Colors::WHITE);
+    driver.drawText(2, 2, TITLES[page], Colors::BLACK, Colors::WHITE);
+    for (int16_t i = 0; i < 4; i++) {
+        const int16_t y = static_cast<int16_t>(14 + i * 12);
+        if (page == 0) {
+            driver.fillRoundRect(2, y, 8, 8, 2, Colors::WHITE);
+        } else if (page == 1) {
+            driver.drawCircle(6, y + 4, 4, Colors::WHITE);
+        } else {
+            driver.fillTriangle(2, y + 8, 6, y, 10, y + 8, Colors::WHITE);
+        }
+        driver.drawText(14, y, ITEMS[page][i], Colors::WHITE, Colors::BLACK);
+        driver.drawHLine(14, y + 10, 112, Colors::GRAY);
+    }
+}
+
+// 动态组件：右上角的时钟
+static void drawClock(GraphicsDriver& driver, uint32_t seconds) {
+    char text[12];
+    snprintf(text, sizeof(text), "%02u:%02u", static_cast<unsigned>(seconds / 60 % 60),
+             static_cast<unsigned>(seconds % 60));
+    driver.fillRect(96, 1, 31, 9, Colors::WHITE);
+    driver.drawText(97, 2, text, Colors::BLACK, Colors::WHITE);
+}
+
+// 切换到页面：命中时恢复快照，未命中时完整重绘并保存快照
+static bool showPage(Linux_SPI_Driver& driver, ScreenCache& cache, uint16_t page, uint32_t seconds) {
+    const bool hit = driver.restoreScreen(cache, page);
+    if (!hit) {
+        drawPage(driver, page);
+        driver.captureScreen(cache, page);
+    }
+    drawClock(driver, seconds);
+    driver.display();
+    return hit;
+}
+
+int main(int argc, char** argv) {
+    const char* path = argc > 1 ? argv[1] : "/tmp/minimalui_screen_cache.capture";
+
+    Linux_SPI_Config config;
+    config.device = path;
+    config.capture = true;
+    Linux_SPI_Driver driver(config, std::unique_ptr<DisplayController>(new SSD1309Controller(SSD1309Config{})));
+    if (!driver.initialize()) {
+        printf("Failed to initialize capture driver\n");
+        return 1;
+    }
+    auto* controller = static_cast<SSD1309Controller*>(driver.controller());
+    const size_t frame_size = 128 * 64 / 8;
+
+    // 容量可以同时保存任意两页（含第0页）的压缩快照，但放不下全部三页
+    size_t compressed[PAGES];
+    std::vector<uint8_t> scratch(ScreenCache::encodeBound(frame_size));
+    for (uint16_t page = 0; page < PAGES; page++) {
+        drawPage(driver, page);
+        compressed[page] = ScreenCache::encode(controller->getFrameBuffer(), frame_size, scratch.data(),
+                                               scratch.size());
+    }
+    const size_t budget = compressed[0] + std::max(compressed[1], compressed[2]);
+    printf("Page switching (SSD1309 128x64)\n");
+    printf("  snapshots %zu/%zu/%zu bytes compressed from %zu, budget %zu\n", compressed[0], compressed[1],
+           compressed[2], frame_size, budget);
+
+    // 访问顺序0、1、0、2：第三页存入时淘汰最久未使用的第1页
+    ScreenCache cache(budget);
+    const uint16_t visits[] = {0, 1, 0, 2};
+    for (uint16_t page : visits) {
+        showPage(driver, cache, page, 42);
+    }
+    driver.resetStats();
+    driver.restoreScreen(cache, 2);
+    const Linux_SPI_Stats restore = driver.stats();
+
+    // 页面切换开销（主机，传输写入capture文件）
+    const int iterations = 5000;
+    auto time = [&](auto&& body) {
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < iterations; i++) {
+            body(static_cast<uint16_t>(i % 2 ? 0 : 2));
+        }
+        return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count() /
+               iterations;
+    };
+    uint8_t* target = controller->getFrameBuffer();
+    const double redraw_us = time([&](uint16_t page) {
+        drawPage(driver, page);
+        driver.display();
+    });
+    const double restore_us = time([&](uint16_t page) { driver.restoreScreen(cache, page); });
+    const double decode_us = time([&](uint16_t page) { cache.load(page, target, frame_size); });
+    printf("  per switch: redraw + flush %.1f us, restore %.1f us (decompress alone %.2f us)\n", redraw_us,
+           restore_us, decode_us);
+    printf("  restore sent %llu SPI messages, %llu bytes\n",
+           static_cast<unsigned long long>(restore.spi_messages), static_cast<unsigned long long>(restore.bytes));
+    const CacheStats& stats = cache.stats();
+    printf("  cache: %u hits, %u misses, %u stores, %u evictions, %zu/%zu bytes\n", stats.hits, stats.misses,
+           stats.stores, stats.evictions, stats.used_bytes, cache.budget());
+    return 0;
+}
@@ -0,0 +1,50 @@
+#include <cstdio>
+#include <memory>
+#include "Linux_SPI_Driver.h"
+#include "SSD1309Controller.h"
+
+using namespace MinimalUI;
+
+static void printStats(const char* label, const Linux_SPI_Stats& stats) {
+    printf("  %-26s %4llu transport calls -> %3llu SPI_IOC_MESSAGE + %3llu GPIO ioctls (%llu bytes)\n", label,
+           static_cast<unsigned long long>(stats.calls), static_cast<unsigned long long>(stats.spi_messages),
+           static_cast<unsigned long long>(stats.gpio_ioctls), static_cast<unsigned long long>(stats.bytes));
+}
+
+int main(int argc, char** argv) {
+    const char* path = argc > 1 ? argv[1] : "/tmp/minimalui_spidev.capture";
+
+    Linux_SPI_Config config;
+    config.device = path;
+    config.capture = true;
+    Linux_SPI_Driver driver(config, std::unique_ptr<DisplayController>(new SSD1309Controller(SSD1309Config{})));
+    if (!driver.initialize()) {
+        printf("Failed to initialize capture driver\n");
+        return 1;
+    }
+
+    printf("Syscalls per frame (SSD1309 128x64)\n");
+    printStats("initialize + clear", driver.stats());
+
+    driver.resetStats();
+    driver.fillRect(0, 0, 128, 12, Colors::WHITE);
+    driver.drawText(4, 2, "spidev", Colors::BLACK, Colors::WHITE);
+    driver.drawCircle(100, 40, 15, Colors::WHITE);
+    driver.drawLine(0, 63, 127, 16, Colors::WHITE);
+    driver.display();
+    printStats("full-screen redraw", driver.stats());
+
+    driver.resetStats();
+    driver.fillRect(4, 30, 40, 8, Colors::BLACK);
+    driver.drawText(4, 30, "42.5", Colors::WHITE, Colors::BLACK);
+    driver.display();
+    printStats("one label update", driver.stats());
+
+    driver.resetStats();
+    driver.scroll(8);
+    driver.display();
+    printStats("scroll by one page", driver.stats());
+
+    printf("\nCapture written to %s\n", path);
+    return 0;
+}
@@ -0,0 +1,167 @@
+#include <chrono>
+#include <cstdio>
+#include <thread>
+#include "EmulatedBus.h"
+#include "SSD1309Model.h"
+#include "SSD1309Controller.h"
+
+using namespace MinimalUI;
+
+// 8位灰度转换为RGB565
+static Color grayColor(uint8_t level) {
+    return static_cast<Color>(((level >> 3) << 11) | ((level >> 2) << 5) | (level >> 3));
+}
+
+// 按帧耗时预测帧率
+static void printFrame(const char* label, const EmulatedBus& bus, const BusStats& before) {
+    BusStats after = bus.stats();
+    uint64_t ns = bus.lastFrameNs();
+    printf("  %-22s %7.3f ms  %5llu bytes  %4llu transactions  -> %7.1f fps\n", label, ns / 1e6,
+           static_cast<unsigned long long>(after.command_bytes + after.data_bytes -
+                                           before.command_bytes - before.data_bytes),
+           static_cast<unsigned long long>(after.transactions - before.transactions),
+           ns ? 1e9 / ns : 0.0);
+}
+
+static void runTimingTable() {
+    printf("Predicted frame times (simulated bus)\n");
+    const uint32_t freqs[] = {1000000, 4000000, 10000000};
+    for (uint32_t freq : freqs) {
+        BusTiming timing;
+        timing.freq = freq;
+        SSD1309Model model;
+        EmulatedBus bus(model, timing);
+        SSD1309Controller controller(SSD1309Config{});
+        controller.initialize(&bus);
+        printf(" %u MHz SPI\n", static_cast<unsigned>(freq / 1000000));
+
+        BusStats before = bus.stats();
+        controller.clearScreen();
+        printFrame("full frame", bus, before);
+
+        // 一行8像素高的文字更新（约6个字符）
+        before = bus.stats();
+        controller.fillBufferRect(40, 24, 36, 8, Colors::WHITE);
+        controller.refresh();
+        printFrame("36x8 partial update", bus, before);
+
+        before = bus.stats();
+        controller.scroll(8);
+        controller.refresh();
+        printFrame("scroll by one page", bus, before);
+    }
+}
+
+// 上电到第一帧：复位恢复 + 初始化表 + 清屏和开启显示
+static void runBootTime() {
+    printf("\nBoot to first frame (simulated bus, 8 MHz)\n");
+    SSD1309Config config;
+    const SSD1309Controller::InitTable table = SSD1309Controller::buildInitSequence(config);
+    const size_t command_bytes = SSD1309Controller::INIT_SEQUENCE_LENGTH - 2;  // 去掉头字节和END
+
+    // 对照：初始化表逐字节作为单独的事务发送（转换为表之前的方式）
+    SSD1309Model legacy_model;
+    EmulatedBus legacy_bus(legacy_model, BusTiming());
+    for (size_t i = 0; i < command_bytes; i++) {
+        legacy_bus.sendCommand(table[1 + i]);
+    }
+    const BusStats legacy = legacy_bus.stats();
+
+    // 同一张表由InitSequencer发送
+    SSD1309Model table_model;
+    EmulatedBus table_bus(table_model, BusTiming());
+    InitSequencer sequencer;
+    uint32_t wait_ms = 0;
+    sequencer.start(table.data());
+    sequencer.step(table_bus, wait_ms);
+    const BusStats batched = table_bus.stats();
+
+    // 非阻塞初始化，统计直到第一帧（清屏）完成
+    SSD1309Model model;
+    EmulatedBus bus(model, BusTiming());
+    SSD1309Controller controller(config);
+    if (!controller.beginInit(&bus)) {
+        return;
+    }
+    while (!controller.pollInit(wait_ms)) {
+    }
+    const BusStats boot = bus.stats();
+
+    printf("  init table: %zu command bytes, %u ms of table delays\n", command_bytes,
+           InitSequence::totalDelayMs(table.data()));
+    printf("  %-24s %4llu transactions  %7.3f ms\n", "init, per-byte commands",
+           static_cast<unsigned long long>(legacy.transactions), legacy.busy_ns / 1e6);
+    printf("  %-24s %4llu transactions  %7.3f ms\n", "init, one command burst",
+           static_cast<unsigned long long>(batched.transactions), batched.busy_ns / 1e6);
+    printf("  %-24s %4llu transactions  %7.3f ms (init, clear, display on)\n", "init + first frame",
+           static_cast<unsigned long long>(boot.transactions), boot.busy_ns / 1e6);
+    printf("  reset recovery           %u ms (was 140 ms of blocking delays)\n", controller.resetRecoveryMs());
+    printf("  boot to first frame      %.3f ms\n", controller.resetRecoveryMs() + boot.busy_ns / 1e6);
+}
+
+// 灰度带的感知亮度，可选写出PGM图像（显存和灰度的正确性校验见tests/ssd1309_emulator_test.cpp）
+static void runGrayscale(const char* image_path) {
+    printf("\nGrayscale bit-plane integration (realtime bus, 8 MHz)\n");
+    SSD1309Model model;
+    BusTiming timing;
+    timing.freq = 8000000;
+    EmulatedBus bus(model, timing);
+    bus.setRealtime(true);
+
+    SSD1309Config config;
+    config.grayscale = true;
+    SSD1309Controller controller(config);
+    if (!controller.initialize(&bus)) {
+        return;
+    }
+
+    // 四条灰度带
+    const uint8_t levels[4] = {0, 85, 170, 255};
+    for (int i = 0; i < 4; i++) {
+        controller.fillBufferRect(i * 32, 0, 32, 64, grayColor(levels[i]));
+    }
+    controller.refresh();
+    if (!controller.startGrayscale()) {
+        return;
+    }
+    controller.refresh();
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    model.resetExposure(bus.now());
+    std::this_thread::sleep_for(std::chrono::milliseconds(1100));
+    const uint64_t now = bus.now();
+    const uint16_t pps = controller.planesPerSecond();
+    controller.stopGrayscale();
+
+    printf("  planes/s: configured %u, measured %u\n", config.plane_rate, pps);
+    for (int i = 0; i < 4; i++) {
+        uint32_t sum = 0;
+        for (int16_t y = 0; y < 64; y++) {
+            for (int16_t x = i * 32; x < i * 32 + 32; x++) {
+                sum += model.perceived(x, y, now);
+            }
+        }
+        printf("  band %d: target %3u, perceived %3u\n", i, levels[i], sum / (32 * 64));
+    }
+
+    if (image_path) {
+        FILE* out = fopen(image_path, "wb");
+        if (out) {
+            fprintf(out, "P5\n%d %d\n255\n", SSD1309Model::WIDTH, SSD1309Model::HEIGHT);
+            for (int16_t y = 0; y < SSD1309Model::HEIGHT; y++) {
+                for (int16_t x = 0; x < SSD1309Model::WIDTH; x++) {
+                    fputc(model.perceived(x, y, now), out);
+                }
+            }
+            fclose(out);
+            printf("  perceived image written to %s\n", image_path);
+        }
+    }
+}
+
+int main(int argc, char** argv) {
+    runTimingTable();
+    runBootTime();
+    runGrayscale(argc > 1 ? argv[1] : nullptr);
+    return 0;
+}
@@ -0,0 +1,89 @@
+#include <chrono>
+#include <cstdio>
+#include "GraphicsDriver.h"
+#include "IconCache.h"
+#include "VectorIcon.h"
+
+using namespace MinimalUI;
+
+// 240x320 RGB565帧缓冲区，统计drawBitmap调用次数
+class RasterDriver : public GraphicsDriver {
+public:
+    static const int16_t W = 240;
+    static const int16_t H = 320;
+    Color pixels[W * H];
+    uint32_t bitmaps = 0;
+
+    RasterDriver() { clear(Colors::BLACK); }
+
+    bool initialize() override { return true; }
+    void drawPixel(int16_t x, int16_t y, Color color) override {
+        if (x >= 0 && x < W && y >= 0 && y < H) {
+            pixels[y * W + x] = color;
+        }
+    }
+    void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, Color color) override {
+        for (int16_t j = y; j < y + h; j++) {
+            for (int16_t i = x; i < x + w; i++) {
+                drawPixel(i, j, color);
+            }
+        }
+    }
+    void drawBitmap(int16_t x, int16_t y, int16_t w, int16_t h, const Color* data) override {
+        bitmaps++;
+        for (int16_t j = 0; j < h; j++) {
+            for (int16_t i = 0; i < w; i++) {
+                drawPixel(x + i, y + j, data[j * w + i]);
+            }
+        }
+    }
+    void drawHLine(int16_t x, int16_t y, int16_t w, Color color) override { fillRect(x, y, w, 1, color); }
+    void drawVLine(int16_t x, int16_t y, int16_t h, Color color) override { fillRect(x, y, 1, h, color); }
+    void drawLine(int16_t, int16_t, int16_t, int16_t, Color) override {}
+    void drawRect(int16_t, int16_t, int16_t, int16_t, Color) override {}
+    void drawCircle(int16_t, int16_t, int16_t, Color) override {}
+    void fillCircle(int16_t, int16_t, int16_t, Color) override {}
+    void display() override {}
+    void clear(Color color) override {
+        for (Color& pixel : pixels) {
+            pixel = color;
+        }
+    }
+    int16_t width() const override { return W; }
+    int16_t height() const override { return H; }
+};
+
+static RasterDriver first;
+
+// 每次绘制的平均耗时（主机）
+static double drawUs(int16_t size, IconCache* cache) {
+    const int iterations = 5000;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; i++) {
+        const Color color = static_cast<Color>(i & 1 ? Colors::WHITE : Colors::WHITE - 1);
+        if (cache) {
+            cache->draw(first, 0, 0, ICON_BELL, size, color, Colors::BLACK);
+        } else {
+            first.fillRect(0, 0, size, size, Colors::BLACK);
+            first.drawIcon(0, 0, ICON_BELL, size, color);
+        }
+    }
+    return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count() / iterations;
+}
+
+static void runTiming() {
+    printf("Draw cost (host)\n");
+    const int16_t sizes[] = {32, 96};
+    for (int16_t size : sizes) {
+        IconCache cache(IconCache::bitmapSize(size, false) * 2);
+        const double direct = drawUs(size, nullptr);
+        const double cached = drawUs(size, &cache);
+        printf("  %3d px bell: rasterize %.2f us, cached blit %.2f us (%.1fx), hit rate %u%%\n", size, direct,
+               cached, direct / cached, static_cast<unsigned>(cache.stats().hitRatePercent()));
+    }
+}
+
+int main() {
+    runTiming();
+    return 0;
+}
@@ -0,0 +1,169 @@
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <vector>
+#include "GraphicsDriver.h"
+#include "WidgetPool.h"
+
+using namespace MinimalUI;
+using namespace MinimalUI::Components;
+
+// 只统计填充像素数的驱动
+class NullDriver : public GraphicsDriver {
+public:
+    uint64_t pixels = 0;
+
+    bool initialize() override { return true; }
+    void drawPixel(int16_t, int16_t, Color) override { pixels++; }
+    void fillRect(int16_t, int16_t, int16_t w, int16_t h, Color) override { pixels += w * h; }
+    void drawHLine(int16_t, int16_t, int16_t w, Color) override { pixels += w; }
+    void drawVLine(int16_t, int16_t, int16_t h, Color) override { pixels += h; }
+    void drawLine(int16_t, int16_t, int16_t, int16_t, Color) override {}
+    void drawRect(int16_t, int16_t, int16_t, int16_t, Color) override {}
+    void drawCircle(int16_t, int16_t, int16_t, Color) override {}
+    void fillCircle(int16_t, int16_t, int16_t, Color) override {}
+    void display() override {}
+    void clear(Color) override {}
+    int16_t width() const override { return 1280; }
+    int16_t height() const override { return 720; }
+};
+
+// 纯色方块组件，记录绘制次数
+class Box : public Component {
+public:
+    uint32_t renders = 0;
+
+    Box(int16_t x, int16_t y, int16_t w, int16_t h, Color color) : Component(x, y, w, h), color_(color) {}
+
+    void render(GraphicsDriver* driver) override {
+        driver->fillRect(x_, y_, width_, height_, color_);
+        renders++;
+        markClean();
+    }
+
+private:
+    Color color_;
+};
+
+// 对照：以堆分配节点和shared_ptr子列表组织的组件树
+struct HeapNode {
+    std::shared_ptr<Box> box;
+    std::vector<std::shared_ptr<HeapNode>> children;
+};
+
+static Box* heapHitTest(const HeapNode& node, int16_t x, int16_t y) {
+    if (!node.box->isVisible()) {
+        return nullptr;
+    }
+    for (size_t i = node.children.size(); i-- > 0;) {
+        if (Box* hit = heapHitTest(*node.children[i], x, y)) {
+            return hit;
+        }
+    }
+    return node.box->contains(x, y) ? node.box.get() : nullptr;
+}
+
+static uint32_t heapPaint(const HeapNode& node, GraphicsDriver* driver) {
+    if (!node.box->isVisible()) {
+        return 0;
+    }
+    uint32_t painted = 0;
+    if (node.box->isDirty()) {
+        node.box->render(driver);
+        painted++;
+    }
+    for (const auto& child : node.children) {
+        painted += heapPaint(*child, driver);
+    }
+    return painted;
+}
+
+template <typename F>
+static double nsPerCall(int iterations, F&& body) {
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; i++) {
+        body(i);
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    return std::chrono::duration<double, std::nano>(elapsed).count() / iterations;
+}
+
+// 组件按面板分组（每个面板最多8个子组件）铺满1280x720，总数恰好为N，最后一个面板的子组件可能不足8个
+template <uint16_t N>
+static void runBenchmark() {
+    static WidgetPool<N, sizeof(Box)> pool;
+    using Handle = typename WidgetPool<N, sizeof(Box)>::Handle;
+    NullDriver driver;
+    const int groups = (N + 8) / 9;
+    const int cols = 16;
+    const int16_t cell_w = 1280 / cols;
+    const int16_t cell_h = 720 / ((groups + cols - 1) / cols);
+
+    std::vector<HeapNode> roots;
+    std::vector<Box*> leaves;
+    for (int g = 0; g < groups; g++) {
+        const int16_t x = (g % cols) * cell_w;
+        const int16_t y = (g / cols) * cell_h;
+        Handle panel = pool.template create<Box>(pool.NONE, x, y, cell_w, cell_h, Colors::GRAY);
+        HeapNode root{std::make_shared<Box>(x, y, cell_w, cell_h, Colors::GRAY), {}};
+        const int children = g < groups - 1 ? 8 : N - 9 * (groups - 1) - 1;
+        for (int c = 0; c < children; c++) {
+            const int16_t cx = x + (c % 4) * (cell_w / 4);
+            const int16_t cy = y + (c / 4) * (cell_h / 2);
+            Handle child = pool.template create<Box>(panel, cx, cy, cell_w / 4 - 1, cell_h / 2 - 1, Colors::WHITE);
+            leaves.push_back(pool.template get<Box>(child));
+            root.children.push_back(std::make_shared<HeapNode>(
+                HeapNode{std::make_shared<Box>(cx, cy, cell_w / 4 - 1, cell_h / 2 - 1, Colors::WHITE), {}}));
+        }
+        roots.push_back(std::move(root));
+    }
+    pool.render(&driver);
+    for (const auto& root : roots) {
+        heapPaint(root, &driver);
+    }
+
+    const int iterations = 200000 / N + 100;
+    volatile uint32_t sink = 0;
+    const double pool_hit = nsPerCall(iterations * 8, [&](int i) {
+        sink = sink + pool.hitTest(static_cast<int16_t>((i * 97) % 1280), static_cast<int16_t>((i * 53) % 720));
+    });
+    const double heap_hit = nsPerCall(iterations * 8, [&](int i) {
+        const int16_t x = static_cast<int16_t>((i * 97) % 1280);
+        const int16_t y = static_cast<int16_t>((i * 53) % 720);
+        for (size_t r = roots.size(); r-- > 0;) {
+            if (heapHitTest(roots[r], x, y)) {
+                sink = sink + 1;
+                break;
+            }
+        }
+    });
+    const double pool_scan = nsPerCall(iterations, [&](int) { sink = sink + pool.render(&driver); });
+    const double heap_scan = nsPerCall(iterations, [&](int) {
+        for (const auto& root : roots) {
+            sink = sink + heapPaint(root, &driver);
+        }
+    });
+    // 一个组件变化：扫描找到它并只重绘它
+    const double pool_one = nsPerCall(iterations, [&](int i) {
+        leaves[i % leaves.size()]->invalidate();
+        sink = sink + pool.render(&driver);
+    });
+    // 损坏区：一个面板大小的区域，与之相交的组件整体重绘
+    const double pool_damage = nsPerCall(iterations, [&](int i) {
+        pool.invalidate(Rect{static_cast<int16_t>((i * 37) % 1200), static_cast<int16_t>((i * 19) % 680),
+                             cell_w, cell_h});
+        sink = sink + pool.render(&driver);
+    });
+
+    printf("  %5u widgets  hit test %7.1f ns (heap tree %7.1f)  clean frame %7.1f ns (heap tree %7.1f)"
+           "  one dirty %7.1f ns  damage rect %8.1f ns\n",
+           static_cast<unsigned>(pool.size()), pool_hit, heap_hit, pool_scan, heap_scan, pool_one, pool_damage);
+}
+
+int main() {
+    printf("Traversal cost (host, pool vs shared_ptr tree)\n");
+    runBenchmark<32>();
+    runBenchmark<256>();
+    runBenchmark<1024>();
+    return 0;
+}
@@ -0,0 +1,110 @@
+#pragma once
+
+#include "Component.h"
+#include <cstdint>
+
+namespace MinimalUI {
+
+/**
+ * @brief 缓动曲线
+ * 全部以Q14定点数计算，不依赖FPU
+ */
+enum class Easing : uint8_t {
+    LINEAR,
+    EASE_IN_QUAD,
+    EASE_OUT_QUAD,
+    EASE_IN_OUT_QUAD,
+    EASE_IN_CUBIC,
+    EASE_OUT_CUBIC,
+    EASE_IN_OUT_CUBIC,
+    EASE_IN_OUT_SINE
+};
+
+/**
+ * @brief 计算缓动进度
+ * @param easing 缓动曲线
+ * @param t 线性进度（Q14，0 ~ Q14_ONE）
+ * @return 缓动后的进度（Q14）
+ */
+int32_t ease(Easing easing, int32_t t);
+
+/**
+ * @brief 按Q14进度在两种RGB565颜色之间逐通道插值
+ */
+Color lerpColor(Color from, Color to, int32_t t);
+
+// 补间动画作用的组件属性
+enum class TweenProperty : uint8_t {
+    X,
+    Y,
+    WIDTH,
+    HEIGHT,
+    COLOR,   // 前景色，见Component::setColor()
+    VALUE    // 组件数值，见Component::setValue()
+};
+
+/**
+ * @class Animator
+ * @brief 基于时间的补间动画调度器
+ *
+ * 每个补间的当前值只由经过的时间决定：渲染循环负载高、两次update()间隔
+ * 变长时，动画会跳过中间帧直接到达应处的位置，而不是整体变慢。
+ * 只有属性值真正变化时才写回组件，由组件自行决定重绘的范围
+ * （例如进度条只重绘新增或缩短的那一段）。
+ */
+class Animator {
+public:
+    // 同时运行的最大补间数量
+    static constexpr uint8_t MAX_TWEENS = 16;
+
+    /**
+     * @brief 启动补间，同一组件同一属性上已有的补间会被替换
+     * @param target 目标组件
+     * @param property 属性
+     * @param from 起始值
+     * @param to 结束值
+     * @param duration_ms 时长（毫秒），0表示立即到达结束值
+     * @param easing 缓动曲线
+     * @param now_ms 当前时间（毫秒）
+     * @return 补间句柄，没有空位时返回-1
+     */
+    int8_t start(Component* target, TweenProperty property, int32_t from, int32_t to,
+                 uint32_t duration_ms, Easing easing, uint32_t now_ms);
+
+    /**
+     * @brief 取消组件上的所有补间，属性保持当前值
+     */
+    void cancel(Component* target);
+
+    /**
+     * @brief 推进所有补间到now_ms时刻
+     * @return 仍在运行的补间数量
+     */
+    uint8_t update(uint32_t now_ms);
+
+    // 句柄对应的补间是否仍在运行
+    bool isActive(int8_t handle) const;
+
+    // 是否有补间在运行
+    bool busy() const { return active_count_ > 0; }
+
+private:
+    struct Tween {
+        Component* target;
+        int32_t from;
+        int32_t to;
+        int32_t last;          // 上次写回的值
+        uint32_t start_ms;
+        uint32_t duration_ms;
+        TweenProperty property;
+        Easing easing;
+        bool active;
+    };
+
+    Tween tweens_[MAX_TWEENS] = {};
+    uint8_t active_count_ = 0;
+
+    static void apply(Component* target, TweenProperty property, int32_t value);
+};
+
+} // namespace MinimalUI
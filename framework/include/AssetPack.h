@@ -0,0 +1,166 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include "Font.h"
+#include "GraphicsDriver.h"
+
+namespace MinimalUI {
+
+/**
+ * @brief 资源包文件头（所有多字节字段为小端，与ESP32和常见主机一致）
+ *
+ * 文件布局：
+ *   AssetPackHeader
+ *   AssetEntry[asset_count]     索引，下标即资源ID
+ *   资源数据                     每个资源起始于4字节对齐的偏移
+ */
+struct AssetPackHeader {
+    uint32_t magic;         // ASSET_PACK_MAGIC
+    uint16_t version;       // ASSET_PACK_VERSION
+    uint16_t byte_order;    // 0x1234，按目标平台字节序读出不符时拒绝打开
+    uint32_t asset_count;
+    uint32_t index_offset;  // 索引相对文件头的偏移
+    uint32_t total_size;    // 整个资源包的字节数
+    uint32_t reserved[3];
+};
+
+// 资源类型
+enum class AssetType : uint8_t {
+    NONE = 0,   // 空位（已删除的资源）
+    FONT = 1,
+    IMAGE = 2,
+    GLYPHS = 3  // 按码点排序的字形集（见GlyphSet）
+};
+
+/**
+ * @brief 索引项
+ */
+struct AssetEntry {
+    uint32_t offset;    // 数据相对文件头的偏移，4字节对齐
+    uint32_t size;      // 数据字节数
+    AssetType type;
+    uint8_t format;     // 图像为PixelFormat；字体和字形集为0
+    uint16_t reserved;
+    int16_t width;      // 图像宽度；字体为每个字形的列数；字形集为字符格宽度
+    int16_t height;     // 图像、字体或字形集的高度
+};
+
+/**
+ * @brief 字体资源的数据头，之后依次为字形数据和（比例字体的）间距表
+ */
+struct AssetFontHeader {
+    uint8_t first;
+    uint8_t last;
+    uint8_t glyph_width;
+    uint8_t height;
+    uint8_t gap;
+    uint8_t flags;      // FONT_PROPORTIONAL
+    uint16_t reserved;
+
+    static constexpr uint8_t FONT_PROPORTIONAL = 0x01;
+};
+
+/**
+ * @brief 字形集资源的数据头
+ * 之后依次为count个严格递增的uint32_t码点和count个按页存储的字形（见GlyphSet）
+ */
+struct AssetGlyphHeader {
+    uint32_t count;
+    uint8_t width;
+    uint8_t height;
+    uint8_t advance;
+    uint8_t reserved;
+};
+
+static_assert(sizeof(AssetPackHeader) == 32, "asset pack header layout");
+static_assert(sizeof(AssetEntry) == 16, "asset entry layout");
+static_assert(sizeof(AssetFontHeader) == 8, "asset font header layout");
+static_assert(sizeof(AssetGlyphHeader) == 8, "asset glyph header layout");
+
+constexpr uint32_t ASSET_PACK_MAGIC = 0x4149554D;  // "MUIA"
+constexpr uint16_t ASSET_PACK_VERSION = 1;
+
+/**
+ * @class AssetPack
+ * @brief 内存映射的字体、字形集和图像资源包
+ *
+ * 字体和图标不再编译为C数组，而是打包为一个独立的二进制文件：ESP32上写入数据分区并通过
+ * esp_partition_mmap映射到地址空间，主机上mmap普通文件。更换美术资源只需重写该分区。
+ *
+ * 打开时一次性校验文件头和全部索引项（边界、对齐、数据大小），之后按ID查找只是数组下标，
+ * 返回的Font和Image直接指向映射区域，绘制时像素从Flash/文件缓存读取，不拷贝到RAM。
+ * 返回的指针在close()或析构前有效。
+ */
+class AssetPack {
+public:
+    AssetPack();
+    ~AssetPack();
+
+    AssetPack(const AssetPack&) = delete;
+    AssetPack& operator=(const AssetPack&) = delete;
+
+    /**
+     * @brief 映射并校验资源包
+     * @param name ESP32上为数据分区的标签，主机上为文件路径
+     * @return 找不到、映射失败或格式无效时返回false
+     */
+    bool open(const char* name);
+
+    /**
+     * @brief 使用已在地址空间中的资源包（如链接进固件的数组），不拷贝
+     * 数据须4字节对齐，并在close()前保持有效
+     */
+    bool openMemory(const void* data, size_t size);
+
+    // 解除映射，之前返回的Font和Image全部失效
+    void close();
+
+    bool isOpen() const { return base_ != nullptr; }
+    uint32_t count() const { return count_; }
+    size_t size() const { return size_; }
+    const uint8_t* data() const { return base_; }
+
+    /**
+     * @brief 按ID查找索引项
+     * @return ID超出范围或该位置为空时返回nullptr
+     */
+    const AssetEntry* entry(uint16_t id) const;
+
+    /**
+     * @brief 获取字体，字形和间距表指向映射区域
+     * @return 不存在或不是字体时返回false
+     */
+    bool font(uint16_t id, Font& out) const;
+
+    /**
+     * @brief 获取图像，像素指向映射区域
+     * @return 不存在或不是图像时返回false
+     */
+    bool image(uint16_t id, Image& out) const;
+
+    /**
+     * @brief 获取字形集，码点表和字形指向映射区域
+     * @return 不存在或不是字形集时返回false
+     */
+    bool glyphs(uint16_t id, GlyphSet& out) const;
+
+    /**
+     * @brief 校验资源包格式
+     * 检查文件头、索引范围和每个资源的对齐与大小，字形集还检查码点表是否严格递增
+     */
+    static bool validate(const uint8_t* data, size_t size);
+
+private:
+    const uint8_t* base_;
+    size_t size_;
+    const AssetEntry* index_;
+    uint32_t count_;
+    uintptr_t mapping_;    // 平台映射句柄：ESP32为esp_partition_mmap_handle_t，主机为mmap地址
+    size_t map_length_;    // 主机上mmap的长度（文件大小）
+    bool mapped_;          // base_是否由open()映射（需要解除映射）
+
+    bool attach(const uint8_t* data, size_t size);
+};
+
+} // namespace MinimalUI
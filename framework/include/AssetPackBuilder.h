@@ -0,0 +1,88 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include "AssetPack.h"
+
+namespace MinimalUI {
+
+/**
+ * @brief 主机上的完整点阵字体，AssetPackBuilder从中取出应用用到的字形（见BdfFont）
+ */
+class GlyphSource {
+public:
+    virtual ~GlyphSource() = default;
+
+    // 字符格宽度、高度和步进（像素）
+    virtual uint8_t width() const = 0;
+    virtual uint8_t height() const = 0;
+    virtual uint8_t advance() const = 0;
+
+    /**
+     * @brief 把码点的字形按页格式写入pages（见GlyphSet，调用方已清零）
+     * @return 字体中没有该码点时返回false
+     */
+    virtual bool render(uint32_t codepoint, uint8_t* pages) const = 0;
+};
+
+/**
+ * @class AssetPackBuilder
+ * @brief 在主机上生成资源包（仅主机构建）
+ *
+ * 资源ID按添加顺序从0分配。完整的CJK字体只在主机上读取，按应用文本裁剪为子集后写入资源包。
+ * 生成的文件可直接写入ESP32的数据分区：
+ *   parttool.py write_partition --partition-name=assets --input=assets.bin
+ * 按应用源文件中的文本裁剪BDF字体的命令行工具见tools/mkassets，
+ * CMake中用minimalui_add_assets()在构建时生成资源包。
+ */
+class AssetPackBuilder {
+public:
+    /**
+     * @brief 添加字体，字形和间距表被拷贝进资源包
+     * @return 资源ID；字体无效时返回-1
+     */
+    int addFont(const Font& font);
+
+    /**
+     * @brief 添加图像
+     * @param data 像素数据，RGB565为width*height个Color，MONO1每行(width+7)/8字节
+     * @return 资源ID；尺寸或格式无效时返回-1
+     */
+    int addImage(int16_t width, int16_t height, PixelFormat format, const void* data);
+
+    /**
+     * @brief 从完整字体中取出给定码点的字形，作为字形集添加
+     * 码点无需排序或去重；字体中没有的码点被跳过
+     * @param missing 可选输出：字体中没有的码点
+     * @return 资源ID；字体尺寸无效时返回-1
+     */
+    int addGlyphs(const GlyphSource& source, const std::vector<uint32_t>& codepoints,
+                  std::vector<uint32_t>* missing = nullptr);
+
+    /**
+     * @brief 收集UTF-8文本中用到的非ASCII码点（ASCII由内置字体绘制），排序并去重
+     * 传入应用的全部界面文本，结果交给addGlyphs()即得到只含这些字符的子集字体
+     */
+    static std::vector<uint32_t> collectCodepoints(const char* const* texts, size_t count);
+
+    // 生成资源包
+    std::vector<uint8_t> build() const;
+
+    /**
+     * @brief 生成资源包并写入文件
+     * @return 文件无法写入时返回false
+     */
+    bool write(const char* path) const;
+
+    size_t count() const { return entries_.size(); }
+
+private:
+    struct Pending {
+        AssetEntry entry;               // offset在build()时填写
+        std::vector<uint8_t> data;
+    };
+
+    std::vector<Pending> entries_;
+};
+
+} // namespace MinimalUI
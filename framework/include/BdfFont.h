@@ -0,0 +1,57 @@
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <vector>
+#include "AssetPackBuilder.h"
+
+namespace MinimalUI {
+
+/**
+ * @class BdfFont
+ * @brief BDF点阵字体读取器（仅主机构建）
+ *
+ * 常见的CJK点阵字体（如文泉驿点阵宋体、GNU Unifont）都提供BDF格式。所有字形按
+ * FONTBOUNDINGBOX对齐到同一字符格，交给AssetPackBuilder::addGlyphs()裁剪为子集。
+ * 只读取ENCODING非负的字形，步进取所有字形DWIDTH的最大值。
+ */
+class BdfFont : public GlyphSource {
+public:
+    /**
+     * @brief 读取BDF文件
+     * @return 文件无法读取或格式无效时返回false
+     */
+    bool load(const char* path);
+
+    /**
+     * @brief 从内存中的BDF文本读取
+     * @return 格式无效时返回false
+     */
+    bool parse(const char* text);
+
+    // 字形数
+    size_t count() const { return glyphs_.size(); }
+
+    uint8_t width() const override { return width_; }
+    uint8_t height() const override { return height_; }
+    uint8_t advance() const override { return advance_; }
+    bool render(uint32_t codepoint, uint8_t* pages) const override;
+
+private:
+    struct Glyph {
+        int16_t width;
+        int16_t height;
+        int16_t x_offset;
+        int16_t y_offset;
+        std::vector<uint8_t> rows;   // 每行(width + 7) / 8字节，字节高位为左侧像素
+    };
+
+    std::map<uint32_t, Glyph> glyphs_;
+    uint8_t width_ = 0;
+    uint8_t height_ = 0;
+    uint8_t advance_ = 0;
+    int16_t x_offset_ = 0;          // 字符格左下角相对原点的偏移
+    int16_t y_offset_ = 0;
+};
+
+} // namespace MinimalUI
@@ -0,0 +1,100 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace MinimalUI {
+
+/**
+ * @brief 缓存统计（图标、页面和字形缓存共用）
+ */
+struct CacheStats {
+    uint32_t hits = 0;
+    uint32_t misses = 0;
+    uint32_t stores = 0;       // 新保存的条目
+    uint32_t evictions = 0;    // 因容量或条目数不足被淘汰的条目
+    uint32_t rejected = 0;     // 超过容量、内存分配失败或无法缓存而绕过缓存的次数
+    size_t used_bytes = 0;     // 已保存条目占用的字节数（按字节预算的缓存）
+
+    // 命中率（百分比）
+    uint32_t hitRatePercent() const {
+        const uint32_t total = hits + misses;
+        return total ? static_cast<uint32_t>(static_cast<uint64_t>(hits) * 100 / total) : 0;
+    }
+};
+
+/**
+ * @class BudgetedLru
+ * @brief 按字节预算管理固定数量条目的LRU存储
+ *
+ * 条目数组由使用者提供（大小由各缓存的CONFIG_UI_*_ENTRIES决定），条目的键保存在使用者
+ * 按相同下标排列的数组中，本类只负责每个条目的数据内存、最近使用时间和淘汰：
+ * 所有条目占用的字节数不超过构造时给定的容量，超出时按最近最少使用的顺序淘汰。
+ * ESP32上数据优先分配在PSRAM中。
+ */
+class BudgetedLru {
+public:
+    struct Slot {
+        uint32_t last_use;
+        size_t bytes;
+        uint8_t* data;        // nullptr表示空闲
+    };
+
+    /**
+     * @brief 构造函数
+     * @param slots 条目数组，生命周期不短于本对象
+     * @param count 条目数
+     * @param budget 所有条目合计的最大字节数
+     */
+    BudgetedLru(Slot* slots, uint8_t count, size_t budget);
+    ~BudgetedLru();
+
+    BudgetedLru(const BudgetedLru&) = delete;
+    BudgetedLru& operator=(const BudgetedLru&) = delete;
+
+    uint8_t count() const { return count_; }
+    bool occupied(uint8_t index) const { return slots_[index].data != nullptr; }
+    uint8_t* data(uint8_t index) const { return slots_[index].data; }
+    size_t bytes(uint8_t index) const { return slots_[index].bytes; }
+
+    // 标记条目为最近使用
+    void touch(uint8_t index) { slots_[index].last_use = ++clock_; }
+
+    /**
+     * @brief 为bytes字节的新条目分配空闲位置，按LRU淘汰直到容量和条目都足够
+     * 返回的条目已分配数据内存并标记为最近使用，内容由调用者写入
+     * @return 条目下标；超过总容量或内存不足时返回-1并计入rejected
+     */
+    int16_t insert(size_t bytes);
+
+    // 释放条目的数据内存
+    void release(uint8_t index);
+
+    // 撤销刚由insert()分配的条目（内容无法生成时），计为rejected而不是stores
+    void cancel(uint8_t index);
+
+    // 释放所有条目
+    void clear();
+
+    size_t budget() const { return budget_; }
+    CacheStats& stats() { return stats_; }
+    const CacheStats& stats() const { return stats_; }
+    // 清零计数，保留used_bytes
+    void resetCounters();
+
+    // 缓存数据的内存分配：ESP32上优先使用PSRAM，没有时退回内部RAM
+    static uint8_t* allocate(size_t size);
+    static void deallocate(uint8_t* data);
+
+private:
+    Slot* slots_;
+    uint8_t count_;
+    size_t budget_;
+    uint32_t clock_;          // 每次保存或命中加一，用于LRU
+    CacheStats stats_;
+
+    // 淘汰最久未使用的条目，没有可淘汰的条目时返回false
+    bool evictOldest();
+};
+
+} // namespace MinimalUI
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <cstdint>
+#include <mutex>
+#include <condition_variable>
+
+namespace MinimalUI {
+
+/**
+ * @class BusArbiter
+ * @brief 共享总线的轮询仲裁器
+ *
+ * 多个设备共享一条总线时，每个设备在传输前申请总线，释放时总线按轮询顺序
+ * 交给下一个等待中的设备，保证各设备公平交替。同一设备可以嵌套申请，
+ * 因此一帧内的所有传输在外层申请释放前不会被其他设备打断。
+ */
+class BusArbiter {
+public:
+    // 每条总线支持的最大设备数
+    static constexpr uint8_t MAX_DEVICES = 4;
+
+    /**
+     * @brief 注册设备
+     * @return 设备ID，没有空位时返回-1
+     */
+    int8_t registerDevice();
+
+    /**
+     * @brief 注销设备（设备不能持有总线）
+     */
+    void unregisterDevice(int8_t id);
+
+    /**
+     * @brief 申请总线，必要时阻塞到轮到该设备
+     * ID无效或未注册时直接返回，不会获得总线
+     */
+    void acquire(int8_t id);
+
+    /**
+     * @brief 释放总线，最外层释放时把总线交给下一个等待的设备
+     */
+    void release(int8_t id);
+
+    /**
+     * @brief 当前持有总线的设备ID，空闲时为-1
+     */
+    int8_t owner() const;
+
+    /**
+     * @brief 设备是否正在等待总线
+     */
+    bool waiting(int8_t id) const;
+
+    /**
+     * @brief 作用域内持有总线的辅助类
+     */
+    class Lock {
+    public:
+        Lock(BusArbiter& arbiter, int8_t id) : arbiter_(arbiter), id_(id) { arbiter_.acquire(id_); }
+        ~Lock() { arbiter_.release(id_); }
+        Lock(const Lock&) = delete;
+        Lock& operator=(const Lock&) = delete;
+
+    private:
+        BusArbiter& arbiter_;
+        int8_t id_;
+    };
+
+private:
+    mutable std::mutex mutex_;
+    std::condition_variable cv_;
+    bool registered_[MAX_DEVICES] = {};
+    bool waiting_[MAX_DEVICES] = {};
+    int8_t owner_ = -1;        // 当前持有者
+    int8_t last_owner_ = -1;   // 上一个持有者，用于轮询起点
+    uint16_t depth_ = 0;       // 持有者的嵌套深度
+
+    // 在持有mutex_时选出下一个持有者
+    void grantNext();
+};
+
+} // namespace MinimalUI
@@ -0,0 +1,137 @@
+#pragma once
+
+#include "GraphicsDriver.h"
+#include "InputDriver.h"
+
+namespace MinimalUI {
+
+/**
+ * @brief 组件容器接口
+ * 组件放入容器（例如WidgetPool）后，脏标记和几何变化通过该接口通知容器，
+ * 容器据此维护自己的扁平数组而不必每帧遍历组件对象
+ */
+class ComponentHost {
+public:
+    virtual ~ComponentHost() = default;
+
+    /**
+     * @brief 组件需要重绘
+     * @param slot 组件在容器中的位置
+     * @param geometry 位置、尺寸或可见性是否发生变化
+     */
+    virtual void componentChanged(uint16_t slot, bool geometry) = 0;
+};
+
+/**
+ * @class Component
+ * @brief UI组件基类
+ *
+ * 组件记录自身位置、尺寸和脏标记。内容变化时调用invalidate()，
+ * 渲染循环只对isDirty()的组件调用render()，render()结束时清除脏标记。
+ */
+class Component {
+public:
+    Component(int16_t x, int16_t y, int16_t width, int16_t height);
+    virtual ~Component() = default;
+
+    /**
+     * @brief 绘制组件
+     * 实现应只重绘自上次render()以来变化的部分，结束时调用markClean()
+     */
+    virtual void render(GraphicsDriver* driver) = 0;
+
+    // 位置和尺寸访问器
+    int16_t getX() const { return x_; }
+    int16_t getY() const { return y_; }
+    int16_t getWidth() const { return width_; }
+    int16_t getHeight() const { return height_; }
+    Rect bounds() const { return Rect{x_, y_, width_, height_}; }
+
+    /**
+     * @brief 按内容计算的首选尺寸，供布局引擎测量
+     * 默认为当前尺寸；内容改变首选尺寸时，组件应调用invalidate()
+     */
+    virtual Size preferredSize(GraphicsDriver* /*driver*/) { return Size{width_, height_}; }
+
+    // 设置位置和尺寸（需要整体重绘）
+    void setPosition(int16_t x, int16_t y);
+    void setSize(int16_t width, int16_t height);
+    void setBounds(const Rect& bounds);
+
+    // 设置可见性
+    void setVisible(bool visible);
+    bool isVisible() const { return visible_; }
+
+    /**
+     * @brief 设置前景色（供动画使用），默认忽略
+     */
+    virtual void setColor(Color /*color*/) {}
+
+    /**
+     * @brief 设置组件的主数值（例如进度），默认忽略
+     */
+    virtual void setValue(int32_t /*value*/) {}
+
+    /**
+     * @brief 处理输入事件，默认不处理
+     * 触摸事件坐标为屏幕坐标，调用方通常先用contains()做命中测试
+     * @return 事件是否已被处理（处理后不再传给其他组件）
+     */
+    virtual bool handleInput(const InputEvent& /*event*/) { return false; }
+
+    // 检查点是否在组件内
+    bool contains(int16_t x, int16_t y) const;
+
+    /**
+     * @brief 标记组件需要重绘
+     */
+    void invalidate() {
+        dirty_ = true;
+        if (host_) {
+            host_->componentChanged(slot_, false);
+        }
+    }
+    bool isDirty() const { return dirty_; }
+
+    /**
+     * @brief 要求下次render()整体重绘
+     * 用于组件下方的区域被擦除（例如重叠的组件移动或隐藏）后恢复内容
+     */
+    void repaint() { invalidateLayout(); }
+
+    /**
+     * @brief 由容器调用，设置变化通知的接收者，host为nullptr时解除
+     */
+    void attachHost(ComponentHost* host, uint16_t slot) {
+        host_ = host;
+        slot_ = slot;
+    }
+
+protected:
+    /**
+     * @brief 组件的几何或样式发生变化，下次render()需要整体重绘
+     */
+    virtual void invalidateLayout() { invalidate(); }
+
+    void markClean() { dirty_ = false; }
+
+    int16_t x_;
+    int16_t y_;
+    int16_t width_;
+    int16_t height_;
+    bool visible_ = true;
+    bool dirty_ = true;
+
+private:
+    // 几何变化时通知容器
+    void notifyGeometry() {
+        if (host_) {
+            host_->componentChanged(slot_, true);
+        }
+    }
+
+    ComponentHost* host_ = nullptr;
+    uint16_t slot_ = 0;
+};
+
+} // namespace MinimalUI
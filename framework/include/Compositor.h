@@ -0,0 +1,119 @@
+#pragma once
+
+#include "GraphicsDriver.h"
+#include <cstddef>
+
+namespace MinimalUI {
+
+// 图层与下层的混合方式
+enum class BlendMode : uint8_t {
+    OPAQUE,     // 直接覆盖
+    COLOR_KEY,  // 等于key的像素透明
+    ALPHA       // 按alpha通道（可选）和整体不透明度混合
+};
+
+/**
+ * @brief 合成器中的一个图层（精灵）
+ * 像素数据由调用方持有，合成器只保存指针
+ */
+struct Layer {
+    const Color* pixels = nullptr;  // RGB565像素，nullptr表示纯色图层
+    const uint8_t* alpha = nullptr; // 可选的逐像素alpha（0~255），与pixels同尺寸
+    Color color = Colors::BLACK;    // 纯色图层的颜色
+    int16_t x = 0;
+    int16_t y = 0;
+    int16_t w = 0;
+    int16_t h = 0;
+    BlendMode mode = BlendMode::OPAQUE;
+    Color key = Colors::MAGENTA;    // COLOR_KEY模式的透明色
+    uint8_t opacity = 255;          // 整体不透明度（ALPHA模式）
+    bool visible = true;
+
+    Rect bounds() const { return Rect{x, y, w, h}; }
+};
+
+/**
+ * @class Compositor
+ * @brief 多图层RGB565合成器
+ *
+ * 合成在内存中的条带缓冲区里完成：先用背景色填充，再按图层顺序
+ * 自下而上混合，最后把合成好的像素一次性交给驱动输出，
+ * 因此总线上只出现最终结果。图层变化时只记录受影响的矩形（损坏区），
+ * render()只重新合成并输出损坏区。
+ *
+ * 合成器拥有其区域内的全部内容，区域外由驱动直接绘制的内容不受影响。
+ */
+class Compositor {
+public:
+    // 最大图层数
+    static constexpr uint8_t MAX_LAYERS = 8;
+
+    explicit Compositor(Color background = Colors::BLACK);
+
+    /**
+     * @brief 添加图层到最上层
+     * @return 图层ID，没有空位时返回-1
+     */
+    int8_t addLayer(const Layer& layer);
+
+    /**
+     * @brief 移除图层
+     */
+    void removeLayer(int8_t id);
+
+    /**
+     * @brief 替换图层属性，新旧区域都标记为损坏
+     */
+    void updateLayer(int8_t id, const Layer& layer);
+
+    /**
+     * @brief 移动图层
+     */
+    void moveLayer(int8_t id, int16_t x, int16_t y);
+
+    /**
+     * @brief 获取图层（只读），ID无效时返回nullptr
+     */
+    const Layer* layer(int8_t id) const;
+
+    /**
+     * @brief 设置背景色，整个区域标记为损坏
+     */
+    void setBackground(Color color);
+
+    /**
+     * @brief 标记需要重新合成的区域
+     */
+    void invalidate(const Rect& rect);
+
+    // 当前损坏区（多个损坏矩形的包围盒）
+    const Rect& damage() const { return damage_; }
+
+    /**
+     * @brief 合成一个矩形区域到缓冲区
+     * @param dst 缓冲区，按行存储，行宽为area.w
+     * @param area 要合成的区域
+     */
+    void compose(Color* dst, const Rect& area) const;
+
+    /**
+     * @brief 按条带合成损坏区并输出到驱动
+     * @param driver 图形驱动
+     * @param band 条带缓冲区
+     * @param band_pixels 条带缓冲区的像素数，至少能容纳损坏区的一行
+     * @return 缓冲区不足一行时返回false
+     */
+    bool render(GraphicsDriver& driver, Color* band, size_t band_pixels);
+
+private:
+    Layer layers_[MAX_LAYERS];
+    bool used_[MAX_LAYERS] = {};
+    uint8_t order_[MAX_LAYERS];   // 自下而上的图层ID
+    uint8_t count_ = 0;
+    Color background_;
+    Rect damage_{0, 0, 0, 0};
+
+    void composeLayer(Color* dst, const Rect& area, const Layer& layer) const;
+};
+
+} // namespace MinimalUI
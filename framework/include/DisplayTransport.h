@@ -0,0 +1,56 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+
+namespace MinimalUI {
+
+/**
+ * @brief 显示控制器使用的传输接口
+ * 控制器只通过该接口收发命令和数据，不依赖具体平台的SPI实现
+ *
+ * 共享总线上，帧外的每次调用都单独申请和释放总线（包括sendCommand/sendData的单个字节）。
+ * 调用方应把一组相关的传输放在beginFrame()/endFrame()之间，帧内的调用只增加嵌套计数。
+ */
+class DisplayTransport {
+public:
+    virtual ~DisplayTransport() = default;
+
+    /**
+     * @brief 发送单字节命令（DC低电平）
+     */
+    virtual void sendCommand(uint8_t cmd) = 0;
+
+    /**
+     * @brief 连续发送多个命令字节（DC低电平）
+     * 默认逐字节调用sendCommand()，传输实现应重写为一次传输
+     */
+    virtual void sendCommands(const uint8_t* cmds, size_t count) {
+        for (size_t i = 0; i < count; i++) {
+            sendCommand(cmds[i]);
+        }
+    }
+
+    /**
+     * @brief 发送单字节数据（DC高电平）
+     */
+    virtual void sendData(uint8_t data) = 0;
+
+    /**
+     * @brief 发送数据缓冲区（DC高电平）
+     */
+    virtual void sendBuffer(const uint8_t* buffer, size_t size) = 0;
+
+    /**
+     * @brief 标记一帧传输的开始
+     * beginFrame()与endFrame()之间的传输在共享总线上保持连续，可以嵌套
+     */
+    virtual void beginFrame() {}
+
+    /**
+     * @brief 标记一帧传输的结束
+     */
+    virtual void endFrame() {}
+};
+
+} // namespace MinimalUI
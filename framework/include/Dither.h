@@ -0,0 +1,79 @@
+#pragma once
+
+#include "GraphicsDriver.h"
+
+namespace MinimalUI {
+
+// 彩色到单色的转换方式
+enum class DitherMode : uint8_t {
+    THRESHOLD,  // 亮度阈值（50%）
+    BAYER4,     // 4x4有序抖动，17级灰度
+    BAYER8      // 8x8有序抖动，65级灰度
+};
+
+/**
+ * @brief RGB565颜色的亮度（0~255），按BT.601权重
+ */
+inline uint8_t luminance(Color color) {
+    uint32_t r = (color >> 11) << 3;
+    uint32_t g = ((color >> 5) & 0x3F) << 2;
+    uint32_t b = (color & 0x1F) << 3;
+    // 把通道最大值映射到255，保证白色为满亮度
+    r |= r >> 5;
+    g |= g >> 6;
+    b |= b >> 5;
+    return static_cast<uint8_t>((r * 77 + g * 150 + b * 29) >> 8);
+}
+
+/**
+ * @class MonoDither
+ * @brief RGB565到1bpp页字节的有序抖动
+ *
+ * 单色OLED的显存按页组织，一个字节是同一列上连续8行像素。
+ * 阈值矩阵为8行，与页对齐，因此纯色填充在每列上的页字节只取决于
+ * 列号 & 7，可以对每种颜色预先算出8个页字节，填充时按掩码整字节写入。
+ * 抖动图案以屏幕（显存）坐标为基准，相邻图形拼接处图案连续。
+ */
+class MonoDither {
+public:
+    explicit MonoDither(DitherMode mode = DitherMode::BAYER8);
+
+    void setMode(DitherMode mode);
+    DitherMode mode() const { return mode_; }
+
+    /**
+     * @brief 纯色对应的页字节图案
+     * @return 8个字节，第x列使用下标 x & 7，bit n对应页内第n行
+     */
+    const uint8_t* pattern(Color color);
+
+    /**
+     * @brief 一列上8行像素的页字节
+     * @param column 列号
+     * @param lum 页内各行像素的亮度（8个）
+     */
+    uint8_t pageByte(int16_t column, const uint8_t* lum) const;
+
+    // 像素(x, row)处的阈值，亮度大于阈值时点亮
+    uint8_t threshold(int16_t x, int16_t row) const { return thresholds_[row & 7][x & 7]; }
+
+    /**
+     * @brief 4级灰度：亮度在相邻两级之间时按阈值矩阵抖动
+     * @return 灰度级 0~3
+     */
+    uint8_t level2(uint8_t lum, int16_t x, int16_t row) const;
+
+    /**
+     * @brief 纯色的4级灰度页字节图案，低位平面和高位平面各8个字节
+     */
+    void pattern2(Color color, uint8_t* lsb, uint8_t* msb) const;
+
+private:
+    DitherMode mode_;
+    uint8_t thresholds_[8][8];
+    Color cached_color_;
+    uint8_t cached_pattern_[8];
+    bool cache_valid_;
+};
+
+} // namespace MinimalUI
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <cstdint>
+
+namespace MinimalUI {
+namespace FixedMath {
+
+// Q14定点数的1.0
+constexpr int32_t Q14_ONE = 1 << 14;
+
+// 0~90度的正弦表（Q14）
+inline constexpr int16_t SIN_TABLE_Q14[91] = {
+    0, 286, 572, 857, 1143, 1428, 1713, 1997, 2280, 2563,
+    2845, 3126, 3406, 3686, 3964, 4240, 4516, 4790, 5063, 5334,
+    5604, 5872, 6138, 6402, 6664, 6924, 7182, 7438, 7692, 7943,
+    8192, 8438, 8682, 8923, 9162, 9397, 9630, 9860, 10087, 10311,
+    10531, 10749, 10963, 11174, 11381, 11585, 11786, 11982, 12176, 12365,
+    12551, 12733, 12911, 13085, 13255, 13421, 13583, 13741, 13894, 14044,
+    14189, 14330, 14466, 14598, 14726, 14849, 14968, 15082, 15191, 15296,
+    15396, 15491, 15582, 15668, 15749, 15826, 15897, 15964, 16026, 16083,
+    16135, 16182, 16225, 16262, 16294, 16322, 16344, 16362, 16374, 16382,
+    16384,
+};
+
+// 将角度归一化到 [0, 360)
+inline int16_t normalizeDeg(int32_t deg) {
+    deg %= 360;
+    return static_cast<int16_t>(deg < 0 ? deg + 360 : deg);
+}
+
+// 整数角度的正弦（Q14）
+inline int32_t sinQ14(int32_t deg) {
+    int16_t d = normalizeDeg(deg);
+    if (d <= 90)  return SIN_TABLE_Q14[d];
+    if (d <= 180) return SIN_TABLE_Q14[180 - d];
+    if (d <= 270) return -SIN_TABLE_Q14[d - 180];
+    return -SIN_TABLE_Q14[360 - d];
+}
+
+// 整数角度的余弦（Q14）
+inline int32_t cosQ14(int32_t deg) {
+    return sinQ14(deg + 90);
+}
+
+// 32位整数平方根（向下取整）
+inline uint32_t isqrt(uint32_t v) {
+    uint32_t result = 0;
+    uint32_t bit = 1UL << 30;
+    while (bit > v) {
+        bit >>= 2;
+    }
+    while (bit != 0) {
+        if (v >= result + bit) {
+            v -= result + bit;
+            result = (result >> 1) + bit;
+        } else {
+            result >>= 1;
+        }
+        bit >>= 2;
+    }
+    return result;
+}
+
+// 向下取整除法（除数不为0）
+inline int32_t floorDiv(int32_t num, int32_t den) {
+    int32_t q = num / den;
+    if ((num % den != 0) && ((num < 0) != (den < 0))) q--;
+    return q;
+}
+
+// 向上取整除法（除数不为0）
+inline int32_t ceilDiv(int32_t num, int32_t den) {
+    int32_t q = num / den;
+    if ((num % den != 0) && ((num < 0) == (den < 0))) q++;
+    return q;
+}
+
+} // namespace FixedMath
+} // namespace MinimalUI
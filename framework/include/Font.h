@@ -0,0 +1,149 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace MinimalUI {
+
+/**
+ * @brief 单色点阵字体
+ *
+ * 字形按列存储，每列一个字节，bit0为最上面一行，因此字体高度不超过8像素。
+ * 提供spacing表时为比例字体，否则每个字形固定占glyph_width列。
+ */
+struct Font {
+    const uint8_t* bitmap;   // 字形数据，每个字形glyph_width字节
+    const uint8_t* spacing;  // 可选：每个字形的(左侧空白列数 << 4) | 墨迹列数，nullptr表示等宽
+    uint8_t first;           // 第一个字形的编码
+    uint8_t last;            // 最后一个字形的编码
+    uint8_t glyph_width;     // 每个字形存储的列数
+    uint8_t height;          // 字体高度
+    uint8_t gap;             // 字形之间的空白列数
+
+    // 度数符号在内置字体中的编码（占用ASCII的DEL位置）
+    static constexpr uint8_t DEGREE = 0x7F;
+
+    // 无效UTF-8序列解码得到的替换字符
+    static constexpr uint32_t REPLACEMENT = 0xFFFD;
+
+    /**
+     * @brief 从UTF-8字符串中解码下一个码点并前移指针
+     * 过长编码、代理区和超出U+10FFFF的序列整体返回一个REPLACEMENT；
+     * 截断的序列也返回REPLACEMENT，但不吞掉随后字符的首字节
+     * @return 码点，到达字符串结尾时返回0
+     */
+    static uint32_t nextCodepoint(const char*& text);
+
+    /**
+     * @brief 码点对应的内置字形编码
+     * ASCII原样返回；U+00B0映射为DEGREE，其他码点返回'?'
+     */
+    static uint8_t codeFor(uint32_t codepoint);
+
+    /**
+     * @brief 从字符串中读取下一个字形编码并前移指针
+     * 等价于codeFor(nextCodepoint(text))
+     * @return 字形编码，到达字符串结尾时返回0
+     */
+    static uint8_t nextCode(const char*& text);
+
+    bool hasGlyph(uint8_t code) const { return code >= first && code <= last; }
+
+    /**
+     * @brief 获取字形的墨迹列
+     * @param code 字形编码，字体中不存在时使用'?'
+     * @param count 输出墨迹列数
+     * @return 指向第一列墨迹的指针
+     */
+    const uint8_t* columns(uint8_t code, uint8_t& count) const;
+
+    // 字形的步进宽度（墨迹列数 + 字间距），单位为字体像素
+    uint8_t advance(uint8_t code) const;
+
+    // 数字'0'~'9'中最大的步进宽度，用于等宽数字排版
+    uint8_t digitAdvance() const;
+};
+
+// 内置5x7 ASCII字体（0x20~0x7F，高8像素含下行部分），等宽，步进6像素
+extern const Font FONT_5X7;
+
+// 与FONT_5X7共用字形数据的比例字体
+extern const Font FONT_5X7_PROPORTIONAL;
+
+/**
+ * @brief 按码点排序的字形集（如资源包中的CJK子集字体）
+ *
+ * 码点表严格递增，按二分查找定位字形。每个字形为固定大小的字符格，按页存储：
+ * 共(height + 7) / 8页，每页width个列字节，bit0为该页最上面一行，与SSD1309的显存格式相同。
+ * 所有字形等宽，步进为advance像素。只引用数据，不拥有也不拷贝。
+ */
+struct GlyphSet {
+    const uint32_t* codepoints;  // count个码点，严格递增
+    const uint8_t* bitmaps;      // count个字形，每个glyphBytes()字节
+    uint32_t count;
+    uint8_t width;
+    uint8_t height;
+    uint8_t advance;
+
+    bool isEmpty() const { return count == 0; }
+    uint8_t pages() const { return static_cast<uint8_t>((height + 7) / 8); }
+    size_t glyphBytes() const { return static_cast<size_t>(pages()) * width; }
+
+    /**
+     * @brief 二分查找码点
+     * @return 字形下标，不存在时返回-1
+     */
+    int32_t find(uint32_t codepoint) const;
+
+    // 第index个字形的页数据
+    const uint8_t* glyph(uint32_t index) const { return bitmaps + index * glyphBytes(); }
+};
+
+/**
+ * @brief 文本宽度测量缓存
+ *
+ * 以字体、缩放、排版方式和文本的哈希为键，缓存最近的测量结果。
+ * 布局和对齐会反复测量同一批短字符串，命中时只需计算一次哈希。
+ */
+class TextMeasureCache {
+public:
+    static constexpr uint8_t ENTRY_COUNT = 8;
+
+    /**
+     * @brief 测量文本宽度（像素）
+     * @param font 字体
+     * @param text 文本
+     * @param size 缩放倍数
+     * @param tabular_digits 数字是否按digitAdvance()等宽排版
+     * @param glyphs 可选的字形集，其中存在的非ASCII字符按它的步进计算
+     * @param generation 字形集的版本，同一地址的字形集内容改变后必须不同（见GlyphCache::generation()）
+     */
+    int16_t measure(const Font& font, const char* text, uint8_t size, bool tabular_digits,
+                    const GlyphSet* glyphs = nullptr, uint32_t generation = 0);
+
+    // 清空缓存
+    void clear();
+
+private:
+    struct Entry {
+        const Font* font;
+        const GlyphSet* glyphs;
+        uint32_t generation;
+        uint32_t hash;
+        uint16_t length;
+        uint8_t flags;
+        int16_t width;
+    };
+
+    Entry entries_[ENTRY_COUNT] = {};
+    uint8_t next_ = 0;  // 下一个被替换的位置（轮转替换）
+};
+
+/**
+ * @brief 不经过缓存直接测量文本宽度（像素）
+ * @param glyphs 可选的字形集，其中存在的非ASCII字符按它的步进计算
+ */
+int16_t measureText(const Font& font, const char* text, uint8_t size = 1, bool tabular_digits = false,
+                    const GlyphSet* glyphs = nullptr);
+
+} // namespace MinimalUI
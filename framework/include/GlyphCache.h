@@ -0,0 +1,103 @@
+#pragma once
+
+#include <cstdint>
+#include "BudgetedLru.h"
+#include "Font.h"
+#include "GraphicsDriver.h"
+
+// 字形缓存的槽位数（默认尺寸下共约17KB）
+#ifndef CONFIG_UI_GLYPH_CACHE_ENTRIES
+#define CONFIG_UI_GLYPH_CACHE_ENTRIES 32
+#endif
+
+// 可缓存字形的最大边长（像素），每个槽位固定占用其平方乘2字节
+#ifndef CONFIG_UI_GLYPH_MAX_SIZE
+#define CONFIG_UI_GLYPH_MAX_SIZE 16
+#endif
+
+namespace MinimalUI {
+
+/**
+ * @class GlyphCache
+ * @brief 字形集的按需加载与最近使用字形缓存
+ *
+ * 完整的CJK字体有数MB，只能留在Flash中（资源包的GLYPHS资源，见AssetPack::glyphs()）。
+ * 绘制一个码点时先在缓存中查找，未命中才在Flash中二分查找码点并读取按页存储的字形，
+ * 转换为驱动可直接使用的格式保存到固定大小的槽位中：不透明背景为RGB565位图，
+ * 交给drawBitmap()整块写入；bg与color相同（透明背景）时为MONO1掩码。
+ * 槽位不分配堆内存，已满时替换最久未使用的字形，预热后绘制不再访问Flash。
+ * 统计中misses为从字形集读取并转换的次数，rejected为缩放或字形过大而直接从字形集绘制的次数。
+ *
+ * 通过GraphicsDriver::setGlyphCache()挂到驱动上后，drawText()和Label中的非ASCII字符
+ * 优先使用字形集，字形集中没有的字符仍由当前字体绘制。
+ */
+class GlyphCache {
+public:
+    static constexpr uint8_t MAX_ENTRIES = CONFIG_UI_GLYPH_CACHE_ENTRIES;
+    static constexpr uint8_t MAX_GLYPH_SIZE = CONFIG_UI_GLYPH_MAX_SIZE;
+
+    GlyphCache();
+    explicit GlyphCache(const GlyphSet& glyphs);
+
+    GlyphCache(const GlyphCache&) = delete;
+    GlyphCache& operator=(const GlyphCache&) = delete;
+
+    // 更换字形集，丢弃所有缓存的字形
+    void setGlyphs(const GlyphSet& glyphs);
+    const GlyphSet& glyphs() const { return glyphs_; }
+
+    // 每次setGlyphs()加一；驱动的文本测量缓存以它区分字形集的内容
+    uint32_t generation() const { return generation_; }
+
+    // 码点是否在字形集中（先查缓存）
+    bool hasGlyph(uint32_t codepoint) const;
+
+    uint8_t advance() const { return glyphs_.advance; }
+    uint8_t height() const { return glyphs_.height; }
+
+    /**
+     * @brief 在(x, y)绘制码点的字形，占advance * size宽、height * size高
+     * size为1时经过缓存；放大绘制直接从字形集按行合并为fillRect
+     * @param bg 背景色，与color相同时背景透明
+     * @return 字形集中没有该码点时返回false，不绘制任何内容
+     */
+    bool draw(GraphicsDriver& driver, int16_t x, int16_t y, uint32_t codepoint, Color color, Color bg,
+              uint8_t size = 1);
+
+    /**
+     * @brief 查找或加载字形位图（advance宽、height高）
+     * @param image 输出：位图，指向缓存槽位，在下次加载新字形或clear()前有效
+     * @return 码点不存在或字形超过MAX_GLYPH_SIZE时返回false
+     */
+    bool lookup(uint32_t codepoint, Color color, Color bg, Image& image);
+
+    // 丢弃所有缓存的字形
+    void clear();
+
+    const CacheStats& stats() const { return stats_; }
+    void resetCounters() { stats_ = CacheStats{}; }
+
+private:
+    struct Entry {
+        uint32_t codepoint;   // 0表示空闲
+        Color color;
+        Color bg;
+        uint32_t last_use;
+        alignas(Color) uint8_t data[MAX_GLYPH_SIZE * MAX_GLYPH_SIZE * sizeof(Color)];
+    };
+
+    GlyphSet glyphs_;
+    uint32_t generation_;
+    Entry entries_[MAX_ENTRIES];
+    uint32_t clock_;          // 每次加载或命中加一，用于LRU
+    CacheStats stats_;
+
+    Entry* find(uint32_t codepoint, Color color, Color bg);
+    Entry& victim();
+    bool fits() const;
+    void render(const uint8_t* glyph, Color color, Color bg, uint8_t* data) const;
+    void drawScaled(GraphicsDriver& driver, int16_t x, int16_t y, const uint8_t* glyph, Color color, Color bg,
+                    uint8_t size) const;
+};
+
+} // namespace MinimalUI
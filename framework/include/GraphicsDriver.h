@@ -1,9 +1,14 @@
 #pragma once
 
+#include "Font.h"
 #include <cstdint>
 
 namespace MinimalUI {
 
+class ScreenCache;
+class GlyphCache;
+struct VectorIcon;
+
 // 基本颜色定义
 typedef uint16_t Color;
 
@@ -19,41 +24,274 @@ namespace Colors {
     constexpr Color GRAY        = 0x7BEF;
 }
 
+// 二维点
+struct Point {
+    int16_t x;
+    int16_t y;
+};
+
+// 二维尺寸
+struct Size {
+    int16_t w;
+    int16_t h;
+
+    bool operator==(const Size& other) const { return w == other.w && h == other.h; }
+    bool operator!=(const Size& other) const { return !(*this == other); }
+};
+
+// 图像像素格式
+enum class PixelFormat : uint8_t {
+    RGB565 = 1,   // 每像素一个Color（目标平台字节序），行宽为width
+    MONO1 = 2     // 每像素1位，每行(width + 7) / 8字节，字节高位为左侧像素
+};
+
+/**
+ * @brief 图像描述
+ * 只引用像素数据，不拥有也不拷贝；数据可以直接位于映射的资源包中（见AssetPack）
+ */
+struct Image {
+    int16_t width;
+    int16_t height;
+    PixelFormat format;
+    const uint8_t* data;  // RGB565格式时按2字节对齐
+};
+
+// 轴对齐矩形（左上角 + 宽高）
+struct Rect {
+    int16_t x;
+    int16_t y;
+    int16_t w;
+    int16_t h;
+
+    bool isEmpty() const { return w <= 0 || h <= 0; }
+    // 右边界和下边界（不包含），按32位计算后钳位到int16范围，靠近INT16_MAX的大矩形不会回绕
+    int16_t right() const { return clamp16(static_cast<int32_t>(x) + w); }
+    int16_t bottom() const { return clamp16(static_cast<int32_t>(y) + h); }
+
+    bool contains(int16_t px, int16_t py) const {
+        return px >= x && px < x + w && py >= y && py < y + h;
+    }
+
+    // 求交集，无交集时返回宽高为0的矩形
+    Rect intersect(const Rect& other) const {
+        int16_t nx = x > other.x ? x : other.x;
+        int16_t ny = y > other.y ? y : other.y;
+        int16_t nr = right() < other.right() ? right() : other.right();
+        int16_t nb = bottom() < other.bottom() ? bottom() : other.bottom();
+        if (nr <= nx || nb <= ny) {
+            return Rect{nx, ny, 0, 0};
+        }
+        return Rect{nx, ny, clamp16(static_cast<int32_t>(nr) - nx), clamp16(static_cast<int32_t>(nb) - ny)};
+    }
+
+    static int16_t clamp16(int32_t value) {
+        return static_cast<int16_t>(value > INT16_MAX ? INT16_MAX : (value < INT16_MIN ? INT16_MIN : value));
+    }
+};
+
+/**
+ * @brief 水平扫描线接收器
+ * 光栅化器把填充图形分解为水平扫描段后交给接收器写入
+ */
+class SpanSink {
+public:
+    virtual ~SpanSink() = default;
+
+    /**
+     * @brief 填充一段水平像素
+     * @param x 起始X坐标
+     * @param y 所在行
+     * @param w 宽度（调用方保证大于0且已裁剪）
+     * @param color 颜色
+     */
+    virtual void fillSpan(int16_t x, int16_t y, int16_t w, Color color) = 0;
+};
+
 // 图形驱动抽象接口
-class GraphicsDriver {
+class GraphicsDriver : public SpanSink {
 public:
     virtual ~GraphicsDriver() = default;
-    
+
     // 初始化显示器
     virtual bool initialize() = 0;
-    
+
     // 基本绘图操作
     virtual void drawPixel(int16_t x, int16_t y, Color color) = 0;
     virtual void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, Color color) = 0;
     virtual void drawHLine(int16_t x, int16_t y, int16_t w, Color color) = 0;
     virtual void drawVLine(int16_t x, int16_t y, int16_t h, Color color) = 0;
-    virtual void drawLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, Color color) = 0;
+    // 直线和圆周有基于扫描段的默认实现（见GraphicsDriver.cpp）
+    virtual void drawLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, Color color);
     virtual void drawRect(int16_t x, int16_t y, int16_t w, int16_t h, Color color) = 0;
-    virtual void drawCircle(int16_t x0, int16_t y0, int16_t r, Color color) = 0;
+    virtual void drawCircle(int16_t x0, int16_t y0, int16_t r, Color color);
     virtual void fillCircle(int16_t x0, int16_t y0, int16_t r, Color color) = 0;
-    
-    // 字符绘制（可选实现）
-    virtual void drawChar(int16_t x, int16_t y, char c, Color color, Color bg, uint8_t size = 1) {
-        // 默认空实现
+
+    // 扫描线填充（默认退化为单行fillRect，帧缓冲驱动应重写为整行写入）
+    void fillSpan(int16_t x, int16_t y, int16_t w, Color color) override {
+        fillRect(x, y, w, 1, color);
     }
-    
+
+    // 基于扫描线的填充图形，默认实现见GraphicsDriver.cpp
+    virtual void fillEllipse(int16_t x0, int16_t y0, int16_t rx, int16_t ry, Color color);
+    virtual void fillRoundRect(int16_t x, int16_t y, int16_t w, int16_t h, int16_t r, Color color);
+    virtual void fillTriangle(int16_t x0, int16_t y0, int16_t x1, int16_t y1,
+                              int16_t x2, int16_t y2, Color color);
+    virtual void fillPolygon(const Point* points, uint8_t count, Color color);
+    virtual void fillArc(int16_t x0, int16_t y0, int16_t r_outer, int16_t r_inner,
+                         int16_t start_deg, int16_t end_deg, Color color);
+
+    /**
+     * @brief 用线性渐变填充矩形
+     * 每行（或每列）一次fillRect，单色屏上由驱动的抖动转换呈现灰度过渡
+     * @param vertical true时从上到下由c0过渡到c1，否则从左到右
+     */
+    virtual void fillGradient(int16_t x, int16_t y, int16_t w, int16_t h, Color c0, Color c1, bool vertical = true);
+
+    /**
+     * @brief 绘制RGB565位图
+     * 默认把每行相同颜色的连续像素合并为一次fillRect，流式驱动应重写为整块传输
+     * @param pixels 像素数据，按行存储，行宽为w
+     */
+    virtual void drawBitmap(int16_t x, int16_t y, int16_t w, int16_t h, const Color* pixels);
+
+    /**
+     * @brief 绘制图像，像素直接从image.data读取
+     * RGB565图像交给drawBitmap()；MONO1图像置位像素为color，其余为bg，bg与color相同时背景透明
+     */
+    void drawImage(int16_t x, int16_t y, const Image& image, Color color = Colors::WHITE,
+                   Color bg = Colors::BLACK);
+
+    /**
+     * @brief 按size像素边长填充矢量图标
+     * 每次调用都重新光栅化；重复绘制的图标可通过IconCache缓存为位图
+     * @return 图标的交点超过光栅化器的容量、未绘制任何像素时返回false（见Rasterizer::fillIcon）
+     */
+    bool drawIcon(int16_t x, int16_t y, const VectorIcon& icon, int16_t size, Color color);
+
+    // 字符绘制，默认用当前字体按行输出扫描段；bg与color相同时背景透明
+    virtual void drawChar(int16_t x, int16_t y, char c, Color color, Color bg, uint8_t size = 1);
+
+    /**
+     * @brief 在宽cell_w（字体像素）的字符格中居中绘制一个字形
+     * 不透明背景会填满整个字符格，因此覆盖绘制时无需先清除旧字形
+     * @param code 字形编码（见Font::nextCode）
+     * @param cell_w 字符格宽度，小于字形步进时按字形步进
+     */
+    void drawGlyph(int16_t x, int16_t y, uint8_t code, uint8_t cell_w,
+                   Color color, Color bg, uint8_t size = 1);
+
+    /**
+     * @brief 在宽cell_w（字体像素）的字符格中居中绘制一个码点
+     * 非ASCII字符优先使用字形缓存，字形集中没有时退回当前字体（见drawGlyph()）。
+     * 不透明背景会填满cell_w × lineHeight()的整个字符格
+     */
+    void drawCodepoint(int16_t x, int16_t y, uint32_t codepoint, uint8_t cell_w,
+                       Color color, Color bg, uint8_t size = 1);
+
+    /**
+     * @brief 绘制一行UTF-8文本
+     * 设置了字形缓存时中文等非ASCII字符从字形集绘制，否则只支持ASCII与"°"
+     * @return 文本末尾的X坐标
+     */
+    int16_t drawText(int16_t x, int16_t y, const char* text, Color color, Color bg, uint8_t size = 1);
+
+    /**
+     * @brief 测量文本宽度（带缓存）
+     * @param tabular_digits 数字是否按等宽排版
+     */
+    int16_t measureText(const char* text, uint8_t size = 1, bool tabular_digits = false);
+
+    // 码点的步进宽度（字体像素）：字形集中存在时为字形集的步进，否则为当前字体的步进
+    uint8_t codepointAdvance(uint32_t codepoint) const;
+
+    // 文本行高（字体像素）：当前字体与字形集高度中的较大者
+    uint8_t lineHeight() const;
+
+    // 当前字体
+    void setFont(const Font* font) { font_ = font ? font : &FONT_5X7; }
+    const Font& font() const { return *font_; }
+
+    /**
+     * @brief 设置非ASCII字符使用的字形缓存，nullptr表示只使用当前字体
+     * 缓存不归驱动所有，须在驱动使用期间保持有效；更换缓存的字形集后需重新设置
+     */
+    void setGlyphCache(GlyphCache* cache);
+    GlyphCache* glyphCache() const { return glyphs_; }
+
     // 设备控制
     virtual void display() = 0;
     virtual void clear(Color color = Colors::BLACK) = 0;
-    
+
+    /**
+     * @brief 将整屏内容上移dy行（dy为负时下移），新露出的行清为黑色
+     * 支持硬件滚动的驱动只需在display()时发送新露出的行
+     * @return 不支持硬件滚动时返回false，调用方需自行重绘
+     */
+    virtual bool scroll(int16_t /*dy*/) { return false; }
+
+    /**
+     * @brief 将矩形区域内的内容水平平移dx列（dx为负时左移）
+     * 移出区域的列被丢弃，新露出的列内容不确定，由调用方重绘
+     * @return 驱动没有可平移的帧缓冲区或区域被裁剪时返回false，调用方需自行重绘整个区域
+     */
+    virtual bool shiftRect(int16_t /*x*/, int16_t /*y*/, int16_t /*w*/, int16_t /*h*/, int16_t /*dx*/) {
+        return false;
+    }
+
+    /**
+     * @brief 把帧缓冲区当前的整屏内容保存为页面快照
+     * 在页面的静态内容绘制完成、动态组件绘制之前调用，不需要先display()
+     * @return 驱动没有可读取的帧缓冲区或缓存放不下时返回false
+     */
+    virtual bool captureScreen(ScreenCache& /*cache*/, uint16_t /*page*/) { return false; }
+
+    /**
+     * @brief 从页面快照恢复整屏，并立即一次性发送到屏幕
+     * 恢复后只需重绘该页面的动态组件
+     * @return 未命中或驱动不支持时返回false，调用方需完整重绘该页面
+     */
+    virtual bool restoreScreen(ScreenCache& /*cache*/, uint16_t /*page*/) { return false; }
+
     // 辅助函数
     virtual int16_t width() const { return 240; }  // 默认宽度
     virtual int16_t height() const { return 320; } // 默认高度
 
+    // 裁剪栈的最大深度
+    static constexpr uint8_t MAX_CLIP_DEPTH = 8;
+
+    /**
+     * @brief 压入裁剪矩形，之后的所有绘制都限制在它与当前裁剪区的交集内
+     * @param rect 裁剪矩形
+     * @return 栈已满时返回false，裁剪区保持不变
+     */
+    bool pushClip(const Rect& rect);
+
+    /**
+     * @brief 弹出最近压入的裁剪矩形
+     */
+    void popClip();
+
+    /**
+     * @brief 获取当前裁剪区（屏幕范围与裁剪栈顶的交集）
+     */
+    Rect clipRect() const;
+
 protected:
-    // 辅助函数，用于填充圆角
-    virtual void fillCircleHelper(int16_t x0, int16_t y0, int16_t r, uint8_t corners, 
-                                 int16_t delta, Color color) {}
+    /**
+     * @brief 将矩形裁剪到当前裁剪区
+     * @return 矩形完全落在裁剪区外时返回false，参数不再有效
+     */
+    bool clipToCurrent(int16_t& x, int16_t& y, int16_t& w, int16_t& h) const;
+
+    // 是否存在用户压入的裁剪矩形
+    bool hasClip() const { return clip_depth_ > 0; }
+
+private:
+    Rect clip_stack_[MAX_CLIP_DEPTH];
+    uint8_t clip_depth_ = 0;
+    const Font* font_ = &FONT_5X7;
+    GlyphCache* glyphs_ = nullptr;
+    TextMeasureCache measure_cache_;
 };
 
 // 驱动类型枚举
@@ -64,4 +302,4 @@ enum class DriverType {
     JETSON_FB
 };
 
-} // namespace MinimalUI
\ No newline at end of file
+} // namespace MinimalUI
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include "BudgetedLru.h"
+#include "GraphicsDriver.h"
+#include "VectorIcon.h"
+
+// 图标缓存最多保存的位图数
+#ifndef CONFIG_UI_ICON_CACHE_ENTRIES
+#define CONFIG_UI_ICON_CACHE_ENTRIES 16
+#endif
+
+namespace MinimalUI {
+
+/**
+ * @class IconCache
+ * @brief 按（图标, 尺寸, 颜色, 背景色）缓存矢量图标光栅化结果的位图缓存
+ *
+ * 第一次绘制时把图标光栅化到位图并保存，之后相同参数的绘制只是一次drawImage()：
+ * 不透明背景保存为RGB565位图，交给驱动的drawBitmap()整块写入；
+ * bg与color相同（透明背景）时保存为MONO1掩码，按行合并置位像素。
+ * 所有位图占用的字节数不超过构造时给定的容量，超出时按最近最少使用的顺序淘汰
+ * （见BudgetedLru），ESP32上位图优先分配在PSRAM中。
+ *
+ * 图标按VectorIcon的地址区分，应使用静态存储期的图标。
+ */
+class IconCache {
+public:
+    static constexpr uint8_t MAX_ENTRIES = CONFIG_UI_ICON_CACHE_ENTRIES;
+
+    /**
+     * @brief 构造函数
+     * @param budget 所有位图合计的最大字节数
+     */
+    explicit IconCache(size_t budget);
+
+    IconCache(const IconCache&) = delete;
+    IconCache& operator=(const IconCache&) = delete;
+
+    /**
+     * @brief 绘制图标，未命中时先光栅化并保存
+     * 位图放不下时直接通过扫描段绘制，结果相同；被光栅化器拒绝的图标（见Rasterizer::fitsIcon）
+     * 不绘制任何像素
+     * @param bg 背景色，与color相同时背景透明
+     */
+    void draw(GraphicsDriver& driver, int16_t x, int16_t y, const VectorIcon& icon, int16_t size,
+              Color color, Color bg);
+
+    /**
+     * @brief 查找或生成图标位图
+     * @param image 输出：位图，指向缓存内部，在下次保存新位图或clear()前有效
+     * 最近一个被光栅化器拒绝的（图标, 尺寸）会被记住，之后直接返回false而不再光栅化
+     * @return 位图超过总容量、内存不足或图标被光栅化器拒绝时返回false
+     */
+    bool lookup(const VectorIcon& icon, int16_t size, Color color, Color bg, Image& image);
+
+    // 丢弃所有位图
+    void clear();
+
+    size_t budget() const { return lru_.budget(); }
+    const CacheStats& stats() const { return lru_.stats(); }
+    void resetCounters() { lru_.resetCounters(); }
+
+    // 位图的字节数
+    static size_t bitmapSize(int16_t size, bool transparent);
+
+private:
+    struct Key {
+        const VectorIcon* icon;
+        int16_t size;
+        Color color;
+        Color bg;
+    };
+
+    Key keys_[MAX_ENTRIES];   // 与slots_按下标对应
+    BudgetedLru::Slot slots_[MAX_ENTRIES];
+    BudgetedLru lru_;
+    const VectorIcon* rejected_icon_;   // 最近一个被光栅化器拒绝的图标及其尺寸
+    int16_t rejected_size_;
+
+    // 返回条目下标，未找到时返回-1
+    int16_t find(const VectorIcon& icon, int16_t size, Color color, Color bg) const;
+    // 图标被光栅化器拒绝时返回false
+    static bool render(const VectorIcon& icon, int16_t size, Color color, Color bg, uint8_t* data);
+};
+
+} // namespace MinimalUI
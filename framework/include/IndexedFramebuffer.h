@@ -0,0 +1,100 @@
+#pragma once
+
+#include "GraphicsDriver.h"
+#include <cstddef>
+
+namespace MinimalUI {
+
+/**
+ * @class IndexedFramebuffer
+ * @brief 调色板（4bpp/8bpp）帧缓冲区
+ *
+ * 绘制时写入调色板索引，刷新时通过查找表把索引行展开为面板字节序的RGB565。
+ * 4bpp时一个字节查一次表得到两个像素。相比RGB565帧缓冲区内存只需1/4（4bpp）
+ * 或1/2（8bpp）。修改调色板不需要重绘，只需重新刷新整屏，可用于主题切换和高亮。
+ *
+ * 4bpp时每字节高4位为左侧像素。
+ */
+class IndexedFramebuffer {
+public:
+    /**
+     * @brief 构造函数
+     * @param width 宽度
+     * @param height 高度
+     * @param bpp 每像素位数，4或8
+     */
+    IndexedFramebuffer(int16_t width, int16_t height, uint8_t bpp);
+    ~IndexedFramebuffer();
+
+    IndexedFramebuffer(const IndexedFramebuffer&) = delete;
+    IndexedFramebuffer& operator=(const IndexedFramebuffer&) = delete;
+
+    // 缓冲区是否分配成功
+    bool valid() const { return buffer_ != nullptr; }
+
+    int16_t width() const { return width_; }
+    int16_t height() const { return height_; }
+    uint8_t bpp() const { return bpp_; }
+    uint16_t paletteSize() const { return static_cast<uint16_t>(1u << bpp_); }
+    size_t bufferSize() const { return static_cast<size_t>(stride_) * height_; }
+
+    // 索引数据（按行连续存放，用于整屏快照）
+    uint8_t* data() { return buffer_; }
+    const uint8_t* data() const { return buffer_; }
+
+    /**
+     * @brief 设置调色板，从索引0开始依次设置count个颜色
+     * 调色板变化后整屏标记为脏，刷新时按新颜色展开
+     */
+    void setPalette(const Color* colors, uint16_t count);
+
+    /**
+     * @brief 修改单个调色板项
+     */
+    void setPaletteEntry(uint8_t index, Color color);
+
+    Color paletteEntry(uint8_t index) const { return palette_[index]; }
+
+    /**
+     * @brief 查找颜色对应的索引
+     * 调色板中没有完全相同的颜色时返回最接近的颜色
+     */
+    uint8_t indexOf(Color color);
+
+    /**
+     * @brief 填充矩形（调用方保证已裁剪到缓冲区范围内）
+     */
+    void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint8_t index);
+
+    // 读取像素索引
+    uint8_t pixel(int16_t x, int16_t y) const;
+
+    /**
+     * @brief 把一行中的一段展开为面板字节序（大端）RGB565
+     * @param out 输出缓冲区，至少 w * 2 字节
+     */
+    void expandRow(int16_t y, int16_t x, int16_t w, uint8_t* out) const;
+
+    // 自上次clearDirty()以来修改过的区域（包围盒）
+    const Rect& dirty() const { return dirty_; }
+    void clearDirty() { dirty_ = Rect{0, 0, 0, 0}; }
+    void markAllDirty() { dirty_ = Rect{0, 0, width_, height_}; }
+
+private:
+    int16_t width_;
+    int16_t height_;
+    uint8_t bpp_;
+    int16_t stride_;          // 每行字节数
+    uint8_t* buffer_;
+    Color palette_[256];
+    uint16_t lut_[256];       // 调色板项的面板字节序
+    uint32_t pair_lut_[256];  // 4bpp：一个字节到两个面板字节序像素
+    Color last_color_;        // indexOf()最近一次查询
+    uint8_t last_index_;
+    Rect dirty_;
+
+    void rebuildLut();
+    void markDirty(int16_t x, int16_t y, int16_t w, int16_t h);
+};
+
+} // namespace MinimalUI
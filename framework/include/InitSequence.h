@@ -0,0 +1,86 @@
+#pragma once
+
+#include "DisplayTransport.h"
+#include <cstddef>
+#include <cstdint>
+
+namespace MinimalUI {
+
+/**
+ * 显示控制器上电初始化表
+ *
+ * 表是一串操作，每个操作以一个头字节开始：
+ *   CMDS | n      随后n个字节全部以命令方式（DC低电平）发送，SSD13xx的命令参数也属于此类
+ *   CMD_DATA | n  随后1个命令字节和n-1个参数字节（参数DC高电平），MIPI DCS类TFT控制器使用
+ *   DELAY         随后1个字节为等待的毫秒数
+ *   END           表结束
+ * n最大为63。控制器把表声明为constexpr数组（或由constexpr函数按配置生成），
+ * 由InitSequencer分段发送：两次延时之间的所有操作作为一帧，连续命令合并为一次传输。
+ */
+namespace InitSequence {
+constexpr uint8_t CMDS = 0x00;
+constexpr uint8_t CMD_DATA = 0x40;
+constexpr uint8_t DELAY = 0x80;
+constexpr uint8_t END = 0xFF;
+constexpr uint8_t LENGTH_MASK = 0x3F;
+constexpr uint8_t TYPE_MASK = 0xC0;
+
+/**
+ * @brief 计算表的长度（包括END）
+ */
+constexpr size_t length(const uint8_t* table) {
+    size_t pos = 0;
+    while (table[pos] != END) {
+        pos += (table[pos] & TYPE_MASK) == DELAY ? 2 : 1 + (table[pos] & LENGTH_MASK);
+    }
+    return pos + 1;
+}
+
+/**
+ * @brief 表中所有延时之和（毫秒）
+ */
+constexpr uint32_t totalDelayMs(const uint8_t* table) {
+    size_t pos = 0;
+    uint32_t total = 0;
+    while (table[pos] != END) {
+        if ((table[pos] & TYPE_MASK) == DELAY) {
+            total += table[pos + 1];
+            pos += 2;
+        } else {
+            pos += 1 + (table[pos] & LENGTH_MASK);
+        }
+    }
+    return total;
+}
+} // namespace InitSequence
+
+/**
+ * @class InitSequencer
+ * @brief 非阻塞地发送初始化表
+ * 每次step()发送到下一个延时为止的操作并返回需要等待的时间，调用方在等待期间可以做其他工作
+ */
+class InitSequencer {
+public:
+    /**
+     * @brief 从表头开始
+     */
+    void start(const uint8_t* table) {
+        table_ = table;
+        pos_ = 0;
+    }
+
+    /**
+     * @brief 发送到下一个延时或表尾为止的所有操作
+     * @param wait_ms 输出：下次调用前需要等待的毫秒数
+     * @return 整个表是否已发送完
+     */
+    bool step(DisplayTransport& transport, uint32_t& wait_ms);
+
+    bool done() const { return !table_ || table_[pos_] == InitSequence::END; }
+
+private:
+    const uint8_t* table_ = nullptr;
+    size_t pos_ = 0;
+};
+
+} // namespace MinimalUI
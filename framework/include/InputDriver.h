@@ -0,0 +1,212 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace MinimalUI {
+
+// 输入事件类型
+enum class InputEventType : uint8_t {
+    BUTTON_DOWN,
+    BUTTON_UP,
+    ENCODER,      // 旋转编码器，x为自上次事件以来的步数（顺时针为正）
+    TOUCH_DOWN,
+    TOUCH_MOVE,   // 每帧最多一个，为该帧内最新的位置
+    TOUCH_UP
+};
+
+/**
+ * @brief 输入事件
+ */
+struct InputEvent {
+    InputEventType type;
+    uint8_t id;        // 按键/编码器编号，触摸为0
+    int16_t x;         // 触摸X坐标；编码器步数
+    int16_t y;         // 触摸Y坐标
+    uint32_t time_ms;  // 采样时间
+};
+
+/**
+ * @class InputEventQueue
+ * @brief 单生产者单消费者的无锁事件队列
+ *
+ * 生产者为中断或定时器回调，消费者为UI线程，双方都不加锁、不阻塞。
+ * 触摸移动不进入环形队列，而是只保留最新位置：UI线程每帧取事件时，
+ * 如果手指仍按下且位置有更新，在队列事件之后追加一个TOUCH_MOVE。
+ * 因此采样频率高于帧率时不会积压移动事件，也不会因队列满而丢失按下/抬起。
+ */
+class InputEventQueue {
+public:
+    // 容量必须为2的幂
+    static constexpr uint8_t CAPACITY = 32;
+
+    /**
+     * @brief 加入事件（生产者）
+     * @return 队列已满时丢弃事件并返回false
+     */
+    bool push(const InputEvent& event);
+
+    /**
+     * @brief 更新最新触摸位置（生产者），只保留最后一次
+     */
+    void pushMove(int16_t x, int16_t y, uint32_t time_ms);
+
+    /**
+     * @brief 取出所有待处理事件（消费者）
+     * @param out 输出缓冲区
+     * @param max 缓冲区容量，剩余事件留到下次
+     * @return 取出的事件数
+     */
+    size_t drain(InputEvent* out, size_t max);
+
+    // 因队列满而丢弃的事件数
+    uint16_t dropped() const { return dropped_.load(std::memory_order_relaxed); }
+
+private:
+    InputEvent events_[CAPACITY];
+    std::atomic<uint8_t> head_{0};      // 生产者写入位置
+    std::atomic<uint8_t> tail_{0};      // 消费者读取位置
+    std::atomic<uint16_t> dropped_{0};
+    uint32_t pushed_ = 0;               // 生产者：已入队事件数，作为追踪id
+
+    // 最新触摸位置：x在高16位、y在低16位；move_seq_在位置写入后递增
+    std::atomic<uint32_t> move_xy_{0};
+    std::atomic<uint32_t> move_time_{0};
+    std::atomic<uint32_t> move_seq_{0};
+
+    // 消费者状态
+    uint32_t last_move_seq_ = 0;
+    bool touch_down_ = false;
+    uint32_t drained_ = 0;              // 已取出事件数，与pushed_按顺序对应
+};
+
+/**
+ * @class ButtonDebouncer
+ * @brief 积分式按键去抖
+ *
+ * 每次采样按键按下时计数加一、松开时减一，计数在0和samples之间饱和，
+ * 只有到达两端时才改变稳定状态。抖动期间计数来回摆动，不会产生事件。
+ */
+class ButtonDebouncer {
+public:
+    explicit ButtonDebouncer(uint8_t samples = 5) : limit_(samples ? samples : 1), count_(0), state_(false) {}
+
+    /**
+     * @brief 输入一次原始采样
+     * @param raw 是否按下
+     * @return 稳定状态是否发生变化
+     */
+    bool update(bool raw);
+
+    bool pressed() const { return state_; }
+
+private:
+    uint8_t limit_;
+    uint8_t count_;
+    bool state_;
+};
+
+/**
+ * @class QuadratureDecoder
+ * @brief 正交编码器解码
+ *
+ * 按A/B两相的格雷码状态表累计四分之一步，非法跳变（两相同时变化）被忽略，
+ * 触点抖动产生的来回跳变相互抵消。累计满一格时输出一步。
+ */
+class QuadratureDecoder {
+public:
+    explicit QuadratureDecoder(uint8_t steps_per_detent = 4)
+        : state_(0), accum_(0), steps_per_detent_(steps_per_detent ? steps_per_detent : 1) {}
+
+    /**
+     * @brief 输入两相当前电平（可在中断中调用）
+     * @return 新增的整格步数：1、-1或0
+     */
+    int8_t update(bool a, bool b);
+
+private:
+    uint8_t state_;   // 上一次的AB状态
+    int8_t accum_;    // 未满一格的四分之一步
+    uint8_t steps_per_detent_;
+};
+
+/**
+ * @brief 电阻触摸屏校准参数（Q16定点）
+ * screen_x = (ax * raw_x + bx * raw_y + cx) >> 16，Y同理
+ */
+struct TouchCalibration {
+    int32_t ax, bx, cx;
+    int32_t ay, by, cy;
+
+    /**
+     * @brief 根据原始值范围生成线性校准
+     * @param swap_xy 触摸屏X/Y方向与显示方向互换
+     */
+    static TouchCalibration fromRange(uint16_t raw_x_min, uint16_t raw_x_max,
+                                      uint16_t raw_y_min, uint16_t raw_y_max,
+                                      int16_t width, int16_t height, bool swap_xy);
+};
+
+/**
+ * @class TouchFilter
+ * @brief 电阻触摸坐标滤波
+ *
+ * 每个点取三次采样的中值去除尖峰，校准到屏幕坐标后做一阶低通（Q8系数），
+ * 按下后的第一个点不做平滑，避免从上一次抬起的位置拖过来。
+ */
+class TouchFilter {
+public:
+    explicit TouchFilter(uint8_t alpha_q8 = 96);
+
+    void setCalibration(const TouchCalibration& calibration) { calibration_ = calibration; }
+
+    // 抬起时调用，下次按下重新开始
+    void reset() { primed_ = false; }
+
+    /**
+     * @brief 输入一组原始采样，输出滤波后的屏幕坐标
+     * @param raw_x X方向的3次采样
+     * @param raw_y Y方向的3次采样
+     */
+    void update(const uint16_t* raw_x, const uint16_t* raw_y, int16_t& x, int16_t& y);
+
+private:
+    TouchCalibration calibration_;
+    uint8_t alpha_;     // 新采样的权重（/256）
+    int32_t fx_;        // 滤波后的坐标（Q8）
+    int32_t fy_;
+    bool primed_;
+};
+
+/**
+ * @class InputDriver
+ * @brief 输入设备抽象接口
+ *
+ * 实现类在中断或定时器回调中采样、去抖并把事件写入队列，
+ * UI线程每帧调用一次poll()取出事件。采样不依赖渲染循环，
+ * 长时间的SPI刷新期间输入仍按原有时间戳记录。
+ */
+class InputDriver {
+public:
+    virtual ~InputDriver() = default;
+
+    /**
+     * @brief 初始化硬件并开始采样
+     */
+    virtual bool initialize() = 0;
+
+    /**
+     * @brief 取出自上次调用以来的事件
+     * @return 事件数
+     */
+    size_t poll(InputEvent* events, size_t max) { return queue_.drain(events, max); }
+
+    // 因队列满而丢弃的事件数
+    uint16_t droppedEvents() const { return queue_.dropped(); }
+
+protected:
+    InputEventQueue queue_;
+};
+
+} // namespace MinimalUI
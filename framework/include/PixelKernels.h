@@ -0,0 +1,50 @@
+#pragma once
+
+#include "GraphicsDriver.h"
+#include <cstddef>
+
+namespace MinimalUI {
+namespace PixelKernels {
+
+/**
+ * RGB565像素行处理内核
+ *
+ * 通用实现按32位字一次读写两个像素（SWAR）；混合时把一个像素的三个通道
+ * 展开到一个32位字中（0x07E0F81F布局），一次乘法完成三个通道的插值。
+ * 在主机上编译时自动使用SSE2/AVX2，每次处理8/16个像素。
+ * 所有函数对任意长度和任意2字节对齐的指针都有效。
+ */
+
+// 用单一颜色填充n个像素
+void fill(Color* dst, size_t n, Color color);
+
+// 拷贝n个像素
+void copy(Color* dst, const Color* src, size_t n);
+
+// 拷贝n个像素，跳过等于key的像素（透明色）
+void copyKeyed(Color* dst, const Color* src, size_t n, Color key);
+
+/**
+ * @brief 以统一不透明度混合 dst = src * alpha + dst * (1 - alpha)
+ * @param alpha 不透明度（0~255）
+ */
+void blend(Color* dst, const Color* src, size_t n, uint8_t alpha);
+
+/**
+ * @brief 以统一不透明度把单一颜色混合到n个像素上（半透明遮罩）
+ * @param alpha 不透明度（0~255）
+ */
+void blendFill(Color* dst, size_t n, Color color, uint8_t alpha);
+
+/**
+ * @brief 按逐像素alpha混合
+ * @param alpha 每个像素的不透明度（0~255）
+ * @param opacity 整体不透明度（0~255），与逐像素alpha相乘
+ */
+void blendAlpha(Color* dst, const Color* src, const uint8_t* alpha, size_t n, uint8_t opacity = 255);
+
+// 把0~255的alpha换算为混合内核使用的0~32
+inline uint32_t alpha5(uint32_t alpha) { return (alpha + 4) >> 3; }
+
+} // namespace PixelKernels
+} // namespace MinimalUI
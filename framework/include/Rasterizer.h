@@ -0,0 +1,106 @@
+#pragma once
+
+#include "GraphicsDriver.h"
+#include "VectorIcon.h"
+
+// 矢量图标每行最多的边交点数；超出的图标被拒绝（见Rasterizer::fitsIcon）
+#ifndef CONFIG_UI_VECTOR_MAX_CROSSINGS
+#define CONFIG_UI_VECTOR_MAX_CROSSINGS 32
+#endif
+
+namespace MinimalUI {
+
+/**
+ * @class Rasterizer
+ * @brief 定点扫描线光栅化器
+ *
+ * 将填充图形逐行分解为水平扫描段并输出到SpanSink，
+ * 开销与图形覆盖的行数成正比，而不是与周长像素数成正比。
+ * 所有扫描段在输出前已按裁剪矩形裁剪，完全落在裁剪区外的图形直接丢弃。
+ */
+class Rasterizer {
+public:
+    /**
+     * @brief 构造函数
+     * @param sink 扫描线接收器
+     * @param clip 裁剪矩形
+     */
+    Rasterizer(SpanSink& sink, const Rect& clip);
+
+    /**
+     * @brief 绘制一像素宽的直线（Bresenham）
+     * 同一行上连续的像素合并为一个扫描段，接近水平的长线只输出少数几段
+     */
+    void drawLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, Color color);
+
+    /**
+     * @brief 绘制圆周（中点画圆法）
+     * 顶部和底部同一行上连续的像素合并为一个扫描段
+     */
+    void drawCircle(int16_t x0, int16_t y0, int16_t r, Color color);
+
+    void fillCircle(int16_t x0, int16_t y0, int16_t r, Color color);
+    void fillEllipse(int16_t x0, int16_t y0, int16_t rx, int16_t ry, Color color);
+    void fillRoundRect(int16_t x, int16_t y, int16_t w, int16_t h, int16_t r, Color color);
+    void fillTriangle(int16_t x0, int16_t y0, int16_t x1, int16_t y1,
+                      int16_t x2, int16_t y2, Color color);
+
+    /**
+     * @brief 填充凸多边形
+     * 从最高顶点沿两条边链走到最低顶点，逐行填充两链之间的扫描段。
+     * 每行与轮廓只有两个交点的凹多边形（Y方向单调）同样正确；其他凹多边形和自相交多边形
+     * 的结果不保证是其内部，但不会超出顶点包围盒和裁剪矩形
+     * @param points 顶点数组（顺时针或逆时针均可）
+     * @param count 顶点数量
+     */
+    void fillConvexPolygon(const Point* points, uint8_t count, Color color);
+
+    /**
+     * @brief 填充圆环扇段
+     * 角度以3点钟方向为0度，顺时针增加（屏幕坐标系）
+     * @param r_outer 外半径
+     * @param r_inner 内半径（0表示实心扇形）
+     * @param start_deg 起始角度
+     * @param end_deg 结束角度
+     */
+    void fillArc(int16_t x0, int16_t y0, int16_t r_outer, int16_t r_inner,
+                 int16_t start_deg, int16_t end_deg, Color color);
+
+    /**
+     * @brief 按非零环绕规则填充矢量图标
+     * 每行重新遍历路径并展平曲线，只保存该行的交点，不需要边表和堆内存；
+     * 像素中心落在轮廓内时填充
+     * 输出前先用fitsIcon()检查，图标被拒绝时不输出任何扫描段
+     * @param x 图标左上角
+     * @param y 图标左上角
+     * @param size 图标边长（像素）
+     * @return 图标被拒绝时返回false
+     */
+    bool fillIcon(const VectorIcon& icon, int16_t x, int16_t y, int16_t size, Color color);
+
+    /**
+     * @brief 检查图标在裁剪区内的每一行的交点是否都不超过CONFIG_UI_VECTOR_MAX_CROSSINGS
+     * 超过时图标被拒绝：计入rejectedIcons()并打印警告。这样的图标应简化路径或增大该配置
+     */
+    bool fitsIcon(const VectorIcon& icon, int16_t x, int16_t y, int16_t size) const;
+
+    // 因交点超过CONFIG_UI_VECTOR_MAX_CROSSINGS而被拒绝的图标绘制次数（所有光栅化器合计）
+    static uint32_t rejectedIcons();
+
+    /**
+     * @brief 输出一个闭区间扫描段 [x0, x1]，自动裁剪
+     */
+    void span(int16_t x0, int16_t x1, int16_t y, Color color);
+
+private:
+    SpanSink& sink_;
+    Rect clip_;
+
+    // 包围盒完全落在裁剪区外时返回true（按32位计算，跨越大半个坐标范围的图形不会回绕）
+    bool rejects(int32_t x, int32_t y, int32_t w, int32_t h) const;
+
+    // 圆在dy行上的半宽（x² + dy² <= r² + r）
+    static int16_t circleHalfWidth(int16_t r, int16_t dy);
+};
+
+} // namespace MinimalUI
@@ -0,0 +1,131 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include "GraphicsDriver.h"
+
+// 渲染命令队列容量，必须为2的幂
+#ifndef CONFIG_UI_RENDER_QUEUE_SIZE
+#define CONFIG_UI_RENDER_QUEUE_SIZE 64
+#endif
+
+namespace MinimalUI {
+
+// 渲染命令类型
+enum class RenderOp : uint8_t {
+    FILL_RECT,    // x, y, a=w, b=h, color
+    PIXEL,        // x, y, color
+    HLINE,        // x, y, a=w, color
+    VLINE,        // x, y, a=h, color
+    LINE,         // x, y, a=x1, b=y1, color
+    RECT,         // x, y, a=w, b=h, color
+    CIRCLE,       // x, y, a=r, color
+    FILL_CIRCLE,  // x, y, a=r, color
+    TEXT,         // x, y, color, bg, size, text
+    CLEAR,        // color
+    INVOKE,       // 在渲染任务中调用call.fn(driver, call.context)，用于更新组件状态
+    DISPLAY       // 请求刷新屏幕，结束当前批；紧邻的多个请求合并为一次
+};
+
+/**
+ * @brief 渲染命令
+ * 固定大小、按值拷贝入队，生产者不需要保证任何数据在入队后仍然有效
+ * （INVOKE的context除外）。
+ */
+struct RenderCommand {
+    // 内嵌文本的最大长度（含结尾的0），更长的文本在完整的UTF-8字符处截断
+    static constexpr uint8_t TEXT_CAPACITY = 16;
+
+    typedef void (*Callback)(GraphicsDriver* driver, void* context);
+
+    RenderOp op;
+    uint8_t size;     // 文本放大倍数
+    int16_t x;
+    int16_t y;
+    int16_t a;
+    int16_t b;
+    Color color;
+    Color bg;
+    union {
+        char text[TEXT_CAPACITY];
+        struct {
+            Callback fn;
+            void* context;
+        } call;
+    };
+};
+
+/**
+ * @class RenderQueue
+ * @brief 多生产者单消费者的无锁渲染命令队列
+ *
+ * 任意任务（传感器、网络、UI逻辑）都可以向队列写入绘制命令，不加锁、不阻塞：
+ * 生产者用一次CAS占用位置，写入命令后以槽位序号发布；队列满时命令被丢弃并返回false。
+ * 唯一的渲染任务调用drain()按入队顺序执行命令，驱动、总线引脚和帧缓冲区只被这一个
+ * 任务访问，因此不再需要互斥锁。同一生产者的命令保持入队顺序，不同生产者之间
+ * 按占用位置的先后交错。
+ *
+ * 某个生产者占用位置后、发布前被抢占时，渲染任务在该位置停下，其后的命令留到下一次drain()，
+ * 不会等待或读到不完整的命令。
+ */
+class RenderQueue {
+public:
+    static constexpr uint32_t CAPACITY = CONFIG_UI_RENDER_QUEUE_SIZE;
+    static_assert((CAPACITY & (CAPACITY - 1)) == 0, "CONFIG_UI_RENDER_QUEUE_SIZE must be a power of two");
+
+    RenderQueue();
+
+    /**
+     * @brief 加入命令（生产者，可在任意任务中调用）
+     * @return 队列已满时丢弃命令并返回false
+     */
+    bool push(const RenderCommand& command);
+
+    // 常用命令的便捷写法（生产者）
+    bool fillRect(int16_t x, int16_t y, int16_t w, int16_t h, Color color);
+    bool drawPixel(int16_t x, int16_t y, Color color);
+    bool drawHLine(int16_t x, int16_t y, int16_t w, Color color);
+    bool drawVLine(int16_t x, int16_t y, int16_t h, Color color);
+    bool drawLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, Color color);
+    bool drawRect(int16_t x, int16_t y, int16_t w, int16_t h, Color color);
+    bool drawCircle(int16_t x0, int16_t y0, int16_t r, Color color);
+    bool fillCircle(int16_t x0, int16_t y0, int16_t r, Color color);
+    bool drawText(int16_t x, int16_t y, const char* text, Color color, Color bg, uint8_t size = 1);
+    bool clear(Color color = Colors::BLACK);
+    bool invoke(RenderCommand::Callback fn, void* context);
+    bool display();
+
+    /**
+     * @brief 执行待处理的命令（仅渲染任务调用）
+     * 绘制命令按顺序执行，遇到DISPLAY时连同紧随其后的DISPLAY合并为一次display()并返回，
+     * 之后的命令属于下一帧，留到下次调用，不会在刷新前画进当前帧。
+     * 渲染任务应循环调用直到返回0，每次返回对应最多一帧。
+     * @param max 本次最多执行的命令数（DISPLAY也计数），剩余命令留到下次
+     * @return 执行的命令数
+     */
+    size_t drain(GraphicsDriver* driver, size_t max = CAPACITY);
+
+    // 因队列满而丢弃的命令数
+    uint32_t dropped() const { return dropped_.load(std::memory_order_relaxed); }
+
+    // 合并后实际调用display()的次数
+    uint32_t presented() const { return presented_; }
+
+private:
+    struct Slot {
+        std::atomic<uint32_t> sequence;  // 等于位置时可写，等于位置+1时可读
+        RenderCommand command;
+    };
+
+    Slot slots_[CAPACITY];
+    std::atomic<uint32_t> head_{0};      // 生产者：下一个待占用的位置
+    std::atomic<uint32_t> dropped_{0};
+    uint32_t tail_ = 0;                  // 消费者：下一个待执行的位置
+    uint32_t presented_ = 0;
+
+    static RenderCommand make(RenderOp op, int16_t x, int16_t y, int16_t a, int16_t b, Color color);
+    static void execute(const RenderCommand& command, GraphicsDriver* driver);
+};
+
+} // namespace MinimalUI
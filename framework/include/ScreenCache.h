@@ -0,0 +1,107 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include "BudgetedLru.h"
+
+// 页面缓存最多保存的页面数
+#ifndef CONFIG_UI_SCREEN_CACHE_ENTRIES
+#define CONFIG_UI_SCREEN_CACHE_ENTRIES 8
+#endif
+
+namespace MinimalUI {
+
+/**
+ * @class ScreenCache
+ * @brief 按页面ID保存整屏帧缓冲区快照的缓存
+ *
+ * 在几个静态页面之间切换时，第一次显示某页后把合成好的帧缓冲区保存下来，
+ * 之后切回该页只需把快照写回帧缓冲区并一次性发送，再重绘该页的动态组件，
+ * 不必重新执行每个绘制图元。
+ *
+ * 快照可选用游程编码压缩（单色和调色板界面通常有大面积相同字节），
+ * 压缩后不比原始数据小时直接保存原始数据。所有快照占用的字节数（压缩后）不超过
+ * 构造时给定的容量，超出时按最近最少使用的顺序淘汰（见BudgetedLru），
+ * ESP32上快照优先分配在PSRAM中。编码和解码都直接在快照内存和调用方的缓冲区之间进行，
+ * 没有容量之外的临时缓冲区，容量就是缓存占用的全部堆内存。
+ *
+ * 快照内容的格式由驱动决定，缓存只按字节保存；不同驱动不应共用同一个缓存。
+ */
+class ScreenCache {
+public:
+    static constexpr uint8_t MAX_ENTRIES = CONFIG_UI_SCREEN_CACHE_ENTRIES;
+
+    /**
+     * @brief 构造函数
+     * @param budget 所有快照合计的最大字节数
+     * @param compress 是否用游程编码压缩快照
+     */
+    explicit ScreenCache(size_t budget, bool compress = true);
+
+    ScreenCache(const ScreenCache&) = delete;
+    ScreenCache& operator=(const ScreenCache&) = delete;
+
+    /**
+     * @brief 保存页面快照，同一页面已有的快照被替换
+     * @return 快照超过总容量或内存不足时返回false
+     */
+    bool store(uint16_t page, const uint8_t* data, size_t size);
+
+    /**
+     * @brief 把页面快照解压到out
+     * 压缩的快照先完整校验一遍，确认能解码出size字节后才写入out
+     * @param size out的字节数，必须与保存时相同
+     * @return 未命中、大小不符或快照损坏时返回false，out不被修改
+     */
+    bool load(uint16_t page, uint8_t* out, size_t size);
+
+    // 是否保存了该页面（不计入命中统计）
+    bool contains(uint16_t page) const;
+
+    /**
+     * @brief 丢弃页面快照（页面的静态内容发生变化时调用）
+     */
+    void invalidate(uint16_t page);
+
+    // 丢弃所有快照
+    void clear();
+
+    size_t budget() const { return lru_.budget(); }
+    const CacheStats& stats() const { return lru_.stats(); }
+    void resetCounters() { lru_.resetCounters(); }
+
+    /**
+     * @brief 游程编码
+     * 控制字节c < 0x80时后跟c+1个原样字节；c >= 0x80时后跟1个字节，重复c-0x80+3次
+     * @param out 输出缓冲区；为nullptr时只计算编码后的字节数
+     * @return 编码后的字节数；capacity不够时返回0
+     */
+    static size_t encode(const uint8_t* in, size_t size, uint8_t* out, size_t capacity);
+
+    /**
+     * @brief 游程解码
+     * @param out 输出缓冲区；为nullptr时只校验格式和解码长度
+     * @return 输入格式错误或解码长度不等于size时返回false
+     */
+    static bool decode(const uint8_t* in, size_t in_size, uint8_t* out, size_t size);
+
+    // 最坏情况下编码结果的字节数
+    static size_t encodeBound(size_t size) { return size + size / 128 + 1; }
+
+private:
+    struct Key {
+        uint16_t page;
+        bool compressed;
+        size_t raw_size;
+    };
+
+    Key keys_[MAX_ENTRIES];   // 与slots_按下标对应
+    BudgetedLru::Slot slots_[MAX_ENTRIES];
+    BudgetedLru lru_;
+    bool compress_;
+
+    // 返回条目下标，未找到时返回-1
+    int16_t find(uint16_t page) const;
+};
+
+} // namespace MinimalUI
@@ -0,0 +1,120 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+
+// 编译期开关：未定义或为0时追踪宏展开为空，不产生任何代码
+#ifndef MINIMALUI_TRACE
+#define MINIMALUI_TRACE 0
+#endif
+
+namespace MinimalUI {
+namespace Trace {
+
+// 支持的最大核心数（ESP32为双核）
+constexpr uint8_t MAX_CORES = 2;
+
+// 每个核心的环形缓冲区记录数，必须为2的幂；写满后覆盖最旧的记录
+constexpr uint32_t RING_SIZE = 512;
+
+// 记录类型，对应Chrome trace的ph字段
+enum class Phase : uint8_t {
+    BEGIN,        // "B"：区间开始
+    END,          // "E"：区间结束
+    INSTANT,      // "i"：瞬时事件
+    ASYNC_BEGIN,  // "b"：跨任务/中断的异步区间开始，以id配对
+    ASYNC_END     // "e"
+};
+
+/**
+ * @brief 追踪记录
+ * name只保存指针，必须是字符串字面量或生命周期足够长的字符串
+ */
+struct Record {
+    uint32_t time_us;
+    const char* name;
+    uint32_t id;
+    uint32_t task;    // 记录所在的任务（导出为tid），中断中为核心号
+    Phase phase;
+    uint8_t core;
+};
+
+/**
+ * @brief 运行时开关，默认关闭
+ * 关闭时每个追踪点只有一次原子读取
+ */
+void enable(bool on);
+bool enabled();
+
+// 单调时钟（微秒）
+uint32_t now();
+
+/**
+ * @brief 写入一条记录
+ * 写入当前核心的环形缓冲区，只用一次原子加法分配位置，不加锁，可在中断中调用
+ */
+void record(const char* name, Phase phase, uint32_t id = 0);
+
+/**
+ * @brief 清空所有记录
+ */
+void clear();
+
+/**
+ * @brief 导出为Chrome trace JSON（chrome://tracing 或 Perfetto 可直接打开）
+ * 每个任务一行（tid），记录所在的核心放在args.core中。导出期间应暂停追踪，否则正在写入的记录可能不完整。
+ * 在目标板上传入stdout即通过串口输出，在主机上传入文件。
+ * @return 导出的记录数
+ */
+size_t dump(FILE* out);
+
+/**
+ * @brief 导出到文件
+ */
+bool dumpToFile(const char* path);
+
+/**
+ * @class Scope
+ * @brief 作用域区间：构造时记录开始，析构时记录结束
+ */
+class Scope {
+public:
+    explicit Scope(const char* name) : name_(enabled() ? name : nullptr) {
+        if (name_) {
+            record(name_, Phase::BEGIN);
+        }
+    }
+    ~Scope() {
+        if (name_) {
+            record(name_, Phase::END);
+        }
+    }
+    Scope(const Scope&) = delete;
+    Scope& operator=(const Scope&) = delete;
+
+private:
+    const char* name_;  // 开始时追踪关闭则为nullptr，结束时不再记录，保证配对
+};
+
+} // namespace Trace
+} // namespace MinimalUI
+
+#define MINIMALUI_TRACE_CONCAT_(a, b) a##b
+#define MINIMALUI_TRACE_CONCAT(a, b) MINIMALUI_TRACE_CONCAT_(a, b)
+
+#if MINIMALUI_TRACE
+#define MUI_TRACE_SCOPE(name) \
+    ::MinimalUI::Trace::Scope MINIMALUI_TRACE_CONCAT(mui_trace_scope_, __LINE__)(name)
+#define MUI_TRACE_INSTANT(name) \
+    do { if (::MinimalUI::Trace::enabled()) ::MinimalUI::Trace::record(name, ::MinimalUI::Trace::Phase::INSTANT); } while (0)
+#define MUI_TRACE_ASYNC_BEGIN(name, id) \
+    do { if (::MinimalUI::Trace::enabled()) ::MinimalUI::Trace::record(name, ::MinimalUI::Trace::Phase::ASYNC_BEGIN, id); } while (0)
+#define MUI_TRACE_ASYNC_END(name, id) \
+    do { if (::MinimalUI::Trace::enabled()) ::MinimalUI::Trace::record(name, ::MinimalUI::Trace::Phase::ASYNC_END, id); } while (0)
+#else
+#define MUI_TRACE_SCOPE(name) do {} while (0)
+#define MUI_TRACE_INSTANT(name) do {} while (0)
+#define MUI_TRACE_ASYNC_BEGIN(name, id) do { (void)(id); } while (0)
+#define MUI_TRACE_ASYNC_END(name, id) do { (void)(id); } while (0)
+#endif
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cstdint>
+
+namespace MinimalUI {
+
+// 图标设计网格：坐标以图标边长的1/256为单位（Q8），绘制时按像素尺寸缩放
+constexpr int16_t VECTOR_ICON_GRID = 256;
+
+/**
+ * @brief 矢量路径命令，在命令数组中后跟各自的参数
+ */
+enum class VectorOp : int16_t {
+    END = 0,    // 路径结束
+    MOVE = 1,   // x, y：开始新轮廓，上一个轮廓自动闭合
+    LINE = 2,   // x, y：直线到该点
+    QUAD = 3,   // cx, cy, x, y：二次贝塞尔曲线
+    ARC = 4,    // cx, cy, r, start_deg, end_deg：先直线连到弧起点再沿弧绘制，没有未闭合的轮廓时从弧起点开始；
+                // 角度以3点钟方向为0度、顺时针增加，end_deg < start_deg时逆时针
+    CLOSE = 5,  // 闭合当前轮廓
+};
+
+/**
+ * @brief 矢量图标
+ *
+ * 命令数组是int16_t序列，每条命令为操作码后跟参数，可放在flash中。
+ * 填充使用非零环绕规则：重叠的轮廓合并，镂空的轮廓需与外轮廓方向相反。
+ * 所有坐标应落在[0, VECTOR_ICON_GRID]内。
+ */
+struct VectorIcon {
+    const int16_t* commands;
+    uint16_t length;        // 命令数组的元素数
+};
+
+// 构造命令数组的辅助宏
+#define MUI_ICON_MOVE(x, y) static_cast<int16_t>(::MinimalUI::VectorOp::MOVE), (x), (y)
+#define MUI_ICON_LINE(x, y) static_cast<int16_t>(::MinimalUI::VectorOp::LINE), (x), (y)
+#define MUI_ICON_QUAD(cx, cy, x, y) static_cast<int16_t>(::MinimalUI::VectorOp::QUAD), (cx), (cy), (x), (y)
+#define MUI_ICON_ARC(cx, cy, r, start_deg, end_deg) \
+    static_cast<int16_t>(::MinimalUI::VectorOp::ARC), (cx), (cy), (r), (start_deg), (end_deg)
+#define MUI_ICON_CLOSE static_cast<int16_t>(::MinimalUI::VectorOp::CLOSE)
+#define MUI_ICON_END static_cast<int16_t>(::MinimalUI::VectorOp::END)
+
+// 内置图标
+extern const VectorIcon ICON_HOME;
+extern const VectorIcon ICON_CHECK;    // 圆圈中的对勾（镂空）
+extern const VectorIcon ICON_WIFI;
+extern const VectorIcon ICON_BELL;
+
+} // namespace MinimalUI
@@ -0,0 +1,166 @@
+#include "Animation.h"
+#include "FixedMath.h"
+
+namespace MinimalUI {
+
+using FixedMath::Q14_ONE;
+
+// Q14乘法
+static inline int32_t mulQ14(int32_t a, int32_t b) {
+    return static_cast<int32_t>((static_cast<int64_t>(a) * b) >> 14);
+}
+
+int32_t ease(Easing easing, int32_t t) {
+    if (t <= 0) {
+        return 0;
+    }
+    if (t >= Q14_ONE) {
+        return Q14_ONE;
+    }
+
+    switch (easing) {
+    case Easing::LINEAR:
+        return t;
+    case Easing::EASE_IN_QUAD:
+        return mulQ14(t, t);
+    case Easing::EASE_OUT_QUAD: {
+        int32_t u = Q14_ONE - t;
+        return Q14_ONE - mulQ14(u, u);
+    }
+    case Easing::EASE_IN_OUT_QUAD:
+        if (t < Q14_ONE / 2) {
+            return 2 * mulQ14(t, t);
+        } else {
+            int32_t u = Q14_ONE - t;
+            return Q14_ONE - 2 * mulQ14(u, u);
+        }
+    case Easing::EASE_IN_CUBIC:
+        return mulQ14(mulQ14(t, t), t);
+    case Easing::EASE_OUT_CUBIC: {
+        int32_t u = Q14_ONE - t;
+        return Q14_ONE - mulQ14(mulQ14(u, u), u);
+    }
+    case Easing::EASE_IN_OUT_CUBIC:
+        if (t < Q14_ONE / 2) {
+            return 4 * mulQ14(mulQ14(t, t), t);
+        } else {
+            int32_t u = Q14_ONE - t;
+            return Q14_ONE - 4 * mulQ14(mulQ14(u, u), u);
+        }
+    case Easing::EASE_IN_OUT_SINE: {
+        // (1 - cos(πt)) / 2，正弦表精度为1度，在表项之间线性插值
+        int32_t deg_q14 = t * 180;
+        int32_t deg = deg_q14 >> 14;
+        int32_t frac = deg_q14 & (Q14_ONE - 1);
+        int32_t c0 = FixedMath::cosQ14(deg);
+        int32_t c1 = FixedMath::cosQ14(deg + 1);
+        int32_t c = c0 + mulQ14(c1 - c0, frac);
+        return (Q14_ONE - c) / 2;
+    }
+    }
+    return t;
+}
+
+Color lerpColor(Color from, Color to, int32_t t) {
+    auto channel = [t](int32_t a, int32_t b) { return a + mulQ14(b - a, t); };
+    int32_t r = channel(from >> 11, to >> 11);
+    int32_t g = channel((from >> 5) & 0x3F, (to >> 5) & 0x3F);
+    int32_t b = channel(from & 0x1F, to & 0x1F);
+    return static_cast<Color>((r << 11) | (g << 5) | b);
+}
+
+int8_t Animator::start(Component* target, TweenProperty property, int32_t from, int32_t to,
+                       uint32_t duration_ms, Easing easing, uint32_t now_ms) {
+    if (!target) {
+        return -1;
+    }
+
+    int8_t slot = -1;
+    for (uint8_t i = 0; i < MAX_TWEENS; i++) {
+        if (tweens_[i].active && tweens_[i].target == target && tweens_[i].property == property) {
+            slot = static_cast<int8_t>(i);
+            active_count_--;
+            break;
+        }
+        if (!tweens_[i].active && slot < 0) {
+            slot = static_cast<int8_t>(i);
+        }
+    }
+    if (slot < 0) {
+        return -1;
+    }
+
+    tweens_[slot] = Tween{target, from, to, from, now_ms, duration_ms, property, easing, true};
+    active_count_++;
+    apply(target, property, from);
+    return slot;
+}
+
+void Animator::cancel(Component* target) {
+    for (Tween& tween : tweens_) {
+        if (tween.active && tween.target == target) {
+            tween.active = false;
+            active_count_--;
+        }
+    }
+}
+
+uint8_t Animator::update(uint32_t now_ms) {
+    for (Tween& tween : tweens_) {
+        if (!tween.active) {
+            continue;
+        }
+
+        // 无符号减法在时钟回绕时仍然正确
+        uint32_t elapsed = now_ms - tween.start_ms;
+        int32_t value = tween.to;
+        if (elapsed < tween.duration_ms) {
+            int32_t t = static_cast<int32_t>((static_cast<uint64_t>(elapsed) << 14) / tween.duration_ms);
+            int32_t progress = ease(tween.easing, t);
+            if (tween.property == TweenProperty::COLOR) {
+                value = lerpColor(static_cast<Color>(tween.from), static_cast<Color>(tween.to), progress);
+            } else {
+                value = tween.from + mulQ14(tween.to - tween.from, progress);
+            }
+        } else {
+            tween.active = false;
+            active_count_--;
+        }
+
+        // 值未变化时不写回，组件不会被标记为脏
+        if (value != tween.last) {
+            tween.last = value;
+            apply(tween.target, tween.property, value);
+        }
+    }
+    return active_count_;
+}
+
+bool Animator::isActive(int8_t handle) const {
+    return handle >= 0 && handle < MAX_TWEENS && tweens_[handle].active;
+}
+
+void Animator::apply(Component* target, TweenProperty property, int32_t value) {
+    switch (property) {
+    case TweenProperty::X:
+        target->setPosition(static_cast<int16_t>(value), target->getY());
+        break;
+    case TweenProperty::Y:
+        target->setPosition(target->getX(), static_cast<int16_t>(value));
+        break;
+    case TweenProperty::WIDTH:
+        target->setSize(static_cast<int16_t>(value), target->getHeight());
+        break;
+    case TweenProperty::HEIGHT:
+        target->setSize(target->getWidth(), static_cast<int16_t>(value));
+        break;
+    case TweenProperty::COLOR:
+        target->setColor(static_cast<Color>(value));
+        break;
+    case TweenProperty::VALUE:
+        target->setValue(value);
+        break;
+    }
+}
+
+} // namespace MinimalUI
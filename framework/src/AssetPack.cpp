@@ -0,0 +1,289 @@
+#include "AssetPack.h"
+#include "Trace.h"
+
+#ifdef ESP_PLATFORM
+#include <esp_log.h>
+#include <esp_partition.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace MinimalUI {
+
+#ifdef ESP_PLATFORM
+static const char* TAG = "AssetPack";
+#endif
+
+// 图像数据所需的最少字节数
+static size_t imageBytes(int16_t width, int16_t height, uint8_t format) {
+    if (width <= 0 || height <= 0) {
+        return 0;
+    }
+    switch (static_cast<PixelFormat>(format)) {
+        case PixelFormat::RGB565:
+            return static_cast<size_t>(width) * height * sizeof(Color);
+        case PixelFormat::MONO1:
+            return static_cast<size_t>((width + 7) / 8) * height;
+    }
+    return 0;
+}
+
+AssetPack::AssetPack()
+    : base_(nullptr), size_(0), index_(nullptr), count_(0), mapping_(0), map_length_(0), mapped_(false) {}
+
+AssetPack::~AssetPack() {
+    close();
+}
+
+bool AssetPack::validate(const uint8_t* data, size_t size) {
+    if (!data || (reinterpret_cast<uintptr_t>(data) & 3) != 0 || size < sizeof(AssetPackHeader)) {
+        return false;
+    }
+    const AssetPackHeader* header = reinterpret_cast<const AssetPackHeader*>(data);
+    if (header->magic != ASSET_PACK_MAGIC || header->version != ASSET_PACK_VERSION ||
+        header->byte_order != 0x1234 || header->total_size > size) {
+        return false;
+    }
+    const size_t total = header->total_size;
+    const uint64_t index_end =
+        static_cast<uint64_t>(header->index_offset) + static_cast<uint64_t>(header->asset_count) * sizeof(AssetEntry);
+    if ((header->index_offset & 3) != 0 || header->index_offset < sizeof(AssetPackHeader) || index_end > total ||
+        header->asset_count > 0xFFFF) {
+        return false;
+    }
+
+    const AssetEntry* index = reinterpret_cast<const AssetEntry*>(data + header->index_offset);
+    for (uint32_t id = 0; id < header->asset_count; id++) {
+        const AssetEntry& entry = index[id];
+        if (entry.type == AssetType::NONE) {
+            continue;
+        }
+        if ((entry.offset & 3) != 0 || static_cast<uint64_t>(entry.offset) + entry.size > total) {
+            return false;
+        }
+        if (entry.type == AssetType::IMAGE) {
+            const size_t needed = imageBytes(entry.width, entry.height, entry.format);
+            if (needed == 0 || entry.size < needed) {
+                return false;
+            }
+        } else if (entry.type == AssetType::FONT) {
+            if (entry.size < sizeof(AssetFontHeader)) {
+                return false;
+            }
+            const AssetFontHeader* font = reinterpret_cast<const AssetFontHeader*>(data + entry.offset);
+            // 字形按列存储，每列一个字节，高度不超过8
+            if (font->last < font->first || font->glyph_width == 0 || font->height == 0 || font->height > 8) {
+                return false;
+            }
+            const size_t glyphs = font->last - font->first + 1u;
+            size_t needed = sizeof(AssetFontHeader) + glyphs * font->glyph_width;
+            if (font->flags & AssetFontHeader::FONT_PROPORTIONAL) {
+                needed += glyphs;
+            }
+            if (entry.size < needed) {
+                return false;
+            }
+        } else if (entry.type == AssetType::GLYPHS) {
+            if (entry.size < sizeof(AssetGlyphHeader)) {
+                return false;
+            }
+            const AssetGlyphHeader* glyphs = reinterpret_cast<const AssetGlyphHeader*>(data + entry.offset);
+            if (glyphs->width == 0 || glyphs->height == 0 || glyphs->advance == 0) {
+                return false;
+            }
+            const uint64_t glyph_bytes = static_cast<uint64_t>((glyphs->height + 7) / 8) * glyphs->width;
+            const uint64_t needed = sizeof(AssetGlyphHeader) + glyphs->count * (sizeof(uint32_t) + glyph_bytes);
+            if (entry.size < needed) {
+                return false;
+            }
+            // 二分查找依赖码点表严格递增
+            const uint32_t* codepoints =
+                reinterpret_cast<const uint32_t*>(data + entry.offset + sizeof(AssetGlyphHeader));
+            for (uint32_t i = 1; i < glyphs->count; i++) {
+                if (codepoints[i] <= codepoints[i - 1]) {
+                    return false;
+                }
+            }
+        } else {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool AssetPack::attach(const uint8_t* data, size_t size) {
+    if (!validate(data, size)) {
+        return false;
+    }
+    const AssetPackHeader* header = reinterpret_cast<const AssetPackHeader*>(data);
+    base_ = data;
+    size_ = header->total_size;
+    index_ = reinterpret_cast<const AssetEntry*>(data + header->index_offset);
+    count_ = header->asset_count;
+    return true;
+}
+
+bool AssetPack::openMemory(const void* data, size_t size) {
+    close();
+    return attach(static_cast<const uint8_t*>(data), size);
+}
+
+#ifdef ESP_PLATFORM
+
+bool AssetPack::open(const char* name) {
+    MUI_TRACE_SCOPE("assets.open");
+    close();
+    const esp_partition_t* partition =
+        esp_partition_find_first(ESP_PARTITION_TYPE_DATA, ESP_PARTITION_SUBTYPE_ANY, name);
+    if (!partition) {
+        ESP_LOGW(TAG, "Partition '%s' not found", name);
+        return false;
+    }
+    // 先只映射文件头读出实际大小，再映射整个资源包，避免占用多余的MMU页
+    const void* header_ptr = nullptr;
+    esp_partition_mmap_handle_t handle;
+    if (esp_partition_mmap(partition, 0, sizeof(AssetPackHeader), ESP_PARTITION_MMAP_DATA, &header_ptr,
+                           &handle) != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to map partition '%s'", name);
+        return false;
+    }
+    uint32_t total = static_cast<const AssetPackHeader*>(header_ptr)->total_size;
+    esp_partition_munmap(handle);
+    if (total < sizeof(AssetPackHeader) || total > partition->size) {
+        ESP_LOGE(TAG, "Partition '%s' does not contain an asset pack", name);
+        return false;
+    }
+
+    const void* ptr = nullptr;
+    if (esp_partition_mmap(partition, 0, total, ESP_PARTITION_MMAP_DATA, &ptr, &handle) != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to map %u bytes of partition '%s'", static_cast<unsigned>(total), name);
+        return false;
+    }
+    if (!attach(static_cast<const uint8_t*>(ptr), total)) {
+        ESP_LOGE(TAG, "Invalid asset pack in partition '%s'", name);
+        esp_partition_munmap(handle);
+        return false;
+    }
+    mapping_ = handle;
+    mapped_ = true;
+    ESP_LOGI(TAG, "Mapped %u assets (%u bytes) from '%s'", static_cast<unsigned>(count_),
+             static_cast<unsigned>(total), name);
+    return true;
+}
+
+void AssetPack::close() {
+    if (mapped_) {
+        esp_partition_munmap(static_cast<esp_partition_mmap_handle_t>(mapping_));
+    }
+    base_ = nullptr;
+    size_ = 0;
+    index_ = nullptr;
+    count_ = 0;
+    mapping_ = 0;
+    mapped_ = false;
+}
+
+#else
+
+bool AssetPack::open(const char* name) {
+    MUI_TRACE_SCOPE("assets.open");
+    close();
+    const int fd = ::open(name, O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size < static_cast<off_t>(sizeof(AssetPackHeader))) {
+        ::close(fd);
+        return false;
+    }
+    const size_t length = static_cast<size_t>(st.st_size);
+    void* ptr = mmap(nullptr, length, PROT_READ, MAP_SHARED, fd, 0);
+    // 映射建立后文件描述符不再需要
+    ::close(fd);
+    if (ptr == MAP_FAILED) {
+        return false;
+    }
+    if (!attach(static_cast<const uint8_t*>(ptr), length)) {
+        munmap(ptr, length);
+        return false;
+    }
+    mapping_ = reinterpret_cast<uintptr_t>(ptr);
+    map_length_ = length;
+    mapped_ = true;
+    return true;
+}
+
+void AssetPack::close() {
+    if (mapped_) {
+        munmap(reinterpret_cast<void*>(mapping_), map_length_);
+    }
+    base_ = nullptr;
+    size_ = 0;
+    index_ = nullptr;
+    count_ = 0;
+    mapping_ = 0;
+    map_length_ = 0;
+    mapped_ = false;
+}
+
+#endif
+
+const AssetEntry* AssetPack::entry(uint16_t id) const {
+    if (id >= count_ || index_[id].type == AssetType::NONE) {
+        return nullptr;
+    }
+    return &index_[id];
+}
+
+bool AssetPack::font(uint16_t id, Font& out) const {
+    const AssetEntry* e = entry(id);
+    if (!e || e->type != AssetType::FONT) {
+        return false;
+    }
+    const uint8_t* data = base_ + e->offset;
+    const AssetFontHeader* header = reinterpret_cast<const AssetFontHeader*>(data);
+    const size_t glyphs = header->last - header->first + 1u;
+    out.bitmap = data + sizeof(AssetFontHeader);
+    out.spacing = (header->flags & AssetFontHeader::FONT_PROPORTIONAL) ? out.bitmap + glyphs * header->glyph_width
+                                                                       : nullptr;
+    out.first = header->first;
+    out.last = header->last;
+    out.glyph_width = header->glyph_width;
+    out.height = header->height;
+    out.gap = header->gap;
+    return true;
+}
+
+bool AssetPack::image(uint16_t id, Image& out) const {
+    const AssetEntry* e = entry(id);
+    if (!e || e->type != AssetType::IMAGE) {
+        return false;
+    }
+    out.width = e->width;
+    out.height = e->height;
+    out.format = static_cast<PixelFormat>(e->format);
+    out.data = base_ + e->offset;
+    return true;
+}
+
+bool AssetPack::glyphs(uint16_t id, GlyphSet& out) const {
+    const AssetEntry* e = entry(id);
+    if (!e || e->type != AssetType::GLYPHS) {
+        return false;
+    }
+    const uint8_t* data = base_ + e->offset;
+    const AssetGlyphHeader* header = reinterpret_cast<const AssetGlyphHeader*>(data);
+    out.codepoints = reinterpret_cast<const uint32_t*>(data + sizeof(AssetGlyphHeader));
+    out.bitmaps = data + sizeof(AssetGlyphHeader) + header->count * sizeof(uint32_t);
+    out.count = header->count;
+    out.width = header->width;
+    out.height = header->height;
+    out.advance = header->advance;
+    return true;
+}
+
+} // namespace MinimalUI
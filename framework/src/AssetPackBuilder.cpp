@@ -0,0 +1,176 @@
+#include "AssetPackBuilder.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+namespace MinimalUI {
+
+static size_t alignUp(size_t value) {
+    return (value + 3) & ~static_cast<size_t>(3);
+}
+
+int AssetPackBuilder::addFont(const Font& font) {
+    if (!font.bitmap || font.last < font.first || font.glyph_width == 0 || font.height == 0 || font.height > 8 ||
+        entries_.size() >= 0xFFFF) {
+        return -1;
+    }
+    const size_t glyphs = font.last - font.first + 1u;
+    const size_t bitmap_size = glyphs * font.glyph_width;
+
+    AssetFontHeader header{};
+    header.first = font.first;
+    header.last = font.last;
+    header.glyph_width = font.glyph_width;
+    header.height = font.height;
+    header.gap = font.gap;
+    header.flags = font.spacing ? AssetFontHeader::FONT_PROPORTIONAL : 0;
+
+    Pending pending{};
+    pending.data.resize(sizeof(header) + bitmap_size + (font.spacing ? glyphs : 0));
+    memcpy(pending.data.data(), &header, sizeof(header));
+    memcpy(pending.data.data() + sizeof(header), font.bitmap, bitmap_size);
+    if (font.spacing) {
+        memcpy(pending.data.data() + sizeof(header) + bitmap_size, font.spacing, glyphs);
+    }
+    pending.entry.type = AssetType::FONT;
+    pending.entry.width = font.glyph_width;
+    pending.entry.height = font.height;
+    entries_.push_back(std::move(pending));
+    return static_cast<int>(entries_.size() - 1);
+}
+
+int AssetPackBuilder::addImage(int16_t width, int16_t height, PixelFormat format, const void* data) {
+    if (!data || width <= 0 || height <= 0 || entries_.size() >= 0xFFFF) {
+        return -1;
+    }
+    size_t size = 0;
+    switch (format) {
+        case PixelFormat::RGB565:
+            size = static_cast<size_t>(width) * height * sizeof(Color);
+            break;
+        case PixelFormat::MONO1:
+            size = static_cast<size_t>((width + 7) / 8) * height;
+            break;
+    }
+    if (size == 0) {
+        return -1;
+    }
+
+    Pending pending{};
+    pending.data.assign(static_cast<const uint8_t*>(data), static_cast<const uint8_t*>(data) + size);
+    pending.entry.type = AssetType::IMAGE;
+    pending.entry.format = static_cast<uint8_t>(format);
+    pending.entry.width = width;
+    pending.entry.height = height;
+    entries_.push_back(std::move(pending));
+    return static_cast<int>(entries_.size() - 1);
+}
+
+int AssetPackBuilder::addGlyphs(const GlyphSource& source, const std::vector<uint32_t>& codepoints,
+                                std::vector<uint32_t>* missing) {
+    if (source.width() == 0 || source.height() == 0 || source.advance() == 0 || entries_.size() >= 0xFFFF) {
+        return -1;
+    }
+    std::vector<uint32_t> sorted(codepoints);
+    std::sort(sorted.begin(), sorted.end());
+    sorted.erase(std::unique(sorted.begin(), sorted.end()), sorted.end());
+
+    const size_t glyph_bytes = static_cast<size_t>((source.height() + 7) / 8) * source.width();
+    std::vector<uint32_t> found;
+    std::vector<uint8_t> bitmaps;
+    std::vector<uint8_t> glyph(glyph_bytes);
+    for (uint32_t codepoint : sorted) {
+        std::fill(glyph.begin(), glyph.end(), 0);
+        if (codepoint == 0 || !source.render(codepoint, glyph.data())) {
+            if (missing) {
+                missing->push_back(codepoint);
+            }
+            continue;
+        }
+        found.push_back(codepoint);
+        bitmaps.insert(bitmaps.end(), glyph.begin(), glyph.end());
+    }
+
+    AssetGlyphHeader header{};
+    header.count = static_cast<uint32_t>(found.size());
+    header.width = source.width();
+    header.height = source.height();
+    header.advance = source.advance();
+
+    Pending pending{};
+    pending.data.resize(sizeof(header) + found.size() * sizeof(uint32_t) + bitmaps.size());
+    uint8_t* out = pending.data.data();
+    memcpy(out, &header, sizeof(header));
+    if (!found.empty()) {
+        memcpy(out + sizeof(header), found.data(), found.size() * sizeof(uint32_t));
+        memcpy(out + sizeof(header) + found.size() * sizeof(uint32_t), bitmaps.data(), bitmaps.size());
+    }
+    pending.entry.type = AssetType::GLYPHS;
+    pending.entry.width = source.width();
+    pending.entry.height = source.height();
+    entries_.push_back(std::move(pending));
+    return static_cast<int>(entries_.size() - 1);
+}
+
+std::vector<uint32_t> AssetPackBuilder::collectCodepoints(const char* const* texts, size_t count) {
+    std::vector<uint32_t> codepoints;
+    for (size_t i = 0; i < count; i++) {
+        const char* text = texts[i];
+        if (!text) {
+            continue;
+        }
+        for (uint32_t codepoint = Font::nextCodepoint(text); codepoint != 0; codepoint = Font::nextCodepoint(text)) {
+            if (codepoint >= 0x80 && codepoint != Font::REPLACEMENT) {
+                codepoints.push_back(codepoint);
+            }
+        }
+    }
+    std::sort(codepoints.begin(), codepoints.end());
+    codepoints.erase(std::unique(codepoints.begin(), codepoints.end()), codepoints.end());
+    return codepoints;
+}
+
+std::vector<uint8_t> AssetPackBuilder::build() const {
+    AssetPackHeader header{};
+    header.magic = ASSET_PACK_MAGIC;
+    header.version = ASSET_PACK_VERSION;
+    header.byte_order = 0x1234;
+    header.asset_count = static_cast<uint32_t>(entries_.size());
+    header.index_offset = sizeof(AssetPackHeader);
+
+    // 先排列数据，每个资源起始于4字节对齐的偏移
+    std::vector<AssetEntry> index(entries_.size());
+    size_t offset = header.index_offset + entries_.size() * sizeof(AssetEntry);
+    for (size_t i = 0; i < entries_.size(); i++) {
+        offset = alignUp(offset);
+        index[i] = entries_[i].entry;
+        index[i].offset = static_cast<uint32_t>(offset);
+        index[i].size = static_cast<uint32_t>(entries_[i].data.size());
+        offset += entries_[i].data.size();
+    }
+    header.total_size = static_cast<uint32_t>(alignUp(offset));
+
+    std::vector<uint8_t> pack(header.total_size, 0);
+    memcpy(pack.data(), &header, sizeof(header));
+    if (!index.empty()) {
+        memcpy(pack.data() + header.index_offset, index.data(), index.size() * sizeof(AssetEntry));
+    }
+    for (size_t i = 0; i < entries_.size(); i++) {
+        if (!entries_[i].data.empty()) {
+            memcpy(pack.data() + index[i].offset, entries_[i].data.data(), entries_[i].data.size());
+        }
+    }
+    return pack;
+}
+
+bool AssetPackBuilder::write(const char* path) const {
+    const std::vector<uint8_t> pack = build();
+    FILE* out = fopen(path, "wb");
+    if (!out) {
+        return false;
+    }
+    const bool ok = fwrite(pack.data(), 1, pack.size(), out) == pack.size();
+    return fclose(out) == 0 && ok;
+}
+
+} // namespace MinimalUI
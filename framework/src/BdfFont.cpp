@@ -0,0 +1,160 @@
+#include "BdfFont.h"
+#include <cstdio>
+#include <cstring>
+#include <string>
+
+namespace MinimalUI {
+
+// 十六进制字符的值，无效时返回-1
+static int hexValue(char c) {
+    if (c >= '0' && c <= '9') {
+        return c - '0';
+    }
+    if (c >= 'A' && c <= 'F') {
+        return c - 'A' + 10;
+    }
+    if (c >= 'a' && c <= 'f') {
+        return c - 'a' + 10;
+    }
+    return -1;
+}
+
+static bool startsWith(const std::string& line, const char* keyword) {
+    const size_t length = strlen(keyword);
+    return line.compare(0, length, keyword) == 0 && (line.size() == length || line[length] == ' ');
+}
+
+bool BdfFont::load(const char* path) {
+    FILE* in = fopen(path, "rb");
+    if (!in) {
+        return false;
+    }
+    std::string text;
+    char buffer[4096];
+    size_t n;
+    while ((n = fread(buffer, 1, sizeof(buffer), in)) > 0) {
+        text.append(buffer, n);
+    }
+    fclose(in);
+    return parse(text.c_str());
+}
+
+bool BdfFont::parse(const char* text) {
+    glyphs_.clear();
+    width_ = height_ = advance_ = 0;
+    if (!text) {
+        return false;
+    }
+
+    int box_w = 0;
+    int box_h = 0;
+    int box_x = 0;
+    int box_y = 0;
+    int max_dwidth = 0;
+    bool in_char = false;
+    int encoding = -1;
+    int bitmap_rows = -1;   // 正在读取的BITMAP剩余行数，-1表示不在BITMAP中
+    Glyph glyph{};
+
+    const char* p = text;
+    while (*p) {
+        const char* end = strchr(p, '\n');
+        const size_t length = end ? static_cast<size_t>(end - p) : strlen(p);
+        std::string line(p, length);
+        p += length + (end ? 1 : 0);
+        if (!line.empty() && line.back() == '\r') {
+            line.pop_back();
+        }
+
+        if (bitmap_rows > 0) {
+            const size_t stride = static_cast<size_t>((glyph.width + 7) / 8);
+            for (size_t i = 0; i < stride; i++) {
+                const int high = 2 * i < line.size() ? hexValue(line[2 * i]) : 0;
+                const int low = 2 * i + 1 < line.size() ? hexValue(line[2 * i + 1]) : 0;
+                if (high < 0 || low < 0) {
+                    return false;
+                }
+                glyph.rows.push_back(static_cast<uint8_t>((high << 4) | low));
+            }
+            bitmap_rows--;
+            continue;
+        }
+
+        if (startsWith(line, "FONTBOUNDINGBOX")) {
+            if (sscanf(line.c_str(), "FONTBOUNDINGBOX %d %d %d %d", &box_w, &box_h, &box_x, &box_y) != 4) {
+                return false;
+            }
+        } else if (startsWith(line, "STARTCHAR")) {
+            in_char = true;
+            encoding = -1;
+            glyph = Glyph{};
+        } else if (in_char && startsWith(line, "ENCODING")) {
+            sscanf(line.c_str(), "ENCODING %d", &encoding);
+        } else if (in_char && startsWith(line, "DWIDTH")) {
+            int dwidth = 0;
+            sscanf(line.c_str(), "DWIDTH %d", &dwidth);
+            if (encoding >= 0 && dwidth > max_dwidth) {
+                max_dwidth = dwidth;
+            }
+        } else if (in_char && startsWith(line, "BBX")) {
+            int w, h, x, y;
+            if (sscanf(line.c_str(), "BBX %d %d %d %d", &w, &h, &x, &y) != 4 || w < 0 || h < 0) {
+                return false;
+            }
+            glyph.width = static_cast<int16_t>(w);
+            glyph.height = static_cast<int16_t>(h);
+            glyph.x_offset = static_cast<int16_t>(x);
+            glyph.y_offset = static_cast<int16_t>(y);
+        } else if (in_char && startsWith(line, "BITMAP")) {
+            bitmap_rows = glyph.height;
+        } else if (in_char && startsWith(line, "ENDCHAR")) {
+            if (glyph.rows.size() != static_cast<size_t>((glyph.width + 7) / 8) * glyph.height) {
+                return false;
+            }
+            if (encoding >= 0) {
+                glyphs_[static_cast<uint32_t>(encoding)] = glyph;
+            }
+            in_char = false;
+            bitmap_rows = -1;
+        }
+    }
+
+    if (box_w <= 0 || box_h <= 0 || box_w > 255 || box_h > 255 || glyphs_.empty()) {
+        glyphs_.clear();
+        return false;
+    }
+    width_ = static_cast<uint8_t>(box_w);
+    height_ = static_cast<uint8_t>(box_h);
+    x_offset_ = static_cast<int16_t>(box_x);
+    y_offset_ = static_cast<int16_t>(box_y);
+    advance_ = static_cast<uint8_t>(max_dwidth > 0 && max_dwidth <= 255 ? max_dwidth : box_w);
+    return true;
+}
+
+bool BdfFont::render(uint32_t codepoint, uint8_t* pages) const {
+    auto it = glyphs_.find(codepoint);
+    if (it == glyphs_.end()) {
+        return false;
+    }
+    const Glyph& glyph = it->second;
+    const size_t stride = static_cast<size_t>((glyph.width + 7) / 8);
+    // BDF的y轴向上：字形顶行在字符格中的位置由两者的上边界之差决定
+    const int top = (height_ + y_offset_) - (glyph.y_offset + glyph.height);
+    const int left = glyph.x_offset - x_offset_;
+    for (int row = 0; row < glyph.height; row++) {
+        const int y = top + row;
+        if (y < 0 || y >= height_) {
+            continue;
+        }
+        for (int col = 0; col < glyph.width; col++) {
+            const int x = left + col;
+            if (x < 0 || x >= width_ || !((glyph.rows[row * stride + col / 8] >> (7 - col % 8)) & 0x01)) {
+                continue;
+            }
+            pages[(y / 8) * width_ + x] |= static_cast<uint8_t>(1 << (y % 8));
+        }
+    }
+    return true;
+}
+
+} // namespace MinimalUI
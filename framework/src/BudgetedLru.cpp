@@ -0,0 +1,122 @@
+#include "BudgetedLru.h"
+#include <cstdlib>
+
+#ifdef ESP_PLATFORM
+#include <esp_heap_caps.h>
+#endif
+
+namespace MinimalUI {
+
+BudgetedLru::BudgetedLru(Slot* slots, uint8_t count, size_t budget)
+    : slots_(slots), count_(count), budget_(budget), clock_(0) {
+    for (uint8_t i = 0; i < count_; i++) {
+        slots_[i] = Slot{0, 0, nullptr};
+    }
+}
+
+BudgetedLru::~BudgetedLru() {
+    clear();
+}
+
+uint8_t* BudgetedLru::allocate(size_t size) {
+#ifdef ESP_PLATFORM
+    // 优先使用PSRAM，没有时退回内部RAM
+    void* data = heap_caps_malloc(size, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+    if (!data) {
+        data = heap_caps_malloc(size, MALLOC_CAP_8BIT);
+    }
+    return static_cast<uint8_t*>(data);
+#else
+    return static_cast<uint8_t*>(malloc(size));
+#endif
+}
+
+void BudgetedLru::deallocate(uint8_t* data) {
+#ifdef ESP_PLATFORM
+    heap_caps_free(data);
+#else
+    free(data);
+#endif
+}
+
+void BudgetedLru::release(uint8_t index) {
+    Slot& slot = slots_[index];
+    if (!slot.data) {
+        return;
+    }
+    stats_.used_bytes -= slot.bytes;
+    deallocate(slot.data);
+    slot.data = nullptr;
+}
+
+bool BudgetedLru::evictOldest() {
+    int16_t oldest = -1;
+    for (uint8_t i = 0; i < count_; i++) {
+        if (slots_[i].data &&
+            (oldest < 0 || static_cast<int32_t>(slots_[i].last_use - slots_[oldest].last_use) < 0)) {
+            oldest = i;
+        }
+    }
+    if (oldest < 0) {
+        return false;
+    }
+    release(static_cast<uint8_t>(oldest));
+    stats_.evictions++;
+    return true;
+}
+
+int16_t BudgetedLru::insert(size_t bytes) {
+    if (bytes == 0 || bytes > budget_) {
+        stats_.rejected++;
+        return -1;
+    }
+
+    // 按LRU淘汰，直到容量和条目都足够
+    int16_t index = -1;
+    for (;;) {
+        if (stats_.used_bytes + bytes <= budget_) {
+            for (uint8_t i = 0; i < count_; i++) {
+                if (!slots_[i].data) {
+                    index = i;
+                    break;
+                }
+            }
+            if (index >= 0) {
+                break;
+            }
+        }
+        if (!evictOldest()) {
+            break;
+        }
+    }
+    uint8_t* data = index >= 0 ? allocate(bytes) : nullptr;
+    if (!data) {
+        stats_.rejected++;
+        return -1;
+    }
+
+    slots_[index] = Slot{++clock_, bytes, data};
+    stats_.used_bytes += bytes;
+    stats_.stores++;
+    return index;
+}
+
+void BudgetedLru::cancel(uint8_t index) {
+    release(index);
+    stats_.stores--;
+    stats_.rejected++;
+}
+
+void BudgetedLru::clear() {
+    for (uint8_t i = 0; i < count_; i++) {
+        release(i);
+    }
+}
+
+void BudgetedLru::resetCounters() {
+    const size_t used = stats_.used_bytes;
+    stats_ = CacheStats{};
+    stats_.used_bytes = used;
+}
+
+} // namespace MinimalUI
@@ -0,0 +1,87 @@
+#include "BusArbiter.h"
+
+namespace MinimalUI {
+
+int8_t BusArbiter::registerDevice() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (uint8_t i = 0; i < MAX_DEVICES; i++) {
+        if (!registered_[i]) {
+            registered_[i] = true;
+            waiting_[i] = false;
+            return static_cast<int8_t>(i);
+        }
+    }
+    return -1;
+}
+
+void BusArbiter::unregisterDevice(int8_t id) {
+    if (id < 0 || id >= MAX_DEVICES) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    registered_[id] = false;
+    waiting_[id] = false;
+}
+
+void BusArbiter::acquire(int8_t id) {
+    if (id < 0 || id >= MAX_DEVICES) {
+        return;
+    }
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (!registered_[id]) {
+        return;  // 未注册的设备永远不会被轮询选中，等待会一直阻塞
+    }
+    if (owner_ == id) {
+        depth_++;  // 同一设备嵌套申请
+        return;
+    }
+
+    waiting_[id] = true;
+    if (owner_ < 0) {
+        grantNext();
+    }
+    cv_.wait(lock, [this, id] { return owner_ == id; });
+    depth_ = 1;
+}
+
+void BusArbiter::release(int8_t id) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (owner_ != id || depth_ == 0) {
+        return;
+    }
+    if (--depth_ > 0) {
+        return;
+    }
+
+    last_owner_ = owner_;
+    owner_ = -1;
+    grantNext();
+}
+
+int8_t BusArbiter::owner() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return owner_;
+}
+
+bool BusArbiter::waiting(int8_t id) const {
+    if (id < 0 || id >= MAX_DEVICES) {
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    return waiting_[id];
+}
+
+void BusArbiter::grantNext() {
+    // 从上一个持有者的下一个设备开始轮询，保证每个等待者最多等待一轮
+    for (uint8_t step = 1; step <= MAX_DEVICES; step++) {
+        uint8_t candidate = static_cast<uint8_t>((last_owner_ + step + MAX_DEVICES) % MAX_DEVICES);
+        if (registered_[candidate] && waiting_[candidate]) {
+            waiting_[candidate] = false;
+            owner_ = static_cast<int8_t>(candidate);
+            cv_.notify_all();
+            return;
+        }
+    }
+}
+
+} // namespace MinimalUI
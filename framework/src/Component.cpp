@@ -0,0 +1,54 @@
+#include "Component.h"
+
+namespace MinimalUI {
+
+Component::Component(int16_t x, int16_t y, int16_t width, int16_t height)
+    : x_(x), y_(y), width_(width), height_(height) {
+}
+
+void Component::setPosition(int16_t x, int16_t y) {
+    if (x == x_ && y == y_) {
+        return;
+    }
+    x_ = x;
+    y_ = y;
+    notifyGeometry();
+    invalidateLayout();
+}
+
+void Component::setSize(int16_t width, int16_t height) {
+    if (width == width_ && height == height_) {
+        return;
+    }
+    width_ = width;
+    height_ = height;
+    notifyGeometry();
+    invalidateLayout();
+}
+
+void Component::setBounds(const Rect& bounds) {
+    if (bounds.x == x_ && bounds.y == y_ && bounds.w == width_ && bounds.h == height_) {
+        return;
+    }
+    x_ = bounds.x;
+    y_ = bounds.y;
+    width_ = bounds.w;
+    height_ = bounds.h;
+    notifyGeometry();
+    invalidateLayout();
+}
+
+void Component::setVisible(bool visible) {
+    if (visible == visible_) {
+        return;
+    }
+    visible_ = visible;
+    notifyGeometry();
+    invalidateLayout();
+}
+
+bool Component::contains(int16_t x, int16_t y) const {
+    return bounds().contains(x, y);
+}
+
+} // namespace MinimalUI
@@ -0,0 +1,176 @@
+#include "Compositor.h"
+#include "PixelKernels.h"
+#include "Trace.h"
+
+namespace MinimalUI {
+
+// 两个矩形的包围盒，空矩形不参与
+static Rect unite(const Rect& a, const Rect& b) {
+    if (a.isEmpty()) {
+        return b;
+    }
+    if (b.isEmpty()) {
+        return a;
+    }
+    int16_t x = a.x < b.x ? a.x : b.x;
+    int16_t y = a.y < b.y ? a.y : b.y;
+    int16_t r = a.right() > b.right() ? a.right() : b.right();
+    int16_t bt = a.bottom() > b.bottom() ? a.bottom() : b.bottom();
+    return Rect{x, y, static_cast<int16_t>(r - x), static_cast<int16_t>(bt - y)};
+}
+
+Compositor::Compositor(Color background) : background_(background) {
+}
+
+int8_t Compositor::addLayer(const Layer& layer) {
+    for (uint8_t id = 0; id < MAX_LAYERS; id++) {
+        if (!used_[id]) {
+            used_[id] = true;
+            layers_[id] = layer;
+            order_[count_++] = id;
+            if (layer.visible) {
+                invalidate(layer.bounds());
+            }
+            return static_cast<int8_t>(id);
+        }
+    }
+    return -1;
+}
+
+void Compositor::removeLayer(int8_t id) {
+    if (!layer(id)) {
+        return;
+    }
+    if (layers_[id].visible) {
+        invalidate(layers_[id].bounds());
+    }
+    used_[id] = false;
+    uint8_t out = 0;
+    for (uint8_t i = 0; i < count_; i++) {
+        if (order_[i] != id) {
+            order_[out++] = order_[i];
+        }
+    }
+    count_ = out;
+}
+
+void Compositor::updateLayer(int8_t id, const Layer& layer) {
+    if (!this->layer(id)) {
+        return;
+    }
+    if (layers_[id].visible) {
+        invalidate(layers_[id].bounds());
+    }
+    layers_[id] = layer;
+    if (layer.visible) {
+        invalidate(layer.bounds());
+    }
+}
+
+void Compositor::moveLayer(int8_t id, int16_t x, int16_t y) {
+    if (!layer(id)) {
+        return;
+    }
+    Layer moved = layers_[id];
+    moved.x = x;
+    moved.y = y;
+    updateLayer(id, moved);
+}
+
+const Layer* Compositor::layer(int8_t id) const {
+    if (id < 0 || id >= MAX_LAYERS || !used_[id]) {
+        return nullptr;
+    }
+    return &layers_[id];
+}
+
+void Compositor::setBackground(Color color) {
+    background_ = color;
+    invalidate(Rect{0, 0, INT16_MAX, INT16_MAX});
+}
+
+void Compositor::invalidate(const Rect& rect) {
+    damage_ = unite(damage_, rect);
+}
+
+void Compositor::compose(Color* dst, const Rect& area) const {
+    for (int16_t row = 0; row < area.h; row++) {
+        PixelKernels::fill(dst + row * area.w, area.w, background_);
+    }
+    for (uint8_t i = 0; i < count_; i++) {
+        const Layer& layer = layers_[order_[i]];
+        if (layer.visible) {
+            composeLayer(dst, area, layer);
+        }
+    }
+}
+
+void Compositor::composeLayer(Color* dst, const Rect& area, const Layer& layer) const {
+    Rect part = layer.bounds().intersect(area);
+    if (part.isEmpty()) {
+        return;
+    }
+    if (layer.mode == BlendMode::ALPHA && layer.opacity == 0) {
+        return;
+    }
+
+    const int16_t src_x = part.x - layer.x;
+    for (int16_t row = 0; row < part.h; row++) {
+        Color* out = dst + (part.y - area.y + row) * area.w + (part.x - area.x);
+        const int32_t src_offset = static_cast<int32_t>(part.y - layer.y + row) * layer.w + src_x;
+
+        if (!layer.pixels) {
+            // 纯色图层
+            if (layer.mode == BlendMode::ALPHA && layer.opacity < 255) {
+                PixelKernels::blendFill(out, part.w, layer.color, layer.opacity);
+            } else {
+                PixelKernels::fill(out, part.w, layer.color);
+            }
+            continue;
+        }
+
+        const Color* src = layer.pixels + src_offset;
+        switch (layer.mode) {
+        case BlendMode::OPAQUE:
+            PixelKernels::copy(out, src, part.w);
+            break;
+        case BlendMode::COLOR_KEY:
+            PixelKernels::copyKeyed(out, src, part.w, layer.key);
+            break;
+        case BlendMode::ALPHA:
+            if (layer.alpha) {
+                PixelKernels::blendAlpha(out, src, layer.alpha + src_offset, part.w, layer.opacity);
+            } else {
+                PixelKernels::blend(out, src, part.w, layer.opacity);
+            }
+            break;
+        }
+    }
+}
+
+bool Compositor::render(GraphicsDriver& driver, Color* band, size_t band_pixels) {
+    MUI_TRACE_SCOPE("composite");
+    Rect area = damage_.intersect(driver.clipRect());
+    if (area.isEmpty()) {
+        damage_ = Rect{0, 0, 0, 0};
+        return true;
+    }
+    if (!band || band_pixels < static_cast<size_t>(area.w)) {
+        return false;
+    }
+
+    // 按条带从上到下合成并输出
+    size_t rows_fit = band_pixels / area.w;
+    const int16_t band_rows = rows_fit < static_cast<size_t>(area.h) ? static_cast<int16_t>(rows_fit) : area.h;
+    for (int16_t y = area.y; y < area.bottom(); y += band_rows) {
+        int16_t rows = area.bottom() - y < band_rows ? area.bottom() - y : band_rows;
+        MUI_TRACE_SCOPE("band");
+        Rect strip{area.x, y, area.w, rows};
+        compose(band, strip);
+        driver.drawBitmap(strip.x, strip.y, strip.w, strip.h, band);
+    }
+    damage_ = Rect{0, 0, 0, 0};
+    return true;
+}
+
+} // namespace MinimalUI
@@ -0,0 +1,106 @@
+#include "Dither.h"
+
+namespace MinimalUI {
+
+// 标准Bayer矩阵
+static const uint8_t BAYER8[8][8] = {
+    { 0, 32,  8, 40,  2, 34, 10, 42},
+    {48, 16, 56, 24, 50, 18, 58, 26},
+    {12, 44,  4, 36, 14, 46,  6, 38},
+    {60, 28, 52, 20, 62, 30, 54, 22},
+    { 3, 35, 11, 43,  1, 33,  9, 41},
+    {51, 19, 59, 27, 49, 17, 57, 25},
+    {15, 47,  7, 39, 13, 45,  5, 37},
+    {63, 31, 55, 23, 61, 29, 53, 21},
+};
+
+static const uint8_t BAYER4[4][4] = {
+    { 0,  8,  2, 10},
+    {12,  4, 14,  6},
+    { 3, 11,  1,  9},
+    {15,  7, 13,  5},
+};
+
+MonoDither::MonoDither(DitherMode mode) : mode_(mode), cached_color_(0), cache_valid_(false) {
+    setMode(mode);
+}
+
+void MonoDither::setMode(DitherMode mode) {
+    mode_ = mode;
+    // 阈值取每个灰度级区间的中点，纯黑全灭、纯白全亮
+    for (uint8_t row = 0; row < 8; row++) {
+        for (uint8_t col = 0; col < 8; col++) {
+            switch (mode) {
+            case DitherMode::THRESHOLD:
+                thresholds_[row][col] = 127;
+                break;
+            case DitherMode::BAYER4:
+                thresholds_[row][col] = static_cast<uint8_t>(BAYER4[row & 3][col & 3] * 16 + 8);
+                break;
+            case DitherMode::BAYER8:
+                thresholds_[row][col] = static_cast<uint8_t>(BAYER8[row][col] * 4 + 2);
+                break;
+            }
+        }
+    }
+    cache_valid_ = false;
+}
+
+const uint8_t* MonoDither::pattern(Color color) {
+    if (cache_valid_ && color == cached_color_) {
+        return cached_pattern_;
+    }
+
+    const uint8_t lum = luminance(color);
+    for (uint8_t col = 0; col < 8; col++) {
+        uint8_t bits = 0;
+        for (uint8_t row = 0; row < 8; row++) {
+            if (lum > thresholds_[row][col]) {
+                bits |= static_cast<uint8_t>(1 << row);
+            }
+        }
+        cached_pattern_[col] = bits;
+    }
+    cached_color_ = color;
+    cache_valid_ = true;
+    return cached_pattern_;
+}
+
+uint8_t MonoDither::pageByte(int16_t column, const uint8_t* lum) const {
+    const uint8_t col = column & 7;
+    uint8_t bits = 0;
+    for (uint8_t row = 0; row < 8; row++) {
+        if (lum[row] > thresholds_[row][col]) {
+            bits |= static_cast<uint8_t>(1 << row);
+        }
+    }
+    return bits;
+}
+
+uint8_t MonoDither::level2(uint8_t lum, int16_t x, int16_t row) const {
+    // lum * 3 / 255 的整数部分为基准级，小数部分与阈值比较决定是否进一级
+    uint32_t scaled = static_cast<uint32_t>(lum) * 3;
+    uint8_t level = static_cast<uint8_t>(scaled / 255);
+    uint8_t frac = static_cast<uint8_t>((scaled % 255) * 255 / 254);
+    if (level < 3 && frac > threshold(x, row)) {
+        level++;
+    }
+    return level;
+}
+
+void MonoDither::pattern2(Color color, uint8_t* lsb, uint8_t* msb) const {
+    const uint8_t lum = luminance(color);
+    for (uint8_t col = 0; col < 8; col++) {
+        uint8_t low = 0;
+        uint8_t high = 0;
+        for (uint8_t row = 0; row < 8; row++) {
+            uint8_t level = level2(lum, col, row);
+            low |= static_cast<uint8_t>((level & 0x01) << row);
+            high |= static_cast<uint8_t>(((level >> 1) & 0x01) << row);
+        }
+        lsb[col] = low;
+        msb[col] = high;
+    }
+}
+
+} // namespace MinimalUI
@@ -0,0 +1,159 @@
+#include "Font.h"
+
+namespace MinimalUI {
+
+uint32_t Font::nextCodepoint(const char*& text) {
+    const uint8_t lead = static_cast<uint8_t>(*text);
+    if (lead == 0) {
+        return 0;
+    }
+    text++;
+    if (lead < 0x80) {
+        return lead;
+    }
+
+    // 按首字节确定后续字节数和最小码点（拒绝过长编码）
+    uint8_t trailing;
+    uint32_t codepoint;
+    uint32_t minimum;
+    if (lead >= 0xC2 && lead <= 0xDF) {
+        trailing = 1;
+        codepoint = lead & 0x1F;
+        minimum = 0x80;
+    } else if (lead >= 0xE0 && lead <= 0xEF) {
+        trailing = 2;
+        codepoint = lead & 0x0F;
+        minimum = 0x800;
+    } else if (lead >= 0xF0 && lead <= 0xF4) {
+        trailing = 3;
+        codepoint = lead & 0x07;
+        minimum = 0x10000;
+    } else {
+        // 孤立的后续字节或无效首字节
+        return REPLACEMENT;
+    }
+
+    for (uint8_t i = 0; i < trailing; i++) {
+        const uint8_t byte = static_cast<uint8_t>(*text);
+        if ((byte & 0xC0) != 0x80) {
+            // 序列被截断，下一个字节留给下次解码
+            return REPLACEMENT;
+        }
+        codepoint = (codepoint << 6) | (byte & 0x3F);
+        text++;
+    }
+    if (codepoint < minimum || codepoint > 0x10FFFF || (codepoint >= 0xD800 && codepoint <= 0xDFFF)) {
+        return REPLACEMENT;
+    }
+    return codepoint;
+}
+
+uint8_t Font::codeFor(uint32_t codepoint) {
+    if (codepoint < 0x80) {
+        return static_cast<uint8_t>(codepoint);
+    }
+    return codepoint == 0xB0 ? DEGREE : '?';
+}
+
+uint8_t Font::nextCode(const char*& text) {
+    return codeFor(nextCodepoint(text));
+}
+
+int32_t GlyphSet::find(uint32_t codepoint) const {
+    uint32_t low = 0;
+    uint32_t high = count;
+    while (low < high) {
+        const uint32_t mid = low + (high - low) / 2;
+        if (codepoints[mid] < codepoint) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    return (low < count && codepoints[low] == codepoint) ? static_cast<int32_t>(low) : -1;
+}
+
+const uint8_t* Font::columns(uint8_t code, uint8_t& count) const {
+    if (!hasGlyph(code)) {
+        code = '?';
+    }
+    const uint8_t* glyph = bitmap + (code - first) * glyph_width;
+    if (!spacing) {
+        count = glyph_width;
+        return glyph;
+    }
+    uint8_t packed = spacing[code - first];
+    count = packed & 0x0F;
+    return glyph + (packed >> 4);
+}
+
+uint8_t Font::advance(uint8_t code) const {
+    uint8_t count;
+    columns(code, count);
+    return count + gap;
+}
+
+uint8_t Font::digitAdvance() const {
+    uint8_t widest = 0;
+    for (uint8_t code = '0'; code <= '9'; code++) {
+        uint8_t adv = advance(code);
+        if (adv > widest) {
+            widest = adv;
+        }
+    }
+    return widest;
+}
+
+int16_t measureText(const Font& font, const char* text, uint8_t size, bool tabular_digits, const GlyphSet* glyphs) {
+    if (!text) {
+        return 0;
+    }
+    const uint8_t digit_advance = tabular_digits ? font.digitAdvance() : 0;
+    int16_t width = 0;
+    for (uint32_t codepoint = Font::nextCodepoint(text); codepoint != 0; codepoint = Font::nextCodepoint(text)) {
+        if (codepoint >= 0x80 && glyphs && glyphs->find(codepoint) >= 0) {
+            width += glyphs->advance * size;
+            continue;
+        }
+        const uint8_t code = Font::codeFor(codepoint);
+        bool digit = tabular_digits && code >= '0' && code <= '9';
+        width += (digit ? digit_advance : font.advance(code)) * size;
+    }
+    return width;
+}
+
+int16_t TextMeasureCache::measure(const Font& font, const char* text, uint8_t size, bool tabular_digits,
+                                  const GlyphSet* glyphs, uint32_t generation) {
+    if (!text) {
+        return 0;
+    }
+
+    // FNV-1a哈希，同时记录长度以降低碰撞概率
+    uint32_t hash = 2166136261u;
+    uint16_t length = 0;
+    for (const char* p = text; *p; p++, length++) {
+        hash = (hash ^ static_cast<uint8_t>(*p)) * 16777619u;
+    }
+    const uint8_t flags = static_cast<uint8_t>((size << 1) | (tabular_digits ? 1 : 0));
+
+    for (const Entry& entry : entries_) {
+        if (entry.font == &font && entry.glyphs == glyphs && entry.generation == generation && entry.hash == hash &&
+            entry.length == length && entry.flags == flags) {
+            return entry.width;
+        }
+    }
+
+    int16_t width = measureText(font, text, size, tabular_digits, glyphs);
+    entries_[next_] = Entry{&font, glyphs, generation, hash, length, flags, width};
+    next_ = static_cast<uint8_t>((next_ + 1) % ENTRY_COUNT);
+    return width;
+}
+
+void TextMeasureCache::clear() {
+    for (Entry& entry : entries_) {
+        entry.font = nullptr;
+    }
+    next_ = 0;
+}
+
+} // namespace MinimalUI
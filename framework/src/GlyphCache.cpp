@@ -0,0 +1,173 @@
+#include "GlyphCache.h"
+#include "Trace.h"
+#include <cstring>
+
+namespace MinimalUI {
+
+// 按页存储的字形中(col, row)处的像素
+static inline bool glyphPixel(const uint8_t* glyph, uint8_t width, int16_t col, int16_t row) {
+    return (glyph[(row / 8) * width + col] >> (row % 8)) & 0x01;
+}
+
+GlyphCache::GlyphCache() : glyphs_{nullptr, nullptr, 0, 0, 0, 0}, generation_(0), clock_(0) {
+    clear();
+}
+
+GlyphCache::GlyphCache(const GlyphSet& glyphs) : glyphs_(glyphs), generation_(0), clock_(0) {
+    clear();
+}
+
+void GlyphCache::setGlyphs(const GlyphSet& glyphs) {
+    glyphs_ = glyphs;
+    generation_++;
+    clear();
+}
+
+void GlyphCache::clear() {
+    for (Entry& entry : entries_) {
+        entry.codepoint = 0;
+    }
+}
+
+bool GlyphCache::fits() const {
+    return glyphs_.advance <= MAX_GLYPH_SIZE && glyphs_.height <= MAX_GLYPH_SIZE;
+}
+
+GlyphCache::Entry* GlyphCache::find(uint32_t codepoint, Color color, Color bg) {
+    for (Entry& entry : entries_) {
+        if (entry.codepoint == codepoint && entry.color == color && entry.bg == bg) {
+            return &entry;
+        }
+    }
+    return nullptr;
+}
+
+GlyphCache::Entry& GlyphCache::victim() {
+    Entry* oldest = &entries_[0];
+    for (Entry& entry : entries_) {
+        if (entry.codepoint == 0) {
+            return entry;
+        }
+        if (static_cast<int32_t>(entry.last_use - oldest->last_use) < 0) {
+            oldest = &entry;
+        }
+    }
+    stats_.evictions++;
+    return *oldest;
+}
+
+bool GlyphCache::hasGlyph(uint32_t codepoint) const {
+    if (codepoint == 0 || glyphs_.isEmpty()) {
+        return false;
+    }
+    for (const Entry& entry : entries_) {
+        if (entry.codepoint == codepoint) {
+            return true;
+        }
+    }
+    return glyphs_.find(codepoint) >= 0;
+}
+
+void GlyphCache::render(const uint8_t* glyph, Color color, Color bg, uint8_t* data) const {
+    const int16_t w = glyphs_.advance;
+    const int16_t h = glyphs_.height;
+    const int16_t ink_w = glyphs_.width < w ? glyphs_.width : w;
+    if (color == bg) {
+        const int16_t stride = static_cast<int16_t>((w + 7) / 8);
+        memset(data, 0, static_cast<size_t>(stride) * h);
+        for (int16_t row = 0; row < h; row++) {
+            uint8_t* bits = data + row * stride;
+            for (int16_t col = 0; col < ink_w; col++) {
+                if (glyphPixel(glyph, glyphs_.width, col, row)) {
+                    bits[col / 8] |= static_cast<uint8_t>(0x80 >> (col % 8));
+                }
+            }
+        }
+        return;
+    }
+    Color* pixels = reinterpret_cast<Color*>(data);
+    for (int16_t row = 0; row < h; row++) {
+        for (int16_t col = 0; col < w; col++) {
+            pixels[row * w + col] = (col < ink_w && glyphPixel(glyph, glyphs_.width, col, row)) ? color : bg;
+        }
+    }
+}
+
+bool GlyphCache::lookup(uint32_t codepoint, Color color, Color bg, Image& image) {
+    if (codepoint == 0 || glyphs_.isEmpty() || !fits()) {
+        return false;
+    }
+    image = Image{glyphs_.advance, glyphs_.height, color == bg ? PixelFormat::MONO1 : PixelFormat::RGB565, nullptr};
+
+    if (Entry* hit = find(codepoint, color, bg)) {
+        hit->last_use = ++clock_;
+        stats_.hits++;
+        image.data = hit->data;
+        return true;
+    }
+
+    const int32_t index = glyphs_.find(codepoint);
+    if (index < 0) {
+        return false;
+    }
+    MUI_TRACE_SCOPE("glyph.load");
+    stats_.misses++;
+    stats_.stores++;
+    Entry& entry = victim();
+    render(glyphs_.glyph(static_cast<uint32_t>(index)), color, bg, entry.data);
+    entry.codepoint = codepoint;
+    entry.color = color;
+    entry.bg = bg;
+    entry.last_use = ++clock_;
+    image.data = entry.data;
+    return true;
+}
+
+void GlyphCache::drawScaled(GraphicsDriver& driver, int16_t x, int16_t y, const uint8_t* glyph, Color color,
+                            Color bg, uint8_t size) const {
+    const int16_t w = glyphs_.advance;
+    const int16_t ink_w = glyphs_.width < w ? glyphs_.width : w;
+    const bool opaque = (bg != color);
+    for (int16_t row = 0; row < glyphs_.height; row++) {
+        // 把一行像素按颜色分段，每段一次fillRect
+        int16_t run_start = 0;
+        bool run_on = ink_w > 0 && glyphPixel(glyph, glyphs_.width, 0, row);
+        for (int16_t col = 1; col <= w; col++) {
+            const bool on = col < ink_w && glyphPixel(glyph, glyphs_.width, col, row);
+            if (col < w && on == run_on) {
+                continue;
+            }
+            if (run_on || opaque) {
+                driver.fillRect(x + run_start * size, y + row * size, (col - run_start) * size, size,
+                                run_on ? color : bg);
+            }
+            run_start = col;
+            run_on = on;
+        }
+    }
+}
+
+bool GlyphCache::draw(GraphicsDriver& driver, int16_t x, int16_t y, uint32_t codepoint, Color color, Color bg,
+                      uint8_t size) {
+    if (size == 0) {
+        return hasGlyph(codepoint);
+    }
+    if (size == 1 && fits()) {
+        Image image;
+        if (!lookup(codepoint, color, bg, image)) {
+            return false;
+        }
+        driver.drawImage(x, y, image, color, bg);
+        return true;
+    }
+
+    const int32_t index = (codepoint != 0 && !glyphs_.isEmpty()) ? glyphs_.find(codepoint) : -1;
+    if (index < 0) {
+        return false;
+    }
+    stats_.rejected++;
+    drawScaled(driver, x, y, glyphs_.glyph(static_cast<uint32_t>(index)), color, bg, size);
+    return true;
+}
+
+} // namespace MinimalUI
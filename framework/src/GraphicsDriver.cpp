@@ -0,0 +1,281 @@
+#include "GraphicsDriver.h"
+#include "GlyphCache.h"
+#include "Rasterizer.h"
+#include "Animation.h"
+#include <cstdlib>
+
+namespace MinimalUI {
+
+bool GraphicsDriver::pushClip(const Rect& rect) {
+    if (clip_depth_ >= MAX_CLIP_DEPTH) {
+        return false;
+    }
+    // 栈中保存的是与上一层的交集，查询时无需逐层求交
+    clip_stack_[clip_depth_] = clip_depth_ > 0 ? rect.intersect(clip_stack_[clip_depth_ - 1]) : rect;
+    clip_depth_++;
+    return true;
+}
+
+void GraphicsDriver::popClip() {
+    if (clip_depth_ > 0) {
+        clip_depth_--;
+    }
+}
+
+Rect GraphicsDriver::clipRect() const {
+    Rect screen{0, 0, width(), height()};
+    return clip_depth_ > 0 ? clip_stack_[clip_depth_ - 1].intersect(screen) : screen;
+}
+
+bool GraphicsDriver::clipToCurrent(int16_t& x, int16_t& y, int16_t& w, int16_t& h) const {
+    if (w <= 0 || h <= 0) {
+        return false;
+    }
+    Rect clipped = Rect{x, y, w, h}.intersect(clipRect());
+    if (clipped.isEmpty()) {
+        return false;
+    }
+    x = clipped.x;
+    y = clipped.y;
+    w = clipped.w;
+    h = clipped.h;
+    return true;
+}
+
+void GraphicsDriver::drawLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, Color color) {
+    // 水平线和垂直线交给驱动一次写完
+    if (x0 == x1) {
+        drawVLine(x0, y0 < y1 ? y0 : y1, static_cast<int16_t>(std::abs(y1 - y0) + 1), color);
+        return;
+    }
+    if (y0 == y1) {
+        drawHLine(x0 < x1 ? x0 : x1, y0, static_cast<int16_t>(std::abs(x1 - x0) + 1), color);
+        return;
+    }
+    Rasterizer(*this, clipRect()).drawLine(x0, y0, x1, y1, color);
+}
+
+void GraphicsDriver::drawCircle(int16_t x0, int16_t y0, int16_t r, Color color) {
+    Rasterizer(*this, clipRect()).drawCircle(x0, y0, r, color);
+}
+
+void GraphicsDriver::fillEllipse(int16_t x0, int16_t y0, int16_t rx, int16_t ry, Color color) {
+    Rasterizer(*this, clipRect()).fillEllipse(x0, y0, rx, ry, color);
+}
+
+void GraphicsDriver::fillRoundRect(int16_t x, int16_t y, int16_t w, int16_t h, int16_t r, Color color) {
+    Rasterizer(*this, clipRect()).fillRoundRect(x, y, w, h, r, color);
+}
+
+void GraphicsDriver::fillTriangle(int16_t x0, int16_t y0, int16_t x1, int16_t y1,
+                                  int16_t x2, int16_t y2, Color color) {
+    Rasterizer(*this, clipRect()).fillTriangle(x0, y0, x1, y1, x2, y2, color);
+}
+
+void GraphicsDriver::fillPolygon(const Point* points, uint8_t count, Color color) {
+    Rasterizer(*this, clipRect()).fillConvexPolygon(points, count, color);
+}
+
+void GraphicsDriver::fillArc(int16_t x0, int16_t y0, int16_t r_outer, int16_t r_inner,
+                             int16_t start_deg, int16_t end_deg, Color color) {
+    Rasterizer(*this, clipRect()).fillArc(x0, y0, r_outer, r_inner, start_deg, end_deg, color);
+}
+
+bool GraphicsDriver::drawIcon(int16_t x, int16_t y, const VectorIcon& icon, int16_t size, Color color) {
+    return Rasterizer(*this, clipRect()).fillIcon(icon, x, y, size, color);
+}
+
+void GraphicsDriver::fillGradient(int16_t x, int16_t y, int16_t w, int16_t h, Color c0, Color c1, bool vertical) {
+    if (w <= 0 || h <= 0) {
+        return;
+    }
+    const int16_t steps = vertical ? h : w;
+    for (int16_t i = 0; i < steps; i++) {
+        int32_t t = steps > 1 ? (static_cast<int32_t>(i) << 14) / (steps - 1) : 0;
+        Color color = lerpColor(c0, c1, t);
+        if (vertical) {
+            fillRect(x, y + i, w, 1, color);
+        } else {
+            fillRect(x + i, y, 1, h, color);
+        }
+    }
+}
+
+void GraphicsDriver::drawBitmap(int16_t x, int16_t y, int16_t w, int16_t h, const Color* pixels) {
+    if (!pixels || w <= 0 || h <= 0) {
+        return;
+    }
+    for (int16_t row = 0; row < h; row++) {
+        const Color* line = pixels + static_cast<int32_t>(row) * w;
+        int16_t run_start = 0;
+        for (int16_t col = 1; col <= w; col++) {
+            if (col < w && line[col] == line[run_start]) {
+                continue;
+            }
+            fillRect(x + run_start, y + row, col - run_start, 1, line[run_start]);
+            run_start = col;
+        }
+    }
+}
+
+void GraphicsDriver::drawImage(int16_t x, int16_t y, const Image& image, Color color, Color bg) {
+    if (!image.data || image.width <= 0 || image.height <= 0) {
+        return;
+    }
+    if (image.format == PixelFormat::RGB565) {
+        drawBitmap(x, y, image.width, image.height, reinterpret_cast<const Color*>(image.data));
+        return;
+    }
+
+    // MONO1：按行把相同的位合并为一次fillRect
+    const bool opaque = (bg != color);
+    const int16_t stride = static_cast<int16_t>((image.width + 7) / 8);
+    for (int16_t row = 0; row < image.height; row++) {
+        const uint8_t* line = image.data + static_cast<int32_t>(row) * stride;
+        int16_t run_start = 0;
+        bool run_on = (line[0] & 0x80) != 0;
+        for (int16_t col = 1; col <= image.width; col++) {
+            const bool on = col < image.width && ((line[col >> 3] >> (7 - (col & 7))) & 0x01);
+            if (col < image.width && on == run_on) {
+                continue;
+            }
+            if (run_on || opaque) {
+                fillRect(x + run_start, y + row, col - run_start, 1, run_on ? color : bg);
+            }
+            run_start = col;
+            run_on = on;
+        }
+    }
+}
+
+void GraphicsDriver::drawChar(int16_t x, int16_t y, char c, Color color, Color bg, uint8_t size) {
+    uint8_t code = static_cast<uint8_t>(c);
+    drawGlyph(x, y, code, font_->advance(code), color, bg, size);
+}
+
+void GraphicsDriver::drawGlyph(int16_t x, int16_t y, uint8_t code, uint8_t cell_w,
+                               Color color, Color bg, uint8_t size) {
+    if (size == 0) {
+        return;
+    }
+    uint8_t ink_count;
+    const uint8_t* ink = font_->columns(code, ink_count);
+    const uint8_t advance = ink_count + font_->gap;
+    if (cell_w < advance) {
+        cell_w = advance;
+    }
+
+    const int16_t height = font_->height;
+    Rect cell{x, y, static_cast<int16_t>(cell_w * size), static_cast<int16_t>(height * size)};
+    if (cell.intersect(clipRect()).isEmpty()) {
+        return;
+    }
+
+    // 墨迹在字符格内居中，剩余空白（包括字间距）位于两侧
+    const bool opaque = (bg != color);
+    const uint8_t ink_x = (cell_w - ink_count) / 2;
+    for (int16_t row = 0; row < height; row++) {
+        // 把一行像素按颜色分段，每段一次fillRect
+        int16_t run_start = 0;
+        bool run_on = false;
+        for (int16_t col = 0; col <= cell_w; col++) {
+            bool on = false;
+            if (col < cell_w && col >= ink_x && col < ink_x + ink_count) {
+                on = (ink[col - ink_x] >> row) & 0x01;
+            }
+            if (col < cell_w && (col == 0 || on == run_on)) {
+                run_on = on;
+                continue;
+            }
+            if (run_on || opaque) {
+                fillRect(x + run_start * size, y + row * size, (col - run_start) * size, size,
+                         run_on ? color : bg);
+            }
+            run_start = col;
+            run_on = on;
+        }
+    }
+}
+
+void GraphicsDriver::drawCodepoint(int16_t x, int16_t y, uint32_t codepoint, uint8_t cell_w,
+                                   Color color, Color bg, uint8_t size) {
+    if (size == 0) {
+        return;
+    }
+    const bool opaque = (bg != color);
+    const uint8_t line_h = lineHeight();
+
+    if (codepoint >= 0x80 && glyphs_) {
+        const uint8_t advance = glyphs_->advance();
+        if (cell_w < advance) {
+            cell_w = advance;
+        }
+        const int16_t left = static_cast<int16_t>((cell_w - advance) / 2 * size);
+        if (glyphs_->draw(*this, x + left, y, codepoint, color, bg, size)) {
+            if (opaque) {
+                // 字形之外的字符格部分
+                const int16_t right = static_cast<int16_t>(left + advance * size);
+                const int16_t glyph_h = static_cast<int16_t>(glyphs_->height() * size);
+                if (left > 0) {
+                    fillRect(x, y, left, glyph_h, bg);
+                }
+                if (cell_w * size > right) {
+                    fillRect(x + right, y, cell_w * size - right, glyph_h, bg);
+                }
+                if (line_h * size > glyph_h) {
+                    fillRect(x, y + glyph_h, cell_w * size, line_h * size - glyph_h, bg);
+                }
+            }
+            return;
+        }
+    }
+
+    const uint8_t code = Font::codeFor(codepoint);
+    drawGlyph(x, y, code, cell_w, color, bg, size);
+    if (opaque && line_h > font_->height) {
+        const uint8_t advance = font_->advance(code);
+        fillRect(x, y + font_->height * size, (cell_w > advance ? cell_w : advance) * size,
+                 (line_h - font_->height) * size, bg);
+    }
+}
+
+int16_t GraphicsDriver::drawText(int16_t x, int16_t y, const char* text, Color color, Color bg, uint8_t size) {
+    if (!text) {
+        return x;
+    }
+    for (uint32_t codepoint = Font::nextCodepoint(text); codepoint != 0; codepoint = Font::nextCodepoint(text)) {
+        uint8_t advance = codepointAdvance(codepoint);
+        drawCodepoint(x, y, codepoint, advance, color, bg, size);
+        x += advance * size;
+    }
+    return x;
+}
+
+int16_t GraphicsDriver::measureText(const char* text, uint8_t size, bool tabular_digits) {
+    if (!glyphs_) {
+        return measure_cache_.measure(*font_, text, size, tabular_digits);
+    }
+    // 字形集的地址在setGlyphs()后不变，由版本区分
+    return measure_cache_.measure(*font_, text, size, tabular_digits, &glyphs_->glyphs(), glyphs_->generation());
+}
+
+uint8_t GraphicsDriver::codepointAdvance(uint32_t codepoint) const {
+    if (codepoint >= 0x80 && glyphs_ && glyphs_->hasGlyph(codepoint)) {
+        return glyphs_->advance();
+    }
+    return font_->advance(Font::codeFor(codepoint));
+}
+
+uint8_t GraphicsDriver::lineHeight() const {
+    if (glyphs_ && !glyphs_->glyphs().isEmpty() && glyphs_->height() > font_->height) {
+        return glyphs_->height();
+    }
+    return font_->height;
+}
+
+void GraphicsDriver::setGlyphCache(GlyphCache* cache) {
+    glyphs_ = cache;
+    measure_cache_.clear();
+}
+
+} // namespace MinimalUI
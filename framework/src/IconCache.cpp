@@ -0,0 +1,152 @@
+#include "IconCache.h"
+#include "Rasterizer.h"
+#include "Trace.h"
+#include <cstring>
+
+namespace MinimalUI {
+
+namespace {
+
+// 把扫描段写入RGB565位图
+class BitmapSink : public SpanSink {
+public:
+    BitmapSink(Color* pixels, int16_t stride) : pixels_(pixels), stride_(stride) {}
+
+    void fillSpan(int16_t x, int16_t y, int16_t w, Color color) override {
+        Color* dst = pixels_ + static_cast<int32_t>(y) * stride_ + x;
+        for (int16_t i = 0; i < w; i++) {
+            dst[i] = color;
+        }
+    }
+
+private:
+    Color* pixels_;
+    int16_t stride_;
+};
+
+// 把扫描段写入MONO1掩码（字节高位为左侧像素）
+class MaskSink : public SpanSink {
+public:
+    MaskSink(uint8_t* bits, int16_t stride) : bits_(bits), stride_(stride) {}
+
+    void fillSpan(int16_t x, int16_t y, int16_t w, Color /*color*/) override {
+        uint8_t* row = bits_ + static_cast<int32_t>(y) * stride_;
+        for (int16_t i = x; i < x + w; i++) {
+            row[i / 8] |= static_cast<uint8_t>(0x80 >> (i % 8));
+        }
+    }
+
+private:
+    uint8_t* bits_;
+    int16_t stride_;
+};
+
+} // namespace
+
+IconCache::IconCache(size_t budget)
+    : lru_(slots_, MAX_ENTRIES, budget), rejected_icon_(nullptr), rejected_size_(0) {
+    for (Key& key : keys_) {
+        key = Key{nullptr, 0, 0, 0};
+    }
+}
+
+size_t IconCache::bitmapSize(int16_t size, bool transparent) {
+    if (size <= 0) {
+        return 0;
+    }
+    if (transparent) {
+        return static_cast<size_t>((size + 7) / 8) * size;
+    }
+    return static_cast<size_t>(size) * size * sizeof(Color);
+}
+
+int16_t IconCache::find(const VectorIcon& icon, int16_t size, Color color, Color bg) const {
+    for (uint8_t i = 0; i < MAX_ENTRIES; i++) {
+        const Key& key = keys_[i];
+        if (lru_.occupied(i) && key.icon == &icon && key.size == size && key.color == color && key.bg == bg) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+bool IconCache::render(const VectorIcon& icon, int16_t size, Color color, Color bg, uint8_t* data) {
+    const Rect bounds{0, 0, size, size};
+    if (color == bg) {
+        memset(data, 0, bitmapSize(size, true));
+        MaskSink sink(data, static_cast<int16_t>((size + 7) / 8));
+        return Rasterizer(sink, bounds).fillIcon(icon, 0, 0, size, color);
+    }
+    Color* pixels = reinterpret_cast<Color*>(data);
+    for (int32_t i = 0; i < static_cast<int32_t>(size) * size; i++) {
+        pixels[i] = bg;
+    }
+    BitmapSink sink(pixels, size);
+    return Rasterizer(sink, bounds).fillIcon(icon, 0, 0, size, color);
+}
+
+bool IconCache::lookup(const VectorIcon& icon, int16_t size, Color color, Color bg, Image& image) {
+    const bool transparent = color == bg;
+    image = Image{size, size, transparent ? PixelFormat::MONO1 : PixelFormat::RGB565, nullptr};
+
+    CacheStats& stats = lru_.stats();
+    const int16_t hit = find(icon, size, color, bg);
+    if (hit >= 0) {
+        lru_.touch(static_cast<uint8_t>(hit));
+        stats.hits++;
+        image.data = lru_.data(static_cast<uint8_t>(hit));
+        return true;
+    }
+    stats.misses++;
+    if (&icon == rejected_icon_ && size == rejected_size_) {
+        stats.rejected++;
+        return false;
+    }
+
+    MUI_TRACE_SCOPE("icon.rasterize");
+    const int16_t index = lru_.insert(bitmapSize(size, transparent));
+    if (index < 0) {
+        return false;
+    }
+
+    uint8_t* data = lru_.data(static_cast<uint8_t>(index));
+    if (!render(icon, size, color, bg, data)) {
+        lru_.cancel(static_cast<uint8_t>(index));
+        rejected_icon_ = &icon;
+        rejected_size_ = size;
+        return false;
+    }
+    keys_[index] = Key{&icon, size, color, bg};
+    image.data = data;
+    return true;
+}
+
+void IconCache::draw(GraphicsDriver& driver, int16_t x, int16_t y, const VectorIcon& icon, int16_t size,
+                     Color color, Color bg) {
+    Image image;
+    if (lookup(icon, size, color, bg, image)) {
+        driver.drawImage(x, y, image, color, bg);
+        return;
+    }
+
+    // 被光栅化器拒绝的图标什么也不画
+    if (&icon == rejected_icon_ && size == rejected_size_) {
+        return;
+    }
+    // 放不下时直接光栅化；先检查整个图标，避免被拒绝时只画出背景
+    if (!Rasterizer(driver, Rect{0, 0, size, size}).fitsIcon(icon, 0, 0, size)) {
+        rejected_icon_ = &icon;
+        rejected_size_ = size;
+        return;
+    }
+    if (color != bg) {
+        driver.fillRect(x, y, size, size, bg);
+    }
+    driver.drawIcon(x, y, icon, size, color);
+}
+
+void IconCache::clear() {
+    lru_.clear();
+}
+
+} // namespace MinimalUI
@@ -0,0 +1,182 @@
+#include "IndexedFramebuffer.h"
+#include <cstring>
+#include <new>
+
+namespace MinimalUI {
+
+// 默认调色板：Colors命名空间中的颜色，其余为黑色
+static const Color DEFAULT_PALETTE[] = {
+    Colors::BLACK, Colors::WHITE, Colors::RED, Colors::GREEN, Colors::BLUE,
+    Colors::CYAN, Colors::MAGENTA, Colors::YELLOW, Colors::GRAY,
+};
+
+// RGB565转换为面板字节序（高字节在前）
+static inline uint16_t toPanelOrder(Color color) {
+    return static_cast<uint16_t>((color >> 8) | (color << 8));
+}
+
+IndexedFramebuffer::IndexedFramebuffer(int16_t width, int16_t height, uint8_t bpp)
+    : width_(width), height_(height), bpp_(bpp == 4 ? 4 : 8),
+      stride_(bpp == 4 ? (width + 1) / 2 : width), buffer_(nullptr),
+      last_color_(Colors::BLACK), last_index_(0), dirty_{0, 0, 0, 0} {
+    buffer_ = new (std::nothrow) uint8_t[bufferSize()];
+    if (buffer_) {
+        memset(buffer_, 0, bufferSize());
+    }
+    memset(palette_, 0, sizeof(palette_));
+    setPalette(DEFAULT_PALETTE, sizeof(DEFAULT_PALETTE) / sizeof(DEFAULT_PALETTE[0]));
+}
+
+IndexedFramebuffer::~IndexedFramebuffer() {
+    delete[] buffer_;
+}
+
+void IndexedFramebuffer::setPalette(const Color* colors, uint16_t count) {
+    if (count > paletteSize()) {
+        count = paletteSize();
+    }
+    memcpy(palette_, colors, count * sizeof(Color));
+    rebuildLut();
+}
+
+void IndexedFramebuffer::setPaletteEntry(uint8_t index, Color color) {
+    if (index >= paletteSize() || palette_[index] == color) {
+        return;
+    }
+    palette_[index] = color;
+    rebuildLut();
+}
+
+void IndexedFramebuffer::rebuildLut() {
+    for (uint16_t i = 0; i < 256; i++) {
+        lut_[i] = toPanelOrder(palette_[i]);
+    }
+    if (bpp_ == 4) {
+        // 低地址字节是左侧像素（高4位），小端序下位于低16位
+        for (uint16_t b = 0; b < 256; b++) {
+            pair_lut_[b] = lut_[b >> 4] | (static_cast<uint32_t>(lut_[b & 0x0F]) << 16);
+        }
+    }
+    last_color_ = palette_[0];
+    last_index_ = 0;
+    markAllDirty();
+}
+
+uint8_t IndexedFramebuffer::indexOf(Color color) {
+    // 绘制通常连续使用同一颜色
+    if (color == last_color_) {
+        return last_index_;
+    }
+
+    const uint16_t count = paletteSize();
+    uint8_t best = 0;
+    uint32_t best_dist = UINT32_MAX;
+    for (uint16_t i = 0; i < count; i++) {
+        if (palette_[i] == color) {
+            best = static_cast<uint8_t>(i);
+            break;
+        }
+        // 在5/6/5通道上按平方距离找最接近的颜色
+        int32_t dr = (palette_[i] >> 11) - (color >> 11);
+        int32_t dg = ((palette_[i] >> 5) & 0x3F) - ((color >> 5) & 0x3F);
+        int32_t db = (palette_[i] & 0x1F) - (color & 0x1F);
+        uint32_t dist = static_cast<uint32_t>(4 * dr * dr + dg * dg + 4 * db * db);
+        if (dist < best_dist) {
+            best_dist = dist;
+            best = static_cast<uint8_t>(i);
+        }
+    }
+    last_color_ = color;
+    last_index_ = best;
+    return best;
+}
+
+void IndexedFramebuffer::fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint8_t index) {
+    if (!buffer_ || w <= 0 || h <= 0) {
+        return;
+    }
+    markDirty(x, y, w, h);
+
+    if (bpp_ == 8) {
+        for (int16_t row = y; row < y + h; row++) {
+            memset(buffer_ + row * stride_ + x, index, w);
+        }
+        return;
+    }
+
+    // 4bpp：首尾可能各有半个字节，中间整字节memset
+    const uint8_t nibble = index & 0x0F;
+    const uint8_t packed = static_cast<uint8_t>((nibble << 4) | nibble);
+    for (int16_t row = y; row < y + h; row++) {
+        uint8_t* line = buffer_ + row * stride_;
+        int16_t px = x;
+        int16_t end = x + w;
+        if (px & 1) {
+            line[px >> 1] = (line[px >> 1] & 0xF0) | nibble;
+            px++;
+        }
+        int16_t full = (end - px) >> 1;
+        if (full > 0) {
+            memset(line + (px >> 1), packed, full);
+            px += full * 2;
+        }
+        if (px < end) {
+            line[px >> 1] = (line[px >> 1] & 0x0F) | (nibble << 4);
+        }
+    }
+}
+
+uint8_t IndexedFramebuffer::pixel(int16_t x, int16_t y) const {
+    if (!buffer_ || x < 0 || x >= width_ || y < 0 || y >= height_) {
+        return 0;
+    }
+    uint8_t b = buffer_[y * stride_ + (bpp_ == 4 ? x >> 1 : x)];
+    if (bpp_ == 8) {
+        return b;
+    }
+    return (x & 1) ? (b & 0x0F) : (b >> 4);
+}
+
+void IndexedFramebuffer::expandRow(int16_t y, int16_t x, int16_t w, uint8_t* out) const {
+    if (!buffer_) {
+        return;
+    }
+    const uint8_t* line = buffer_ + y * stride_;
+
+    if (bpp_ == 8) {
+        for (int16_t i = 0; i < w; i++) {
+            memcpy(out + i * 2, &lut_[line[x + i]], 2);
+        }
+        return;
+    }
+
+    int16_t px = x;
+    const int16_t end = x + w;
+    if (px & 1) {
+        memcpy(out, &lut_[line[px >> 1] & 0x0F], 2);
+        out += 2;
+        px++;
+    }
+    // 每个字节查一次表，输出两个像素
+    for (; px + 2 <= end; px += 2) {
+        memcpy(out, &pair_lut_[line[px >> 1]], 4);
+        out += 4;
+    }
+    if (px < end) {
+        memcpy(out, &lut_[line[px >> 1] >> 4], 2);
+    }
+}
+
+void IndexedFramebuffer::markDirty(int16_t x, int16_t y, int16_t w, int16_t h) {
+    if (dirty_.isEmpty()) {
+        dirty_ = Rect{x, y, w, h};
+        return;
+    }
+    int16_t left = x < dirty_.x ? x : dirty_.x;
+    int16_t top = y < dirty_.y ? y : dirty_.y;
+    int16_t right = x + w > dirty_.right() ? x + w : dirty_.right();
+    int16_t bottom = y + h > dirty_.bottom() ? y + h : dirty_.bottom();
+    dirty_ = Rect{left, top, static_cast<int16_t>(right - left), static_cast<int16_t>(bottom - top)};
+}
+
+} // namespace MinimalUI
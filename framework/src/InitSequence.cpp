@@ -0,0 +1,39 @@
+#include "InitSequence.h"
+#include "Trace.h"
+
+namespace MinimalUI {
+
+bool InitSequencer::step(DisplayTransport& transport, uint32_t& wait_ms) {
+    wait_ms = 0;
+    if (done()) {
+        return true;
+    }
+
+    MUI_TRACE_SCOPE("init.sequence");
+    transport.beginFrame();
+    while (table_[pos_] != InitSequence::END) {
+        const uint8_t header = table_[pos_];
+        const uint8_t type = header & InitSequence::TYPE_MASK;
+        if (type == InitSequence::DELAY) {
+            wait_ms = table_[pos_ + 1];
+            pos_ += 2;
+            break;
+        }
+
+        const uint8_t n = header & InitSequence::LENGTH_MASK;
+        const uint8_t* bytes = table_ + pos_ + 1;
+        if (type == InitSequence::CMD_DATA && n > 0) {
+            transport.sendCommand(bytes[0]);
+            if (n > 1) {
+                transport.sendBuffer(bytes + 1, n - 1);
+            }
+        } else if (n > 0) {
+            transport.sendCommands(bytes, n);
+        }
+        pos_ += 1 + n;
+    }
+    transport.endFrame();
+    return wait_ms == 0 && done();
+}
+
+} // namespace MinimalUI
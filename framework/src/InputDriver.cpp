@@ -0,0 +1,181 @@
+#include "InputDriver.h"
+#include "Trace.h"
+
+namespace MinimalUI {
+
+bool InputEventQueue::push(const InputEvent& event) {
+    const uint8_t head = head_.load(std::memory_order_relaxed);
+    const uint8_t next = static_cast<uint8_t>((head + 1) & (CAPACITY - 1));
+    if (next == tail_.load(std::memory_order_acquire)) {
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    events_[head] = event;
+    head_.store(next, std::memory_order_release);
+
+    // 入队到UI取出之间的排队时间显示为异步区间
+    const uint32_t trace_id = pushed_++;
+    MUI_TRACE_ASYNC_BEGIN("input", trace_id);
+    return true;
+}
+
+void InputEventQueue::pushMove(int16_t x, int16_t y, uint32_t time_ms) {
+    move_xy_.store((static_cast<uint32_t>(static_cast<uint16_t>(x)) << 16) | static_cast<uint16_t>(y),
+                   std::memory_order_relaxed);
+    move_time_.store(time_ms, std::memory_order_relaxed);
+    move_seq_.fetch_add(1, std::memory_order_release);
+}
+
+size_t InputEventQueue::drain(InputEvent* out, size_t max) {
+    MUI_TRACE_SCOPE("input.poll");
+    size_t count = 0;
+    uint8_t tail = tail_.load(std::memory_order_relaxed);
+    const uint8_t head = head_.load(std::memory_order_acquire);
+    while (tail != head && count < max) {
+        const InputEvent& event = events_[tail];
+        if (event.type == InputEventType::TOUCH_DOWN) {
+            touch_down_ = true;
+        } else if (event.type == InputEventType::TOUCH_UP) {
+            touch_down_ = false;
+        }
+        out[count++] = event;
+        const uint32_t trace_id = drained_++;
+        MUI_TRACE_ASYNC_END("input", trace_id);
+        tail = static_cast<uint8_t>((tail + 1) & (CAPACITY - 1));
+    }
+    tail_.store(tail, std::memory_order_release);
+
+    // 队列未取完时不追加移动事件，保证移动不会排在之前的按下/抬起前面
+    if (tail != head || count >= max) {
+        return count;
+    }
+
+    // 抬起之前的移动已被TOUCH_UP的坐标取代，只在仍按下时追加
+    const uint32_t seq = move_seq_.load(std::memory_order_acquire);
+    if (seq != last_move_seq_) {
+        last_move_seq_ = seq;
+        if (touch_down_) {
+            const uint32_t xy = move_xy_.load(std::memory_order_relaxed);
+            InputEvent& move = out[count++];
+            move.type = InputEventType::TOUCH_MOVE;
+            move.id = 0;
+            move.x = static_cast<int16_t>(xy >> 16);
+            move.y = static_cast<int16_t>(xy & 0xFFFF);
+            move.time_ms = move_time_.load(std::memory_order_relaxed);
+        }
+    }
+    return count;
+}
+
+bool ButtonDebouncer::update(bool raw) {
+    if (raw) {
+        if (count_ < limit_) {
+            count_++;
+        }
+    } else if (count_ > 0) {
+        count_--;
+    }
+
+    if (!state_ && count_ == limit_) {
+        state_ = true;
+        return true;
+    }
+    if (state_ && count_ == 0) {
+        state_ = false;
+        return true;
+    }
+    return false;
+}
+
+int8_t QuadratureDecoder::update(bool a, bool b) {
+    // 下标为 (上一状态 << 2) | 当前状态，值为四分之一步方向
+    static const int8_t TRANSITIONS[16] = {
+         0, -1,  1,  0,
+         1,  0,  0, -1,
+        -1,  0,  0,  1,
+         0,  1, -1,  0,
+    };
+    const uint8_t current = static_cast<uint8_t>((a ? 2 : 0) | (b ? 1 : 0));
+    accum_ = static_cast<int8_t>(accum_ + TRANSITIONS[(state_ << 2) | current]);
+    state_ = current;
+
+    if (accum_ >= steps_per_detent_) {
+        accum_ = 0;
+        return 1;
+    }
+    if (accum_ <= -steps_per_detent_) {
+        accum_ = 0;
+        return -1;
+    }
+    return 0;
+}
+
+TouchCalibration TouchCalibration::fromRange(uint16_t raw_x_min, uint16_t raw_x_max,
+                                             uint16_t raw_y_min, uint16_t raw_y_max,
+                                             int16_t width, int16_t height, bool swap_xy) {
+    // 原始值范围映射到0 ~ size-1；min大于max时方向反转
+    auto scale = [](uint16_t lo, uint16_t hi, int16_t size) -> int32_t {
+        int32_t span = static_cast<int32_t>(hi) - lo;
+        if (span == 0) {
+            return 0;
+        }
+        return (static_cast<int32_t>(size - 1) << 16) / span;
+    };
+
+    TouchCalibration cal = {};
+    if (!swap_xy) {
+        cal.ax = scale(raw_x_min, raw_x_max, width);
+        cal.cx = -cal.ax * raw_x_min;
+        cal.by = scale(raw_y_min, raw_y_max, height);
+        cal.cy = -cal.by * raw_y_min;
+    } else {
+        // 屏幕X来自触摸屏Y方向，屏幕Y来自触摸屏X方向
+        cal.bx = scale(raw_y_min, raw_y_max, width);
+        cal.cx = -cal.bx * raw_y_min;
+        cal.ay = scale(raw_x_min, raw_x_max, height);
+        cal.cy = -cal.ay * raw_x_min;
+    }
+    return cal;
+}
+
+static inline uint16_t median3(const uint16_t* v) {
+    uint16_t a = v[0];
+    uint16_t b = v[1];
+    uint16_t c = v[2];
+    if (a > b) {
+        uint16_t t = a;
+        a = b;
+        b = t;
+    }
+    if (b > c) {
+        b = c;
+    }
+    return a > b ? a : b;
+}
+
+TouchFilter::TouchFilter(uint8_t alpha_q8)
+    : calibration_(TouchCalibration::fromRange(0, 4095, 0, 4095, 4096, 4096, false)),
+      alpha_(alpha_q8 ? alpha_q8 : 1), fx_(0), fy_(0), primed_(false) {}
+
+void TouchFilter::update(const uint16_t* raw_x, const uint16_t* raw_y, int16_t& x, int16_t& y) {
+    const int32_t rx = median3(raw_x);
+    const int32_t ry = median3(raw_y);
+
+    // Q16校准结果右移8位得到Q8屏幕坐标
+    const int32_t sx = (calibration_.ax * rx + calibration_.bx * ry + calibration_.cx) >> 8;
+    const int32_t sy = (calibration_.ay * rx + calibration_.by * ry + calibration_.cy) >> 8;
+
+    if (!primed_) {
+        fx_ = sx;
+        fy_ = sy;
+        primed_ = true;
+    } else {
+        fx_ += ((sx - fx_) * alpha_) >> 8;
+        fy_ += ((sy - fy_) * alpha_) >> 8;
+    }
+
+    x = static_cast<int16_t>((fx_ + 128) >> 8);
+    y = static_cast<int16_t>((fy_ + 128) >> 8);
+}
+
+} // namespace MinimalUI
@@ -0,0 +1,283 @@
+#include "PixelKernels.h"
+#include <cstring>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace MinimalUI {
+namespace PixelKernels {
+
+namespace {
+
+// 把RGB565展开为 00000GGGGGG00000RRRRR000000BBBBB，通道之间留出乘法所需的空位
+constexpr uint32_t SPREAD_MASK = 0x07E0F81F;
+
+inline uint32_t spread(uint32_t c) {
+    return (c | (c << 16)) & SPREAD_MASK;
+}
+
+inline uint32_t pack(uint32_t x) {
+    return (x | (x >> 16)) & 0xFFFF;
+}
+
+// d + floor((s - d) * a / 32)，a取0~32；各SIMD实现使用相同公式，结果逐位一致
+inline uint32_t blendPixel(uint32_t s, uint32_t d, uint32_t a) {
+    uint32_t xs = spread(s);
+    uint32_t xd = spread(d);
+    return pack(((xs * a + xd * (32 - a)) >> 5) & SPREAD_MASK);
+}
+
+// 像素对按32位字读写（memcpy避免对齐和别名问题，编译器会生成单次访问）
+inline uint32_t loadPair(const Color* p) {
+    uint32_t w;
+    memcpy(&w, p, sizeof(w));
+    return w;
+}
+
+inline void storePair(Color* p, uint32_t w) {
+    memcpy(p, &w, sizeof(w));
+}
+
+inline uint32_t effectiveAlpha(uint32_t alpha, uint32_t opacity) {
+    return alpha5((alpha * (opacity + 1)) >> 8);
+}
+
+#if defined(__SSE2__)
+// 8个像素的通道插值：d + ((s - d) * a) >> 5，a为每个16位通道的0~32
+inline __m128i blend8(__m128i s, __m128i d, __m128i a) {
+    const __m128i mask6 = _mm_set1_epi16(0x3F);
+    const __m128i mask5 = _mm_set1_epi16(0x1F);
+    __m128i sr = _mm_srli_epi16(s, 11);
+    __m128i dr = _mm_srli_epi16(d, 11);
+    __m128i sg = _mm_and_si128(_mm_srli_epi16(s, 5), mask6);
+    __m128i dg = _mm_and_si128(_mm_srli_epi16(d, 5), mask6);
+    __m128i sb = _mm_and_si128(s, mask5);
+    __m128i db = _mm_and_si128(d, mask5);
+    __m128i r = _mm_add_epi16(dr, _mm_srai_epi16(_mm_mullo_epi16(_mm_sub_epi16(sr, dr), a), 5));
+    __m128i g = _mm_add_epi16(dg, _mm_srai_epi16(_mm_mullo_epi16(_mm_sub_epi16(sg, dg), a), 5));
+    __m128i b = _mm_add_epi16(db, _mm_srai_epi16(_mm_mullo_epi16(_mm_sub_epi16(sb, db), a), 5));
+    return _mm_or_si128(_mm_or_si128(_mm_slli_epi16(r, 11), _mm_slli_epi16(g, 5)), b);
+}
+
+// 8个alpha字节（0~255）换算为0~32
+inline __m128i alpha8(const uint8_t* alpha, uint32_t opacity) {
+    __m128i a = _mm_unpacklo_epi8(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(alpha)),
+                                  _mm_setzero_si128());
+    a = _mm_srli_epi16(_mm_mullo_epi16(a, _mm_set1_epi16(static_cast<int16_t>(opacity + 1))), 8);
+    return _mm_srli_epi16(_mm_add_epi16(a, _mm_set1_epi16(4)), 3);
+}
+#endif
+
+#if defined(__AVX2__)
+inline __m256i blend16(__m256i s, __m256i d, __m256i a) {
+    const __m256i mask6 = _mm256_set1_epi16(0x3F);
+    const __m256i mask5 = _mm256_set1_epi16(0x1F);
+    __m256i sr = _mm256_srli_epi16(s, 11);
+    __m256i dr = _mm256_srli_epi16(d, 11);
+    __m256i sg = _mm256_and_si256(_mm256_srli_epi16(s, 5), mask6);
+    __m256i dg = _mm256_and_si256(_mm256_srli_epi16(d, 5), mask6);
+    __m256i sb = _mm256_and_si256(s, mask5);
+    __m256i db = _mm256_and_si256(d, mask5);
+    __m256i r = _mm256_add_epi16(dr, _mm256_srai_epi16(_mm256_mullo_epi16(_mm256_sub_epi16(sr, dr), a), 5));
+    __m256i g = _mm256_add_epi16(dg, _mm256_srai_epi16(_mm256_mullo_epi16(_mm256_sub_epi16(sg, dg), a), 5));
+    __m256i b = _mm256_add_epi16(db, _mm256_srai_epi16(_mm256_mullo_epi16(_mm256_sub_epi16(sb, db), a), 5));
+    return _mm256_or_si256(_mm256_or_si256(_mm256_slli_epi16(r, 11), _mm256_slli_epi16(g, 5)), b);
+}
+
+inline __m256i alpha16(const uint8_t* alpha, uint32_t opacity) {
+    __m256i a = _mm256_cvtepu8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(alpha)));
+    a = _mm256_srli_epi16(_mm256_mullo_epi16(a, _mm256_set1_epi16(static_cast<int16_t>(opacity + 1))), 8);
+    return _mm256_srli_epi16(_mm256_add_epi16(a, _mm256_set1_epi16(4)), 3);
+}
+#endif
+
+} // namespace
+
+void fill(Color* dst, size_t n, Color color) {
+    size_t i = 0;
+#if defined(__SSE2__)
+    const __m128i c = _mm_set1_epi16(static_cast<int16_t>(color));
+    for (; i + 8 <= n; i += 8) {
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), c);
+    }
+#endif
+    // 先对齐到4字节，然后每次写入一个像素对
+    if (i < n && (reinterpret_cast<uintptr_t>(dst + i) & 0x2)) {
+        dst[i++] = color;
+    }
+    const uint32_t pair = (static_cast<uint32_t>(color) << 16) | color;
+    for (; i + 2 <= n; i += 2) {
+        storePair(dst + i, pair);
+    }
+    if (i < n) {
+        dst[i] = color;
+    }
+}
+
+void copy(Color* dst, const Color* src, size_t n) {
+    memcpy(dst, src, n * sizeof(Color));
+}
+
+void copyKeyed(Color* dst, const Color* src, size_t n, Color key) {
+    size_t i = 0;
+#if defined(__AVX2__)
+    const __m256i k16 = _mm256_set1_epi16(static_cast<int16_t>(key));
+    for (; i + 16 <= n; i += 16) {
+        __m256i s = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+        __m256i d = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(dst + i));
+        __m256i m = _mm256_cmpeq_epi16(s, k16);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), _mm256_blendv_epi8(s, d, m));
+    }
+#endif
+#if defined(__SSE2__)
+    const __m128i k8 = _mm_set1_epi16(static_cast<int16_t>(key));
+    for (; i + 8 <= n; i += 8) {
+        __m128i s = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+        __m128i d = _mm_loadu_si128(reinterpret_cast<const __m128i*>(dst + i));
+        __m128i m = _mm_cmpeq_epi16(s, k8);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i),
+                         _mm_or_si128(_mm_and_si128(m, d), _mm_andnot_si128(m, s)));
+    }
+#endif
+    // 像素对中两个都不透明时整字写入，都透明时跳过
+    const uint32_t key_pair = (static_cast<uint32_t>(key) << 16) | key;
+    for (; i + 2 <= n; i += 2) {
+        uint32_t s = loadPair(src + i);
+        uint32_t x = s ^ key_pair;
+        bool lo = (x & 0xFFFF) != 0;
+        bool hi = (x >> 16) != 0;
+        if (lo && hi) {
+            storePair(dst + i, s);
+        } else if (lo) {
+            dst[i] = src[i];
+        } else if (hi) {
+            dst[i + 1] = src[i + 1];
+        }
+    }
+    if (i < n && src[i] != key) {
+        dst[i] = src[i];
+    }
+}
+
+void blend(Color* dst, const Color* src, size_t n, uint8_t alpha) {
+    const uint32_t a = alpha5(alpha);
+    if (a == 0) {
+        return;
+    }
+    if (a >= 32) {
+        copy(dst, src, n);
+        return;
+    }
+
+    size_t i = 0;
+#if defined(__AVX2__)
+    const __m256i a16 = _mm256_set1_epi16(static_cast<int16_t>(a));
+    for (; i + 16 <= n; i += 16) {
+        __m256i s = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+        __m256i d = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(dst + i));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), blend16(s, d, a16));
+    }
+#endif
+#if defined(__SSE2__)
+    const __m128i a8 = _mm_set1_epi16(static_cast<int16_t>(a));
+    for (; i + 8 <= n; i += 8) {
+        __m128i s = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+        __m128i d = _mm_loadu_si128(reinterpret_cast<const __m128i*>(dst + i));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), blend8(s, d, a8));
+    }
+#endif
+    for (; i + 2 <= n; i += 2) {
+        uint32_t s = loadPair(src + i);
+        uint32_t d = loadPair(dst + i);
+        uint32_t lo = blendPixel(s & 0xFFFF, d & 0xFFFF, a);
+        uint32_t hi = blendPixel(s >> 16, d >> 16, a);
+        storePair(dst + i, lo | (hi << 16));
+    }
+    if (i < n) {
+        dst[i] = static_cast<Color>(blendPixel(src[i], dst[i], a));
+    }
+}
+
+void blendFill(Color* dst, size_t n, Color color, uint8_t alpha) {
+    const uint32_t a = alpha5(alpha);
+    if (a == 0) {
+        return;
+    }
+    if (a >= 32) {
+        fill(dst, n, color);
+        return;
+    }
+
+    size_t i = 0;
+#if defined(__AVX2__)
+    const __m256i a16 = _mm256_set1_epi16(static_cast<int16_t>(a));
+    const __m256i c16 = _mm256_set1_epi16(static_cast<int16_t>(color));
+    for (; i + 16 <= n; i += 16) {
+        __m256i d = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(dst + i));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), blend16(c16, d, a16));
+    }
+#endif
+#if defined(__SSE2__)
+    const __m128i a8 = _mm_set1_epi16(static_cast<int16_t>(a));
+    const __m128i c8 = _mm_set1_epi16(static_cast<int16_t>(color));
+    for (; i + 8 <= n; i += 8) {
+        __m128i d = _mm_loadu_si128(reinterpret_cast<const __m128i*>(dst + i));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), blend8(c8, d, a8));
+    }
+#endif
+    // 源颜色的一项乘积对所有像素相同，每个像素只剩一次乘法
+    const uint32_t src_term = spread(color) * a;
+    const uint32_t dst_weight = 32 - a;
+    for (; i + 2 <= n; i += 2) {
+        uint32_t d = loadPair(dst + i);
+        uint32_t lo = pack(((src_term + spread(d & 0xFFFF) * dst_weight) >> 5) & SPREAD_MASK);
+        uint32_t hi = pack(((src_term + spread(d >> 16) * dst_weight) >> 5) & SPREAD_MASK);
+        storePair(dst + i, lo | (hi << 16));
+    }
+    if (i < n) {
+        dst[i] = static_cast<Color>(pack(((src_term + spread(dst[i]) * dst_weight) >> 5) & SPREAD_MASK));
+    }
+}
+
+void blendAlpha(Color* dst, const Color* src, const uint8_t* alpha, size_t n, uint8_t opacity) {
+    if (opacity == 0) {
+        return;
+    }
+
+    size_t i = 0;
+#if defined(__AVX2__)
+    for (; i + 16 <= n; i += 16) {
+        __m256i s = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+        __m256i d = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(dst + i));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), blend16(s, d, alpha16(alpha + i, opacity)));
+    }
+#endif
+#if defined(__SSE2__)
+    for (; i + 8 <= n; i += 8) {
+        __m128i s = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+        __m128i d = _mm_loadu_si128(reinterpret_cast<const __m128i*>(dst + i));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), blend8(s, d, alpha8(alpha + i, opacity)));
+    }
+#endif
+    for (; i + 2 <= n; i += 2) {
+        uint32_t a0 = effectiveAlpha(alpha[i], opacity);
+        uint32_t a1 = effectiveAlpha(alpha[i + 1], opacity);
+        if ((a0 | a1) == 0) {
+            continue;  // 全透明的像素对不写回
+        }
+        uint32_t s = loadPair(src + i);
+        uint32_t d = loadPair(dst + i);
+        uint32_t lo = blendPixel(s & 0xFFFF, d & 0xFFFF, a0);
+        uint32_t hi = blendPixel(s >> 16, d >> 16, a1);
+        storePair(dst + i, lo | (hi << 16));
+    }
+    if (i < n) {
+        dst[i] = static_cast<Color>(blendPixel(src[i], dst[i], effectiveAlpha(alpha[i], opacity)));
+    }
+}
+
+} // namespace PixelKernels
+} // namespace MinimalUI
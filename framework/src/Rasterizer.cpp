@@ -0,0 +1,686 @@
+#include "Rasterizer.h"
+#include "FixedMath.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+
+#ifdef ESP_PLATFORM
+#include <esp_log.h>
+#endif
+
+namespace MinimalUI {
+
+#ifdef ESP_PLATFORM
+static const char* TAG = "Rasterizer";
+#endif
+
+namespace {
+
+constexpr int32_t SPAN_INF = 0x7FFF;
+
+std::atomic<uint32_t> rejected_icons{0};
+
+// 凸多边形的一条边（16.16定点）
+struct EdgeWalker {
+    int64_t x;       // 起点X（16.16）
+    int64_t step;    // 每行X增量（16.16）
+    int16_t y_start; // 起点行
+    int16_t y_end;   // 终点行
+    uint8_t to;      // 终点顶点索引
+};
+
+void startEdge(EdgeWalker& e, const Point* pts, uint8_t count, uint8_t from, int8_t dir) {
+    uint8_t to = static_cast<uint8_t>((from + count + dir) % count);
+    int32_t dy = pts[to].y - pts[from].y;
+    e.x = static_cast<int64_t>(pts[from].x) << 16;
+    e.step = dy > 0 ? (static_cast<int64_t>(pts[to].x - pts[from].x) << 16) / dy : 0;
+    e.y_start = pts[from].y;
+    e.y_end = pts[to].y;
+    e.to = to;
+}
+
+// 将边推进到包含第y行的位置，返回该行的X坐标（四舍五入）
+int32_t edgeXAt(EdgeWalker& e, const Point* pts, uint8_t count, int8_t dir,
+                uint8_t bottom, int16_t y) {
+    while (e.to != bottom && (y > e.y_end || e.y_start == e.y_end)) {
+        startEdge(e, pts, count, e.to, dir);
+    }
+    int64_t x = e.x + e.step * (y - e.y_start);
+    return static_cast<int32_t>((x + 0x8000) >> 16);
+}
+
+
+// 采样线与路径的一个交点（Q8像素坐标）
+struct Crossing {
+    int32_t x;
+    int8_t winding;   // 向下的边为+1，向上的边为-1
+};
+
+// 一行的采样线（像素中心）与展平后各线段的交点
+struct RowSampler {
+    int32_t y;
+    Crossing crossings[CONFIG_UI_VECTOR_MAX_CROSSINGS];
+    uint8_t count;
+    bool overflow;    // 交点超过容量，本行的环绕数不可信
+
+    void segment(int32_t x0, int32_t y0, int32_t x1, int32_t y1) {
+        int8_t winding = 0;
+        if (y0 <= y && y < y1) {
+            winding = 1;
+        } else if (y1 <= y && y < y0) {
+            winding = -1;
+        }
+        if (winding == 0) {
+            return;
+        }
+        if (count == CONFIG_UI_VECTOR_MAX_CROSSINGS) {
+            overflow = true;
+            return;
+        }
+        const int64_t x = x0 + static_cast<int64_t>(x1 - x0) * (y - y0) / (y1 - y0);
+        crossings[count++] = Crossing{static_cast<int32_t>(x), winding};
+    }
+};
+
+// 遍历图标路径，把直线、曲线和圆弧展平为线段交给RowSampler
+class IconWalker {
+public:
+    IconWalker(int16_t x, int16_t y, int16_t size, RowSampler& row)
+        : x_(x), y_(y), size_(size), row_(row) {}
+
+    void walk(const VectorIcon& icon) {
+        const int16_t* cmd = icon.commands;
+        const int16_t* end = cmd + icon.length;
+        while (cmd < end) {
+            const VectorOp op = static_cast<VectorOp>(*cmd++);
+            const int16_t* args = cmd;
+            switch (op) {
+                case VectorOp::MOVE:
+                    if (end - cmd < 2) return;
+                    close();
+                    cur_x_ = start_x_ = px(args[0]);
+                    cur_y_ = start_y_ = py(args[1]);
+                    open_ = true;
+                    cmd += 2;
+                    break;
+                case VectorOp::LINE:
+                    if (end - cmd < 2) return;
+                    lineTo(px(args[0]), py(args[1]));
+                    cmd += 2;
+                    break;
+                case VectorOp::QUAD:
+                    if (end - cmd < 4) return;
+                    quadTo(px(args[0]), py(args[1]), px(args[2]), py(args[3]));
+                    cmd += 4;
+                    break;
+                case VectorOp::ARC:
+                    if (end - cmd < 5) return;
+                    arc(args[0], args[1], args[2], args[3], args[4]);
+                    cmd += 5;
+                    break;
+                case VectorOp::CLOSE:
+                    close();
+                    break;
+                default:
+                    // END或未知操作码
+                    close();
+                    return;
+            }
+        }
+        close();
+    }
+
+private:
+    int32_t x_;
+    int32_t y_;
+    int32_t size_;
+    RowSampler& row_;
+    int32_t start_x_ = 0;
+    int32_t start_y_ = 0;
+    int32_t cur_x_ = 0;
+    int32_t cur_y_ = 0;
+    bool open_ = false;
+
+    // 设计网格坐标（1/256图标边长）到Q8像素坐标
+    int32_t px(int32_t u) const { return x_ * 256 + u * size_; }
+    int32_t py(int32_t v) const { return y_ * 256 + v * size_; }
+
+    void begin() {
+        if (!open_) {
+            start_x_ = cur_x_;
+            start_y_ = cur_y_;
+            open_ = true;
+        }
+    }
+
+    void lineTo(int32_t x, int32_t y) {
+        begin();
+        row_.segment(cur_x_, cur_y_, x, y);
+        cur_x_ = x;
+        cur_y_ = y;
+    }
+
+    void close() {
+        if (open_) {
+            row_.segment(cur_x_, cur_y_, start_x_, start_y_);
+            cur_x_ = start_x_;
+            cur_y_ = start_y_;
+            open_ = false;
+        }
+    }
+
+    void quadTo(int32_t cx, int32_t cy, int32_t x, int32_t y) {
+        begin();
+        // 曲线在控制多边形的凸包内，凸包不跨过采样线时不必展平
+        const int32_t y_min = std::min(std::min(cur_y_, cy), y);
+        const int32_t y_max = std::max(std::max(cur_y_, cy), y);
+        if (row_.y >= y_min && row_.y < y_max) {
+            // 分段数随控制多边形的长度（像素）增加
+            const int32_t length = (std::abs(cx - cur_x_) + std::abs(cy - cur_y_) +
+                                    std::abs(x - cx) + std::abs(y - cy)) / 256;
+            const int64_t n = std::min<int32_t>(16, std::max<int32_t>(2, 1 + length / 4));
+            const int64_t x0 = cur_x_;
+            const int64_t y0 = cur_y_;
+            int32_t prev_x = cur_x_;
+            int32_t prev_y = cur_y_;
+            for (int64_t i = 1; i <= n; i++) {
+                const int64_t s = n - i;
+                const int32_t qx = static_cast<int32_t>((s * s * x0 + 2 * s * i * cx + i * i * x) / (n * n));
+                const int32_t qy = static_cast<int32_t>((s * s * y0 + 2 * s * i * cy + i * i * y) / (n * n));
+                row_.segment(prev_x, prev_y, qx, qy);
+                prev_x = qx;
+                prev_y = qy;
+            }
+        }
+        cur_x_ = x;
+        cur_y_ = y;
+    }
+
+    void arc(int16_t cx, int16_t cy, int16_t r, int16_t start_deg, int16_t end_deg) {
+        const int32_t center_x = px(cx);
+        const int32_t center_y = py(cy);
+        const int64_t radius = static_cast<int64_t>(r) * size_;
+        auto pointX = [&](int32_t deg) {
+            return static_cast<int32_t>(center_x + ((radius * FixedMath::cosQ14(deg)) >> 14));
+        };
+        auto pointY = [&](int32_t deg) {
+            return static_cast<int32_t>(center_y + ((radius * FixedMath::sinQ14(deg)) >> 14));
+        };
+
+        if (open_) {
+            lineTo(pointX(start_deg), pointY(start_deg));
+        } else {
+            cur_x_ = pointX(start_deg);
+            cur_y_ = pointY(start_deg);
+            begin();
+        }
+
+        const int32_t sweep = static_cast<int32_t>(end_deg) - start_deg;
+        if (row_.y >= center_y - radius && row_.y < center_y + radius) {
+            // 半径越大每段角度越小，弦高保持在约半像素以内
+            const int32_t r_px = static_cast<int32_t>(radius >> 8);
+            const int32_t step = r_px > 48 ? 5 : r_px > 16 ? 10 : r_px > 6 ? 15 : 30;
+            const int32_t n = std::max<int32_t>(1, (std::abs(sweep) + step - 1) / step);
+            for (int32_t i = 1; i <= n; i++) {
+                const int32_t deg = start_deg + sweep * i / n;
+                lineTo(pointX(deg), pointY(deg));
+            }
+        } else {
+            cur_x_ = pointX(end_deg);
+            cur_y_ = pointY(end_deg);
+        }
+    }
+};
+
+} // namespace
+
+Rasterizer::Rasterizer(SpanSink& sink, const Rect& clip)
+    : sink_(sink), clip_(clip) {
+}
+
+bool Rasterizer::rejects(int32_t x, int32_t y, int32_t w, int32_t h) const {
+    return clip_.isEmpty() || w <= 0 || h <= 0 ||
+           x >= clip_.right() || y >= clip_.bottom() ||
+           x + w <= clip_.x || y + h <= clip_.y;
+}
+
+int16_t Rasterizer::circleHalfWidth(int16_t r, int16_t dy) {
+    int32_t v = static_cast<int32_t>(r) * r + r - static_cast<int32_t>(dy) * dy;
+    return v > 0 ? static_cast<int16_t>(FixedMath::isqrt(static_cast<uint32_t>(v))) : 0;
+}
+
+void Rasterizer::span(int16_t x0, int16_t x1, int16_t y, Color color) {
+    if (y < clip_.y || y >= clip_.bottom()) {
+        return;
+    }
+    int16_t lo = std::max(x0, clip_.x);
+    int16_t hi = std::min(x1, static_cast<int16_t>(clip_.right() - 1));
+    if (lo <= hi) {
+        sink_.fillSpan(lo, y, hi - lo + 1, color);
+    }
+}
+
+void Rasterizer::drawLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, Color color) {
+    if (rejects(std::min(x0, x1), std::min(y0, y1), std::abs(x1 - x0) + 1, std::abs(y1 - y0) + 1)) {
+        return;
+    }
+
+    const bool steep = std::abs(y1 - y0) > std::abs(x1 - x0);
+    if (steep) {
+        std::swap(x0, y0);
+        std::swap(x1, y1);
+    }
+    if (x0 > x1) {
+        std::swap(x0, x1);
+        std::swap(y0, y1);
+    }
+
+    const int32_t dx = x1 - x0;
+    const int32_t dy = std::abs(y1 - y0);
+    const int16_t ystep = (y0 < y1) ? 1 : -1;
+    int32_t err = dx / 2;
+    int16_t y = y0;
+    int32_t run_start = x0;   // 当前行上尚未输出的第一个像素
+
+    for (int32_t x = x0; x <= x1; x++) {
+        if (steep) {
+            // 陡峭的线每行只有一个像素
+            span(y, y, static_cast<int16_t>(x), color);
+        }
+        err -= dy;
+        if (err < 0 || x == x1) {
+            if (!steep) {
+                span(static_cast<int16_t>(run_start), static_cast<int16_t>(x), y, color);
+                run_start = x + 1;
+            }
+            if (err < 0) {
+                y += ystep;
+                err += dx;
+            }
+        }
+    }
+}
+
+void Rasterizer::drawCircle(int16_t x0, int16_t y0, int16_t r, Color color) {
+    if (r < 0 || rejects(x0 - r, y0 - r, 2 * r + 1, 2 * r + 1)) {
+        return;
+    }
+
+    // 第dy行与第-dy行上距圆心[a, b]列的像素，左右对称；a == 0时两侧连成一段
+    auto mirrored = [&](int32_t a, int32_t b, int32_t dy) {
+        for (int32_t row = dy; ; row = -dy) {
+            const int16_t py = static_cast<int16_t>(y0 + row);
+            if (a == 0) {
+                span(static_cast<int16_t>(x0 - b), static_cast<int16_t>(x0 + b), py, color);
+            } else {
+                span(static_cast<int16_t>(x0 - b), static_cast<int16_t>(x0 - a), py, color);
+                span(static_cast<int16_t>(x0 + a), static_cast<int16_t>(x0 + b), py, color);
+            }
+            if (row <= 0) {
+                break;
+            }
+        }
+    };
+
+    // 在第一个八分圆上推进：(x, y)所在的顶部/底部行上x连续的像素合并为一段，
+    // 左右两侧（第±x行，第±y列）每行各一个像素。越过对角线（x > y）的点都是已输出点
+    // 关于对角线的镜像，到此为止，每个像素只输出一次
+    int32_t f = 1 - r;
+    int32_t ddF_x = 1;
+    int32_t ddF_y = -2 * r;
+    int32_t x = 0;
+    int32_t y = r;
+    int32_t run_start = 0;
+
+    if (r > 0) {
+        mirrored(r, r, 0);
+    }
+    while (x < y) {
+        int32_t next_y = y;
+        if (f >= 0) {
+            next_y--;
+            ddF_y += 2;
+            f += ddF_y;
+        }
+        ddF_x += 2;
+        f += ddF_x;
+
+        if (x + 1 > next_y) {
+            break;
+        }
+        if (next_y != y) {
+            mirrored(run_start, x, y);
+            run_start = x + 1;
+        }
+        x++;
+        y = next_y;
+        if (x < y) {
+            mirrored(y, y, x);
+        }
+    }
+    mirrored(run_start, x, y);
+}
+
+void Rasterizer::fillCircle(int16_t x0, int16_t y0, int16_t r, Color color) {
+    if (r < 0 || rejects(x0 - r, y0 - r, 2 * r + 1, 2 * r + 1)) {
+        return;
+    }
+
+    // 自中心向外逐行推进，半宽单调递减，无需逐行开方
+    const int32_t limit = static_cast<int32_t>(r) * r + r;
+    int32_t x = r;
+    for (int32_t dy = 0; dy <= r; dy++) {
+        while (x > 0 && x * x + dy * dy > limit) {
+            x--;
+        }
+        span(x0 - x, x0 + x, y0 + dy, color);
+        if (dy != 0) {
+            span(x0 - x, x0 + x, y0 - dy, color);
+        }
+    }
+}
+
+void Rasterizer::fillEllipse(int16_t x0, int16_t y0, int16_t rx, int16_t ry, Color color) {
+    if (rx < 0 || ry < 0 || rejects(x0 - rx, y0 - ry, 2 * rx + 1, 2 * ry + 1)) {
+        return;
+    }
+
+    // x²·ry² + dy²·rx² <= rx²·ry² + rx·ry·(rx+ry)/2，rx == ry 时与fillCircle一致
+    const int64_t rx2 = static_cast<int64_t>(rx) * rx;
+    const int64_t ry2 = static_cast<int64_t>(ry) * ry;
+    const int64_t limit = rx2 * ry2 + static_cast<int64_t>(rx) * ry * (rx + ry) / 2;
+    int64_t x = rx;
+    for (int64_t dy = 0; dy <= ry; dy++) {
+        while (x > 0 && x * x * ry2 + dy * dy * rx2 > limit) {
+            x--;
+        }
+        span(x0 - x, x0 + x, y0 + dy, color);
+        if (dy != 0) {
+            span(x0 - x, x0 + x, y0 - dy, color);
+        }
+    }
+}
+
+void Rasterizer::fillRoundRect(int16_t x, int16_t y, int16_t w, int16_t h, int16_t r, Color color) {
+    if (rejects(x, y, w, h)) {
+        return;
+    }
+
+    // 半径不超过短边的一半，保证上下圆角行不重叠
+    int16_t max_r = (std::min(w, h) - 1) / 2;
+    if (r > max_r) r = max_r;
+    if (r < 0) r = 0;
+
+    const int16_t x_left = x + r;           // 圆角圆心X（左）
+    const int16_t x_right = x + w - 1 - r;  // 圆角圆心X（右）
+    const int16_t y_top = y + r;            // 圆角圆心Y（上）
+    const int16_t y_bottom = y + h - 1 - r; // 圆角圆心Y（下）
+
+    // 圆角部分
+    const int32_t limit = static_cast<int32_t>(r) * r + r;
+    int32_t cx = r;
+    for (int32_t dy = 0; dy <= r; dy++) {
+        while (cx > 0 && cx * cx + dy * dy > limit) {
+            cx--;
+        }
+        span(x_left - cx, x_right + cx, y_top - dy, color);
+        if (y_bottom != y_top) {
+            span(x_left - cx, x_right + cx, y_bottom + dy, color);
+        }
+    }
+
+    // 中间整行
+    int16_t row_begin = std::max<int16_t>(y_top + 1, clip_.y);
+    int16_t row_end = std::min<int16_t>(y_bottom - 1, clip_.bottom() - 1);
+    for (int16_t row = row_begin; row <= row_end; row++) {
+        span(x, x + w - 1, row, color);
+    }
+}
+
+void Rasterizer::fillTriangle(int16_t x0, int16_t y0, int16_t x1, int16_t y1,
+                              int16_t x2, int16_t y2, Color color) {
+    const Point pts[3] = {{x0, y0}, {x1, y1}, {x2, y2}};
+    fillConvexPolygon(pts, 3, color);
+}
+
+void Rasterizer::fillConvexPolygon(const Point* points, uint8_t count, Color color) {
+    if (!points || count == 0) {
+        return;
+    }
+
+    // 包围盒与最高/最低顶点
+    uint8_t top = 0;
+    uint8_t bottom = 0;
+    int16_t min_x = points[0].x;
+    int16_t max_x = points[0].x;
+    for (uint8_t i = 1; i < count; i++) {
+        if (points[i].y < points[top].y) top = i;
+        if (points[i].y > points[bottom].y) bottom = i;
+        min_x = std::min(min_x, points[i].x);
+        max_x = std::max(max_x, points[i].x);
+    }
+
+    const int16_t y_min = points[top].y;
+    const int16_t y_max = points[bottom].y;
+    if (rejects(min_x, y_min, max_x - min_x + 1, y_max - y_min + 1)) {
+        return;
+    }
+
+    if (y_min == y_max) {
+        span(min_x, max_x, y_min, color);
+        return;
+    }
+
+    // 从最高顶点出发沿两个方向各走一条边链，逐行取两链之间的扫描段
+    EdgeWalker forward;
+    EdgeWalker backward;
+    startEdge(forward, points, count, top, 1);
+    startEdge(backward, points, count, top, -1);
+
+    int16_t row_begin = std::max(y_min, clip_.y);
+    int16_t row_end = std::min<int16_t>(y_max, clip_.bottom() - 1);
+    for (int16_t row = row_begin; row <= row_end; row++) {
+        int32_t xa = edgeXAt(forward, points, count, 1, bottom, row);
+        int32_t xb = edgeXAt(backward, points, count, -1, bottom, row);
+        if (xa > xb) std::swap(xa, xb);
+        span(static_cast<int16_t>(xa), static_cast<int16_t>(xb), row, color);
+    }
+}
+
+void Rasterizer::fillArc(int16_t x0, int16_t y0, int16_t r_outer, int16_t r_inner,
+                         int16_t start_deg, int16_t end_deg, Color color) {
+    if (r_outer < 0 || r_inner > r_outer ||
+        rejects(x0 - r_outer, y0 - r_outer, 2 * r_outer + 1, 2 * r_outer + 1)) {
+        return;
+    }
+
+    int32_t sweep = static_cast<int32_t>(end_deg) - start_deg;
+    bool full = sweep >= 360 || sweep <= -360;
+    if (!full) {
+        sweep = FixedMath::normalizeDeg(sweep);
+        if (sweep == 0) {
+            return;
+        }
+    }
+
+    // 将扇区拆分为上半平面(180~360)和下半平面(0~180)内的角度区间
+    struct AngleRange { int16_t a; int16_t b; };
+    AngleRange lower[2];
+    AngleRange upper[2];
+    uint8_t lower_count = 0;
+    uint8_t upper_count = 0;
+    bool has_zero = full;
+    bool has_180 = full;
+
+    if (!full) {
+        int16_t s = FixedMath::normalizeDeg(start_deg);
+        int32_t e = s + sweep;
+        AngleRange pieces[2] = {{s, static_cast<int16_t>(std::min<int32_t>(e, 360))}, {0, 0}};
+        uint8_t piece_count = 1;
+        if (e > 360) {
+            pieces[1] = {0, static_cast<int16_t>(e - 360)};
+            piece_count = 2;
+        }
+        for (uint8_t i = 0; i < piece_count; i++) {
+            const AngleRange& p = pieces[i];
+            if (p.a == 0 || p.b == 360) has_zero = true;
+            if (p.a <= 180 && p.b >= 180) has_180 = true;
+            if (p.a < 180) lower[lower_count++] = {p.a, std::min<int16_t>(p.b, 180)};
+            if (p.b > 180) upper[upper_count++] = {std::max<int16_t>(p.a, 180), p.b};
+        }
+    }
+
+    // 射线θ与第dy行交点的X坐标：dy·cosθ/sinθ，0/180/360度时为无穷
+    auto rayFloor = [](int32_t dy, int16_t deg) -> int32_t {
+        int32_t s = FixedMath::sinQ14(deg);
+        if (s == 0) return (deg == 180) ? -SPAN_INF : SPAN_INF;
+        return FixedMath::floorDiv(dy * FixedMath::cosQ14(deg), s);
+    };
+    auto rayCeil = [](int32_t dy, int16_t deg) -> int32_t {
+        int32_t s = FixedMath::sinQ14(deg);
+        if (s == 0) return (deg == 180) ? -SPAN_INF : SPAN_INF;
+        return FixedMath::ceilDiv(dy * FixedMath::cosQ14(deg), s);
+    };
+
+    int16_t dy_begin = std::max<int16_t>(-r_outer, clip_.y - y0);
+    int16_t dy_end = std::min<int16_t>(r_outer, clip_.bottom() - 1 - y0);
+    for (int16_t dy = dy_begin; dy <= dy_end; dy++) {
+        int16_t ady = dy < 0 ? -dy : dy;
+
+        // 圆环在该行上的区间
+        int32_t ring[2][2];
+        uint8_t ring_count = 0;
+        int32_t xo = circleHalfWidth(r_outer, ady);
+        if (r_inner > 0 && ady <= r_inner - 1) {
+            int32_t xi = circleHalfWidth(r_inner - 1, ady);
+            ring[ring_count][0] = -xo;
+            ring[ring_count++][1] = -xi - 1;
+            ring[ring_count][0] = xi + 1;
+            ring[ring_count++][1] = xo;
+        } else {
+            ring[ring_count][0] = -xo;
+            ring[ring_count++][1] = xo;
+        }
+
+        // 扇区在该行上的区间
+        int32_t sector[3][2];
+        uint8_t sector_count = 0;
+        if (full) {
+            sector[sector_count][0] = -SPAN_INF;
+            sector[sector_count++][1] = SPAN_INF;
+        } else if (dy > 0) {
+            // 下半平面：θ随x增大而减小
+            for (uint8_t i = 0; i < lower_count; i++) {
+                sector[sector_count][0] = rayCeil(dy, lower[i].b);
+                sector[sector_count++][1] = rayFloor(dy, lower[i].a);
+            }
+        } else if (dy < 0) {
+            // 上半平面：θ随x增大而增大
+            for (uint8_t i = 0; i < upper_count; i++) {
+                sector[sector_count][0] = rayCeil(dy, upper[i].a);
+                sector[sector_count++][1] = rayFloor(dy, upper[i].b);
+            }
+        } else {
+            if (has_180) {
+                sector[sector_count][0] = -SPAN_INF;
+                sector[sector_count++][1] = -1;
+            }
+            sector[sector_count][0] = 0;
+            sector[sector_count++][1] = 0;
+            if (has_zero) {
+                sector[sector_count][0] = 1;
+                sector[sector_count++][1] = SPAN_INF;
+            }
+        }
+
+        for (uint8_t i = 0; i < ring_count; i++) {
+            for (uint8_t j = 0; j < sector_count; j++) {
+                int32_t lo = std::max(ring[i][0], sector[j][0]);
+                int32_t hi = std::min(ring[i][1], sector[j][1]);
+                if (lo <= hi) {
+                    span(static_cast<int16_t>(x0 + lo), static_cast<int16_t>(x0 + hi),
+                         y0 + dy, color);
+                }
+            }
+        }
+    }
+}
+
+uint32_t Rasterizer::rejectedIcons() {
+    return rejected_icons.load(std::memory_order_relaxed);
+}
+
+bool Rasterizer::fitsIcon(const VectorIcon& icon, int16_t x, int16_t y, int16_t size) const {
+    if (!icon.commands || size <= 0 || rejects(x, y, size, size)) {
+        return true;
+    }
+
+    RowSampler row;
+    const int16_t row_begin = std::max(y, clip_.y);
+    const int16_t row_end = std::min<int16_t>(y + size - 1, clip_.bottom() - 1);
+    for (int16_t r = row_begin; r <= row_end; r++) {
+        row.y = r * 256 + 128;
+        row.count = 0;
+        row.overflow = false;
+        IconWalker(x, y, size, row).walk(icon);
+        if (row.overflow) {
+            rejected_icons.fetch_add(1, std::memory_order_relaxed);
+#ifdef ESP_PLATFORM
+            ESP_LOGW(TAG, "Vector icon (%d px) exceeds %d crossings per row", size,
+                     CONFIG_UI_VECTOR_MAX_CROSSINGS);
+#endif
+            return false;
+        }
+    }
+    return true;
+}
+
+bool Rasterizer::fillIcon(const VectorIcon& icon, int16_t x, int16_t y, int16_t size, Color color) {
+    // 丢掉部分交点会使环绕数错乱、填充到轮廓外，有一行放不下就不输出任何扫描段
+    if (!fitsIcon(icon, x, y, size)) {
+        return false;
+    }
+    if (!icon.commands || size <= 0 || rejects(x, y, size, size)) {
+        return true;
+    }
+
+    RowSampler row;
+    const int16_t row_begin = std::max(y, clip_.y);
+    const int16_t row_end = std::min<int16_t>(y + size - 1, clip_.bottom() - 1);
+    for (int16_t r = row_begin; r <= row_end; r++) {
+        row.y = r * 256 + 128;
+        row.count = 0;
+        IconWalker(x, y, size, row).walk(icon);
+
+        // 交点很少，插入排序即可
+        for (uint8_t i = 1; i < row.count; i++) {
+            const Crossing c = row.crossings[i];
+            uint8_t j = i;
+            while (j > 0 && row.crossings[j - 1].x > c.x) {
+                row.crossings[j] = row.crossings[j - 1];
+                j--;
+            }
+            row.crossings[j] = c;
+        }
+
+        // 环绕数从0变为非0处进入轮廓，回到0处离开；填充中心在[left, right)内的像素
+        int32_t winding = 0;
+        int32_t left = 0;
+        for (uint8_t i = 0; i < row.count; i++) {
+            const int32_t before = winding;
+            winding += row.crossings[i].winding;
+            if (before == 0 && winding != 0) {
+                left = row.crossings[i].x;
+            } else if (before != 0 && winding == 0) {
+                const int32_t first = FixedMath::ceilDiv(left - 128, 256);
+                const int32_t last = FixedMath::ceilDiv(row.crossings[i].x - 128, 256) - 1;
+                if (first <= last) {
+                    span(static_cast<int16_t>(first), static_cast<int16_t>(last), r, color);
+                }
+            }
+        }
+    }
+    return true;
+}
+
+} // namespace MinimalUI
@@ -0,0 +1,211 @@
+#include "RenderQueue.h"
+#include "Trace.h"
+
+namespace MinimalUI {
+
+RenderQueue::RenderQueue() {
+    for (uint32_t i = 0; i < CAPACITY; i++) {
+        slots_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+}
+
+bool RenderQueue::push(const RenderCommand& command) {
+    uint32_t pos = head_.load(std::memory_order_relaxed);
+    Slot* slot;
+    for (;;) {
+        slot = &slots_[pos & (CAPACITY - 1)];
+        const uint32_t sequence = slot->sequence.load(std::memory_order_acquire);
+        const int32_t diff = static_cast<int32_t>(sequence - pos);
+        if (diff == 0) {
+            // 槽位空闲：CAS成功即占用该位置，失败时pos被更新为最新值后重试
+            if (head_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                break;
+            }
+        } else if (diff < 0) {
+            // 槽位仍保存着上一圈未执行的命令：队列已满
+            dropped_.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        } else {
+            // 其他生产者已占用该位置
+            pos = head_.load(std::memory_order_relaxed);
+        }
+    }
+    slot->command = command;
+    slot->sequence.store(pos + 1, std::memory_order_release);
+    return true;
+}
+
+RenderCommand RenderQueue::make(RenderOp op, int16_t x, int16_t y, int16_t a, int16_t b, Color color) {
+    RenderCommand command;
+    command.op = op;
+    command.size = 1;
+    command.x = x;
+    command.y = y;
+    command.a = a;
+    command.b = b;
+    command.color = color;
+    command.bg = color;
+    return command;
+}
+
+bool RenderQueue::fillRect(int16_t x, int16_t y, int16_t w, int16_t h, Color color) {
+    return push(make(RenderOp::FILL_RECT, x, y, w, h, color));
+}
+
+bool RenderQueue::drawPixel(int16_t x, int16_t y, Color color) {
+    return push(make(RenderOp::PIXEL, x, y, 0, 0, color));
+}
+
+bool RenderQueue::drawHLine(int16_t x, int16_t y, int16_t w, Color color) {
+    return push(make(RenderOp::HLINE, x, y, w, 0, color));
+}
+
+bool RenderQueue::drawVLine(int16_t x, int16_t y, int16_t h, Color color) {
+    return push(make(RenderOp::VLINE, x, y, h, 0, color));
+}
+
+bool RenderQueue::drawLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, Color color) {
+    return push(make(RenderOp::LINE, x0, y0, x1, y1, color));
+}
+
+bool RenderQueue::drawRect(int16_t x, int16_t y, int16_t w, int16_t h, Color color) {
+    return push(make(RenderOp::RECT, x, y, w, h, color));
+}
+
+bool RenderQueue::drawCircle(int16_t x0, int16_t y0, int16_t r, Color color) {
+    return push(make(RenderOp::CIRCLE, x0, y0, r, 0, color));
+}
+
+bool RenderQueue::fillCircle(int16_t x0, int16_t y0, int16_t r, Color color) {
+    return push(make(RenderOp::FILL_CIRCLE, x0, y0, r, 0, color));
+}
+
+/**
+ * @brief 文本最多取max_bytes字节时实际拷贝的字节数
+ * 切点落在多字节UTF-8序列中间时退回到该序列的首字节之前，
+ * 不留下半个字符（否则绘制时多出一个替换字符）
+ */
+static uint8_t utf8Prefix(const char* text, uint8_t max_bytes) {
+    uint8_t n = 0;
+    while (text[n] && n < max_bytes) {
+        n++;
+    }
+    if (!text[n]) {
+        return n;
+    }
+
+    // 向前跳过最多3个后续字节，找到切点所在序列的首字节
+    uint8_t start = n;
+    while (start > 0 && n - start < 3 && (static_cast<uint8_t>(text[start - 1]) & 0xC0) == 0x80) {
+        start--;
+    }
+    if (start == 0) {
+        return n;
+    }
+    const uint8_t lead = static_cast<uint8_t>(text[start - 1]);
+    const uint8_t length = lead >= 0xF0 ? 4 : lead >= 0xE0 ? 3 : lead >= 0xC0 ? 2 : 1;
+    return start - 1 + length > n ? static_cast<uint8_t>(start - 1) : n;
+}
+
+bool RenderQueue::drawText(int16_t x, int16_t y, const char* text, Color color, Color bg, uint8_t size) {
+    RenderCommand command = make(RenderOp::TEXT, x, y, 0, 0, color);
+    command.bg = bg;
+    command.size = size;
+    const uint8_t n = text ? utf8Prefix(text, RenderCommand::TEXT_CAPACITY - 1) : 0;
+    for (uint8_t i = 0; i < n; i++) {
+        command.text[i] = text[i];
+    }
+    command.text[n] = '\0';
+    return push(command);
+}
+
+bool RenderQueue::clear(Color color) {
+    return push(make(RenderOp::CLEAR, 0, 0, 0, 0, color));
+}
+
+bool RenderQueue::invoke(RenderCommand::Callback fn, void* context) {
+    RenderCommand command = make(RenderOp::INVOKE, 0, 0, 0, 0, 0);
+    command.call.fn = fn;
+    command.call.context = context;
+    return push(command);
+}
+
+bool RenderQueue::display() {
+    return push(make(RenderOp::DISPLAY, 0, 0, 0, 0, 0));
+}
+
+void RenderQueue::execute(const RenderCommand& command, GraphicsDriver* driver) {
+    switch (command.op) {
+        case RenderOp::FILL_RECT:
+            driver->fillRect(command.x, command.y, command.a, command.b, command.color);
+            break;
+        case RenderOp::PIXEL:
+            driver->drawPixel(command.x, command.y, command.color);
+            break;
+        case RenderOp::HLINE:
+            driver->drawHLine(command.x, command.y, command.a, command.color);
+            break;
+        case RenderOp::VLINE:
+            driver->drawVLine(command.x, command.y, command.a, command.color);
+            break;
+        case RenderOp::LINE:
+            driver->drawLine(command.x, command.y, command.a, command.b, command.color);
+            break;
+        case RenderOp::RECT:
+            driver->drawRect(command.x, command.y, command.a, command.b, command.color);
+            break;
+        case RenderOp::CIRCLE:
+            driver->drawCircle(command.x, command.y, command.a, command.color);
+            break;
+        case RenderOp::FILL_CIRCLE:
+            driver->fillCircle(command.x, command.y, command.a, command.color);
+            break;
+        case RenderOp::TEXT:
+            driver->drawText(command.x, command.y, command.text, command.color, command.bg, command.size);
+            break;
+        case RenderOp::CLEAR:
+            driver->clear(command.color);
+            break;
+        case RenderOp::INVOKE:
+            if (command.call.fn) {
+                command.call.fn(driver, command.call.context);
+            }
+            break;
+        case RenderOp::DISPLAY:
+            break;
+    }
+}
+
+size_t RenderQueue::drain(GraphicsDriver* driver, size_t max) {
+    MUI_TRACE_SCOPE("render.drain");
+    size_t count = 0;
+    bool present = false;
+    while (count < max) {
+        Slot& slot = slots_[tail_ & (CAPACITY - 1)];
+        if (slot.sequence.load(std::memory_order_acquire) != tail_ + 1) {
+            // 队列为空，或下一个位置的生产者尚未发布
+            break;
+        }
+        const bool display = slot.command.op == RenderOp::DISPLAY;
+        if (present && !display) {
+            // 刷新请求之后的命令属于下一帧，留到下次drain()
+            break;
+        }
+        if (display) {
+            present = true;
+        } else {
+            execute(slot.command, driver);
+        }
+        // 释放槽位给下一圈的生产者
+        slot.sequence.store(tail_ + CAPACITY, std::memory_order_release);
+        tail_++;
+        count++;
+    }
+    if (present) {
+        driver->display();
+        presented_++;
+    }
+    return count;
+}
+
+} // namespace MinimalUI
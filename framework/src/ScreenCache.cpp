@@ -0,0 +1,176 @@
+#include "ScreenCache.h"
+#include "Trace.h"
+#include <cstring>
+
+namespace MinimalUI {
+
+ScreenCache::ScreenCache(size_t budget, bool compress)
+    : lru_(slots_, MAX_ENTRIES, budget), compress_(compress) {
+    for (Key& key : keys_) {
+        key = Key{0, false, 0};
+    }
+}
+
+int16_t ScreenCache::find(uint16_t page) const {
+    for (uint8_t i = 0; i < MAX_ENTRIES; i++) {
+        if (lru_.occupied(i) && keys_[i].page == page) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+bool ScreenCache::store(uint16_t page, const uint8_t* data, size_t size) {
+    MUI_TRACE_SCOPE("cache.store");
+    // 旧快照先丢弃，新快照保存失败时该页面视为未缓存
+    invalidate(page);
+
+    // 先只计算编码长度，再直接编码到快照自己的内存中，不需要容量之外的临时缓冲区
+    size_t stored = size;
+    bool compressed = false;
+    if (compress_) {
+        const size_t encoded = encode(data, size, nullptr, encodeBound(size));
+        if (encoded > 0 && encoded < size) {
+            stored = encoded;
+            compressed = true;
+        }
+    }
+
+    const int16_t index = lru_.insert(stored);
+    if (index < 0) {
+        return false;
+    }
+    uint8_t* snapshot = lru_.data(static_cast<uint8_t>(index));
+    if (compressed) {
+        encode(data, size, snapshot, stored);
+    } else {
+        memcpy(snapshot, data, size);
+    }
+    keys_[index] = Key{page, compressed, size};
+    return true;
+}
+
+bool ScreenCache::load(uint16_t page, uint8_t* out, size_t size) {
+    MUI_TRACE_SCOPE("cache.load");
+    CacheStats& stats = lru_.stats();
+    const int16_t found = find(page);
+    if (found < 0 || keys_[found].raw_size != size) {
+        stats.misses++;
+        return false;
+    }
+    const uint8_t index = static_cast<uint8_t>(found);
+    if (keys_[index].compressed) {
+        // 先完整校验一遍再解码到out：out通常是正在显示的帧缓冲区，
+        // 解码中途失败时不能留下半页快照
+        if (!decode(lru_.data(index), lru_.bytes(index), nullptr, size)) {
+            // 编码由store()生成，解码失败不应出现；丢弃损坏的快照
+            lru_.release(index);
+            stats.misses++;
+            return false;
+        }
+        decode(lru_.data(index), lru_.bytes(index), out, size);
+    } else {
+        memcpy(out, lru_.data(index), size);
+    }
+    lru_.touch(index);
+    stats.hits++;
+    return true;
+}
+
+bool ScreenCache::contains(uint16_t page) const {
+    return find(page) >= 0;
+}
+
+void ScreenCache::invalidate(uint16_t page) {
+    const int16_t index = find(page);
+    if (index >= 0) {
+        lru_.release(static_cast<uint8_t>(index));
+    }
+}
+
+void ScreenCache::clear() {
+    lru_.clear();
+}
+
+size_t ScreenCache::encode(const uint8_t* in, size_t size, uint8_t* out, size_t capacity) {
+    size_t o = 0;
+    size_t i = 0;
+    size_t literal_start = 0;   // 尚未输出的原样字节从这里开始
+
+    auto flushLiterals = [&](size_t end) -> bool {
+        while (literal_start < end) {
+            size_t n = end - literal_start;
+            if (n > 128) {
+                n = 128;
+            }
+            if (o + 1 + n > capacity) {
+                return false;
+            }
+            if (out) {
+                out[o] = static_cast<uint8_t>(n - 1);
+                memcpy(out + o + 1, in + literal_start, n);
+            }
+            o += 1 + n;
+            literal_start += n;
+        }
+        return true;
+    };
+
+    while (i < size) {
+        // 从i开始的重复长度，最多130
+        size_t run = 1;
+        while (i + run < size && run < 130 && in[i + run] == in[i]) {
+            run++;
+        }
+        if (run < 3) {
+            i += run;
+            continue;
+        }
+        if (!flushLiterals(i) || o + 2 > capacity) {
+            return 0;
+        }
+        if (out) {
+            out[o] = static_cast<uint8_t>(0x80 + run - 3);
+            out[o + 1] = in[i];
+        }
+        o += 2;
+        i += run;
+        literal_start = i;
+    }
+    if (!flushLiterals(size)) {
+        return 0;
+    }
+    return o;
+}
+
+bool ScreenCache::decode(const uint8_t* in, size_t in_size, uint8_t* out, size_t size) {
+    size_t i = 0;
+    size_t o = 0;
+    while (i < in_size) {
+        const uint8_t control = in[i++];
+        if (control < 0x80) {
+            const size_t n = control + 1u;
+            if (i + n > in_size || o + n > size) {
+                return false;
+            }
+            if (out) {
+                memcpy(out + o, in + i, n);
+            }
+            i += n;
+            o += n;
+        } else {
+            const size_t n = control - 0x80u + 3u;
+            if (i >= in_size || o + n > size) {
+                return false;
+            }
+            if (out) {
+                memset(out + o, in[i], n);
+            }
+            i++;
+            o += n;
+        }
+    }
+    return o == size;
+}
+
+} // namespace MinimalUI
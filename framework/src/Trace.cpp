@@ -0,0 +1,128 @@
+#include "Trace.h"
+#include <atomic>
+
+#ifdef ESP_PLATFORM
+#include <esp_timer.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#else
+#include <chrono>
+#endif
+#include <cstdint>
+
+namespace MinimalUI {
+namespace Trace {
+
+static_assert((RING_SIZE & (RING_SIZE - 1)) == 0, "RING_SIZE must be a power of two");
+
+// 每个核心一个环形缓冲区，同一核心上的任务和中断通过原子加法分配位置
+struct Ring {
+    Record records[RING_SIZE];
+    std::atomic<uint32_t> head{0};
+};
+
+static Ring rings[MAX_CORES];
+static std::atomic<bool> tracing{false};
+
+static inline uint8_t currentCore() {
+#ifdef ESP_PLATFORM
+    return static_cast<uint8_t>(xPortGetCoreID() % MAX_CORES);
+#else
+    return 0;
+#endif
+}
+
+// 当前任务的标识，导出为tid：同一核心上的不同任务各自成行，区间不会相互嵌套
+static inline uint32_t currentTask(uint8_t core) {
+#ifdef ESP_PLATFORM
+    if (xPortInIsrContext()) {
+        return core;   // 中断按核心归为一行；任务句柄是指针，不会与之冲突
+    }
+    return static_cast<uint32_t>(reinterpret_cast<uintptr_t>(xTaskGetCurrentTaskHandle()));
+#else
+    (void)core;
+    static std::atomic<uint32_t> next_thread{1};
+    static thread_local const uint32_t thread = next_thread.fetch_add(1, std::memory_order_relaxed);
+    return thread;
+#endif
+}
+
+void enable(bool on) {
+    tracing.store(on, std::memory_order_relaxed);
+}
+
+bool enabled() {
+    return tracing.load(std::memory_order_relaxed);
+}
+
+uint32_t now() {
+#ifdef ESP_PLATFORM
+    return static_cast<uint32_t>(esp_timer_get_time());
+#else
+    using namespace std::chrono;
+    return static_cast<uint32_t>(duration_cast<microseconds>(steady_clock::now().time_since_epoch()).count());
+#endif
+}
+
+void record(const char* name, Phase phase, uint32_t id) {
+    const uint8_t core = currentCore();
+    Ring& ring = rings[core];
+    const uint32_t index = ring.head.fetch_add(1, std::memory_order_relaxed) & (RING_SIZE - 1);
+    Record& r = ring.records[index];
+    r.time_us = now();
+    r.name = name;
+    r.id = id;
+    r.task = currentTask(core);
+    r.phase = phase;
+    r.core = core;
+}
+
+void clear() {
+    for (Ring& ring : rings) {
+        ring.head.store(0, std::memory_order_relaxed);
+    }
+}
+
+size_t dump(FILE* out) {
+    static const char* const PHASES[] = {"B", "E", "i", "b", "e"};
+
+    size_t count = 0;
+    fputs("{\"traceEvents\":[\n", out);
+    for (uint8_t core = 0; core < MAX_CORES; core++) {
+        const Ring& ring = rings[core];
+        const uint32_t head = ring.head.load(std::memory_order_acquire);
+        const uint32_t n = head < RING_SIZE ? head : RING_SIZE;
+
+        // 环形缓冲区回绕后，最旧记录的结束事件可能没有对应的开始事件，
+        // Chrome会忽略这些不成对的记录
+        for (uint32_t i = head - n; i != head; i++) {
+            const Record& r = ring.records[i & (RING_SIZE - 1)];
+            fprintf(out, "%s{\"name\":\"%s\",\"cat\":\"ui\",\"ph\":\"%s\",\"ts\":%u,\"pid\":0,\"tid\":%u,"
+                    "\"args\":{\"core\":%u}",
+                    count ? ",\n" : "", r.name ? r.name : "?", PHASES[static_cast<uint8_t>(r.phase)],
+                    static_cast<unsigned>(r.time_us), static_cast<unsigned>(r.task), static_cast<unsigned>(r.core));
+            if (r.phase == Phase::INSTANT) {
+                fputs(",\"s\":\"t\"", out);
+            } else if (r.phase == Phase::ASYNC_BEGIN || r.phase == Phase::ASYNC_END) {
+                fprintf(out, ",\"id\":%u", static_cast<unsigned>(r.id));
+            }
+            fputc('}', out);
+            count++;
+        }
+    }
+    fputs("\n],\"displayTimeUnit\":\"ms\"}\n", out);
+    fflush(out);
+    return count;
+}
+
+bool dumpToFile(const char* path) {
+    FILE* out = fopen(path, "w");
+    if (!out) {
+        return false;
+    }
+    dump(out);
+    return fclose(out) == 0;
+}
+
+} // namespace Trace
+} // namespace MinimalUI
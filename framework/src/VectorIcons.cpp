@@ -0,0 +1,45 @@
+#include "VectorIcon.h"
+
+namespace MinimalUI {
+
+// 外轮廓在屏幕坐标中顺时针，镂空部分逆时针
+
+// 房屋：屋顶、墙体和底边开口的门
+static const int16_t ICON_HOME_PATH[] = {
+    MUI_ICON_MOVE(128, 24), MUI_ICON_LINE(240, 128), MUI_ICON_LINE(208, 128), MUI_ICON_LINE(208, 232),
+    MUI_ICON_LINE(48, 232), MUI_ICON_LINE(48, 128), MUI_ICON_LINE(16, 128),
+    MUI_ICON_MOVE(104, 232), MUI_ICON_LINE(152, 232), MUI_ICON_LINE(152, 168), MUI_ICON_LINE(104, 168),
+    MUI_ICON_END,
+};
+
+// 实心圆中镂空的对勾
+static const int16_t ICON_CHECK_PATH[] = {
+    MUI_ICON_ARC(128, 128, 120, 0, 360),
+    MUI_ICON_MOVE(112, 180), MUI_ICON_LINE(196, 96), MUI_ICON_LINE(172, 72), MUI_ICON_LINE(112, 132),
+    MUI_ICON_LINE(88, 108), MUI_ICON_LINE(64, 132),
+    MUI_ICON_END,
+};
+
+// 三道信号弧和底部的圆点
+static const int16_t ICON_WIFI_PATH[] = {
+    MUI_ICON_ARC(128, 208, 176, 225, 315), MUI_ICON_ARC(128, 208, 144, 315, 225), MUI_ICON_CLOSE,
+    MUI_ICON_ARC(128, 208, 120, 225, 315), MUI_ICON_ARC(128, 208, 88, 315, 225), MUI_ICON_CLOSE,
+    MUI_ICON_ARC(128, 208, 64, 225, 315), MUI_ICON_ARC(128, 208, 32, 315, 225), MUI_ICON_CLOSE,
+    MUI_ICON_ARC(128, 208, 20, 0, 360),
+    MUI_ICON_END,
+};
+
+// 铃铛：二次曲线的铃身和半圆铃舌
+static const int16_t ICON_BELL_PATH[] = {
+    MUI_ICON_MOVE(128, 24), MUI_ICON_QUAD(200, 24, 200, 120), MUI_ICON_LINE(208, 184), MUI_ICON_LINE(232, 200),
+    MUI_ICON_LINE(24, 200), MUI_ICON_LINE(48, 184), MUI_ICON_LINE(56, 120), MUI_ICON_QUAD(56, 24, 128, 24),
+    MUI_ICON_CLOSE, MUI_ICON_ARC(128, 208, 28, 0, 180),
+    MUI_ICON_END,
+};
+
+const VectorIcon ICON_HOME = {ICON_HOME_PATH, sizeof(ICON_HOME_PATH) / sizeof(ICON_HOME_PATH[0])};
+const VectorIcon ICON_CHECK = {ICON_CHECK_PATH, sizeof(ICON_CHECK_PATH) / sizeof(ICON_CHECK_PATH[0])};
+const VectorIcon ICON_WIFI = {ICON_WIFI_PATH, sizeof(ICON_WIFI_PATH) / sizeof(ICON_WIFI_PATH[0])};
+const VectorIcon ICON_BELL = {ICON_BELL_PATH, sizeof(ICON_BELL_PATH) / sizeof(ICON_BELL_PATH[0])};
+
+} // namespace MinimalUI
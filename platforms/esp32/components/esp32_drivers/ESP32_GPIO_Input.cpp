@@ -0,0 +1,140 @@
+#include "ESP32_GPIO_Input.h"
+#include <esp_log.h>
+
+namespace MinimalUI {
+
+static const char* TAG = "ESP32_GPIO_Input";
+
+ESP32_GPIO_Input::ESP32_GPIO_Input(const ESP32_GPIO_InputConfig& config)
+    : config_(config), decoder_(config.encoder_steps), encoder_delta_(0),
+      timer_(nullptr), isr_added_(false) {
+    if (config_.button_count > ESP32_GPIO_InputConfig::MAX_BUTTONS) {
+        config_.button_count = ESP32_GPIO_InputConfig::MAX_BUTTONS;
+    }
+    for (uint8_t i = 0; i < config_.button_count; i++) {
+        debouncers_[i] = ButtonDebouncer(config_.debounce_samples);
+    }
+}
+
+ESP32_GPIO_Input::~ESP32_GPIO_Input() {
+    shutdown();
+}
+
+bool ESP32_GPIO_Input::initialize() {
+    // 按键：输入，按下为低电平时上拉，否则下拉
+    for (uint8_t i = 0; i < config_.button_count; i++) {
+        const ESP32_ButtonConfig& button = config_.buttons[i];
+        if (button.pin < 0) {
+            continue;
+        }
+        gpio_config_t io_conf = {};
+        io_conf.pin_bit_mask = 1ULL << button.pin;
+        io_conf.mode = GPIO_MODE_INPUT;
+        io_conf.pull_up_en = button.active_low ? GPIO_PULLUP_ENABLE : GPIO_PULLUP_DISABLE;
+        io_conf.pull_down_en = button.active_low ? GPIO_PULLDOWN_DISABLE : GPIO_PULLDOWN_ENABLE;
+        io_conf.intr_type = GPIO_INTR_DISABLE;
+        gpio_config(&io_conf);
+    }
+
+    if (hasEncoder()) {
+        gpio_config_t io_conf = {};
+        io_conf.pin_bit_mask = (1ULL << config_.encoder_a) | (1ULL << config_.encoder_b);
+        io_conf.mode = GPIO_MODE_INPUT;
+        io_conf.pull_up_en = GPIO_PULLUP_ENABLE;
+        io_conf.pull_down_en = GPIO_PULLDOWN_DISABLE;
+        io_conf.intr_type = GPIO_INTR_ANYEDGE;
+        gpio_config(&io_conf);
+
+        // 中断服务可能已被其他驱动安装
+        esp_err_t ret = gpio_install_isr_service(0);
+        if (ret != ESP_OK && ret != ESP_ERR_INVALID_STATE) {
+            ESP_LOGE(TAG, "Failed to install GPIO ISR service: %s", esp_err_to_name(ret));
+            return false;
+        }
+        decoder_.update(gpio_get_level((gpio_num_t)config_.encoder_a),
+                        gpio_get_level((gpio_num_t)config_.encoder_b));
+        gpio_isr_handler_add((gpio_num_t)config_.encoder_a, encoderIsr, this);
+        gpio_isr_handler_add((gpio_num_t)config_.encoder_b, encoderIsr, this);
+        isr_added_ = true;
+    }
+
+    esp_timer_create_args_t timer_args = {};
+    timer_args.callback = sampleCallback;
+    timer_args.arg = this;
+    timer_args.dispatch_method = ESP_TIMER_TASK;
+    timer_args.name = "gpio_input";
+    timer_args.skip_unhandled_events = true;
+    if (esp_timer_create(&timer_args, &timer_) != ESP_OK ||
+        esp_timer_start_periodic(timer_, config_.sample_period_us) != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to start sample timer");
+        shutdown();
+        return false;
+    }
+
+    ESP_LOGI(TAG, "GPIO input started: %d buttons, encoder %s",
+             config_.button_count, hasEncoder() ? "on" : "off");
+    return true;
+}
+
+void ESP32_GPIO_Input::shutdown() {
+    if (timer_) {
+        esp_timer_stop(timer_);
+        esp_timer_delete(timer_);
+        timer_ = nullptr;
+    }
+    if (isr_added_) {
+        gpio_isr_handler_remove((gpio_num_t)config_.encoder_a);
+        gpio_isr_handler_remove((gpio_num_t)config_.encoder_b);
+        isr_added_ = false;
+    }
+}
+
+void ESP32_GPIO_Input::sampleCallback(void* arg) {
+    static_cast<ESP32_GPIO_Input*>(arg)->sample();
+}
+
+// 不放在IRAM：QuadratureDecoder::update()和gpio_get_level()都在flash中。
+// 中断服务以flags 0安装，flash缓存关闭期间（写flash时）中断推迟到缓存恢复后执行
+void ESP32_GPIO_Input::encoderIsr(void* arg) {
+    auto* self = static_cast<ESP32_GPIO_Input*>(arg);
+    int8_t step = self->decoder_.update(gpio_get_level((gpio_num_t)self->config_.encoder_a),
+                                        gpio_get_level((gpio_num_t)self->config_.encoder_b));
+    if (step != 0) {
+        self->encoder_delta_.fetch_add(step, std::memory_order_relaxed);
+    }
+}
+
+void ESP32_GPIO_Input::sample() {
+    const uint32_t now_ms = static_cast<uint32_t>(esp_timer_get_time() / 1000);
+
+    for (uint8_t i = 0; i < config_.button_count; i++) {
+        const ESP32_ButtonConfig& button = config_.buttons[i];
+        if (button.pin < 0) {
+            continue;
+        }
+        bool raw = gpio_get_level((gpio_num_t)button.pin) != (button.active_low ? 1 : 0);
+        if (debouncers_[i].update(raw)) {
+            InputEvent event = {};
+            event.type = debouncers_[i].pressed() ? InputEventType::BUTTON_DOWN : InputEventType::BUTTON_UP;
+            event.id = i;
+            event.time_ms = now_ms;
+            queue_.push(event);
+        }
+    }
+
+    // 一个采样周期内的所有编码器步数合并为一个事件
+    int16_t delta = encoder_delta_.exchange(0, std::memory_order_relaxed);
+    if (delta != 0) {
+        InputEvent event = {};
+        event.type = InputEventType::ENCODER;
+        event.id = 0;
+        event.x = delta;
+        event.time_ms = now_ms;
+        if (!queue_.push(event)) {
+            // 队列满时把步数留到下次，不丢失旋转量
+            encoder_delta_.fetch_add(delta, std::memory_order_relaxed);
+        }
+    }
+}
+
+} // namespace MinimalUI
@@ -0,0 +1,68 @@
+#pragma once
+
+#include "InputDriver.h"
+#include <driver/gpio.h>
+#include <esp_timer.h>
+#include <atomic>
+#include <cstdint>
+
+namespace MinimalUI {
+
+/**
+ * @brief 单个按键配置
+ */
+struct ESP32_ButtonConfig {
+    int8_t pin = -1;         // GPIO引脚
+    bool active_low = true;  // 按下时为低电平（使用内部上拉）
+};
+
+/**
+ * @brief GPIO按键/旋转编码器配置
+ */
+struct ESP32_GPIO_InputConfig {
+    static constexpr uint8_t MAX_BUTTONS = 8;
+
+    ESP32_ButtonConfig buttons[MAX_BUTTONS]; // 按键，事件id为数组下标
+    uint8_t button_count = 0;
+    int8_t encoder_a = -1;           // 编码器A相，-1表示不使用编码器
+    int8_t encoder_b = -1;           // 编码器B相
+    uint8_t encoder_steps = 4;       // 每格的四分之一步数
+    uint32_t sample_period_us = 1000; // 按键采样周期
+    uint8_t debounce_samples = 5;    // 去抖所需的连续一致采样数
+};
+
+/**
+ * @class ESP32_GPIO_Input
+ * @brief GPIO按键和旋转编码器输入
+ *
+ * 按键由esp_timer周期采样并积分去抖；编码器两相在GPIO边沿中断中解码，
+ * 步数累计后由采样回调合并为一个ENCODER事件，快速旋转时不会塞满队列。
+ */
+class ESP32_GPIO_Input : public InputDriver {
+public:
+    explicit ESP32_GPIO_Input(const ESP32_GPIO_InputConfig& config);
+    ~ESP32_GPIO_Input() override;
+
+    bool initialize() override;
+
+    /**
+     * @brief 停止采样并释放中断和定时器
+     */
+    void shutdown();
+
+private:
+    ESP32_GPIO_InputConfig config_;
+    ButtonDebouncer debouncers_[ESP32_GPIO_InputConfig::MAX_BUTTONS];
+    QuadratureDecoder decoder_;
+    std::atomic<int16_t> encoder_delta_;  // 中断中累计、采样回调中取走
+    esp_timer_handle_t timer_;
+    bool isr_added_;
+
+    bool hasEncoder() const { return config_.encoder_a >= 0 && config_.encoder_b >= 0; }
+    void sample();
+
+    static void sampleCallback(void* arg);
+    static void encoderIsr(void* arg);
+};
+
+} // namespace MinimalUI
@@ -0,0 +1,51 @@
+#include "ESP32_SPI_Bus.h"
+#include <esp_log.h>
+
+namespace MinimalUI {
+
+static const char* TAG = "ESP32_SPI_Bus";
+
+std::mutex ESP32_SPI_Bus::registry_mutex_;
+ESP32_SPI_Bus* ESP32_SPI_Bus::buses_[ESP32_SPI_Bus::MAX_HOSTS] = {};
+
+ESP32_SPI_Bus* ESP32_SPI_Bus::acquire(spi_host_device_t host, const spi_bus_config_t& bus_cfg) {
+    if (static_cast<int>(host) < 0 || static_cast<int>(host) >= MAX_HOSTS) {
+        ESP_LOGE(TAG, "Invalid SPI host %d", static_cast<int>(host));
+        return nullptr;
+    }
+
+    std::lock_guard<std::mutex> lock(registry_mutex_);
+    ESP32_SPI_Bus*& bus = buses_[host];
+    if (!bus) {
+        esp_err_t ret = spi_bus_initialize(host, &bus_cfg, SPI_DMA_CH_AUTO);
+        if (ret != ESP_OK) {
+            ESP_LOGE(TAG, "Failed to initialize SPI bus: %s", esp_err_to_name(ret));
+            return nullptr;
+        }
+        bus = new ESP32_SPI_Bus(host);
+        ESP_LOGI(TAG, "SPI bus %d initialized", static_cast<int>(host));
+    }
+
+    bus->ref_count_++;
+    ESP_LOGD(TAG, "SPI bus %d acquired, %d users", static_cast<int>(host), bus->ref_count_);
+    return bus;
+}
+
+void ESP32_SPI_Bus::release(ESP32_SPI_Bus* bus) {
+    if (!bus) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(registry_mutex_);
+    if (bus->ref_count_ > 0 && --bus->ref_count_ > 0) {
+        return;
+    }
+
+    spi_host_device_t host = bus->host_;
+    buses_[host] = nullptr;
+    delete bus;
+    spi_bus_free(host);
+    ESP_LOGI(TAG, "SPI bus %d freed", static_cast<int>(host));
+}
+
+} // namespace MinimalUI
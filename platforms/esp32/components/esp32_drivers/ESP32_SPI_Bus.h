@@ -0,0 +1,50 @@
+#pragma once
+
+#include "BusArbiter.h"
+#include <driver/spi_master.h>
+#include <cstdint>
+#include <mutex>
+
+namespace MinimalUI {
+
+/**
+ * @class ESP32_SPI_Bus
+ * @brief ESP32 SPI总线的共享所有权
+ *
+ * 同一SPI主机上的多个设备共享一个总线实例：第一个使用者初始化总线，
+ * 最后一个使用者释放总线。每条总线附带一个BusArbiter，
+ * 用于在设备之间轮询分配总线并保证单帧传输连续。
+ */
+class ESP32_SPI_Bus {
+public:
+    /**
+     * @brief 获取（必要时初始化）指定主机上的总线
+     * @param host SPI主机
+     * @param bus_cfg 总线配置，仅在首次初始化时生效
+     * @return 总线实例，初始化失败时返回nullptr
+     */
+    static ESP32_SPI_Bus* acquire(spi_host_device_t host, const spi_bus_config_t& bus_cfg);
+
+    /**
+     * @brief 释放一次引用，引用计数归零时释放总线
+     */
+    static void release(ESP32_SPI_Bus* bus);
+
+    spi_host_device_t host() const { return host_; }
+    BusArbiter& arbiter() { return arbiter_; }
+
+private:
+    // ESP32系列最多有SPI1~SPI3三个主机
+    static constexpr uint8_t MAX_HOSTS = 3;
+
+    static std::mutex registry_mutex_;
+    static ESP32_SPI_Bus* buses_[MAX_HOSTS];
+
+    explicit ESP32_SPI_Bus(spi_host_device_t host) : host_(host), ref_count_(0) {}
+
+    spi_host_device_t host_;
+    uint8_t ref_count_;
+    BusArbiter arbiter_;
+};
+
+} // namespace MinimalUI
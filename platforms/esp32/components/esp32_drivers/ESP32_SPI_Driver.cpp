@@ -1,17 +1,28 @@
 #include "ESP32_SPI_Driver.h"
+#include "ESP32_SPI_Bus.h"
 #include "controllers/DisplayController.h"
+#include "Rasterizer.h"
+#include "ScreenCache.h"
+#include "Dither.h"
+#include "Trace.h"
+#include <algorithm>
+#include <cstdlib>
 #include <cstring>
 #include <driver/gpio.h>
 #include <freertos/FreeRTOS.h>
 #include <freertos/task.h>
 #include <esp_log.h>
+#include <esp_timer.h>
+#include <esp_rom_sys.h>
 
 namespace MinimalUI {
 
 static const char* TAG = "ESP32_SPI_Driver";
 
 ESP32_SPI_Driver::ESP32_SPI_Driver(const ESP32_SPI_Config& config, std::unique_ptr<DisplayController> controller)
-    : config_(config), spi_(nullptr), controller_(std::move(controller)) {
+    : config_(config), spi_(nullptr), bus_(nullptr), bus_device_id_(-1), bus_hold_depth_(0),
+      controller_(std::move(controller)), init_state_(InitState::IDLE), init_start_us_(0),
+      init_deadline_us_(0), fill_color_(0), fill_pixel_size_(0) {
     ESP_LOGI(TAG, "ESP32_SPI_Driver created with controller");
 }
 
@@ -21,20 +32,102 @@ ESP32_SPI_Driver::~ESP32_SPI_Driver() {
 }
 
 bool ESP32_SPI_Driver::initialize() {
+    if (!beginInitialize()) {
+        return false;
+    }
+    
+    uint32_t wait_ms = 0;
+    InitState state;
+    while ((state = pollInitialize(&wait_ms)) != InitState::READY && state != InitState::FAILED) {
+        vTaskDelay(pdMS_TO_TICKS(wait_ms > 0 ? wait_ms : 1));
+    }
+    return state == InitState::READY;
+}
+
+bool ESP32_SPI_Driver::beginInitialize() {
     ESP_LOGI(TAG, "Initializing ESP32 SPI Driver");
+    init_start_us_ = esp_timer_get_time();
     
     if (!controller_) {
         ESP_LOGE(TAG, "No display controller provided");
+        init_state_ = InitState::FAILED;
         return false;
     }
     
     // 初始化SPI硬件
     if (!initSPI()) {
+        init_state_ = InitState::FAILED;
         return false;
     }
     
-    // 初始化显示控制器
-    return controller_->initialize(this);
+    // 硬件复位：低电平脉冲只需数微秒，恢复时间由控制器给出，等待期间不阻塞
+    init_deadline_us_ = esp_timer_get_time();
+    if (config_.rst_pin >= 0) {
+        gpio_set_level((gpio_num_t)config_.rst_pin, 0);
+        esp_rom_delay_us(10);
+        gpio_set_level((gpio_num_t)config_.rst_pin, 1);
+        init_deadline_us_ += static_cast<int64_t>(controller_->resetRecoveryMs()) * 1000;
+    }
+    init_state_ = InitState::RESET_RECOVERY;
+    return true;
+}
+
+ESP32_SPI_Driver::InitState ESP32_SPI_Driver::pollInitialize(uint32_t* wait_ms) {
+    if (wait_ms) {
+        *wait_ms = 0;
+    }
+    
+    while (init_state_ == InitState::RESET_RECOVERY || init_state_ == InitState::CONTROLLER) {
+        int64_t now = esp_timer_get_time();
+        if (now < init_deadline_us_) {
+            if (wait_ms) {
+                *wait_ms = static_cast<uint32_t>((init_deadline_us_ - now + 999) / 1000);
+            }
+            break;
+        }
+        
+        if (init_state_ == InitState::RESET_RECOVERY) {
+            // 不支持非阻塞初始化的控制器在beginInit()中完成全部初始化
+            init_state_ = controller_->beginInit(this) ? InitState::CONTROLLER : InitState::FAILED;
+            continue;
+        }
+        
+        uint32_t controller_wait = 0;
+        if (!controller_->pollInit(controller_wait)) {
+            init_deadline_us_ = now + static_cast<int64_t>(controller_wait) * 1000;
+            continue;
+        }
+        
+        if (!createIndexedFramebuffer()) {
+            init_state_ = InitState::FAILED;
+            break;
+        }
+        init_state_ = InitState::READY;
+        ESP_LOGI(TAG, "Display ready %lld us after beginInitialize()",
+                 static_cast<long long>(esp_timer_get_time() - init_start_us_));
+    }
+    return init_state_;
+}
+
+bool ESP32_SPI_Driver::createIndexedFramebuffer() {
+    // 按配置创建调色板帧缓冲区，之后的绘制只写内存，display()时统一发送
+    if (config_.indexed_bpp == 0) {
+        return true;
+    }
+    if (controller_->getPixelSize() != 2) {
+        ESP_LOGW(TAG, "Indexed framebuffer requires an RGB565 controller, drawing directly");
+        return true;
+    }
+    indexed_fb_.reset(new IndexedFramebuffer(controller_->getWidth(), controller_->getHeight(),
+                                             config_.indexed_bpp));
+    if (!indexed_fb_->valid()) {
+        ESP_LOGE(TAG, "Failed to allocate %d bpp framebuffer", config_.indexed_bpp);
+        indexed_fb_.reset();
+        return false;
+    }
+    ESP_LOGI(TAG, "Indexed framebuffer: %d bpp, %zu bytes",
+             indexed_fb_->bpp(), indexed_fb_->bufferSize());
+    return true;
 }
 
 bool ESP32_SPI_Driver::initSPI() {
@@ -64,9 +157,9 @@ bool ESP32_SPI_Driver::initSPI() {
         .intr_flags = 0
     };
     
-    esp_err_t ret = spi_bus_initialize(config_.spi_host, &bus_cfg, SPI_DMA_CH_AUTO);
-    if (ret != ESP_OK) {
-        ESP_LOGE(TAG, "Failed to initialize SPI bus: %s", esp_err_to_name(ret));
+    // 总线由同一主机上的所有设备共享，首个设备负责初始化
+    bus_ = ESP32_SPI_Bus::acquire(config_.spi_host, bus_cfg);
+    if (!bus_) {
         return false;
     }
     
@@ -81,25 +174,27 @@ bool ESP32_SPI_Driver::initSPI() {
         .post_cb = nullptr
     };
     
-    ret = spi_bus_add_device(config_.spi_host, &dev_cfg, &spi_);
+    esp_err_t ret = spi_bus_add_device(config_.spi_host, &dev_cfg, &spi_);
     if (ret != ESP_OK) {
         ESP_LOGE(TAG, "Failed to add SPI device: %s", esp_err_to_name(ret));
-        spi_bus_free(config_.spi_host);
+        spi_ = nullptr;
+        ESP32_SPI_Bus::release(bus_);
+        bus_ = nullptr;
+        return false;
+    }
+    
+    bus_device_id_ = bus_->arbiter().registerDevice();
+    if (bus_device_id_ < 0) {
+        ESP_LOGE(TAG, "Too many devices on SPI bus %d", static_cast<int>(config_.spi_host));
+        freeSPI();
         return false;
     }
     
     // 设置GPIO初始状态
     gpio_set_level((gpio_num_t)config_.cs_pin, 1);
     gpio_set_level((gpio_num_t)config_.dc_pin, 1);
-    
     if (config_.rst_pin >= 0) {
-        // 硬件复位
-        gpio_set_level((gpio_num_t)config_.rst_pin, 1);
-        vTaskDelay(pdMS_TO_TICKS(10));
-        gpio_set_level((gpio_num_t)config_.rst_pin, 0);
-        vTaskDelay(pdMS_TO_TICKS(10));
         gpio_set_level((gpio_num_t)config_.rst_pin, 1);
-        vTaskDelay(pdMS_TO_TICKS(120));
     }
     
     ESP_LOGI(TAG, "SPI hardware initialized successfully");
@@ -108,14 +203,42 @@ bool ESP32_SPI_Driver::initSPI() {
 
 void ESP32_SPI_Driver::freeSPI() {
     if (spi_) {
+        if (bus_device_id_ >= 0) {
+            bus_->arbiter().unregisterDevice(bus_device_id_);
+            bus_device_id_ = -1;
+        }
         spi_bus_remove_device(spi_);
-        spi_bus_free(config_.spi_host);
         spi_ = nullptr;
+        
+        // 只释放本设备的引用，总线在最后一个设备移除后才真正释放
+        ESP32_SPI_Bus::release(bus_);
+        bus_ = nullptr;
         ESP_LOGI(TAG, "SPI resources released");
     }
 }
 
+void ESP32_SPI_Driver::beginFrame() {
+    if (!bus_) return;
+    
+    // 帧内的调用（包括逐字节的sendCommand/sendData）只增加嵌套深度，不再访问仲裁器
+    if (bus_hold_depth_++ > 0) return;
+    
+    // 仲裁器保证设备间轮询；同时锁定ESP-IDF总线，
+    // 使手动控制的CS在整帧期间不会与其他设备（如SD卡）的传输重叠
+    bus_->arbiter().acquire(bus_device_id_);
+    spi_device_acquire_bus(spi_, portMAX_DELAY);
+}
+
+void ESP32_SPI_Driver::endFrame() {
+    if (!bus_ || bus_hold_depth_ == 0) return;
+    
+    if (--bus_hold_depth_ > 0) return;
+    spi_device_release_bus(spi_);
+    bus_->arbiter().release(bus_device_id_);
+}
+
 void ESP32_SPI_Driver::sendCommand(uint8_t cmd) {
+    beginFrame();
     gpio_set_level((gpio_num_t)config_.dc_pin, 0);  // DC低电平表示命令
     gpio_set_level((gpio_num_t)config_.cs_pin, 0);  // 选中芯片
     
@@ -126,9 +249,11 @@ void ESP32_SPI_Driver::sendCommand(uint8_t cmd) {
     }
     
     gpio_set_level((gpio_num_t)config_.cs_pin, 1);  // 取消选中
+    endFrame();
 }
 
 void ESP32_SPI_Driver::sendData(uint8_t data) {
+    beginFrame();
     gpio_set_level((gpio_num_t)config_.dc_pin, 1);  // DC高电平表示数据
     gpio_set_level((gpio_num_t)config_.cs_pin, 0);  // 选中芯片
     
@@ -139,10 +264,21 @@ void ESP32_SPI_Driver::sendData(uint8_t data) {
     }
     
     gpio_set_level((gpio_num_t)config_.cs_pin, 1);  // 取消选中
+    endFrame();
 }
 
 void ESP32_SPI_Driver::sendBuffer(const uint8_t* buffer, size_t size) {
-    gpio_set_level((gpio_num_t)config_.dc_pin, 1);  // DC高电平表示数据
+    transmit(buffer, size, 1);  // DC高电平表示数据
+}
+
+void ESP32_SPI_Driver::sendCommands(const uint8_t* cmds, size_t count) {
+    // 连续命令（含SSD13xx的命令参数）在一次片选内发送，而不是每字节一次事务
+    transmit(cmds, count, 0);
+}
+
+void ESP32_SPI_Driver::transmit(const uint8_t* buffer, size_t size, uint32_t dc_level) {
+    beginFrame();
+    gpio_set_level((gpio_num_t)config_.dc_pin, dc_level);
     gpio_set_level((gpio_num_t)config_.cs_pin, 0);  // 选中芯片
     
     // 对于大数据，可能需要分块发送
@@ -153,6 +289,8 @@ void ESP32_SPI_Driver::sendBuffer(const uint8_t* buffer, size_t size) {
     while (remaining > 0) {
         size_t chunk_size = (remaining > max_transfer_size) ? max_transfer_size : remaining;
         
+        // spi_device_transmit()阻塞到DMA完成，区间结束即传输完成，不需要在中断中另外记录
+        MUI_TRACE_SCOPE("spi.transfer");
         spi_transaction_t t = createTransaction(ptr, chunk_size * 8);
         esp_err_t ret = spi_device_transmit(spi_, &t);
         if (ret != ESP_OK) {
@@ -165,6 +303,7 @@ void ESP32_SPI_Driver::sendBuffer(const uint8_t* buffer, size_t size) {
     }
     
     gpio_set_level((gpio_num_t)config_.cs_pin, 1);  // 取消选中
+    endFrame();
 }
 
 spi_transaction_t ESP32_SPI_Driver::createTransaction(const void* data, size_t length) {
@@ -188,114 +327,134 @@ int16_t ESP32_SPI_Driver::height() const {
 void ESP32_SPI_Driver::drawPixel(int16_t x, int16_t y, Color color) {
     if (!controller_) return;
     
-    if (x < 0 || x >= width() || y < 0 || y >= height()) {
-        return;  // 越界检查
+    if (!clipRect().contains(x, y)) {
+        return;  // 裁剪检查
     }
     
-    controller_->setAddrWindow(x, y, 1, 1);
-    
-    uint8_t pixel_data[4]; // 支持不同像素格式
-    uint8_t pixel_size = controller_->getPixelSize();
-    convertColor(color, pixel_data, pixel_size);
-    controller_->writePixelData(pixel_data, pixel_size);
+    writeRect(x, y, 1, 1, color);
 }
 
 void ESP32_SPI_Driver::fillRect(int16_t x, int16_t y, int16_t w, int16_t h, Color color) {
     if (!controller_) return;
     
-    int16_t screen_width = width();
-    int16_t screen_height = height();
+    // 裁剪到当前裁剪区，完全不可见时直接返回
+    if (!clipToCurrent(x, y, w, h)) {
+        return;
+    }
+    
+    writeRect(x, y, w, h, color);
+}
+
+void ESP32_SPI_Driver::fillSpan(int16_t x, int16_t y, int16_t w, Color color) {
+    if (!controller_) return;
     
-    if (x >= screen_width || y >= screen_height || w <= 0 || h <= 0) {
-        return;  // 参数检查
+    // 光栅化器输出的扫描段已裁剪，无需再次检查
+    writeRect(x, y, w, 1, color);
+}
+
+void ESP32_SPI_Driver::drawBitmap(int16_t x, int16_t y, int16_t w, int16_t h, const Color* pixels) {
+    if (!controller_ || !pixels) return;
+    
+    // 调色板模式下按颜色段写入索引
+    const uint8_t pixel_size = controller_->getPixelSize();
+    if (indexed_fb_) {
+        GraphicsDriver::drawBitmap(x, y, w, h, pixels);
+        return;
     }
     
-    // 调整绘图区域，确保不超出屏幕
-    if (x < 0) {
-        w += x;
-        x = 0;
+    const int16_t src_x = x;
+    const int16_t src_y = y;
+    const int16_t stride = w;
+    if (!clipToCurrent(x, y, w, h)) return;
+    pixels += static_cast<int32_t>(y - src_y) * stride + (x - src_x);
+    
+    // 持有帧缓冲区的控制器（如单色OLED）自行转换像素格式
+    if (controller_->drawBufferBitmap(x, y, w, h, pixels, stride)) {
+        return;
     }
-    if (y < 0) {
-        h += y;
-        y = 0;
+    if (pixel_size < 2) {
+        for (int16_t row = 0; row < h; row++) {
+            GraphicsDriver::drawBitmap(x, y + row, w, 1, pixels + static_cast<int32_t>(row) * stride);
+        }
+        return;
     }
-    if (x + w > screen_width) {
-        w = screen_width - x;
+    
+    // 整块位图作为一帧，在颜色缓冲区中逐块转换像素格式后发送
+    beginFrame();
+    controller_->setAddrWindow(x, y, w, h);
+    fill_pixel_size_ = 0;  // 缓冲区内容不再是单一颜色
+    
+    const size_t pixels_per_chunk = FILL_BUFFER_SIZE / pixel_size;
+    size_t used = 0;
+    for (int16_t row = 0; row < h; row++) {
+        const Color* line = pixels + static_cast<int32_t>(row) * stride;
+        for (int16_t col = 0; col < w; col++) {
+            convertColor(line[col], fill_buffer_ + used * pixel_size, pixel_size);
+            if (++used == pixels_per_chunk) {
+                controller_->writePixelData(fill_buffer_, used * pixel_size);
+                used = 0;
+            }
+        }
     }
-    if (y + h > screen_height) {
-        h = screen_height - y;
+    if (used > 0) {
+        controller_->writePixelData(fill_buffer_, used * pixel_size);
+    }
+    endFrame();
+}
+
+void ESP32_SPI_Driver::writeRect(int16_t x, int16_t y, int16_t w, int16_t h, Color color) {
+    // 调色板模式下只写入索引
+    if (indexed_fb_) {
+        indexed_fb_->fillRect(x, y, w, h, indexed_fb_->indexOf(color));
+        return;
     }
     
+    // 持有帧缓冲区的控制器直接在内存中整行填充
+    if (controller_->fillBufferRect(x, y, w, h, color)) {
+        return;
+    }
+    
+    // 窗口设置与像素数据作为一帧发送，避免被同一总线上的其他设备打断
+    beginFrame();
     controller_->setAddrWindow(x, y, w, h);
     
     // 计算像素总数和每像素字节数
     uint32_t pixelCount = w * h;
     uint8_t pixel_size = controller_->getPixelSize();
-    
-    // 创建颜色缓冲区
-    const size_t max_buffer_size = 1024;
-    size_t pixels_per_chunk = max_buffer_size / pixel_size;
-    uint8_t* color_buffer = new uint8_t[pixels_per_chunk * pixel_size];
-    
-    // 预填充一个像素的颜色数据
-    uint8_t pixel_data[4];
-    convertColor(color, pixel_data, pixel_size);
-    
-    // 填充颜色缓冲区
-    for (size_t i = 0; i < pixels_per_chunk; i++) {
-        memcpy(color_buffer + i * pixel_size, pixel_data, pixel_size);
+    size_t pixels_per_chunk = FILL_BUFFER_SIZE / pixel_size;
+    
+    // 颜色或像素格式变化时才重新填充颜色缓冲区
+    if (fill_pixel_size_ != pixel_size || fill_color_ != color) {
+        uint8_t pixel_data[4];
+        convertColor(color, pixel_data, pixel_size);
+        for (size_t i = 0; i < pixels_per_chunk; i++) {
+            memcpy(fill_buffer_ + i * pixel_size, pixel_data, pixel_size);
+        }
+        fill_color_ = color;
+        fill_pixel_size_ = pixel_size;
     }
     
     // 分块发送数据
     uint32_t remaining_pixels = pixelCount;
     while (remaining_pixels > 0) {
         uint32_t chunk_pixels = std::min(remaining_pixels, (uint32_t)pixels_per_chunk);
-        controller_->writePixelData(color_buffer, chunk_pixels * pixel_size);
+        controller_->writePixelData(fill_buffer_, chunk_pixels * pixel_size);
         remaining_pixels -= chunk_pixels;
     }
-    
-    delete[] color_buffer;
+    endFrame();
 }
 
 void ESP32_SPI_Driver::drawHLine(int16_t x, int16_t y, int16_t w, Color color) {
-    int16_t screen_width = width();
-    int16_t screen_height = height();
-    
-    if (y < 0 || y >= screen_height || x >= screen_width || w <= 0) {
-        return;
-    }
-    
-    if (x < 0) {
-        w += x;
-        x = 0;
-    }
-    if (x + w > screen_width) {
-        w = screen_width - x;
-    }
-    
     fillRect(x, y, w, 1, color);
 }
 
 void ESP32_SPI_Driver::drawVLine(int16_t x, int16_t y, int16_t h, Color color) {
-    int16_t screen_width = width();
-    int16_t screen_height = height();
-    
-    if (x < 0 || x >= screen_width || y >= screen_height || h <= 0) {
-        return;
-    }
-    
-    if (y < 0) {
-        h += y;
-        y = 0;
-    }
-    if (y + h > screen_height) {
-        h = screen_height - y;
-    }
-    
     fillRect(x, y, 1, h, color);
 }
 
 void ESP32_SPI_Driver::drawLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, Color color) {
+    if (!controller_) return;
+    
     // 处理水平线和垂直线的特殊情况
     if (x0 == x1) {
         drawVLine(x0, std::min(y0, y1), std::abs(y1 - y0) + 1, color);
@@ -306,6 +465,15 @@ void ESP32_SPI_Driver::drawLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1,
         return;
     }
     
+    // 包围盒完全在裁剪区外时直接丢弃
+    const Rect clip = clipRect();
+    Rect bounds{std::min(x0, x1), std::min(y0, y1),
+                static_cast<int16_t>(std::abs(x1 - x0) + 1),
+                static_cast<int16_t>(std::abs(y1 - y0) + 1)};
+    if (bounds.intersect(clip).isEmpty()) {
+        return;
+    }
+    
     // Bresenham算法绘制一般直线
     int16_t steep = std::abs(y1 - y0) > std::abs(x1 - x0);
     if (steep) {
@@ -325,10 +493,10 @@ void ESP32_SPI_Driver::drawLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1,
     int16_t y = y0;
     
     for (int16_t x = x0; x <= x1; x++) {
-        if (steep) {
-            drawPixel(y, x, color);
-        } else {
-            drawPixel(x, y, color);
+        int16_t px = steep ? y : x;
+        int16_t py = steep ? x : y;
+        if (clip.contains(px, py)) {
+            writeRect(px, py, 1, 1, color);
         }
         
         err -= dy;
@@ -340,6 +508,10 @@ void ESP32_SPI_Driver::drawLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1,
 }
 
 void ESP32_SPI_Driver::drawRect(int16_t x, int16_t y, int16_t w, int16_t h, Color color) {
+    if (Rect{x, y, w, h}.intersect(clipRect()).isEmpty()) {
+        return;
+    }
+    
     // 绘制四条边
     drawHLine(x, y, w, color);          // 顶边
     drawHLine(x, y + h - 1, w, color);  // 底边
@@ -348,56 +520,31 @@ void ESP32_SPI_Driver::drawRect(int16_t x, int16_t y, int16_t w, int16_t h, Colo
 }
 
 void ESP32_SPI_Driver::drawCircle(int16_t x0, int16_t y0, int16_t r, Color color) {
-    int16_t f = 1 - r;
-    int16_t ddF_x = 1;
-    int16_t ddF_y = -2 * r;
-    int16_t x = 0;
-    int16_t y = r;
+    if (!controller_ || r < 0) return;
     
-    drawPixel(x0, y0 + r, color);
-    drawPixel(x0, y0 - r, color);
-    drawPixel(x0 + r, y0, color);
-    drawPixel(x0 - r, y0, color);
+    const Rect clip = clipRect();
+    if (Rect{static_cast<int16_t>(x0 - r), static_cast<int16_t>(y0 - r),
+             static_cast<int16_t>(2 * r + 1), static_cast<int16_t>(2 * r + 1)}
+            .intersect(clip).isEmpty()) {
+        return;
+    }
     
-    while (x < y) {
-        if (f >= 0) {
-            y--;
-            ddF_y += 2;
-            f += ddF_y;
+    auto plot = [&](int16_t px, int16_t py) {
+        if (clip.contains(px, py)) {
+            writeRect(px, py, 1, 1, color);
         }
-        
-        x++;
-        ddF_x += 2;
-        f += ddF_x;
-        
-        drawPixel(x0 + x, y0 + y, color);
-        drawPixel(x0 - x, y0 + y, color);
-        drawPixel(x0 + x, y0 - y, color);
-        drawPixel(x0 - x, y0 - y, color);
-        drawPixel(x0 + y, y0 + x, color);
-        drawPixel(x0 - y, y0 + x, color);
-        drawPixel(x0 + y, y0 - x, color);
-        drawPixel(x0 - y, y0 - x, color);
-    }
-}
-
-void ESP32_SPI_Driver::fillCircle(int16_t x0, int16_t y0, int16_t r, Color color) {
-    // 先画垂直线贯穿圆心
-    drawVLine(x0, y0 - r, 2 * r + 1, color);
-    fillCircleHelper(x0, y0, r, 3, 0, color);
-}
-
-void ESP32_SPI_Driver::fillCircleHelper(int16_t x0, int16_t y0, int16_t r, uint8_t corners, 
-                                       int16_t delta, Color color) {
+    };
+    
     int16_t f = 1 - r;
     int16_t ddF_x = 1;
     int16_t ddF_y = -2 * r;
     int16_t x = 0;
     int16_t y = r;
-    int16_t px = x;
-    int16_t py = y;
     
-    delta++; // 偏移量加1
+    plot(x0, y0 + r);
+    plot(x0, y0 - r);
+    plot(x0 + r, y0);
+    plot(x0 - r, y0);
     
     while (x < y) {
         if (f >= 0) {
@@ -410,36 +557,68 @@ void ESP32_SPI_Driver::fillCircleHelper(int16_t x0, int16_t y0, int16_t r, uint8
         ddF_x += 2;
         f += ddF_x;
         
-        if (x < (y + 1)) {
-            if (corners & 1) drawVLine(x0 + x, y0 - y, 2 * y + delta, color);
-            if (corners & 2) drawVLine(x0 - x, y0 - y, 2 * y + delta, color);
-        }
-        
-        if (y != py) {
-            if (corners & 1) drawVLine(x0 + py, y0 - px, 2 * px + delta, color);
-            if (corners & 2) drawVLine(x0 - py, y0 - px, 2 * px + delta, color);
-            py = y;
-        }
-        px = x;
+        plot(x0 + x, y0 + y);
+        plot(x0 - x, y0 + y);
+        plot(x0 + x, y0 - y);
+        plot(x0 - x, y0 - y);
+        plot(x0 + y, y0 + x);
+        plot(x0 - y, y0 + x);
+        plot(x0 + y, y0 - x);
+        plot(x0 - y, y0 - x);
     }
 }
 
-void ESP32_SPI_Driver::drawChar(int16_t x, int16_t y, char c, Color color, Color bg, uint8_t size) {
-    // 这里可以实现字符绘制逻辑
-    // 通常需要字体资源，为简化这里留空
-    ESP_LOGD(TAG, "Drawing char '%c' at (%d,%d)", c, x, y);
+void ESP32_SPI_Driver::fillCircle(int16_t x0, int16_t y0, int16_t r, Color color) {
+    // 逐行生成扫描段，每行只产生一次填充
+    Rasterizer(*this, clipRect()).fillCircle(x0, y0, r, color);
 }
 
 void ESP32_SPI_Driver::display() {
+    MUI_TRACE_SCOPE("flush");
     if (controller_) {
+        if (indexed_fb_) {
+            flushIndexed();
+        }
         controller_->refresh();
     }
     ESP_LOGD(TAG, "Display refreshed");
 }
 
+void ESP32_SPI_Driver::flushIndexed() {
+    const Rect area = indexed_fb_->dirty();
+    if (area.isEmpty()) {
+        return;
+    }
+    
+    // 脏区作为一个窗口连续发送：逐行经查找表展开到发送缓冲区，缓冲区满时发送
+    beginFrame();
+    controller_->setAddrWindow(area.x, area.y, area.w, area.h);
+    fill_pixel_size_ = 0;  // 缓冲区内容不再是单一颜色
+    
+    const int16_t max_pixels = FILL_BUFFER_SIZE / 2;
+    size_t used = 0;
+    for (int16_t row = area.y; row < area.bottom(); row++) {
+        for (int16_t seg = 0; seg < area.w; seg += max_pixels) {
+            int16_t n = std::min<int16_t>(area.w - seg, max_pixels);
+            if (used + n * 2 > FILL_BUFFER_SIZE) {
+                controller_->writePixelData(fill_buffer_, used);
+                used = 0;
+            }
+            indexed_fb_->expandRow(row, area.x + seg, n, fill_buffer_ + used);
+            used += n * 2;
+        }
+    }
+    if (used > 0) {
+        controller_->writePixelData(fill_buffer_, used);
+    }
+    endFrame();
+    
+    indexed_fb_->clearDirty();
+}
+
 void ESP32_SPI_Driver::clear(Color color) {
     if (controller_) {
-        if (color == 0x0000) { // 如果是黑色，直接使用控制器的清屏功能
+        if (color == 0x0000 && !hasClip() && !indexed_fb_) { // 如果是黑色且未裁剪，直接使用控制器的清屏功能
             controller_->clearScreen();
         } else {
             fillRect(0, 0, width(), height(), color);
@@ -447,10 +626,73 @@ void ESP32_SPI_Driver::clear(Color color) {
     }
 }
 
+bool ESP32_SPI_Driver::scroll(int16_t dy) {
+    return controller_ ? controller_->scroll(dy) : false;
+}
+
+bool ESP32_SPI_Driver::shiftRect(int16_t x, int16_t y, int16_t w, int16_t h, int16_t dx) {
+    // 区域被裁剪时移入的内容来自屏幕外，交给调用方重绘整个区域；调色板帧缓冲区不支持平移
+    int16_t cx = x;
+    int16_t cy = y;
+    int16_t cw = w;
+    int16_t ch = h;
+    if (!controller_ || indexed_fb_ || !clipToCurrent(cx, cy, cw, ch) || cx != x || cy != y || cw != w || ch != h ||
+        dx >= w || dx <= -w) {
+        return false;
+    }
+    return controller_->shiftBufferRect(x, y, w, h, dx);
+}
+
+bool ESP32_SPI_Driver::setRotation(Rotation rotation) {
+    // 调色板帧缓冲区按初始化时的尺寸分配
+    if (!controller_ || indexed_fb_) {
+        return false;
+    }
+    return controller_->setRotation(rotation);
+}
+
+bool ESP32_SPI_Driver::captureScreen(ScreenCache& cache, uint16_t page) {
+    if (!controller_) {
+        return false;
+    }
+    // 调色板帧缓冲区保存索引，快照恢复后仍按当前调色板展开
+    if (indexed_fb_) {
+        return cache.store(page, indexed_fb_->data(), indexed_fb_->bufferSize());
+    }
+    size_t size = 0;
+    const uint8_t* data = controller_->snapshotData(size);
+    return data && cache.store(page, data, size);
+}
+
+bool ESP32_SPI_Driver::restoreScreen(ScreenCache& cache, uint16_t page) {
+    MUI_TRACE_SCOPE("restore");
+    if (!controller_) {
+        return false;
+    }
+    if (indexed_fb_) {
+        if (!cache.load(page, indexed_fb_->data(), indexed_fb_->bufferSize())) {
+            return false;
+        }
+        // 整屏作为一个窗口连续发送
+        indexed_fb_->markAllDirty();
+        flushIndexed();
+        controller_->refresh();
+        return true;
+    }
+    // load()未命中或快照损坏时不修改帧缓冲区，调用方完整重绘即可
+    size_t size = 0;
+    uint8_t* target = controller_->snapshotTarget(size);
+    if (!target || !cache.load(page, target, size)) {
+        return false;
+    }
+    controller_->presentSnapshot();
+    return true;
+}
+
 void ESP32_SPI_Driver::convertColor(Color color, uint8_t* buffer, uint8_t pixel_size) {
     switch (pixel_size) {
-        case 1: // 单色 (SSD1309等)
-            buffer[0] = (color != 0) ? 0xFF : 0x00;
+        case 1: // 单色：按亮度阈值转换（持有帧缓冲区的单色控制器在fillBufferRect中抖动）
+            buffer[0] = (luminance(color) > 127) ? 0xFF : 0x00;
             break;
         case 2: // RGB565 (ILI9341等)
             buffer[0] = color >> 8;
@@ -1,6 +1,8 @@
 #pragma once
 
 #include "../../framework/include/GraphicsDriver.h"
+#include "DisplayTransport.h"
+#include "IndexedFramebuffer.h"
 #include <driver/spi_master.h>
 #include <driver/gpio.h>
 #include <esp_err.h>
@@ -11,6 +13,8 @@ namespace MinimalUI {
 
 // 前向声明
 class DisplayController;
+class ESP32_SPI_Bus;
+enum class Rotation : uint8_t;
 
 /**
  * @brief ESP32 SPI驱动配置结构
@@ -25,14 +29,15 @@ struct ESP32_SPI_Config {
     int8_t miso_pin = -1; // MISO引脚，通常不需要
     uint32_t freq;      // SPI频率
     uint8_t spi_mode; // SPI模式
+    uint8_t indexed_bpp = 0; // 调色板帧缓冲区位数（4或8），0表示直写显存；仅用于RGB565控制器
 };
 
 /**
  * @class ESP32_SPI_Driver
  * @brief ESP32平台的通用SPI显示驱动
- * 支持可插拔的显示控制器
+ * 支持可插拔的显示控制器；同一SPI主机上可挂载多个驱动实例（多块屏幕）
  */
-class ESP32_SPI_Driver : public GraphicsDriver {
+class ESP32_SPI_Driver : public GraphicsDriver, public DisplayTransport {
 public:
     /**
      * @brief 构造函数
@@ -46,7 +51,36 @@ public:
      */
     ~ESP32_SPI_Driver() override;
 
+    /**
+     * @brief 非阻塞初始化的状态
+     */
+    enum class InitState {
+        IDLE,            // 未开始
+        RESET_RECOVERY,  // 复位已释放，等待控制器就绪
+        CONTROLLER,      // 正在发送控制器初始化表
+        READY,           // 可以绘制
+        FAILED
+    };
+
+    /**
+     * @brief 开始非阻塞初始化
+     * 配置SPI并发出复位脉冲后立即返回，之后反复调用pollInitialize()直到READY。
+     * 复位恢复和初始化表中的延时期间调用方可以继续其他启动工作（WiFi、传感器等）
+     * @return SPI初始化是否成功
+     */
+    bool beginInitialize();
+
+    /**
+     * @brief 推进非阻塞初始化，从不阻塞
+     * @param wait_ms 可选输出：距下一步还需等待的毫秒数
+     * @return 当前状态
+     */
+    InitState pollInitialize(uint32_t* wait_ms = nullptr);
+
+    InitState initState() const { return init_state_; }
+
     // 实现GraphicsDriver接口
+    // initialize()为阻塞版本：beginInitialize()后等待到READY
     bool initialize() override;
     void drawPixel(int16_t x, int16_t y, Color color) override;
     void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, Color color) override;
@@ -56,25 +90,58 @@ public:
     void drawRect(int16_t x, int16_t y, int16_t w, int16_t h, Color color) override;
     void drawCircle(int16_t x0, int16_t y0, int16_t r, Color color) override;
     void fillCircle(int16_t x0, int16_t y0, int16_t r, Color color) override;
-    void drawChar(int16_t x, int16_t y, char c, Color color, Color bg, uint8_t size = 1) override;
+    void fillSpan(int16_t x, int16_t y, int16_t w, Color color) override;
+    void drawBitmap(int16_t x, int16_t y, int16_t w, int16_t h, const Color* pixels) override;
     void display() override;
     void clear(Color color = 0x0000) override;
+    bool scroll(int16_t dy) override;
+    bool shiftRect(int16_t x, int16_t y, int16_t w, int16_t h, int16_t dx) override;
+    bool captureScreen(ScreenCache& cache, uint16_t page) override;
+    bool restoreScreen(ScreenCache& cache, uint16_t page) override;
     int16_t width() const override;
     int16_t height() const override;
 
-    // SPI通信方法 - 供控制器使用
-    void sendCommand(uint8_t cmd);
-    void sendData(uint8_t data);
-    void sendBuffer(const uint8_t* buffer, size_t size);
+    /**
+     * @brief 设置显示旋转，之后width()/height()和裁剪都按旋转后的尺寸，调用方需重绘
+     * @return 控制器不支持该旋转或启用了调色板帧缓冲区时返回false
+     */
+    bool setRotation(Rotation rotation);
+
+    /**
+     * @brief 获取调色板帧缓冲区，未启用时返回nullptr
+     * 修改其调色板后调用display()即可按新颜色整屏刷新，无需重绘
+     */
+    IndexedFramebuffer* indexedFramebuffer() { return indexed_fb_.get(); }
 
-protected:
-    void fillCircleHelper(int16_t x0, int16_t y0, int16_t r, uint8_t corners,
-                         int16_t delta, Color color) override;
+    // 实现DisplayTransport接口 - 供控制器使用
+    // 帧外的单字节发送每次都要申请仲裁器和ESP-IDF总线，控制器应在帧内调用
+    void sendCommand(uint8_t cmd) override;
+    void sendData(uint8_t data) override;
+    void sendBuffer(const uint8_t* buffer, size_t size) override;
+    void sendCommands(const uint8_t* cmds, size_t count) override;
+    void beginFrame() override;
+    void endFrame() override;
 
 private:
+    // 填充缓冲区大小（字节）
+    static constexpr size_t FILL_BUFFER_SIZE = 1024;
+
     ESP32_SPI_Config config_;
     spi_device_handle_t spi_;
+    ESP32_SPI_Bus* bus_;          // 共享总线（引用计数）
+    int8_t bus_device_id_;        // 在总线仲裁器中的设备ID
+    uint16_t bus_hold_depth_;     // 帧嵌套深度
     std::unique_ptr<DisplayController> controller_;
+    std::unique_ptr<IndexedFramebuffer> indexed_fb_;  // 调色板帧缓冲区（可选）
+
+    InitState init_state_;
+    int64_t init_start_us_;       // beginInitialize()的时刻
+    int64_t init_deadline_us_;    // 当前等待结束的时刻
+
+    // 直写显存时复用的颜色缓冲区，避免每次填充都分配内存
+    uint8_t fill_buffer_[FILL_BUFFER_SIZE];
+    Color fill_color_;          // 缓冲区当前填充的颜色
+    uint8_t fill_pixel_size_;   // 缓冲区当前的像素格式，0表示未填充
 
     // 初始化SPI硬件
     bool initSPI();
@@ -82,9 +149,21 @@ private:
     // 释放SPI资源
     void freeSPI();
 
+    // 控制器初始化完成后按配置创建调色板帧缓冲区
+    bool createIndexedFramebuffer();
+
+    // 以给定DC电平发送一段字节，超过单次传输上限时分块
+    void transmit(const uint8_t* buffer, size_t size, uint32_t dc_level);
+
     // 创建SPI事务
     spi_transaction_t createTransaction(const void* data, size_t length);
 
+    // 写入已裁剪的矩形区域（帧缓冲区或直写显存）
+    void writeRect(int16_t x, int16_t y, int16_t w, int16_t h, Color color);
+
+    // 把调色板帧缓冲区的脏区展开为RGB565并发送
+    void flushIndexed();
+
     // 颜色转换辅助方法
     void convertColor(Color color, uint8_t* buffer, uint8_t pixel_size);
 };
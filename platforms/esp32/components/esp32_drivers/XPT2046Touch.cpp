@@ -0,0 +1,198 @@
+#include "XPT2046Touch.h"
+#include "ESP32_SPI_Bus.h"
+#include <esp_log.h>
+
+namespace MinimalUI {
+
+static const char* TAG = "XPT2046Touch";
+
+XPT2046Touch::XPT2046Touch(const XPT2046Config& config)
+    : config_(config), spi_(nullptr), bus_(nullptr), bus_device_id_(-1), timer_(nullptr),
+      filter_(config.filter_alpha), down_(false), release_count_(0), last_x_(0), last_y_(0) {
+    filter_.setCalibration(TouchCalibration::fromRange(config_.raw_x_min, config_.raw_x_max,
+                                                       config_.raw_y_min, config_.raw_y_max,
+                                                       config_.width, config_.height, config_.swap_xy));
+}
+
+XPT2046Touch::~XPT2046Touch() {
+    shutdown();
+}
+
+bool XPT2046Touch::initialize() {
+    if (config_.irq_pin >= 0) {
+        gpio_config_t io_conf = {};
+        io_conf.pin_bit_mask = 1ULL << config_.irq_pin;
+        io_conf.mode = GPIO_MODE_INPUT;
+        io_conf.pull_up_en = GPIO_PULLUP_ENABLE;
+        io_conf.pull_down_en = GPIO_PULLDOWN_DISABLE;
+        io_conf.intr_type = GPIO_INTR_DISABLE;
+        gpio_config(&io_conf);
+    }
+
+    spi_bus_config_t bus_cfg = {
+        .mosi_io_num = config_.mosi_pin,
+        .miso_io_num = config_.miso_pin,
+        .sclk_io_num = config_.sclk_pin,
+        .quadwp_io_num = -1,
+        .quadhd_io_num = -1,
+        .max_transfer_sz = 4092,
+        .flags = 0,
+        .intr_flags = 0
+    };
+    bus_ = ESP32_SPI_Bus::acquire(config_.spi_host, bus_cfg);
+    if (!bus_) {
+        return false;
+    }
+
+    spi_device_interface_config_t dev_cfg = {
+        .mode = 0,
+        .clock_speed_hz = static_cast<int>(config_.freq),
+        .spics_io_num = config_.cs_pin,
+        .flags = 0,
+        .queue_size = 1,
+        .pre_cb = nullptr,
+        .post_cb = nullptr
+    };
+    esp_err_t ret = spi_bus_add_device(config_.spi_host, &dev_cfg, &spi_);
+    if (ret != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to add SPI device: %s", esp_err_to_name(ret));
+        spi_ = nullptr;
+        shutdown();
+        return false;
+    }
+
+    bus_device_id_ = bus_->arbiter().registerDevice();
+    if (bus_device_id_ < 0) {
+        ESP_LOGE(TAG, "Too many devices on SPI bus %d", static_cast<int>(config_.spi_host));
+        shutdown();
+        return false;
+    }
+
+    esp_timer_create_args_t timer_args = {};
+    timer_args.callback = sampleCallback;
+    timer_args.arg = this;
+    timer_args.dispatch_method = ESP_TIMER_TASK;
+    timer_args.name = "xpt2046";
+    timer_args.skip_unhandled_events = true;
+    if (esp_timer_create(&timer_args, &timer_) != ESP_OK ||
+        esp_timer_start_periodic(timer_, config_.sample_period_us) != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to start sample timer");
+        shutdown();
+        return false;
+    }
+
+    ESP_LOGI(TAG, "XPT2046 touch started, %u us sample period",
+             static_cast<unsigned>(config_.sample_period_us));
+    return true;
+}
+
+void XPT2046Touch::shutdown() {
+    if (timer_) {
+        esp_timer_stop(timer_);
+        esp_timer_delete(timer_);
+        timer_ = nullptr;
+    }
+    if (bus_device_id_ >= 0) {
+        bus_->arbiter().unregisterDevice(bus_device_id_);
+        bus_device_id_ = -1;
+    }
+    if (spi_) {
+        spi_bus_remove_device(spi_);
+        spi_ = nullptr;
+    }
+    if (bus_) {
+        ESP32_SPI_Bus::release(bus_);
+        bus_ = nullptr;
+    }
+}
+
+uint16_t XPT2046Touch::readChannel(uint8_t command) {
+    // 发送控制字节后的两个字节中是12位转换结果（MSB对齐，末尾3位无效）
+    spi_transaction_t t = {};
+    t.flags = SPI_TRANS_USE_TXDATA | SPI_TRANS_USE_RXDATA;
+    t.length = 24;
+    t.tx_data[0] = command;
+    if (spi_device_polling_transmit(spi_, &t) != ESP_OK) {
+        return 0;
+    }
+    return static_cast<uint16_t>(((t.rx_data[1] << 8) | t.rx_data[2]) >> 3);
+}
+
+void XPT2046Touch::sampleCallback(void* arg) {
+    static_cast<XPT2046Touch*>(arg)->sample();
+}
+
+void XPT2046Touch::sample() {
+    // 未按下且PENIRQ为高电平时无需访问总线
+    if (!down_ && config_.irq_pin >= 0 && gpio_get_level((gpio_num_t)config_.irq_pin)) {
+        return;
+    }
+
+    bool pressed = false;
+    uint16_t raw_x[3];
+    uint16_t raw_y[3];
+    {
+        BusArbiter::Lock lock(bus_->arbiter(), bus_device_id_);
+        uint16_t z1 = readChannel(CMD_Z1);
+        uint16_t z2 = readChannel(CMD_Z2);
+        int32_t z = static_cast<int32_t>(z1) + 4095 - z2;
+        pressed = z1 != 0 && z > config_.pressure_threshold;
+        if (pressed) {
+            for (uint8_t i = 0; i < 3; i++) {
+                raw_x[i] = readChannel(CMD_X);
+                raw_y[i] = readChannel(i == 2 ? CMD_Y_POWERDOWN : CMD_Y);
+            }
+        } else {
+            readChannel(CMD_Y_POWERDOWN);
+        }
+    }
+
+    const uint32_t now_ms = static_cast<uint32_t>(esp_timer_get_time() / 1000);
+    InputEvent event = {};
+    event.id = 0;
+    event.time_ms = now_ms;
+
+    if (!pressed) {
+        if (down_ && ++release_count_ >= 2) {
+            // 队列满时保持按下状态，下次采样重试，抬起事件不会丢失
+            event.type = InputEventType::TOUCH_UP;
+            event.x = last_x_;
+            event.y = last_y_;
+            if (queue_.push(event)) {
+                down_ = false;
+                filter_.reset();
+            } else {
+                release_count_ = 2;
+            }
+        }
+        return;
+    }
+
+    release_count_ = 0;
+    int16_t x;
+    int16_t y;
+    filter_.update(raw_x, raw_y, x, y);
+    x = x < 0 ? 0 : (x >= config_.width ? config_.width - 1 : x);
+    y = y < 0 ? 0 : (y >= config_.height ? config_.height - 1 : y);
+
+    if (!down_) {
+        // 队列满时不进入按下状态，下次采样重试，保证按下/抬起成对
+        event.type = InputEventType::TOUCH_DOWN;
+        event.x = x;
+        event.y = y;
+        if (queue_.push(event)) {
+            down_ = true;
+            last_x_ = x;
+            last_y_ = y;
+        }
+        return;
+    }
+
+    if (x != last_x_ || y != last_y_) {
+        last_x_ = x;
+        last_y_ = y;
+        queue_.pushMove(x, y, now_ms);
+    }
+}
+
+} // namespace MinimalUI
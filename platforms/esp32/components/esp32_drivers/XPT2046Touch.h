@@ -0,0 +1,91 @@
+#pragma once
+
+#include "InputDriver.h"
+#include <driver/spi_master.h>
+#include <driver/gpio.h>
+#include <esp_timer.h>
+#include <cstdint>
+
+namespace MinimalUI {
+
+class ESP32_SPI_Bus;
+
+/**
+ * @brief XPT2046电阻触摸控制器配置
+ */
+struct XPT2046Config {
+    spi_host_device_t spi_host = SPI2_HOST; // 可与显示屏共用SPI主机
+    int8_t cs_pin;              // 片选引脚
+    int8_t irq_pin = -1;        // PENIRQ引脚，-1表示每次都读取压力判断按下
+    int8_t mosi_pin;            // MOSI引脚（总线已初始化时忽略）
+    int8_t miso_pin;            // MISO引脚
+    int8_t sclk_pin;            // SCLK引脚
+    uint32_t freq = 2000000;    // SPI频率，XPT2046最高约2.5MHz
+    int16_t width = 320;        // 屏幕宽度
+    int16_t height = 240;       // 屏幕高度
+    uint16_t raw_x_min = 200;   // 原始值校准范围
+    uint16_t raw_x_max = 3900;
+    uint16_t raw_y_min = 200;
+    uint16_t raw_y_max = 3900;
+    bool swap_xy = false;       // 触摸屏与显示方向X/Y互换
+    uint16_t pressure_threshold = 400; // 压力大于该值视为按下
+    uint32_t sample_period_us = 5000;  // 采样周期
+    uint8_t filter_alpha = 96;  // 低通滤波系数（/256），越小越平滑
+};
+
+/**
+ * @class XPT2046Touch
+ * @brief XPT2046电阻触摸输入
+ *
+ * esp_timer周期采样：配置了PENIRQ且未按下时只读GPIO，不占用SPI总线；
+ * 按下后每次读取压力和各3次X/Y采样，经TouchFilter滤波后发布。
+ * 移动事件按帧合并，UI每帧只收到最新位置。连续两次采样无压力才认为抬起，
+ * 避免轻触时的抖动产生多余的按下/抬起。
+ *
+ * 与显示屏共用SPI主机时通过总线仲裁器排队，长时间刷屏期间采样会推迟；
+ * 对延迟敏感时建议使用独立的SPI主机。
+ */
+class XPT2046Touch : public InputDriver {
+public:
+    explicit XPT2046Touch(const XPT2046Config& config);
+    ~XPT2046Touch() override;
+
+    bool initialize() override;
+
+    /**
+     * @brief 停止采样并释放SPI设备
+     */
+    void shutdown();
+
+    /**
+     * @brief 替换默认的线性校准（例如三点校准的结果）
+     */
+    void setCalibration(const TouchCalibration& calibration) { filter_.setCalibration(calibration); }
+
+private:
+    // 控制字节：起始位 | 通道 | 12位差分模式 | 转换间保持参考电压
+    static constexpr uint8_t CMD_X = 0xD1;
+    static constexpr uint8_t CMD_Y = 0x91;
+    static constexpr uint8_t CMD_Z1 = 0xB1;
+    static constexpr uint8_t CMD_Z2 = 0xC1;
+    // 最后一次转换后掉电，重新使能PENIRQ
+    static constexpr uint8_t CMD_Y_POWERDOWN = 0x90;
+
+    XPT2046Config config_;
+    spi_device_handle_t spi_;
+    ESP32_SPI_Bus* bus_;
+    int8_t bus_device_id_;
+    esp_timer_handle_t timer_;
+    TouchFilter filter_;
+    bool down_;
+    uint8_t release_count_;     // 连续无压力的采样次数
+    int16_t last_x_;
+    int16_t last_y_;
+
+    uint16_t readChannel(uint8_t command);
+    void sample();
+
+    static void sampleCallback(void* arg);
+};
+
+} // namespace MinimalUI
@@ -1,12 +1,21 @@
 #pragma once
 
+#include "GraphicsDriver.h"
+#include "DisplayTransport.h"
 #include <cstdint>
 #include <cstddef>  // This header defines size_t
 
 namespace MinimalUI {
 
-// 前向声明
-class ESP32_SPI_Driver;
+/**
+ * @brief 显示内容相对面板的顺时针旋转角度
+ */
+enum class Rotation : uint8_t {
+    ROTATE_0 = 0,
+    ROTATE_90 = 1,
+    ROTATE_180 = 2,
+    ROTATE_270 = 3
+};
 
 /**
  * @brief 显示控制器抽象接口
@@ -18,10 +27,32 @@ public:
 
     /**
      * @brief 初始化显示控制器
-     * @param spi_driver SPI通信驱动
+     * @param transport 命令/数据传输接口
      * @return 初始化是否成功
      */
-    virtual bool initialize(ESP32_SPI_Driver* spi_driver) = 0;
+    virtual bool initialize(DisplayTransport* transport) = 0;
+
+    /**
+     * @brief 开始非阻塞初始化
+     * 与pollInit()配合使用，由驱动的启动状态机调用；默认实现直接阻塞完成initialize()
+     * @return 参数无效时返回false
+     */
+    virtual bool beginInit(DisplayTransport* transport) { return initialize(transport); }
+
+    /**
+     * @brief 推进非阻塞初始化，从不阻塞
+     * @param wait_ms 输出：未完成时下次调用前需要等待的毫秒数
+     * @return 初始化是否已完成
+     */
+    virtual bool pollInit(uint32_t& wait_ms) {
+        wait_ms = 0;
+        return true;
+    }
+
+    /**
+     * @brief 硬件复位释放后到可以接收命令的等待时间（毫秒）
+     */
+    virtual uint16_t resetRecoveryMs() const { return 120; }
 
     /**
      * @brief 设置绘图窗口
@@ -39,6 +70,80 @@ public:
      */
     virtual void writePixelData(const uint8_t* data, size_t length) = 0;
 
+    /**
+     * @brief 在控制器帧缓冲区中填充矩形
+     * 持有帧缓冲区的控制器应重写此方法，填充结果在refresh()时统一发送。
+     * 调用方保证矩形已裁剪到屏幕范围内。
+     * @return 是否已写入帧缓冲区；返回false时驱动直接通过SPI写入显存
+     */
+    virtual bool fillBufferRect(int16_t /*x*/, int16_t /*y*/, int16_t /*w*/, int16_t /*h*/,
+                                Color /*color*/) {
+        return false;
+    }
+
+    /**
+     * @brief 把RGB565位图写入控制器帧缓冲区
+     * 调用方保证矩形已裁剪到屏幕范围内
+     * @param pixels 位图左上角像素
+     * @param stride 位图每行的像素数
+     * @return 是否已写入帧缓冲区；返回false时由驱动逐段填充
+     */
+    virtual bool drawBufferBitmap(int16_t /*x*/, int16_t /*y*/, int16_t /*w*/, int16_t /*h*/,
+                                  const Color* /*pixels*/, int16_t /*stride*/) {
+        return false;
+    }
+
+    /**
+     * @brief 硬件滚动
+     * 内容整体上移dy行（dy为负时下移），新露出的行被清为背景色，
+     * 下次refresh()只需发送这些行。SSD1309通过起始行寄存器实现，
+     * ST7789等TFT控制器可通过垂直滚动区域（VSCRDEF/VSCRSADD）实现。
+     * @param dy 滚动行数
+     * @return 控制器不支持硬件滚动时返回false，调用方需自行重绘
+     */
+    virtual bool scroll(int16_t /*dy*/) { return false; }
+
+    /**
+     * @brief 在控制器帧缓冲区中水平平移矩形区域
+     * 调用方保证矩形在屏幕范围内且|dx| < w；新露出的列保持原内容，由调用方重绘
+     * @return 控制器不持有帧缓冲区时返回false
+     */
+    virtual bool shiftBufferRect(int16_t /*x*/, int16_t /*y*/, int16_t /*w*/, int16_t /*h*/,
+                                 int16_t /*dx*/) {
+        return false;
+    }
+
+    /**
+     * @brief 获取可保存为快照的帧缓冲区
+     * @param size 输出：缓冲区字节数
+     * @return 控制器不持有帧缓冲区，或当前内容不能按原样保存（如硬件滚动偏移不为0）时返回nullptr
+     */
+    virtual const uint8_t* snapshotData(size_t& size) { size = 0; return nullptr; }
+
+    /**
+     * @brief 获取用于写回快照的帧缓冲区，写入后调用presentSnapshot()
+     * @return 不支持快照时返回nullptr
+     */
+    virtual uint8_t* snapshotTarget(size_t& size) { size = 0; return nullptr; }
+
+    /**
+     * @brief 把写回的快照整屏发送到屏幕
+     */
+    virtual void presentSnapshot() {}
+
+    /**
+     * @brief 设置显示旋转
+     * 旋转后getWidth()/getHeight()返回旋转后的尺寸，帧缓冲区内容被清空，调用方需重绘。
+     * 控制器应尽量用地址模式和重映射命令实现，不能时在刷新时软件转换。
+     * @return 控制器不支持该旋转时返回false，设置保持不变
+     */
+    virtual bool setRotation(Rotation rotation) { return rotation == Rotation::ROTATE_0; }
+
+    /**
+     * @brief 获取当前旋转
+     */
+    virtual Rotation getRotation() const { return Rotation::ROTATE_0; }
+
     /**
      * @brief 清屏
      */
@@ -50,12 +155,12 @@ public:
     virtual void refresh() = 0;
 
     /**
-     * @brief 获取显示器宽度
+     * @brief 获取显示器宽度（已考虑旋转）
      */
     virtual int16_t getWidth() const = 0;
 
     /**
-     * @brief 获取显示器高度
+     * @brief 获取显示器高度（已考虑旋转）
      */
     virtual int16_t getHeight() const = 0;
 
@@ -65,7 +170,7 @@ public:
     virtual uint8_t getPixelSize() const = 0;
 
 protected:
-    ESP32_SPI_Driver* spi_driver_ = nullptr;
+    DisplayTransport* transport_ = nullptr;
 };
 
 } // namespace MinimalUI
\ No newline at end of file
@@ -1,16 +1,35 @@
 #include "SSD1309Controller.h"
-#include "../ESP32_SPI_Driver.h"
+#include "Trace.h"
 #include <esp_log.h>
+#include <esp_heap_caps.h>
 #include <freertos/FreeRTOS.h>
 #include <freertos/task.h>
+#include <cstdlib>
 #include <cstring>
+#include <algorithm>
+#include <utility>
 
 namespace MinimalUI {
 
 static const char* TAG = "SSD1309Controller";
 
+constexpr uint8_t SSD1309Controller::GRAY_SEQUENCE[];
+
+// 默认配置的初始化表在编译期生成，且长度与声明一致
+static constexpr SSD1309Controller::InitTable DEFAULT_INIT_SEQUENCE =
+    SSD1309Controller::buildInitSequence(SSD1309Config{});
+static_assert(InitSequence::length(DEFAULT_INIT_SEQUENCE.data()) == SSD1309Controller::INIT_SEQUENCE_LENGTH,
+              "SSD1309 init sequence length mismatch");
+
 SSD1309Controller::SSD1309Controller(const SSD1309Config& config)
-    : config_(config), frame_buffer_(nullptr), buffer_size_(0), dirty_(true) {
+    : config_(config), width_(config.width), height_(config.height), frame_buffer_(nullptr),
+      transpose_buffer_(nullptr), buffer_size_(0),
+      dirty_pages_(0), start_line_(0), start_line_dirty_(false), dither_(config.dither),
+      init_sequence_(buildInitSequence(config)), init_pending_(false),
+      gray_plane_(nullptr), send_planes_(nullptr), pending_planes_(nullptr), planes_pending_(false),
+      planes_mutex_(nullptr), gray_timer_(nullptr), gray_task_(nullptr), gray_exit_(nullptr),
+      gray_running_(false), planes_per_second_(0), subframe_(0), planes_sent_(0),
+      window_start_us_(0) {
     
     // 计算缓冲区大小：宽度 * 高度 / 8 (每个字节存储8个像素)
     buffer_size_ = (config_.width * config_.height) / 8;
@@ -18,101 +37,71 @@ SSD1309Controller::SSD1309Controller(const SSD1309Config& config)
     
     // 初始化缓冲区为全黑
     memset(frame_buffer_, 0x00, buffer_size_);
+    if (config_.grayscale) {
+        gray_plane_ = new uint8_t[buffer_size_];
+        memset(gray_plane_, 0x00, buffer_size_);
+    }
+    applyRotation();
     
     ESP_LOGI(TAG, "SSD1309Controller created: %dx%d, buffer size: %zu bytes", 
-             config_.width, config_.height, buffer_size_);
+             width_, height_, buffer_size_);
 }
 
-bool SSD1309Controller::initialize(ESP32_SPI_Driver* spi_driver) {
-    spi_driver_ = spi_driver;
-    
-    if (!spi_driver_) {
-        ESP_LOGE(TAG, "SPI driver is null");
+SSD1309Controller::~SSD1309Controller() {
+    stopGrayscale();
+    delete[] frame_buffer_;
+    delete[] gray_plane_;
+    delete[] transpose_buffer_;
+}
+
+bool SSD1309Controller::initialize(DisplayTransport* transport) {
+    if (!beginInit(transport)) {
         return false;
     }
     
-    ESP_LOGI(TAG, "Initializing SSD1309 OLED controller");
-    
-    // 发送初始化命令序列
-    initializeCommands();
-    
-    // 清屏
-    clearScreen();
-    
-    // 开启显示
-    sendCommand(SSD1309_DISPLAYON);
-    
+    // 阻塞方式：按初始化表中的延时等待
+    uint32_t wait_ms = 0;
+    while (!pollInit(wait_ms)) {
+        vTaskDelay(pdMS_TO_TICKS(wait_ms > 0 ? wait_ms : 1));
+    }
     ESP_LOGI(TAG, "SSD1309 initialization completed");
     return true;
 }
 
-void SSD1309Controller::initializeCommands() {
-    // 关闭显示
-    sendCommand(SSD1309_DISPLAYOFF);
-    
-    // 设置显示时钟分频
-    sendCommand(SSD1309_SETDISPLAYCLOCKDIV, 0x80);
-    
-    // 设置多路复用比
-    sendCommand(SSD1309_SETMULTIPLEX, config_.height - 1);
-    
-    // 设置显示偏移
-    sendCommand(SSD1309_SETDISPLAYOFFSET, 0x00);
-    
-    // 设置起始行
-    sendCommand(SSD1309_SETSTARTLINE | 0x0);
+bool SSD1309Controller::beginInit(DisplayTransport* transport) {
+    transport_ = transport;
     
-    // 设置电荷泵
-    if (config_.external_vcc) {
-        sendCommand(SSD1309_CHARGEPUMP, 0x10);
-    } else {
-        sendCommand(SSD1309_CHARGEPUMP, 0x14);
-    }
-    
-    // 设置内存地址模式为水平模式
-    sendCommand(SSD1309_MEMORYMODE, 0x00);
-    
-    // 设置段重映射
-    if (config_.flip_horizontal) {
-        sendCommand(SSD1309_SEGREMAP | 0x1);
-    } else {
-        sendCommand(SSD1309_SEGREMAP | 0x0);
+    if (!transport_) {
+        ESP_LOGE(TAG, "Transport is null");
+        return false;
     }
     
-    // 设置COM扫描方向
-    if (config_.flip_vertical) {
-        sendCommand(SSD1309_COMSCANDEC);
-    } else {
-        sendCommand(SSD1309_COMSCANINC);
+    ESP_LOGI(TAG, "Initializing SSD1309 OLED controller");
+    sequencer_.start(init_sequence_.data());
+    init_pending_ = true;
+    return true;
+}
+
+bool SSD1309Controller::pollInit(uint32_t& wait_ms) {
+    wait_ms = 0;
+    if (!init_pending_) {
+        return true;
     }
-    
-    // 设置COM引脚配置
-    uint8_t com_pins = 0x02;
-    if (config_.height == 64) {
-        com_pins = 0x12;
-    } else if (config_.height == 32) {
-        com_pins = 0x02;
+    if (!sequencer_.step(*transport_, wait_ms)) {
+        return false;
     }
-    sendCommand(SSD1309_SETCOMPINS, com_pins);
-    
-    // 设置对比度
-    sendCommand(SSD1309_SETCONTRAST, 0xCF);
     
-    // 设置预充电周期
-    if (config_.external_vcc) {
-        sendCommand(SSD1309_SETPRECHARGE, 0x22);
-    } else {
-        sendCommand(SSD1309_SETPRECHARGE, 0xF1);
+    // 清屏和开启显示作为一帧发送，共享总线时不被其他设备打断
+    transport_->beginFrame();
+    if (start_line_ != 0) {
+        sendCommand(SSD1309_SETSTARTLINE | static_cast<uint8_t>(start_line_));
     }
+    clearScreen();
+    sendCommand(SSD1309_DISPLAYON);
+    transport_->endFrame();
     
-    // 设置VCOM检测电平
-    sendCommand(SSD1309_SETVCOMDETECT, 0x40);
-    
-    // 恢复正常显示
-    sendCommand(SSD1309_DISPLAYALLON_RESUME);
-    
-    // 设置正常显示模式
-    sendCommand(SSD1309_NORMALDISPLAY);
+    init_pending_ = false;
+    return true;
 }
 
 void SSD1309Controller::setAddrWindow(int16_t x, int16_t y, int16_t w, int16_t h) {
@@ -124,84 +113,650 @@ void SSD1309Controller::setAddrWindow(int16_t x, int16_t y, int16_t w, int16_t h
     if (x2 >= config_.width) x2 = config_.width - 1;
     if (y2 >= config_.height) y2 = config_.height - 1;
     
-    // 设置列地址范围
-    sendCommand(SSD1309_COLUMNADDR);
-    sendCommand(x);
-    sendCommand(x2);
-    
-    // 设置页地址范围 (每页8像素高)
-    sendCommand(SSD1309_PAGEADDR);
-    sendCommand(y / 8);
-    sendCommand(y2 / 8);
+    // 列地址范围和页地址范围（每页8像素高）作为一次命令传输
+    const uint8_t cmds[6] = {
+        SSD1309_COLUMNADDR, static_cast<uint8_t>(x), static_cast<uint8_t>(x2),
+        SSD1309_PAGEADDR, static_cast<uint8_t>(y / 8), static_cast<uint8_t>(y2 / 8)
+    };
+    if (transport_) {
+        transport_->sendCommands(cmds, sizeof(cmds));
+    }
 }
 
 void SSD1309Controller::writePixelData(const uint8_t* data, size_t length) {
-    if (!spi_driver_ || !data || length == 0) {
+    if (!transport_ || !data || length == 0) {
         return;
     }
     
     // SSD1309直接发送数据
-    spi_driver_->sendBuffer(data, length);
+    transport_->sendBuffer(data, length);
 }
 
 void SSD1309Controller::setPixel(int16_t x, int16_t y, bool color) {
-    if (x < 0 || x >= config_.width || y < 0 || y >= config_.height) {
+    if (x < 0 || x >= width_ || y < 0 || y >= height_) {
         return; // 越界检查
     }
     
     // 计算在帧缓冲区中的位置
-    // SSD1309使用页模式：每页8像素高，按列存储
-    int16_t page = y / 8;
-    int16_t bit = y % 8;
-    size_t index = page * config_.width + x;
+    // SSD1309使用页模式：每页8像素高，按列存储；行号需加上硬件起始行偏移
+    int16_t row = physicalRow(y);
+    int16_t page = row / 8;
+    int16_t bit = row % 8;
+    size_t index = page * width_ + x;
     
     if (index >= buffer_size_) {
         return;
     }
     
-    // 设置或清除对应的位
+    // 设置或清除对应的位；灰度模式下两个平面同时设置（灰度级0或3）
     if (color) {
         frame_buffer_[index] |= (1 << bit);
     } else {
         frame_buffer_[index] &= ~(1 << bit);
     }
+    if (gray_plane_) {
+        gray_plane_[index] = (gray_plane_[index] & ~(1 << bit)) | (frame_buffer_[index] & (1 << bit));
+    }
     
-    dirty_ = true;
+    markDirty(page, x, 1);
+}
+
+bool SSD1309Controller::fillBufferRect(int16_t x, int16_t y, int16_t w, int16_t h, Color color) {
+    if (w <= 0 || h <= 0) {
+        return true;
+    }
+
+    // 灰度模式下高位图案写入frame_buffer_，低位图案写入gray_plane_
+    const uint8_t* pattern = nullptr;
+    uint8_t low_pattern[8];
+    uint8_t high_pattern[8];
+    if (gray_plane_) {
+        dither_.pattern2(color, low_pattern, high_pattern);
+        pattern = high_pattern;
+    } else {
+        pattern = dither_.pattern(color);
+    }
+
+    // 帧缓冲区是以起始行为偏移的环形缓冲区，逻辑行区间最多拆成两段物理行
+    int16_t row = physicalRow(y);
+    int16_t first = std::min<int16_t>(h, height_ - row);
+    fillPhysicalRows(frame_buffer_, x, row, w, first, pattern);
+    if (gray_plane_) {
+        fillPhysicalRows(gray_plane_, x, row, w, first, low_pattern);
+    }
+    if (first < h) {
+        fillPhysicalRows(frame_buffer_, x, 0, w, h - first, pattern);
+        if (gray_plane_) {
+            fillPhysicalRows(gray_plane_, x, 0, w, h - first, low_pattern);
+        }
+    }
+    return true;
+}
+
+bool SSD1309Controller::drawBufferBitmap(int16_t x, int16_t y, int16_t w, int16_t h,
+                                         const Color* pixels, int16_t stride) {
+    if (w <= 0 || h <= 0 || !pixels) {
+        return true;
+    }
+
+    int16_t row = physicalRow(y);
+    int16_t first = std::min<int16_t>(h, height_ - row);
+    bitmapPhysicalRows(x, row, w, first, pixels, stride);
+    if (first < h) {
+        bitmapPhysicalRows(x, 0, w, h - first, pixels + static_cast<int32_t>(first) * stride, stride);
+    }
+    return true;
+}
+
+bool SSD1309Controller::scroll(int16_t dy) {
+    if (dy == 0) {
+        return true;
+    }
+    if (gray_plane_ || transposed(config_.rotation)) {
+        // 后台轮换发送的是整屏位平面，不跟随起始行；转置后面板的行方向是逻辑的列方向
+        return false;
+    }
+
+    const int16_t height = height_;
+    if (dy >= height || dy <= -height) {
+        // 整屏滚出，等价于清屏
+        memset(frame_buffer_, 0x00, buffer_size_);
+        markAllDirty();
+        return true;
+    }
+
+    // 移动起始行后，滚出屏幕的物理行成为新露出的行，清空它们并只标记这些页
+    start_line_ = static_cast<int16_t>((start_line_ + dy + height) % height);
+    start_line_dirty_ = true;
+    if (dy > 0) {
+        fillBufferRect(0, height - dy, width_, dy, Colors::BLACK);
+    } else {
+        fillBufferRect(0, 0, width_, -dy, Colors::BLACK);
+    }
+
+    ESP_LOGD(TAG, "Scrolled by %d rows, start line %d", dy, start_line_);
+    return true;
+}
+
+bool SSD1309Controller::shiftBufferRect(int16_t x, int16_t y, int16_t w, int16_t h, int16_t dx) {
+    if (w <= 0 || h <= 0 || dx == 0) {
+        return true;
+    }
+
+    // 与fillBufferRect相同，逻辑行区间最多拆成两段物理行；灰度的两个平面一起平移
+    int16_t row = physicalRow(y);
+    int16_t first = std::min<int16_t>(h, height_ - row);
+    shiftPhysicalRows(frame_buffer_, x, row, w, first, dx);
+    if (gray_plane_) {
+        shiftPhysicalRows(gray_plane_, x, row, w, first, dx);
+    }
+    if (first < h) {
+        shiftPhysicalRows(frame_buffer_, x, 0, w, h - first, dx);
+        if (gray_plane_) {
+            shiftPhysicalRows(gray_plane_, x, 0, w, h - first, dx);
+        }
+    }
+    return true;
+}
+
+const uint8_t* SSD1309Controller::snapshotData(size_t& size) {
+    // 滚动后帧缓冲区按物理行保存，与起始行为0的快照不一致
+    if (gray_plane_ || start_line_ != 0) {
+        size = 0;
+        return nullptr;
+    }
+    size = buffer_size_;
+    return frame_buffer_;
+}
+
+uint8_t* SSD1309Controller::snapshotTarget(size_t& size) {
+    if (gray_plane_) {
+        size = 0;
+        return nullptr;
+    }
+    size = buffer_size_;
+    return frame_buffer_;
+}
+
+void SSD1309Controller::presentSnapshot() {
+    // 快照按起始行0保存；整屏各页都脏时refresh()合并为一次窗口写入
+    if (start_line_ != 0) {
+        start_line_ = 0;
+        start_line_dirty_ = true;
+    }
+    markAllDirty();
+    refresh();
+}
+
+void SSD1309Controller::fillPhysicalRows(uint8_t* buffer, int16_t x, int16_t row, int16_t w, int16_t h,
+                                         const uint8_t* pattern) {
+    // 一个字节是同一列的8行，按页掩码整字节写入抖动图案；纯黑纯白整页覆盖时退化为memset
+    bool uniform = true;
+    for (uint8_t i = 1; i < 8; i++) {
+        uniform = uniform && pattern[i] == pattern[0];
+    }
+    const bool solid = uniform && (pattern[0] == 0x00 || pattern[0] == 0xFF);
+
+    const int16_t row_end = row + h;
+    for (int16_t page = row / 8; page <= (row_end - 1) / 8; page++) {
+        int16_t base = page * 8;
+        int16_t low = std::max(row, base) - base;
+        int16_t high = std::min<int16_t>(row_end, base + 8) - base;
+        uint8_t mask = static_cast<uint8_t>((0xFF << low) & (0xFF >> (8 - high)));
+        uint8_t* dst = buffer + page * width_ + x;
+
+        if (solid && mask == 0xFF) {
+            memset(dst, pattern[0], w);
+        } else {
+            const uint8_t keep = static_cast<uint8_t>(~mask);
+            for (int16_t i = 0; i < w; i++) {
+                dst[i] = (dst[i] & keep) | (pattern[(x + i) & 7] & mask);
+            }
+        }
+        markDirty(page, x, w);
+    }
+}
+
+void SSD1309Controller::shiftPhysicalRows(uint8_t* buffer, int16_t x, int16_t row, int16_t w, int16_t h,
+                                          int16_t dx) {
+    // 列在页内是连续字节，水平平移就是页内的字节搬移；左移时从左向右复制，右移时反向
+    const int16_t length = w - std::abs(dx);
+    const int16_t dst_x = x + std::max<int16_t>(dx, 0);
+    const int16_t src_x = x + std::max<int16_t>(-dx, 0);
+
+    const int16_t row_end = row + h;
+    for (int16_t page = row / 8; page <= (row_end - 1) / 8; page++) {
+        int16_t base = page * 8;
+        int16_t low = std::max(row, base) - base;
+        int16_t high = std::min<int16_t>(row_end, base + 8) - base;
+        uint8_t mask = static_cast<uint8_t>((0xFF << low) & (0xFF >> (8 - high)));
+        uint8_t* dst = buffer + page * width_ + dst_x;
+        const uint8_t* src = buffer + page * width_ + src_x;
+
+        if (mask == 0xFF) {
+            memmove(dst, src, length);
+        } else if (dx < 0) {
+            for (int16_t i = 0; i < length; i++) {
+                dst[i] = (dst[i] & ~mask) | (src[i] & mask);
+            }
+        } else {
+            for (int16_t i = length - 1; i >= 0; i--) {
+                dst[i] = (dst[i] & ~mask) | (src[i] & mask);
+            }
+        }
+        markDirty(page, x, w);
+    }
+}
+
+void SSD1309Controller::bitmapPhysicalRows(int16_t x, int16_t row, int16_t w, int16_t h,
+                                           const Color* pixels, int16_t stride) {
+    // 每列收集页内各行像素的亮度，一次生成一个页字节
+    const int16_t row_end = row + h;
+    for (int16_t page = row / 8; page <= (row_end - 1) / 8; page++) {
+        int16_t base = page * 8;
+        int16_t low = std::max(row, base) - base;
+        int16_t high = std::min<int16_t>(row_end, base + 8) - base;
+        uint8_t mask = static_cast<uint8_t>((0xFF << low) & (0xFF >> (8 - high)));
+        uint8_t* dst = frame_buffer_ + page * width_ + x;
+        const Color* src = pixels + static_cast<int32_t>(base + low - row) * stride;
+
+        uint8_t lum[8] = {};
+        for (int16_t i = 0; i < w; i++) {
+            for (int16_t bit = low; bit < high; bit++) {
+                lum[bit] = luminance(src[(bit - low) * stride + i]);
+            }
+            if (!gray_plane_) {
+                uint8_t bits = dither_.pageByte(x + i, lum);
+                dst[i] = (dst[i] & ~mask) | (bits & mask);
+                continue;
+            }
+
+            // 灰度模式：每个像素的灰度级拆到两个平面
+            uint8_t lsb = 0;
+            uint8_t msb = 0;
+            for (int16_t bit = low; bit < high; bit++) {
+                uint8_t level = dither_.level2(lum[bit], x + i, bit);
+                lsb |= static_cast<uint8_t>((level & 0x01) << bit);
+                msb |= static_cast<uint8_t>(((level >> 1) & 0x01) << bit);
+            }
+            uint8_t* gray_dst = gray_plane_ + page * width_ + x;
+            gray_dst[i] = (gray_dst[i] & ~mask) | lsb;
+            dst[i] = (dst[i] & ~mask) | msb;
+        }
+        markDirty(page, x, w);
+    }
+}
+
+bool SSD1309Controller::setRotation(Rotation rotation) {
+    if (rotation == config_.rotation) {
+        return true;
+    }
+    // 初始化表正在发送时不能改动其中的重映射命令
+    if (init_pending_ ||
+        (transposed(rotation) && (grayscaleRunning() || config_.height % 8 != 0 || config_.width / 8 > MAX_PAGES))) {
+        ESP_LOGW(TAG, "Rotation %d not supported in current mode", static_cast<int>(rotation) * 90);
+        return false;
+    }
+
+    config_.rotation = rotation;
+    init_sequence_ = buildInitSequence(config_);
+    applyRotation();
+
+    // 帧缓冲区按新尺寸重新排列，旧内容无意义；起始行回到0
+    memset(frame_buffer_, 0x00, buffer_size_);
+    if (gray_plane_) {
+        memset(gray_plane_, 0x00, buffer_size_);
+    }
+    if (start_line_ != 0) {
+        start_line_ = 0;
+        start_line_dirty_ = true;
+    }
+
+    // 未初始化时重映射随初始化表发送
+    if (transport_) {
+        const uint8_t cmds[2] = {
+            static_cast<uint8_t>(SSD1309_SEGREMAP | (segmentRemapped(config_) ? 0x01 : 0x00)),
+            comScanReversed(config_) ? SSD1309_COMSCANDEC : SSD1309_COMSCANINC
+        };
+        transport_->beginFrame();
+        transport_->sendCommands(cmds, sizeof(cmds));
+        transport_->endFrame();
+    }
+    ESP_LOGI(TAG, "Rotation %d, %dx%d", static_cast<int>(rotation) * 90, width_, height_);
+    return true;
+}
+
+void SSD1309Controller::applyRotation() {
+    if (transposed(config_.rotation)) {
+        width_ = config_.height;
+        height_ = config_.width;
+        if (!transpose_buffer_) {
+            transpose_buffer_ = new uint8_t[buffer_size_];
+        }
+    } else {
+        width_ = config_.width;
+        height_ = config_.height;
+    }
+    markAllDirty();
+}
+
+void SSD1309Controller::transpose8x8(const uint8_t* in, uint8_t* out) {
+    // 64位字中第i字节第j位位于8i+j，转置即交换8i+j与8j+i：
+    // 依次交换对角线两侧的1x1、2x2、4x4子块，每步一次移位异或
+    uint64_t x = 0;
+    for (int i = 7; i >= 0; i--) {
+        x = (x << 8) | in[i];
+    }
+    uint64_t t = (x ^ (x >> 7)) & 0x00AA00AA00AA00AAULL;
+    x ^= t ^ (t << 7);
+    t = (x ^ (x >> 14)) & 0x0000CCCC0000CCCCULL;
+    x ^= t ^ (t << 14);
+    t = (x ^ (x >> 28)) & 0x00000000F0F0F0F0ULL;
+    x ^= t ^ (t << 28);
+    for (int i = 0; i < 8; i++) {
+        out[i] = static_cast<uint8_t>(x >> (8 * i));
+    }
+}
+
+void SSD1309Controller::markAllDirty() {
+    const int16_t pages = height_ / 8;
+    dirty_pages_ = (1UL << pages) - 1;
+    for (int16_t page = 0; page < pages; page++) {
+        dirty_x0_[page] = 0;
+        dirty_x1_[page] = width_;
+    }
+}
+
+void SSD1309Controller::markDirty(int16_t page, int16_t x, int16_t w) {
+    // 每页只记录一个列区间，多处修改时取并集
+    if (!(dirty_pages_ & (1UL << page))) {
+        dirty_pages_ |= 1UL << page;
+        dirty_x0_[page] = x;
+        dirty_x1_[page] = x + w;
+        return;
+    }
+    dirty_x0_[page] = std::min<int16_t>(dirty_x0_[page], x);
+    dirty_x1_[page] = std::max<int16_t>(dirty_x1_[page], x + w);
 }
 
 void SSD1309Controller::clearScreen() {
     // 清空帧缓冲区
     memset(frame_buffer_, 0x00, buffer_size_);
-    dirty_ = true;
+    if (gray_plane_) {
+        memset(gray_plane_, 0x00, buffer_size_);
+    }
+    markAllDirty();
     
     // 立即刷新到显示器
     refresh();
 }
 
 void SSD1309Controller::refresh() {
-    if (!spi_driver_ || !dirty_) {
+    MUI_TRACE_SCOPE("ssd1309.refresh");
+    if (!transport_ || (dirty_pages_ == 0 && !start_line_dirty_)) {
         return;
     }
     
-    // 设置整个显示区域
-    setAddrWindow(0, 0, config_.width, config_.height);
+    if (grayscaleRunning()) {
+        // 位平面由后台任务整屏发送，这里只更新待发送平面，任务发送下一个位平面前换入
+        xSemaphoreTake(planes_mutex_, portMAX_DELAY);
+        memcpy(pending_planes_, gray_plane_, buffer_size_);
+        memcpy(pending_planes_ + buffer_size_, frame_buffer_, buffer_size_);
+        planes_pending_ = true;
+        xSemaphoreGive(planes_mutex_);
+        dirty_pages_ = 0;
+        return;
+    }
+    
+    if (transposed(config_.rotation)) {
+        refreshTransposed();
+        return;
+    }
+    
+    transport_->beginFrame();
+    
+    // 只发送脏页中的脏列；整页都脏的连续页在帧缓冲区中连续，合并为一次窗口写入
+    const int16_t pages = config_.height / 8;
+    auto fullWidth = [this](int16_t p) {
+        return (dirty_pages_ & (1UL << p)) && dirty_x0_[p] == 0 && dirty_x1_[p] == config_.width;
+    };
+    int16_t page = 0;
+    while (page < pages) {
+        if (!(dirty_pages_ & (1UL << page))) {
+            page++;
+            continue;
+        }
+        
+        if (!fullWidth(page)) {
+            int16_t x = dirty_x0_[page];
+            int16_t w = dirty_x1_[page] - x;
+            setAddrWindow(x, page * 8, w, 8);
+            writePixelData(frame_buffer_ + page * config_.width + x, w);
+            page++;
+            continue;
+        }
+        
+        int16_t run_end = page;
+        while (run_end + 1 < pages && fullWidth(run_end + 1)) {
+            run_end++;
+        }
+        
+        setAddrWindow(0, page * 8, config_.width, (run_end - page + 1) * 8);
+        writePixelData(frame_buffer_ + page * config_.width,
+                       (run_end - page + 1) * config_.width);
+        page = run_end + 1;
+    }
+    dirty_pages_ = 0;
     
-    // 发送整个帧缓冲区
-    writePixelData(frame_buffer_, buffer_size_);
+    // 新露出的行已写入显存后再切换起始行，避免显示残留内容
+    if (start_line_dirty_) {
+        sendCommand(SSD1309_SETSTARTLINE | static_cast<uint8_t>(start_line_));
+        start_line_dirty_ = false;
+    }
     
-    dirty_ = false;
+    transport_->endFrame();
+}
+
+void SSD1309Controller::refreshTransposed() {
+    MUI_TRACE_SCOPE("ssd1309.transpose");
+    // 帧缓冲区第p页的列x..x+7对应显存第x/8页的列8p..8p+7，
+    // 脏区转换到显存坐标后取包围盒，转置后作为一个窗口发送
+    const int16_t pages = height_ / 8;
+    int16_t col0 = config_.width;
+    int16_t col1 = 0;
+    int16_t page0 = config_.height / 8;
+    int16_t page1 = 0;
+    for (int16_t page = 0; page < pages; page++) {
+        if (!(dirty_pages_ & (1UL << page))) {
+            continue;
+        }
+        col0 = std::min<int16_t>(col0, page * 8);
+        col1 = std::max<int16_t>(col1, page * 8 + 8);
+        page0 = std::min<int16_t>(page0, dirty_x0_[page] / 8);
+        page1 = std::max<int16_t>(page1, (dirty_x1_[page] + 7) / 8);
+    }
+    dirty_pages_ = 0;
+
+    transport_->beginFrame();
+    if (col0 < col1) {
+        const int16_t w = col1 - col0;
+        uint8_t* out = transpose_buffer_;
+        for (int16_t page = page0; page < page1; page++) {
+            for (int16_t col = col0; col < col1; col += 8) {
+                transpose8x8(frame_buffer_ + (col / 8) * width_ + page * 8, out);
+                out += 8;
+            }
+        }
+        setAddrWindow(col0, page0 * 8, w, (page1 - page0) * 8);
+        writePixelData(transpose_buffer_, static_cast<size_t>(w) * (page1 - page0));
+    }
+    if (start_line_dirty_) {
+        sendCommand(SSD1309_SETSTARTLINE | static_cast<uint8_t>(start_line_));
+        start_line_dirty_ = false;
+    }
+    transport_->endFrame();
+}
+
+bool SSD1309Controller::startGrayscale() {
+    if (grayscaleRunning()) {
+        return true;
+    }
+    if (!gray_plane_ || !transport_ || config_.plane_rate == 0) {
+        ESP_LOGE(TAG, "Grayscale mode not configured or controller not initialized");
+        return false;
+    }
+    if (transposed(config_.rotation)) {
+        // 后台任务直接整屏发送位平面，不经过转置
+        ESP_LOGE(TAG, "Grayscale mode requires 0 or 180 degree rotation");
+        return false;
+    }
+
+    // 发送平面放在DMA可访问的内存中，SPI传输不需要额外拷贝；待发送平面与其交换，同样需要DMA内存
+    send_planes_ = static_cast<uint8_t*>(heap_caps_malloc(buffer_size_ * 2, MALLOC_CAP_DMA));
+    pending_planes_ = static_cast<uint8_t*>(heap_caps_malloc(buffer_size_ * 2, MALLOC_CAP_DMA));
+    gray_exit_ = xSemaphoreCreateBinary();
+    planes_mutex_ = xSemaphoreCreateMutex();
+    if (!send_planes_ || !pending_planes_ || !gray_exit_ || !planes_mutex_) {
+        ESP_LOGE(TAG, "Failed to allocate DMA plane buffers");
+        freeGrayResources();
+        return false;
+    }
+    memcpy(send_planes_, gray_plane_, buffer_size_);
+    memcpy(send_planes_ + buffer_size_, frame_buffer_, buffer_size_);
+    planes_pending_ = false;
+    dirty_pages_ = 0;
+
+    subframe_ = 0;
+    planes_sent_ = 0;
+    window_start_us_ = esp_timer_get_time();
+    planes_per_second_.store(0, std::memory_order_relaxed);
+    gray_running_.store(true, std::memory_order_release);
+
+    if (xTaskCreate(grayTask, "ssd1309_gray", 3072, this, 5, &gray_task_) != pdPASS) {
+        ESP_LOGE(TAG, "Failed to create grayscale task");
+        gray_running_.store(false, std::memory_order_release);
+        gray_task_ = nullptr;
+        freeGrayResources();
+        return false;
+    }
+
+    esp_timer_create_args_t timer_args = {};
+    timer_args.callback = grayTimerCallback;
+    timer_args.arg = this;
+    timer_args.dispatch_method = ESP_TIMER_TASK;
+    timer_args.name = "ssd1309_gray";
+    timer_args.skip_unhandled_events = true;
+    if (esp_timer_create(&timer_args, &gray_timer_) != ESP_OK ||
+        esp_timer_start_periodic(gray_timer_, 1000000ULL / config_.plane_rate) != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to start grayscale timer");
+        stopGrayscale();
+        return false;
+    }
+
+    ESP_LOGI(TAG, "Grayscale started: %u planes/s", config_.plane_rate);
+    return true;
+}
+
+void SSD1309Controller::stopGrayscale() {
+    if (!grayscaleRunning()) {
+        return;
+    }
+
+    if (gray_timer_) {
+        esp_timer_stop(gray_timer_);
+        esp_timer_delete(gray_timer_);
+        gray_timer_ = nullptr;
+    }
+
+    // 唤醒任务使其退出，等待它发送完当前平面并给出退出信号后再释放发送平面
+    gray_running_.store(false, std::memory_order_release);
+    xTaskNotifyGive(gray_task_);
+    xSemaphoreTake(gray_exit_, portMAX_DELAY);
+    gray_task_ = nullptr;
+    freeGrayResources();
+    planes_per_second_.store(0, std::memory_order_relaxed);
+
+    // 停止后回到单色刷新，显存内容以高位平面为准
+    markAllDirty();
+}
+
+void SSD1309Controller::grayTimerCallback(void* arg) {
+    auto* self = static_cast<SSD1309Controller*>(arg);
+    if (self->gray_task_) {
+        xTaskNotifyGive(self->gray_task_);
+    }
+}
+
+void SSD1309Controller::grayTask(void* arg) {
+    auto* self = static_cast<SSD1309Controller*>(arg);
+    while (true) {
+        // 发送慢于定时器时多次通知合并为一次，实测速率随之下降
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        if (!self->grayscaleRunning()) {
+            break;
+        }
+        self->sendNextPlane();
+    }
+    // 给出信号后stopGrayscale()可能立即释放发送平面，之后不能再访问self
+    xSemaphoreGive(self->gray_exit_);
+    vTaskDelete(nullptr);
+}
+
+void SSD1309Controller::freeGrayResources() {
+    heap_caps_free(send_planes_);
+    heap_caps_free(pending_planes_);
+    send_planes_ = nullptr;
+    pending_planes_ = nullptr;
+    if (gray_exit_) {
+        vSemaphoreDelete(gray_exit_);
+        gray_exit_ = nullptr;
+    }
+    if (planes_mutex_) {
+        vSemaphoreDelete(planes_mutex_);
+        planes_mutex_ = nullptr;
+    }
+}
+
+void SSD1309Controller::sendNextPlane() {
+    MUI_TRACE_SCOPE("ssd1309.plane");
+    const uint8_t plane = GRAY_SEQUENCE[subframe_];
+    subframe_ = static_cast<uint8_t>((subframe_ + 1) % GRAY_SUBFRAMES);
+
+    // 持锁只交换指针，传输期间refresh()可以继续写入待发送平面
+    xSemaphoreTake(planes_mutex_, portMAX_DELAY);
+    if (planes_pending_) {
+        std::swap(send_planes_, pending_planes_);
+        planes_pending_ = false;
+    }
+    xSemaphoreGive(planes_mutex_);
+
+    transport_->beginFrame();
+    setAddrWindow(0, 0, config_.width, config_.height);
+    writePixelData(send_planes_ + plane * buffer_size_, buffer_size_);
+    transport_->endFrame();
+
+    planes_sent_++;
+    int64_t now = esp_timer_get_time();
+    int64_t elapsed = now - window_start_us_;
+    if (elapsed >= 1000000) {
+        planes_per_second_.store(static_cast<uint16_t>(planes_sent_ * 1000000LL / elapsed),
+                                 std::memory_order_relaxed);
+        planes_sent_ = 0;
+        window_start_us_ = now;
+    }
 }
 
 void SSD1309Controller::sendCommand(uint8_t cmd) {
-    if (spi_driver_) {
-        spi_driver_->sendCommand(cmd);
+    if (transport_) {
+        transport_->sendCommand(cmd);
     }
 }
 
 void SSD1309Controller::sendCommand(uint8_t cmd, uint8_t param) {
-    if (spi_driver_) {
-        spi_driver_->sendCommand(cmd);
-        spi_driver_->sendData(param);
+    if (transport_) {
+        // SSD1309的命令参数同样以DC低电平发送，与命令合并为一次传输
+        const uint8_t cmds[2] = {cmd, param};
+        transport_->sendCommands(cmds, sizeof(cmds));
     }
 }
 
@@ -1,6 +1,14 @@
 #pragma once
 
 #include "DisplayController.h"
+#include "Dither.h"
+#include "InitSequence.h"
+#include <esp_timer.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+#include <freertos/task.h>
+#include <array>
+#include <atomic>
 #include <iostream>
 
 namespace MinimalUI {
@@ -15,26 +23,55 @@ struct SSD1309Config {
     bool external_vcc = false;  // 是否使用外部VCC
     bool flip_horizontal = false; // 水平翻转
     bool flip_vertical = false;   // 垂直翻转
+    Rotation rotation = Rotation::ROTATE_0; // 显示旋转，90°/270°时宽高互换
+    DitherMode dither = DitherMode::BAYER8; // 彩色绘制转换为单色的方式
+    bool grayscale = false;     // 4级灰度模式（两个位平面时间调制）
+    uint16_t plane_rate = 180;  // 灰度模式下每秒发送的位平面数
 };
 
 /**
  * @brief SSD1309 OLED显示控制器实现
  * 支持128x64单色OLED显示器
+ *
+ * 旋转：180°只需同时反转段重映射和COM扫描方向，由硬件完成。SSD1309的寻址模式不能
+ * 交换行列（显存字节始终是同一列的8行），90°/270°时帧缓冲区按旋转后的尺寸排列，
+ * 刷新时每个8x8像素块做一次位矩阵转置，剩下的镜像仍交给段重映射（90°）或COM扫描方向（270°）。
+ *
+ * 所有命令和数据都在DisplayTransport::beginFrame()/endFrame()之间发送，共享总线时
+ * 每帧只申请一次总线，帧内的传输不会与其他设备交错。
  */
 class SSD1309Controller : public DisplayController {
 public:
     explicit SSD1309Controller(const SSD1309Config& config);
-    virtual ~SSD1309Controller() = default;
+    ~SSD1309Controller() override;
 
     // 实现DisplayController接口
-    bool initialize(ESP32_SPI_Driver* spi_driver) override;
+    bool initialize(DisplayTransport* transport) override;
+    bool beginInit(DisplayTransport* transport) override;
+    bool pollInit(uint32_t& wait_ms) override;
+    uint16_t resetRecoveryMs() const override { return 10; }
     void setAddrWindow(int16_t x, int16_t y, int16_t w, int16_t h) override;
     void writePixelData(const uint8_t* data, size_t length) override;
     void clearScreen() override;
     void refresh() override;
-    int16_t getWidth() const override { return config_.width; }
-    int16_t getHeight() const override { return config_.height; }
+    int16_t getWidth() const override { return width_; }
+    int16_t getHeight() const override { return height_; }
     uint8_t getPixelSize() const override { return 1; } // 1位单色
+    bool fillBufferRect(int16_t x, int16_t y, int16_t w, int16_t h, Color color) override;
+    bool drawBufferBitmap(int16_t x, int16_t y, int16_t w, int16_t h,
+                          const Color* pixels, int16_t stride) override;
+    // 起始行只能沿面板的行方向滚动，90°/270°时不支持；配置了灰度模式（SSD1309Config::grayscale）时
+    // 无论后台发送是否运行都不支持，因为位平面整屏发送，不跟随起始行
+    bool scroll(int16_t dy) override;
+    // 逐页memmove，部分覆盖的页按行掩码合并
+    bool shiftBufferRect(int16_t x, int16_t y, int16_t w, int16_t h, int16_t dx) override;
+    // 快照为整个1位帧缓冲区；起始行不为0或启用灰度时不能保存
+    const uint8_t* snapshotData(size_t& size) override;
+    uint8_t* snapshotTarget(size_t& size) override;
+    void presentSnapshot() override;
+    // 灰度发送期间不能切换到90°/270°
+    bool setRotation(Rotation rotation) override;
+    Rotation getRotation() const override { return config_.rotation; }
 
     /**
      * @brief 设置单个像素
@@ -46,15 +83,137 @@ public:
 
     /**
      * @brief 获取帧缓冲区
+     * 缓冲区按旋转后的尺寸以页排列（每页getWidth()字节），逻辑行y位于行 (y + getStartLine()) % getHeight()；
+     * 90°/270°时刷新前还要按8x8块转置才是显存内容
      * @return 指向帧缓冲区的指针
      */
     uint8_t* getFrameBuffer() { return frame_buffer_; }
 
+    /**
+     * @brief 获取当前硬件起始行（滚动偏移）
+     */
+    int16_t getStartLine() const { return start_line_; }
+
+    /**
+     * @brief 获取灰度低位平面（未启用灰度模式时为nullptr）
+     * 灰度模式下getFrameBuffer()为高位平面，像素灰度级 = 高位 * 2 + 低位
+     */
+    uint8_t* getGrayPlane() { return gray_plane_; }
+
+    /**
+     * @brief 启动灰度位平面的后台轮换发送
+     * 定时器按plane_rate唤醒发送任务，每次经DMA整屏发送一个位平面，
+     * 高位平面与低位平面的显示时间为2:1，人眼积分后得到4级灰度。
+     * 运行期间refresh()只把绘制平面复制到待发送平面，由发送任务在下一个位平面前换入，
+     * refresh()不再访问传输接口。
+     * @return 未启用灰度模式、未初始化、旋转90°/270°或资源分配失败时返回false
+     */
+    bool startGrayscale();
+
+    /**
+     * @brief 停止后台发送，显存保留最后发送的位平面
+     */
+    void stopGrayscale();
+
+    bool grayscaleRunning() const { return gray_running_.load(std::memory_order_acquire); }
+
+    /**
+     * @brief 实测的每秒发送位平面数，每秒更新一次
+     * 传输跟不上定时器时低于plane_rate，此时灰度会出现闪烁
+     */
+    uint16_t planesPerSecond() const { return planes_per_second_.load(std::memory_order_relaxed); }
+
+    // 上电初始化表（InitSequence格式）
+    static constexpr size_t INIT_SEQUENCE_LENGTH = 26;
+    using InitTable = std::array<uint8_t, INIT_SEQUENCE_LENGTH>;
+
+    /**
+     * @brief 转置8x8位矩阵
+     * in[i]的第j位成为out[j]的第i位，即一个页字节块的行与列互换
+     */
+    static void transpose8x8(const uint8_t* in, uint8_t* out);
+
+    // 是否反转段重映射（列方向）：水平翻转与90°/180°旋转叠加
+    static constexpr bool segmentRemapped(const SSD1309Config& config) {
+        return config.flip_horizontal != (config.rotation == Rotation::ROTATE_90 ||
+                                          config.rotation == Rotation::ROTATE_180);
+    }
+
+    // 是否反转COM扫描方向（行方向）：垂直翻转与180°/270°旋转叠加
+    static constexpr bool comScanReversed(const SSD1309Config& config) {
+        return config.flip_vertical != (config.rotation == Rotation::ROTATE_180 ||
+                                        config.rotation == Rotation::ROTATE_270);
+    }
+
+    // 90°/270°需要在刷新时转置
+    static constexpr bool transposed(Rotation rotation) {
+        return rotation == Rotation::ROTATE_90 || rotation == Rotation::ROTATE_270;
+    }
+
+    /**
+     * @brief 按配置生成上电初始化表
+     * 全部命令及参数合并为一次命令传输；配置为常量时表在编译期生成
+     */
+    static constexpr InitTable buildInitSequence(const SSD1309Config& config) {
+        return {{
+            InitSequence::CMDS | 24,
+            SSD1309_DISPLAYOFF,
+            SSD1309_SETDISPLAYCLOCKDIV, 0x80,
+            SSD1309_SETMULTIPLEX, static_cast<uint8_t>(config.height - 1),
+            SSD1309_SETDISPLAYOFFSET, 0x00,
+            SSD1309_SETSTARTLINE | 0x00,
+            SSD1309_CHARGEPUMP, static_cast<uint8_t>(config.external_vcc ? 0x10 : 0x14),
+            SSD1309_MEMORYMODE, 0x00,   // 水平寻址
+            static_cast<uint8_t>(SSD1309_SEGREMAP | (segmentRemapped(config) ? 0x01 : 0x00)),
+            comScanReversed(config) ? SSD1309_COMSCANDEC : SSD1309_COMSCANINC,
+            SSD1309_SETCOMPINS, static_cast<uint8_t>(config.height == 64 ? 0x12 : 0x02),
+            SSD1309_SETCONTRAST, 0xCF,
+            SSD1309_SETPRECHARGE, static_cast<uint8_t>(config.external_vcc ? 0x22 : 0xF1),
+            SSD1309_SETVCOMDETECT, 0x40,
+            SSD1309_DISPLAYALLON_RESUME,
+            SSD1309_NORMALDISPLAY,
+            InitSequence::END
+        }};
+    }
+
+    // 一个灰度周期内依次发送的位平面（1=高位，0=低位）
+    static constexpr uint8_t GRAY_SUBFRAMES = 3;
+    static constexpr uint8_t GRAY_SEQUENCE[GRAY_SUBFRAMES] = {1, 0, 1};
+
 private:
+    // 帧缓冲区最多的页数：90°/270°时128列成为128行
+    static constexpr int16_t MAX_PAGES = 16;
+
     SSD1309Config config_;
-    uint8_t* frame_buffer_;     // 帧缓冲区
+    int16_t width_;             // 旋转后的宽度（帧缓冲区每页字节数）
+    int16_t height_;            // 旋转后的高度
+    uint8_t* frame_buffer_;     // 帧缓冲区（以起始行为偏移的环形缓冲区）
+    uint8_t* transpose_buffer_; // 90°/270°时转置后待发送的显存数据
     size_t buffer_size_;        // 缓冲区大小
-    bool dirty_;                // 是否需要刷新
+    uint32_t dirty_pages_;      // 需要刷新的页（按位）
+    int16_t dirty_x0_[MAX_PAGES]; // 每页脏列范围起点
+    int16_t dirty_x1_[MAX_PAGES]; // 每页脏列范围终点（不包含）
+    int16_t start_line_;        // 硬件起始行
+    bool start_line_dirty_;     // 起始行是否需要在刷新时发送
+    MonoDither dither_;         // RGB565到页字节的转换
+    InitTable init_sequence_;   // 按配置生成的初始化表
+    InitSequencer sequencer_;   // 非阻塞发送初始化表
+    bool init_pending_;         // 初始化表发送完后还需清屏并开启显示
+
+    // 灰度模式
+    uint8_t* gray_plane_;       // 低位绘制平面，frame_buffer_为高位绘制平面
+    uint8_t* send_planes_;      // DMA发送平面：低位在前、高位在后，只由发送任务访问
+    uint8_t* pending_planes_;   // refresh()写入的待发送平面，布局同send_planes_
+    bool planes_pending_;       // pending_planes_有未换入的内容
+    SemaphoreHandle_t planes_mutex_; // 保护pending_planes_和planes_pending_，只在复制和交换指针时持有
+    esp_timer_handle_t gray_timer_;
+    TaskHandle_t gray_task_;
+    SemaphoreHandle_t gray_exit_; // 发送任务退出前给出，stopGrayscale()等待它后再释放发送平面
+    std::atomic<bool> gray_running_;
+    std::atomic<uint16_t> planes_per_second_;
+    uint8_t subframe_;          // 当前灰度周期内的子帧
+    uint32_t planes_sent_;      // 当前统计窗口内发送的位平面数
+    int64_t window_start_us_;   // 当前统计窗口起点
 
     // SSD1309命令定义
     static constexpr uint8_t SSD1309_SETCONTRAST = 0x81;
@@ -82,11 +241,25 @@ private:
     static constexpr uint8_t SSD1309_CHARGEPUMP = 0x8D;
 
     // 私有方法
+    int16_t physicalRow(int16_t y) const { return (y + start_line_) % height_; }
+    void applyRotation();
+    void refreshTransposed();
+    void markAllDirty();
+    void markDirty(int16_t page, int16_t x, int16_t w);
+    void fillPhysicalRows(uint8_t* buffer, int16_t x, int16_t row, int16_t w, int16_t h,
+                          const uint8_t* pattern);
+    void shiftPhysicalRows(uint8_t* buffer, int16_t x, int16_t row, int16_t w, int16_t h, int16_t dx);
+    void bitmapPhysicalRows(int16_t x, int16_t row, int16_t w, int16_t h,
+                            const Color* pixels, int16_t stride);
     void sendCommand(uint8_t cmd);
     void sendCommand(uint8_t cmd, uint8_t param);
-    void initializeCommands();
     void setPageMode();
     void setHorizontalMode();
+    void sendNextPlane();
+    // 释放发送平面和退出信号量（发送任务已退出或未创建）
+    void freeGrayResources();
+    static void grayTimerCallback(void* arg);
+    static void grayTask(void* arg);
 };
 
 } // namespace MinimalUI
\ No newline at end of file
@@ -3,11 +3,27 @@
 #include <freertos/task.h>
 #include "../components/esp32_drivers/ESP32_SPI_Driver.h"
 #include "../components/esp32_drivers/controllers/SSD1309Controller.h"
+#include "AssetPack.h"
+#include "GlyphCache.h"
+#include "IconCache.h"
+#include "RenderQueue.h"
 
 using namespace MinimalUI;
 
 static const char* TAG = "MinimalUI_ESP32";
 
+// 所有任务都通过命令队列绘制，只有渲染任务访问驱动、SPI总线和帧缓冲区
+static RenderQueue renderQueue;
+
+// assets分区中的资源包，未写入时各测试图案只使用内置字体
+static AssetPack assets;
+
+// 矢量图标的位图缓存，只在渲染任务中使用
+static IconCache iconCache(4096);
+
+// 资源包中中文字形集的缓存，驱动交给渲染任务前挂到驱动上
+static GlyphCache glyphCache;
+
 // 创建ESP32 SPI驱动实例 (SSD1309 OLED)
 MinimalUI::ESP32_SPI_Driver* createESP32Driver() {
     // 配置SPI接口
@@ -36,108 +52,206 @@ MinimalUI::ESP32_SPI_Driver* createESP32Driver() {
     return new ESP32_SPI_Driver(spi_config, std::move(controller));
 }
 
+/**
+ * @brief 结束一个测试图案：请求刷新并报告队列满时丢弃的命令
+ * 绘制命令被丢弃时图案不完整，但下一个图案会先清屏；刷新请求本身等到入队为止。
+ */
+static void present(RenderQueue& queue) {
+    static uint32_t reported = 0;
+    const uint32_t dropped = queue.dropped();
+    if (dropped != reported) {
+        ESP_LOGW(TAG, "Render queue full: %u commands dropped", static_cast<unsigned>(dropped - reported));
+    }
+    while (!queue.display()) {
+        vTaskDelay(pdMS_TO_TICKS(10));
+    }
+    reported = queue.dropped();
+}
+
 // 简单测试图案1：全屏填充
-void testPattern1_FullFill(ESP32_SPI_Driver* driver) {
+void testPattern1_FullFill(RenderQueue& queue) {
     ESP_LOGI(TAG, "Test 1: Full white screen");
-    driver->clear(1);  // 全白
-    driver->display();
+    queue.clear(1);  // 全白
+    present(queue);
 }
 
 // 简单测试图案2：四个角落的方块
-void testPattern2_CornerBlocks(ESP32_SPI_Driver* driver) {
+void testPattern2_CornerBlocks(RenderQueue& queue) {
     ESP_LOGI(TAG, "Test 2: Corner blocks");
-    driver->clear(0);  // 清屏
+    queue.clear(0);  // 清屏
     
     // 四个角落的小方块 (8x8像素)
-    driver->fillRect(0, 0, 8, 8, 1);           // 左上角
-    driver->fillRect(120, 0, 8, 8, 1);         // 右上角  
-    driver->fillRect(0, 56, 8, 8, 1);          // 左下角
-    driver->fillRect(120, 56, 8, 8, 1);        // 右下角
+    queue.fillRect(0, 0, 8, 8, 1);             // 左上角
+    queue.fillRect(120, 0, 8, 8, 1);           // 右上角  
+    queue.fillRect(0, 56, 8, 8, 1);            // 左下角
+    queue.fillRect(120, 56, 8, 8, 1);          // 右下角
     
-    driver->display();
+    present(queue);
 }
 
 // 简单测试图案3：水平条纹
-void testPattern3_HorizontalStripes(ESP32_SPI_Driver* driver) {
+void testPattern3_HorizontalStripes(RenderQueue& queue) {
     ESP_LOGI(TAG, "Test 3: Horizontal stripes");
-    driver->clear(0);  // 清屏
+    queue.clear(0);  // 清屏
     
     // 每隔4像素画一条水平线
     for (int y = 0; y < 64; y += 8) {
-        driver->fillRect(0, y, 128, 4, 1);
+        queue.fillRect(0, y, 128, 4, 1);
     }
     
-    driver->display();
+    present(queue);
 }
 
 // 简单测试图案4：垂直条纹
-void testPattern4_VerticalStripes(ESP32_SPI_Driver* driver) {
+void testPattern4_VerticalStripes(RenderQueue& queue) {
     ESP_LOGI(TAG, "Test 4: Vertical stripes");
-    driver->clear(0);  // 清屏
+    queue.clear(0);  // 清屏
     
     // 每隔8像素画一条垂直线
     for (int x = 0; x < 128; x += 16) {
-        driver->fillRect(x, 0, 8, 64, 1);
+        queue.fillRect(x, 0, 8, 64, 1);
     }
     
-    driver->display();
+    present(queue);
 }
 
 // 简单测试图案5：中心十字
-void testPattern5_CenterCross(ESP32_SPI_Driver* driver) {
+void testPattern5_CenterCross(RenderQueue& queue) {
     ESP_LOGI(TAG, "Test 5: Center cross");
-    driver->clear(0);  // 清屏
+    queue.clear(0);  // 清屏
     
     // 水平线穿过中心
-    driver->fillRect(0, 30, 128, 4, 1);
+    queue.fillRect(0, 30, 128, 4, 1);
     // 垂直线穿过中心  
-    driver->fillRect(62, 0, 4, 64, 1);
+    queue.fillRect(62, 0, 4, 64, 1);
     
-    driver->display();
+    present(queue);
 }
 
 // 简单测试图案6：棋盘格
-void testPattern6_Checkerboard(ESP32_SPI_Driver* driver) {
+void testPattern6_Checkerboard(RenderQueue& queue) {
     ESP_LOGI(TAG, "Test 6: Checkerboard pattern");
-    driver->clear(0);  // 清屏
+    queue.clear(0);  // 清屏
     
     // 8x8 棋盘格
     for (int x = 0; x < 128; x += 16) {
         for (int y = 0; y < 64; y += 16) {
             if ((x/16 + y/16) % 2 == 0) {
-                driver->fillRect(x, y, 8, 8, 1);
+                queue.fillRect(x, y, 8, 8, 1);
             }
         }
     }
     
-    driver->display();
+    present(queue);
+}
+
+// 在渲染任务中绘制：资源包中的字体和图像直接从Flash映射区读取
+static void drawAssets(GraphicsDriver* driver, void*) {
+    Font font;
+    Image image;
+    int16_t x = 0;
+    for (uint16_t id = 0; id < assets.count() && x < 128; id++) {
+        if (assets.image(id, image)) {
+            driver->drawImage(x, 0, image, 1, 0);
+            x += image.width + 2;
+        } else if (assets.font(id, font)) {
+            driver->setFont(&font);
+            driver->drawText(0, 40, "Asset font", 1, 0);
+            driver->setFont(nullptr);
+        }
+    }
+    if (driver->glyphCache()) {
+        driver->drawText(0, 50, "\xE6\xB8\xA9\xE5\xBA\xA6 25\xC2\xB0" "C", 1, 0);  // 温度 25°C
+    }
+}
+
+// 测试图案7：资源包中的图像和字体（需要先写入assets分区）
+void testPattern7_Assets(RenderQueue& queue) {
+    ESP_LOGI(TAG, "Test 7: %u assets from flash", static_cast<unsigned>(assets.count()));
+    queue.clear(0);
+    queue.invoke(drawAssets, nullptr);
+    present(queue);
+}
+
+// 在渲染任务中绘制：同一组图标按三种尺寸缩放，第二次绘制起直接使用缓存的位图
+static void drawIcons(GraphicsDriver* driver, void*) {
+    const VectorIcon* icons[] = {&ICON_HOME, &ICON_CHECK, &ICON_WIFI, &ICON_BELL};
+    const int16_t sizes[] = {12, 16, 24};
+    int16_t y = 0;
+    for (int16_t size : sizes) {
+        for (int i = 0; i < 4; i++) {
+            iconCache.draw(*driver, static_cast<int16_t>(i * 30), y, *icons[i], size, 1, 0);
+        }
+        y += size + 2;
+    }
+    ESP_LOGI(TAG, "Icon cache: %zu bytes, hit rate %u%%", iconCache.stats().used_bytes,
+             static_cast<unsigned>(iconCache.stats().hitRatePercent()));
+}
+
+// 测试图案8：矢量图标
+void testPattern8_Icons(RenderQueue& queue) {
+    ESP_LOGI(TAG, "Test 8: Vector icons");
+    queue.clear(0);
+    queue.invoke(drawIcons, nullptr);
+    present(queue);
 }
 
 // 运行所有测试图案
-void runAllTests(ESP32_SPI_Driver* driver) {
+void runAllTests(RenderQueue& queue) {
     const int delay_ms = 3000;  // 每个测试显示3秒
     
-    testPattern1_FullFill(driver);
+    testPattern1_FullFill(queue);
     vTaskDelay(pdMS_TO_TICKS(delay_ms));
     
-    testPattern2_CornerBlocks(driver);
+    testPattern2_CornerBlocks(queue);
     vTaskDelay(pdMS_TO_TICKS(delay_ms));
     
-    testPattern3_HorizontalStripes(driver);
+    testPattern3_HorizontalStripes(queue);
     vTaskDelay(pdMS_TO_TICKS(delay_ms));
     
-    testPattern4_VerticalStripes(driver);
+    testPattern4_VerticalStripes(queue);
     vTaskDelay(pdMS_TO_TICKS(delay_ms));
     
-    testPattern5_CenterCross(driver);
+    testPattern5_CenterCross(queue);
     vTaskDelay(pdMS_TO_TICKS(delay_ms));
     
-    testPattern6_Checkerboard(driver);
+    testPattern6_Checkerboard(queue);
+    vTaskDelay(pdMS_TO_TICKS(delay_ms));
+    
+    if (assets.isOpen()) {
+        testPattern7_Assets(queue);
+        vTaskDelay(pdMS_TO_TICKS(delay_ms));
+    }
+
+    testPattern8_Icons(queue);
     vTaskDelay(pdMS_TO_TICKS(delay_ms));
     
     ESP_LOGI(TAG, "All test patterns completed");
 }
 
+// 渲染任务：每10ms执行完队列中的命令，每次drain()最多一帧，紧邻的刷新请求合并为一次
+static void renderTask(void* arg) {
+    auto* driver = static_cast<ESP32_SPI_Driver*>(arg);
+    while (1) {
+        while (renderQueue.drain(driver) > 0) {
+        }
+        vTaskDelay(pdMS_TO_TICKS(10));
+    }
+}
+
+// 心跳任务：独立于测试图案，在右下角闪烁一个小方块
+static void heartbeatTask(void*) {
+    bool on = false;
+    while (1) {
+        // 队列满时本周期不翻转，丢弃计入dropped()；刷新请求被丢弃时方块随下一次刷新显示
+        if (renderQueue.fillRect(124, 60, 4, 4, on ? 0 : 1)) {
+            on = !on;
+            renderQueue.display();
+        }
+        vTaskDelay(pdMS_TO_TICKS(500));
+    }
+}
+
 // ESP32 app_main入口点
 extern "C" void app_main(void) {
     ESP_LOGI(TAG, "MinimalUI ESP32 Demo Starting");
@@ -150,21 +264,50 @@ extern "C" void app_main(void) {
         return;
     }
     
-    // 初始化驱动
-    if (!driver->initialize()) {
+    // 非阻塞初始化：复位恢复和初始化表延时期间可以进行其他启动工作（WiFi、传感器等）
+    if (!driver->beginInitialize()) {
         ESP_LOGE(TAG, "Failed to initialize driver");
         delete driver;
         return;
     }
     
+    uint32_t wait_ms = 0;
+    ESP32_SPI_Driver::InitState state;
+    while ((state = driver->pollInitialize(&wait_ms)) != ESP32_SPI_Driver::InitState::READY) {
+        if (state == ESP32_SPI_Driver::InitState::FAILED) {
+            ESP_LOGE(TAG, "Failed to initialize driver");
+            delete driver;
+            return;
+        }
+        // 此处可插入其他启动步骤，没有时让出CPU直到下一步
+        vTaskDelay(pdMS_TO_TICKS(wait_ms > 0 ? wait_ms : 1));
+    }
+    
     ESP_LOGI(TAG, "Driver initialized successfully");
     
+    if (!assets.open("assets")) {
+        ESP_LOGI(TAG, "No asset pack in 'assets' partition, using built-in font only");
+    }
+    GlyphSet glyphs;
+    for (uint16_t id = 0; id < assets.count(); id++) {
+        if (assets.glyphs(id, glyphs)) {
+            glyphCache.setGlyphs(glyphs);
+            driver->setGlyphCache(&glyphCache);
+            ESP_LOGI(TAG, "Glyph set: %u characters", static_cast<unsigned>(glyphs.count));
+            break;
+        }
+    }
+    
+    // 从此驱动只归渲染任务所有
+    xTaskCreate(renderTask, "render", 4096, driver, 5, nullptr);
+    xTaskCreate(heartbeatTask, "heartbeat", 2048, nullptr, 3, nullptr);
+    
     // 运行测试图案序列
     ESP_LOGI(TAG, "Starting test pattern sequence...");
     
     // ESP32应用中的无限循环
     while (1) {
-        runAllTests(driver);
+        runAllTests(renderQueue);
         ESP_LOGI(TAG, "Test cycle completed, restarting in 2 seconds...");
         vTaskDelay(pdMS_TO_TICKS(2000)); // 等待2秒后重新开始
     }
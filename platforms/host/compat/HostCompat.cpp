@@ -0,0 +1,269 @@
+#include "esp_timer.h"
+#include "freertos/semphr.h"
+#include "freertos/task.h"
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+
+using Clock = std::chrono::steady_clock;
+
+static const Clock::time_point process_start = Clock::now();
+
+int64_t esp_timer_get_time() {
+    return std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - process_start).count();
+}
+
+// ---------------------------------------------------------------------------
+// 任务
+
+struct HostTask {
+    std::string name;
+    std::mutex mutex;
+    std::condition_variable cv;
+    uint32_t notify_count = 0;
+};
+
+static thread_local HostTask* current_task = nullptr;
+
+static HostTask* currentTask() {
+    // 非xTaskCreate创建的线程（例如主线程）第一次使用时分配任务对象
+    if (!current_task) {
+        current_task = new HostTask();
+        current_task->name = "host";
+    }
+    return current_task;
+}
+
+BaseType_t xTaskCreate(TaskFunction_t fn, const char* name, uint32_t /*stack_depth*/, void* arg,
+                       UBaseType_t /*priority*/, TaskHandle_t* out_handle) {
+    // 句柄可能在任务结束后仍被其他线程使用（例如发送通知），因此任务对象不释放
+    HostTask* task = new HostTask();
+    task->name = name ? name : "";
+    if (out_handle) {
+        *out_handle = task;
+    }
+    std::thread([fn, arg, task]() {
+        current_task = task;
+        fn(arg);
+    }).detach();
+    return pdPASS;
+}
+
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t fn, const char* name, uint32_t stack_depth, void* arg,
+                                   UBaseType_t priority, TaskHandle_t* out_handle, BaseType_t /*core*/) {
+    return xTaskCreate(fn, name, stack_depth, arg, priority, out_handle);
+}
+
+void vTaskDelete(TaskHandle_t /*task*/) {
+    // 主机线程在任务函数返回时结束
+}
+
+void vTaskDelay(TickType_t ticks) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(ticks));
+}
+
+TickType_t xTaskGetTickCount() {
+    return static_cast<TickType_t>(esp_timer_get_time() / 1000);
+}
+
+TaskHandle_t xTaskGetCurrentTaskHandle() {
+    return currentTask();
+}
+
+void xTaskNotifyGive(TaskHandle_t task) {
+    if (!task) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(task->mutex);
+        task->notify_count++;
+    }
+    task->cv.notify_one();
+}
+
+void vTaskNotifyGiveFromISR(TaskHandle_t task, BaseType_t* higher_priority_woken) {
+    xTaskNotifyGive(task);
+    if (higher_priority_woken) {
+        *higher_priority_woken = pdFALSE;
+    }
+}
+
+uint32_t ulTaskNotifyTake(BaseType_t clear_on_exit, TickType_t ticks_to_wait) {
+    HostTask* task = currentTask();
+    std::unique_lock<std::mutex> lock(task->mutex);
+    auto ready = [task]() { return task->notify_count > 0; };
+    if (ticks_to_wait == portMAX_DELAY) {
+        task->cv.wait(lock, ready);
+    } else if (!task->cv.wait_for(lock, std::chrono::milliseconds(ticks_to_wait), ready)) {
+        return 0;
+    }
+    uint32_t count = task->notify_count;
+    task->notify_count = clear_on_exit ? 0 : count - 1;
+    return count;
+}
+
+// ---------------------------------------------------------------------------
+// 信号量
+
+struct HostSemaphore {
+    std::mutex mutex;
+    std::condition_variable cv;
+    bool available = false;
+};
+
+SemaphoreHandle_t xSemaphoreCreateBinary() {
+    return new HostSemaphore();
+}
+
+SemaphoreHandle_t xSemaphoreCreateMutex() {
+    auto* semaphore = new HostSemaphore();
+    semaphore->available = true;
+    return semaphore;
+}
+
+BaseType_t xSemaphoreTake(SemaphoreHandle_t semaphore, TickType_t ticks_to_wait) {
+    if (!semaphore) {
+        return pdFALSE;
+    }
+    std::unique_lock<std::mutex> lock(semaphore->mutex);
+    auto ready = [semaphore]() { return semaphore->available; };
+    if (ticks_to_wait == portMAX_DELAY) {
+        semaphore->cv.wait(lock, ready);
+    } else if (!semaphore->cv.wait_for(lock, std::chrono::milliseconds(ticks_to_wait), ready)) {
+        return pdFALSE;
+    }
+    semaphore->available = false;
+    return pdTRUE;
+}
+
+BaseType_t xSemaphoreGive(SemaphoreHandle_t semaphore) {
+    if (!semaphore) {
+        return pdFALSE;
+    }
+    // 持锁通知：等待方取得信号量后可能立即删除它
+    std::lock_guard<std::mutex> lock(semaphore->mutex);
+    if (semaphore->available) {
+        return pdFALSE;  // 二值信号量已给出
+    }
+    semaphore->available = true;
+    semaphore->cv.notify_one();
+    return pdTRUE;
+}
+
+void vSemaphoreDelete(SemaphoreHandle_t semaphore) {
+    delete semaphore;
+}
+
+// ---------------------------------------------------------------------------
+// 定时器
+
+struct esp_timer {
+    esp_timer_create_args_t args;
+    std::thread thread;
+    std::mutex mutex;
+    std::condition_variable cv;
+    bool armed = false;
+    bool periodic = false;
+    bool quit = false;
+    std::chrono::microseconds period{0};
+    Clock::time_point deadline;
+
+    void run() {
+        std::unique_lock<std::mutex> lock(mutex);
+        while (!quit) {
+            if (!armed) {
+                cv.wait(lock);
+                continue;
+            }
+            if (cv.wait_until(lock, deadline) != std::cv_status::timeout || !armed || quit) {
+                continue;
+            }
+
+            if (periodic) {
+                deadline += period;
+                // 回调慢于周期时跳过错过的触发，与skip_unhandled_events一致
+                if (args.skip_unhandled_events && deadline < Clock::now()) {
+                    deadline = Clock::now() + period;
+                }
+            } else {
+                armed = false;
+            }
+            lock.unlock();
+            args.callback(args.arg);
+            lock.lock();
+        }
+    }
+};
+
+esp_err_t esp_timer_create(const esp_timer_create_args_t* args, esp_timer_handle_t* out_handle) {
+    if (!args || !args->callback || !out_handle) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    esp_timer* timer = new esp_timer();
+    timer->args = *args;
+    timer->thread = std::thread([timer]() { timer->run(); });
+    *out_handle = timer;
+    return ESP_OK;
+}
+
+static esp_err_t startTimer(esp_timer_handle_t timer, uint64_t us, bool periodic) {
+    if (!timer) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    {
+        std::lock_guard<std::mutex> lock(timer->mutex);
+        if (timer->armed) {
+            return ESP_ERR_INVALID_STATE;
+        }
+        timer->armed = true;
+        timer->periodic = periodic;
+        timer->period = std::chrono::microseconds(us);
+        timer->deadline = Clock::now() + timer->period;
+    }
+    timer->cv.notify_one();
+    return ESP_OK;
+}
+
+esp_err_t esp_timer_start_once(esp_timer_handle_t timer, uint64_t timeout_us) {
+    return startTimer(timer, timeout_us, false);
+}
+
+esp_err_t esp_timer_start_periodic(esp_timer_handle_t timer, uint64_t period_us) {
+    return startTimer(timer, period_us, true);
+}
+
+esp_err_t esp_timer_stop(esp_timer_handle_t timer) {
+    if (!timer) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    {
+        std::lock_guard<std::mutex> lock(timer->mutex);
+        if (!timer->armed) {
+            return ESP_ERR_INVALID_STATE;
+        }
+        timer->armed = false;
+    }
+    timer->cv.notify_one();
+    return ESP_OK;
+}
+
+esp_err_t esp_timer_delete(esp_timer_handle_t timer) {
+    if (!timer) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    {
+        std::lock_guard<std::mutex> lock(timer->mutex);
+        timer->quit = true;
+    }
+    timer->cv.notify_one();
+    if (timer->thread.get_id() == std::this_thread::get_id()) {
+        // 在自身回调中删除：线程结束后由系统回收，对象不再释放
+        timer->thread.detach();
+        return ESP_OK;
+    }
+    timer->thread.join();
+    delete timer;
+    return ESP_OK;
+}
@@ -0,0 +1,15 @@
+#pragma once
+
+#include <cstdio>
+
+// 主机端日志：错误和警告输出到stderr，其余级别默认关闭，
+// 定义MINIMALUI_HOST_VERBOSE后输出信息级日志
+#define ESP_LOGE(tag, format, ...) fprintf(stderr, "E (%s) " format "\n", tag, ##__VA_ARGS__)
+#define ESP_LOGW(tag, format, ...) fprintf(stderr, "W (%s) " format "\n", tag, ##__VA_ARGS__)
+#ifdef MINIMALUI_HOST_VERBOSE
+#define ESP_LOGI(tag, format, ...) fprintf(stderr, "I (%s) " format "\n", tag, ##__VA_ARGS__)
+#else
+#define ESP_LOGI(tag, format, ...) do { (void)(tag); } while (0)
+#endif
+#define ESP_LOGD(tag, format, ...) do { (void)(tag); } while (0)
+#define ESP_LOGV(tag, format, ...) do { (void)(tag); } while (0)
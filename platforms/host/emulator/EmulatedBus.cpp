@@ -0,0 +1,191 @@
+#include "EmulatedBus.h"
+#include <chrono>
+#include <thread>
+
+namespace MinimalUI {
+
+static int64_t wallMicros() {
+    using namespace std::chrono;
+    return duration_cast<microseconds>(steady_clock::now().time_since_epoch()).count();
+}
+
+EmulatedBus::EmulatedBus(PanelModel& model, const BusTiming& timing)
+    : model_(model), timing_(timing), realtime_(false), time_ns_(0), wall_origin_us_(wallMicros()),
+      frame_depth_(0), frame_start_ns_(0), last_frame_ns_(0) {
+    if (timing_.freq == 0) {
+        timing_.freq = 1;
+    }
+    if (timing_.max_transfer == 0) {
+        timing_.max_transfer = 1;
+    }
+}
+
+void EmulatedBus::setRealtime(bool realtime) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    // 切换到实时模式时让真实时间从当前模拟时刻继续
+    wall_origin_us_ = wallMicros() - static_cast<int64_t>(time_ns_ / 1000);
+    realtime_ = realtime;
+}
+
+void EmulatedBus::setTiming(const BusTiming& timing) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    timing_ = timing;
+    if (timing_.freq == 0) {
+        timing_.freq = 1;
+    }
+    if (timing_.max_transfer == 0) {
+        timing_.max_transfer = 1;
+    }
+}
+
+bool EmulatedBus::realtime() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return realtime_;
+}
+
+BusTiming EmulatedBus::timing() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return timing_;
+}
+
+uint64_t EmulatedBus::now() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (realtime_) {
+        uint64_t wall = static_cast<uint64_t>(wallMicros() - wall_origin_us_) * 1000;
+        return wall > time_ns_ ? wall : time_ns_;
+    }
+    return time_ns_;
+}
+
+BusStats EmulatedBus::stats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return stats_;
+}
+
+void EmulatedBus::resetStats() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stats_ = BusStats();
+}
+
+uint64_t EmulatedBus::lastFrameNs() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return last_frame_ns_;
+}
+
+uint64_t EmulatedBus::byteNs() const {
+    return 8000000000ULL / timing_.freq;
+}
+
+uint64_t EmulatedBus::beginTransfer(size_t bytes) {
+    if (realtime_) {
+        // 总线空闲期间真实时间照常流逝
+        uint64_t wall = static_cast<uint64_t>(wallMicros() - wall_origin_us_) * 1000;
+        if (wall > time_ns_) {
+            time_ns_ = wall;
+        }
+    }
+    const uint64_t duration = timing_.transaction_overhead_ns + bytes * byteNs();
+    const uint64_t start = time_ns_ + timing_.transaction_overhead_ns;
+    time_ns_ += duration;
+    stats_.transactions++;
+    stats_.busy_ns += duration;
+    return start + byteNs();
+}
+
+int64_t EmulatedBus::wakeMicros() const {
+    if (!realtime_) {
+        return -1;
+    }
+    return wall_origin_us_ + static_cast<int64_t>(time_ns_ / 1000);
+}
+
+void EmulatedBus::sleepUntil(int64_t wall_us) {
+    if (wall_us < 0) {
+        return;
+    }
+    int64_t remaining = wall_us - wallMicros();
+    if (remaining > 0) {
+        std::this_thread::sleep_for(std::chrono::microseconds(remaining));
+    }
+}
+
+void EmulatedBus::sendCommand(uint8_t cmd) {
+    int64_t wake_us;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        uint64_t at = beginTransfer(1);
+        stats_.command_bytes++;
+        model_.command(cmd, at);
+        wake_us = wakeMicros();
+    }
+    sleepUntil(wake_us);
+}
+
+void EmulatedBus::sendData(uint8_t data) {
+    sendBuffer(&data, 1);
+}
+
+void EmulatedBus::sendBuffer(const uint8_t* buffer, size_t size) {
+    while (size > 0) {
+        size_t chunk;
+        int64_t wake_us;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            // 每段都在锁内读取max_transfer，传输途中的setTiming()从下一段开始生效
+            chunk = size > timing_.max_transfer ? timing_.max_transfer : size;
+            uint64_t at = beginTransfer(chunk);
+            stats_.data_bytes += chunk;
+            model_.data(buffer, chunk, at, byteNs());
+            wake_us = wakeMicros();
+        }
+        sleepUntil(wake_us);
+        buffer += chunk;
+        size -= chunk;
+    }
+}
+
+void EmulatedBus::sendCommands(const uint8_t* cmds, size_t count) {
+    while (count > 0) {
+        size_t chunk;
+        int64_t wake_us;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            chunk = count > timing_.max_transfer ? timing_.max_transfer : count;
+            uint64_t at = beginTransfer(chunk);
+            stats_.command_bytes += chunk;
+            for (size_t i = 0; i < chunk; i++) {
+                model_.command(cmds[i], at + i * byteNs());
+            }
+            wake_us = wakeMicros();
+        }
+        sleepUntil(wake_us);
+        cmds += chunk;
+        count -= chunk;
+    }
+}
+
+void EmulatedBus::beginFrame() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (frame_depth_++ == 0) {
+        frame_start_ns_ = time_ns_;
+        if (realtime_) {
+            uint64_t wall = static_cast<uint64_t>(wallMicros() - wall_origin_us_) * 1000;
+            if (wall > frame_start_ns_) {
+                frame_start_ns_ = wall;
+            }
+        }
+    }
+}
+
+void EmulatedBus::endFrame() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (frame_depth_ == 0) {
+        return;
+    }
+    if (--frame_depth_ == 0) {
+        stats_.frames++;
+        last_frame_ns_ = time_ns_ > frame_start_ns_ ? time_ns_ - frame_start_ns_ : 0;
+    }
+}
+
+} // namespace MinimalUI
@@ -0,0 +1,92 @@
+#pragma once
+
+#include "DisplayTransport.h"
+#include "PanelModel.h"
+#include <cstdint>
+#include <mutex>
+
+namespace MinimalUI {
+
+/**
+ * @brief 总线时序模型参数
+ */
+struct BusTiming {
+    uint32_t freq = 8000000;                  // SPI时钟（Hz）
+    uint32_t transaction_overhead_ns = 12000; // 每次传输的固定开销（驱动调用、CS切换）
+    uint32_t max_transfer = 4092;             // 单次传输的最大字节数，超过时拆分（与ESP32驱动一致）
+};
+
+/**
+ * @brief 总线统计
+ */
+struct BusStats {
+    uint64_t transactions = 0;
+    uint64_t command_bytes = 0;
+    uint64_t data_bytes = 0;
+    uint64_t frames = 0;       // 最外层beginFrame/endFrame次数
+    uint64_t busy_ns = 0;      // 总线占用时间
+};
+
+/**
+ * @class EmulatedBus
+ * @brief 主机端SPI总线模拟，作为控制器的DisplayTransport
+ *
+ * 每次sendCommand/sendCommands/sendData/sendBuffer按一次传输计时：
+ * 固定开销 + 字节数 * 8 / freq。字节按DC状态交给PanelModel。
+ *
+ * 两种时间模式：
+ * - 模拟模式（默认）：时间只随传输前进，调用立即返回，用于预测帧率；
+ * - 实时模式：空闲时间按真实时间计入，每次传输阻塞到模拟完成时刻，
+ *   控制器的定时器和后台任务（例如灰度位平面轮换）看到与实际硬件相同的速度。
+ */
+class EmulatedBus : public DisplayTransport {
+public:
+    EmulatedBus(PanelModel& model, const BusTiming& timing);
+
+    // 实现DisplayTransport接口
+    void sendCommand(uint8_t cmd) override;
+    void sendData(uint8_t data) override;
+    void sendBuffer(const uint8_t* buffer, size_t size) override;
+    void sendCommands(const uint8_t* cmds, size_t count) override;
+    void beginFrame() override;
+    void endFrame() override;
+
+    void setRealtime(bool realtime);
+    bool realtime() const;
+
+    void setTiming(const BusTiming& timing);
+    BusTiming timing() const;
+
+    // 当前模拟时刻（纳秒）
+    uint64_t now() const;
+
+    BusStats stats() const;
+    void resetStats();
+
+    // 最近一次完整帧（最外层beginFrame到endFrame）的模拟耗时
+    uint64_t lastFrameNs() const;
+
+private:
+    PanelModel& model_;
+    BusTiming timing_;
+    bool realtime_;
+    mutable std::mutex mutex_;
+    uint64_t time_ns_;          // 模拟时钟
+    int64_t wall_origin_us_;    // 实时模式下模拟时钟0点对应的真实时刻
+    int frame_depth_;
+    uint64_t frame_start_ns_;
+    uint64_t last_frame_ns_;
+    BusStats stats_;
+
+    // 以下三个函数由调用方持有mutex_
+    uint64_t byteNs() const;
+    // 开始一次传输，返回第一个字节完成的时刻
+    uint64_t beginTransfer(size_t bytes);
+    // 实时模式下当前传输完成时刻对应的真实时刻（微秒），模拟模式返回-1
+    int64_t wakeMicros() const;
+
+    // 在锁外阻塞到真实时刻wall_us，wall_us < 0时立即返回
+    static void sleepUntil(int64_t wall_us);
+};
+
+} // namespace MinimalUI
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace MinimalUI {
+
+/**
+ * @class PanelModel
+ * @brief 显示控制器芯片的主机端模型
+ *
+ * EmulatedBus把控制器发出的字节流按DC状态分为命令和数据交给模型，
+ * 并给出每个字节在模拟时间轴上的到达时刻。新的控制器只需实现该接口，
+ * 即可复用总线的时序模型和统计。
+ */
+class PanelModel {
+public:
+    virtual ~PanelModel() = default;
+
+    /**
+     * @brief 上电复位：寄存器恢复默认值，显存内容不确定（模型中清零）
+     */
+    virtual void reset() = 0;
+
+    /**
+     * @brief 收到一个命令字节（DC低电平）
+     * @param time_ns 字节传输完成的模拟时刻
+     */
+    virtual void command(uint8_t byte, uint64_t time_ns) = 0;
+
+    /**
+     * @brief 收到一段数据（DC高电平）
+     * @param start_ns 第一个字节传输完成的模拟时刻
+     * @param byte_ns 每字节的传输时间
+     */
+    virtual void data(const uint8_t* bytes, size_t length, uint64_t start_ns, uint64_t byte_ns) = 0;
+};
+
+} // namespace MinimalUI
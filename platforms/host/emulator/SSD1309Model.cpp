@@ -0,0 +1,345 @@
+#include "SSD1309Model.h"
+#include <cstring>
+
+namespace MinimalUI {
+
+SSD1309Model::SSD1309Model() {
+    reset();
+}
+
+void SSD1309Model::reset() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    memset(ram_, 0, sizeof(ram_));
+
+    // 数据手册中的复位值
+    memory_mode_ = 2;
+    col_start_ = 0;
+    col_end_ = WIDTH - 1;
+    page_start_ = 0;
+    page_end_ = PAGES - 1;
+    column_ = 0;
+    page_ = 0;
+    start_line_ = 0;
+    display_offset_ = 0;
+    multiplex_ = HEIGHT - 1;
+    contrast_ = 0x7F;
+    seg_remap_ = false;
+    com_reversed_ = false;
+    display_on_ = false;
+    inverted_ = false;
+    entire_on_ = false;
+
+    pending_command_ = 0;
+    pending_count_ = 0;
+    param_index_ = 0;
+
+    protocol_errors_ = 0;
+    unknown_commands_ = 0;
+    ram_writes_ = 0;
+
+    exposure_start_ns_ = 0;
+    memset(changed_ns_, 0, sizeof(changed_ns_));
+    memset(lit_ns_, 0, sizeof(lit_ns_));
+}
+
+uint8_t SSD1309Model::paramCount(uint8_t command) {
+    switch (command) {
+    case 0x20: // MEMORYMODE
+    case 0x81: // SETCONTRAST
+    case 0x8D: // CHARGEPUMP（SSD1306兼容）
+    case 0xA8: // SETMULTIPLEX
+    case 0xD3: // SETDISPLAYOFFSET
+    case 0xD5: // SETDISPLAYCLOCKDIV
+    case 0xD9: // SETPRECHARGE
+    case 0xDA: // SETCOMPINS
+    case 0xDB: // SETVCOMDETECT
+    case 0xFD: // 命令锁
+        return 1;
+    case 0x21: // COLUMNADDR
+    case 0x22: // PAGEADDR
+    case 0xA3: // 垂直滚动区域
+        return 2;
+    case 0x29: // 垂直+水平滚动
+    case 0x2A:
+        return 5;
+    case 0x26: // 水平滚动
+    case 0x27:
+        return 6;
+    default:
+        return 0;
+    }
+}
+
+void SSD1309Model::command(uint8_t byte, uint64_t /*time_ns*/) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    // 参数同样以命令方式（DC低电平）发送
+    if (pending_count_ > 0) {
+        if (param_index_ < sizeof(params_)) {
+            params_[param_index_] = byte;
+        }
+        param_index_++;
+        if (--pending_count_ == 0) {
+            execute(pending_command_, params_);
+        }
+        return;
+    }
+
+    uint8_t count = paramCount(byte);
+    if (count > 0) {
+        pending_command_ = byte;
+        pending_count_ = count;
+        param_index_ = 0;
+        return;
+    }
+    execute(byte, nullptr);
+}
+
+void SSD1309Model::execute(uint8_t command, const uint8_t* params) {
+    if (command <= 0x0F) {
+        column_ = static_cast<uint8_t>((column_ & 0xF0) | command);
+        return;
+    }
+    if (command <= 0x1F) {
+        column_ = static_cast<uint8_t>(((command & 0x07) << 4) | (column_ & 0x0F));
+        return;
+    }
+    if (command >= 0x40 && command <= 0x7F) {
+        start_line_ = command & 0x3F;
+        return;
+    }
+    if (command >= 0xB0 && command <= 0xB7) {
+        page_ = command & 0x07;
+        return;
+    }
+
+    switch (command) {
+    case 0x20:
+        memory_mode_ = params[0] & 0x03;
+        break;
+    case 0x21:
+        col_start_ = params[0] & 0x7F;
+        col_end_ = params[1] & 0x7F;
+        column_ = col_start_;
+        break;
+    case 0x22:
+        page_start_ = params[0] & 0x07;
+        page_end_ = params[1] & 0x07;
+        page_ = page_start_;
+        break;
+    case 0x81:
+        contrast_ = params[0];
+        break;
+    case 0xA8:
+        multiplex_ = params[0] & 0x3F;
+        break;
+    case 0xD3:
+        display_offset_ = params[0] & 0x3F;
+        break;
+    case 0xA0:
+    case 0xA1:
+        seg_remap_ = command & 0x01;
+        break;
+    case 0xA4:
+    case 0xA5:
+        entire_on_ = command & 0x01;
+        break;
+    case 0xA6:
+    case 0xA7:
+        inverted_ = command & 0x01;
+        break;
+    case 0xAE:
+    case 0xAF:
+        display_on_ = command & 0x01;
+        break;
+    case 0xC0:
+        com_reversed_ = false;
+        break;
+    case 0xC8:
+        com_reversed_ = true;
+        break;
+    case 0x8D: case 0xD5: case 0xD9: case 0xDA: case 0xDB: case 0xFD:
+    case 0xA3: case 0x26: case 0x27: case 0x29: case 0x2A:
+    case 0x2E: case 0x2F: case 0xE3:
+        // 只影响模拟信号或滚动，不改变显存映射
+        break;
+    default:
+        unknown_commands_++;
+        break;
+    }
+}
+
+void SSD1309Model::data(const uint8_t* bytes, size_t length, uint64_t start_ns, uint64_t byte_ns) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (size_t i = 0; i < length; i++) {
+        if (pending_count_ > 0) {
+            // 命令参数未收齐时收到数据：控制器把参数当作数据发送了
+            protocol_errors_++;
+        }
+        writeRam(bytes[i], start_ns + i * byte_ns);
+        advance();
+    }
+}
+
+void SSD1309Model::writeRam(uint8_t byte, uint64_t time_ns) {
+    uint8_t& cell = ram_[page_][column_];
+    ram_writes_++;
+    if (cell == byte) {
+        return;
+    }
+
+    // 结算原来点亮的位在本窗口内的点亮时间
+    uint64_t since = changed_ns_[page_][column_];
+    if (since < exposure_start_ns_) {
+        since = exposure_start_ns_;
+    }
+    if (time_ns > since) {
+        for (uint8_t bit = 0; bit < 8; bit++) {
+            if (cell & (1 << bit)) {
+                lit_ns_[page_][column_][bit] += time_ns - since;
+            }
+        }
+    }
+    changed_ns_[page_][column_] = time_ns;
+    cell = byte;
+}
+
+void SSD1309Model::advance() {
+    switch (memory_mode_) {
+    case 0: // 水平寻址
+        if (column_ >= col_end_) {
+            column_ = col_start_;
+            page_ = page_ >= page_end_ ? page_start_ : static_cast<uint8_t>(page_ + 1);
+        } else {
+            column_++;
+        }
+        break;
+    case 1: // 垂直寻址
+        if (page_ >= page_end_) {
+            page_ = page_start_;
+            column_ = column_ >= col_end_ ? col_start_ : static_cast<uint8_t>(column_ + 1);
+        } else {
+            page_++;
+        }
+        break;
+    default: // 页寻址：列地址到末尾后回到起点，页不变
+        column_ = column_ >= col_end_ ? col_start_ : static_cast<uint8_t>(column_ + 1);
+        break;
+    }
+}
+
+int16_t SSD1309Model::ramRow(int16_t y) const {
+    const int16_t rows = multiplex_ + 1;
+    if (y < 0 || y >= rows) {
+        return -1;
+    }
+    int16_t com = com_reversed_ ? rows - 1 - y : y;
+    return static_cast<int16_t>((com + start_line_ + display_offset_) % HEIGHT);
+}
+
+int16_t SSD1309Model::ramColumn(int16_t x) const {
+    if (x < 0 || x >= WIDTH) {
+        return -1;
+    }
+    return seg_remap_ ? WIDTH - 1 - x : x;
+}
+
+uint8_t SSD1309Model::ram(int16_t page, int16_t column) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (page < 0 || page >= PAGES || column < 0 || column >= WIDTH) {
+        return 0;
+    }
+    return ram_[page][column];
+}
+
+bool SSD1309Model::pixel(int16_t x, int16_t y) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    int16_t row = ramRow(y);
+    int16_t col = ramColumn(x);
+    if (!display_on_ || row < 0 || col < 0) {
+        return false;
+    }
+    if (entire_on_) {
+        return true;
+    }
+    bool lit = ram_[row / 8][col] & (1 << (row % 8));
+    return lit != inverted_;
+}
+
+void SSD1309Model::resetExposure(uint64_t time_ns) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    exposure_start_ns_ = time_ns;
+    memset(lit_ns_, 0, sizeof(lit_ns_));
+}
+
+uint8_t SSD1309Model::perceived(int16_t x, int16_t y, uint64_t time_ns) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    int16_t row = ramRow(y);
+    int16_t col = ramColumn(x);
+    if (row < 0 || col < 0 || time_ns <= exposure_start_ns_) {
+        return 0;
+    }
+
+    const int16_t page = row / 8;
+    const uint8_t bit = row % 8;
+    uint64_t lit = lit_ns_[page][col][bit];
+    if (ram_[page][col] & (1 << bit)) {
+        uint64_t since = changed_ns_[page][col];
+        if (since < exposure_start_ns_) {
+            since = exposure_start_ns_;
+        }
+        if (time_ns > since) {
+            lit += time_ns - since;
+        }
+    }
+    const uint64_t window = time_ns - exposure_start_ns_;
+    uint64_t level = lit * 255 / window;
+    return static_cast<uint8_t>(level > 255 ? 255 : level);
+}
+
+bool SSD1309Model::displayOn() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return display_on_;
+}
+
+uint8_t SSD1309Model::memoryMode() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return memory_mode_;
+}
+
+uint8_t SSD1309Model::startLine() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return start_line_;
+}
+
+uint8_t SSD1309Model::contrast() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return contrast_;
+}
+
+bool SSD1309Model::segmentRemap() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return seg_remap_;
+}
+
+bool SSD1309Model::comScanReversed() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return com_reversed_;
+}
+
+uint32_t SSD1309Model::protocolErrors() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return protocol_errors_;
+}
+
+uint32_t SSD1309Model::unknownCommands() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return unknown_commands_;
+}
+
+uint32_t SSD1309Model::ramWrites() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return ram_writes_;
+}
+
+} // namespace MinimalUI
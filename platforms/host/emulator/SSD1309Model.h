@@ -0,0 +1,119 @@
+#pragma once
+
+#include "PanelModel.h"
+#include <cstdint>
+#include <mutex>
+
+namespace MinimalUI {
+
+/**
+ * @class SSD1309Model
+ * @brief SSD1309命令集和128x64 GDDRAM的模型
+ *
+ * 按数据手册解析4线SPI字节流：命令及其参数都以DC低电平发送，
+ * DC高电平的字节写入GDDRAM当前地址并按寻址模式（水平/垂直/页）前进。
+ * 支持COLUMNADDR、PAGEADDR、MEMORYMODE、页模式列/页地址、SEGREMAP、
+ * COMSCANINC/DEC、SETSTARTLINE、显示偏移、反色、全亮和开关显示。
+ *
+ * 协议错误（命令参数未收齐时收到数据、未知命令）单独计数，便于发现DC使用错误。
+ *
+ * 模型还对每个像素记录点亮时间，perceived()返回积分窗口内的平均亮度，
+ * 用于验证位平面时间调制得到的灰度。线程安全：总线线程写入、其他线程读取。
+ */
+class SSD1309Model : public PanelModel {
+public:
+    static constexpr int16_t WIDTH = 128;
+    static constexpr int16_t HEIGHT = 64;
+    static constexpr int16_t PAGES = HEIGHT / 8;
+
+    SSD1309Model();
+
+    // 实现PanelModel接口
+    void reset() override;
+    void command(uint8_t byte, uint64_t time_ns) override;
+    void data(const uint8_t* bytes, size_t length, uint64_t start_ns, uint64_t byte_ns) override;
+
+    /**
+     * @brief 读取GDDRAM中的一个字节
+     * @param page 页（0~7）
+     * @param column 列（0~127）
+     */
+    uint8_t ram(int16_t page, int16_t column) const;
+
+    /**
+     * @brief 屏幕上(x, y)处是否点亮
+     * 考虑段重映射、COM扫描方向、起始行、显示偏移、反色、全亮和显示开关
+     */
+    bool pixel(int16_t x, int16_t y) const;
+
+    /**
+     * @brief 开始新的亮度积分窗口
+     */
+    void resetExposure(uint64_t time_ns);
+
+    /**
+     * @brief 屏幕上(x, y)处从resetExposure()到time_ns的平均亮度（0~255）
+     * 按GDDRAM位的点亮时间积分；不考虑显示开关等全局状态
+     */
+    uint8_t perceived(int16_t x, int16_t y, uint64_t time_ns) const;
+
+    // 寄存器状态
+    bool displayOn() const;
+    uint8_t memoryMode() const;
+    uint8_t startLine() const;
+    uint8_t contrast() const;
+    bool segmentRemap() const;
+    bool comScanReversed() const;
+
+    // 协议统计
+    uint32_t protocolErrors() const;
+    uint32_t unknownCommands() const;
+    uint32_t ramWrites() const;
+
+private:
+    mutable std::mutex mutex_;
+    uint8_t ram_[PAGES][WIDTH];
+
+    // 寄存器
+    uint8_t memory_mode_;   // 0水平 1垂直 2页
+    uint8_t col_start_;
+    uint8_t col_end_;
+    uint8_t page_start_;
+    uint8_t page_end_;
+    uint8_t column_;        // 当前地址
+    uint8_t page_;
+    uint8_t start_line_;
+    uint8_t display_offset_;
+    uint8_t multiplex_;
+    uint8_t contrast_;
+    bool seg_remap_;
+    bool com_reversed_;
+    bool display_on_;
+    bool inverted_;
+    bool entire_on_;
+
+    // 命令参数解析
+    uint8_t pending_command_;
+    uint8_t pending_count_;     // 还需要的参数个数
+    uint8_t params_[6];
+    uint8_t param_index_;
+
+    // 统计
+    uint32_t protocol_errors_;
+    uint32_t unknown_commands_;
+    uint32_t ram_writes_;
+
+    // 亮度积分
+    uint64_t exposure_start_ns_;
+    uint64_t changed_ns_[PAGES][WIDTH];     // 字节最后一次变化的时刻
+    uint64_t lit_ns_[PAGES][WIDTH][8];      // 各位在窗口内已累计的点亮时间
+
+    void execute(uint8_t command, const uint8_t* params);
+    void writeRam(uint8_t byte, uint64_t time_ns);
+    void advance();
+    int16_t ramRow(int16_t y) const;
+    int16_t ramColumn(int16_t x) const;
+    static uint8_t paramCount(uint8_t command);
+};
+
+} // namespace MinimalUI
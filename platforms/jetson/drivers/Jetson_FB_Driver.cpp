@@ -0,0 +1,397 @@
+#include "Jetson_FB_Driver.h"
+#include "DriverFactory.h"
+#include "PixelKernels.h"
+#include "Rasterizer.h"
+#include "Trace.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <linux/fb.h>
+#include <sys/ioctl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace MinimalUI {
+
+static const char* TAG = "Jetson_FB_Driver";
+
+#define FB_LOGE(fmt, ...) fprintf(stderr, "E (%s) " fmt "\n", TAG, ##__VA_ARGS__)
+#define FB_LOGW(fmt, ...) fprintf(stderr, "W (%s) " fmt "\n", TAG, ##__VA_ARGS__)
+
+Jetson_FB_Driver::Jetson_FB_Driver(const Jetson_FB_Config& config)
+    : config_(config), fd_(-1), is_device_(false), map_(nullptr), map_size_(0),
+      width_(0), height_(0), bpp_(0), stride_(0), pages_(1), front_(0), page_rows_(0),
+      red_shift_(16), green_shift_(8), blue_shift_(0), alpha_bits_(0), dirty_{0, 0, 0, 0} {
+}
+
+Jetson_FB_Driver::~Jetson_FB_Driver() {
+    release();
+}
+
+void Jetson_FB_Driver::registerDriver(const Jetson_FB_Config& config) {
+    DriverFactory::registerCreator(DriverType::JETSON_FB, [config]() -> std::shared_ptr<GraphicsDriver> {
+        auto driver = std::make_shared<Jetson_FB_Driver>(config);
+        return driver->initialize() ? driver : nullptr;
+    });
+}
+
+bool Jetson_FB_Driver::initialize() {
+    release();
+    if (!config_.device) {
+        FB_LOGE("No framebuffer device given");
+        return false;
+    }
+
+    // 只有给出了文件尺寸时才允许创建文件，避免在/dev下误建普通文件
+    const int flags = O_RDWR | (config_.width > 0 ? O_CREAT : 0);
+    fd_ = open(config_.device, flags, 0644);
+    if (fd_ < 0) {
+        FB_LOGE("Failed to open %s: %s", config_.device, strerror(errno));
+        return false;
+    }
+
+    struct stat st;
+    if (fstat(fd_, &st) != 0) {
+        FB_LOGE("fstat %s failed: %s", config_.device, strerror(errno));
+        release();
+        return false;
+    }
+    is_device_ = S_ISCHR(st.st_mode);
+    if (!(is_device_ ? openDevice() : openFile())) {
+        release();
+        return false;
+    }
+
+    void* map = mmap(nullptr, map_size_, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+    if (map == MAP_FAILED) {
+        FB_LOGE("mmap of %zu bytes failed: %s", map_size_, strerror(errno));
+        release();
+        return false;
+    }
+    map_ = static_cast<uint8_t*>(map);
+
+    // 两页都清为黑色，之后只需维护脏区
+    for (uint8_t p = 0; p < pages_; p++) {
+        fillRows(p, 0, 0, width_, height_, Colors::BLACK);
+    }
+    dirty_ = Rect{0, 0, 0, 0};
+    return true;
+}
+
+bool Jetson_FB_Driver::openDevice() {
+    fb_var_screeninfo var;
+    fb_fix_screeninfo fix;
+    if (ioctl(fd_, FBIOGET_VSCREENINFO, &var) != 0 || ioctl(fd_, FBIOGET_FSCREENINFO, &fix) != 0) {
+        FB_LOGE("%s is not a framebuffer device", config_.device);
+        return false;
+    }
+
+    // 虚拟分辨率不足两页时尝试申请，驱动拒绝时保持单缓冲
+    if (config_.double_buffer && var.yres_virtual < var.yres * 2) {
+        fb_var_screeninfo request = var;
+        request.yres_virtual = var.yres * 2;
+        request.yoffset = 0;
+        if (ioctl(fd_, FBIOPUT_VSCREENINFO, &request) == 0) {
+            ioctl(fd_, FBIOGET_VSCREENINFO, &var);
+            ioctl(fd_, FBIOGET_FSCREENINFO, &fix);
+        }
+    }
+
+    if (var.bits_per_pixel != 16 && var.bits_per_pixel != 32) {
+        FB_LOGE("Unsupported pixel depth: %u bpp", var.bits_per_pixel);
+        return false;
+    }
+    if (var.bits_per_pixel == 16 && (var.red.offset != 11 || var.green.length != 6)) {
+        FB_LOGE("16 bpp framebuffer is not RGB565");
+        return false;
+    }
+    if (var.xres > INT16_MAX || var.yres > INT16_MAX) {
+        FB_LOGE("Resolution %ux%u too large", var.xres, var.yres);
+        return false;
+    }
+
+    width_ = static_cast<int16_t>(var.xres);
+    height_ = static_cast<int16_t>(var.yres);
+    bpp_ = static_cast<uint8_t>(var.bits_per_pixel);
+    stride_ = fix.line_length;
+    page_rows_ = var.yres;
+    map_size_ = fix.smem_len;
+    red_shift_ = static_cast<uint8_t>(var.red.offset);
+    green_shift_ = static_cast<uint8_t>(var.green.offset);
+    blue_shift_ = static_cast<uint8_t>(var.blue.offset);
+    alpha_bits_ = var.transp.length ? ((1u << var.transp.length) - 1) << var.transp.offset : 0;
+
+    // 不支持平移的设备（ypanstep为0）或显存不足两页时只用单缓冲
+    pages_ = 1;
+    front_ = 0;
+    if (config_.double_buffer && fix.ypanstep != 0 && var.yres_virtual >= var.yres * 2 &&
+        map_size_ >= stride_ * page_rows_ * 2) {
+        pages_ = 2;
+        if (!panTo(0)) {
+            FB_LOGW("FBIOPAN_DISPLAY not supported, using single buffer");
+            pages_ = 1;
+        }
+    }
+    if (map_size_ < stride_ * page_rows_) {
+        FB_LOGE("Framebuffer memory too small: %zu bytes", map_size_);
+        return false;
+    }
+    return true;
+}
+
+bool Jetson_FB_Driver::openFile() {
+    if (config_.width <= 0 || config_.height <= 0 || (config_.bpp != 16 && config_.bpp != 32)) {
+        FB_LOGE("%s is a regular file: width, height and bpp (16/32) must be configured", config_.device);
+        return false;
+    }
+
+    width_ = config_.width;
+    height_ = config_.height;
+    bpp_ = config_.bpp;
+    stride_ = static_cast<size_t>(width_) * (bpp_ / 8);
+    page_rows_ = static_cast<uint32_t>(height_);
+    pages_ = config_.double_buffer ? 2 : 1;
+    front_ = 0;
+    map_size_ = stride_ * page_rows_ * pages_;
+
+    // XRGB8888，与大多数设备的32位格式一致
+    red_shift_ = 16;
+    green_shift_ = 8;
+    blue_shift_ = 0;
+    alpha_bits_ = 0;
+
+    struct stat st;
+    if (fstat(fd_, &st) == 0 && static_cast<size_t>(st.st_size) < map_size_ &&
+        ftruncate(fd_, static_cast<off_t>(map_size_)) != 0) {
+        FB_LOGE("Failed to resize %s: %s", config_.device, strerror(errno));
+        return false;
+    }
+    return true;
+}
+
+void Jetson_FB_Driver::release() {
+    if (map_) {
+        munmap(map_, map_size_);
+        map_ = nullptr;
+    }
+    if (fd_ >= 0) {
+        close(fd_);
+        fd_ = -1;
+    }
+}
+
+bool Jetson_FB_Driver::panTo(uint8_t page) {
+    if (!is_device_) {
+        return true;
+    }
+    fb_var_screeninfo var;
+    if (ioctl(fd_, FBIOGET_VSCREENINFO, &var) != 0) {
+        return false;
+    }
+    var.xoffset = 0;
+    var.yoffset = page * page_rows_;
+    return ioctl(fd_, FBIOPAN_DISPLAY, &var) == 0;
+}
+
+const uint8_t* Jetson_FB_Driver::page(uint8_t page) const {
+    if (!map_ || page >= pages_) {
+        return nullptr;
+    }
+    return map_ + stride_ * page_rows_ * page;
+}
+
+uint8_t* Jetson_FB_Driver::row(uint8_t page, int16_t y) const {
+    return map_ + stride_ * (page_rows_ * page + static_cast<uint32_t>(y));
+}
+
+uint32_t Jetson_FB_Driver::pack32(Color color) const {
+    // RGB565展开为8位通道，低位用高位补齐，使白色为0xFF
+    uint32_t r = (color >> 11) & 0x1F;
+    uint32_t g = (color >> 5) & 0x3F;
+    uint32_t b = color & 0x1F;
+    r = (r << 3) | (r >> 2);
+    g = (g << 2) | (g >> 4);
+    b = (b << 3) | (b >> 2);
+    return (r << red_shift_) | (g << green_shift_) | (b << blue_shift_) | alpha_bits_;
+}
+
+Color Jetson_FB_Driver::readPixel(int16_t x, int16_t y) const {
+    if (!map_ || x < 0 || y < 0 || x >= width_ || y >= height_) {
+        return Colors::BLACK;
+    }
+    const uint8_t* p = row(backPage(), y);
+    if (bpp_ == 16) {
+        Color color;
+        memcpy(&color, p + x * 2, sizeof(color));
+        return color;
+    }
+    uint32_t v;
+    memcpy(&v, p + x * 4, sizeof(v));
+    uint32_t r = (v >> red_shift_) & 0xFF;
+    uint32_t g = (v >> green_shift_) & 0xFF;
+    uint32_t b = (v >> blue_shift_) & 0xFF;
+    return static_cast<Color>(((r >> 3) << 11) | ((g >> 2) << 5) | (b >> 3));
+}
+
+void Jetson_FB_Driver::fillRows(uint8_t page, int16_t x, int16_t y, int16_t w, int16_t h, Color color) {
+    if (bpp_ == 16) {
+        for (int16_t r = 0; r < h; r++) {
+            PixelKernels::fill(reinterpret_cast<Color*>(row(page, y + r)) + x, w, color);
+        }
+        return;
+    }
+    const uint32_t value = pack32(color);
+    for (int16_t r = 0; r < h; r++) {
+        uint32_t* line = reinterpret_cast<uint32_t*>(row(page, y + r)) + x;
+        std::fill(line, line + w, value);
+    }
+}
+
+void Jetson_FB_Driver::copyRect(uint8_t from, uint8_t to, const Rect& area) {
+    const size_t offset = static_cast<size_t>(area.x) * (bpp_ / 8);
+    const size_t bytes = static_cast<size_t>(area.w) * (bpp_ / 8);
+    for (int16_t y = area.y; y < area.bottom(); y++) {
+        memcpy(row(to, y) + offset, row(from, y) + offset, bytes);
+    }
+}
+
+void Jetson_FB_Driver::markDirty(int16_t x, int16_t y, int16_t w, int16_t h) {
+    if (pages_ < 2) {
+        return;
+    }
+    if (dirty_.isEmpty()) {
+        dirty_ = Rect{x, y, w, h};
+        return;
+    }
+    int16_t left = std::min(dirty_.x, x);
+    int16_t top = std::min(dirty_.y, y);
+    int16_t right = std::max<int16_t>(dirty_.right(), x + w);
+    int16_t bottom = std::max<int16_t>(dirty_.bottom(), y + h);
+    dirty_ = Rect{left, top, static_cast<int16_t>(right - left), static_cast<int16_t>(bottom - top)};
+}
+
+void Jetson_FB_Driver::writeRect(int16_t x, int16_t y, int16_t w, int16_t h, Color color) {
+    fillRows(backPage(), x, y, w, h, color);
+    markDirty(x, y, w, h);
+}
+
+void Jetson_FB_Driver::drawPixel(int16_t x, int16_t y, Color color) {
+    if (!map_ || !clipRect().contains(x, y)) {
+        return;
+    }
+    writeRect(x, y, 1, 1, color);
+}
+
+void Jetson_FB_Driver::fillRect(int16_t x, int16_t y, int16_t w, int16_t h, Color color) {
+    if (!map_ || !clipToCurrent(x, y, w, h)) {
+        return;
+    }
+    writeRect(x, y, w, h, color);
+}
+
+void Jetson_FB_Driver::fillSpan(int16_t x, int16_t y, int16_t w, Color color) {
+    if (!map_) return;
+
+    // 光栅化器输出的扫描段已裁剪，无需再次检查
+    writeRect(x, y, w, 1, color);
+}
+
+void Jetson_FB_Driver::drawBitmap(int16_t x, int16_t y, int16_t w, int16_t h, const Color* pixels) {
+    if (!map_ || !pixels) return;
+
+    const int16_t src_x = x;
+    const int16_t src_y = y;
+    const int16_t stride = w;
+    if (!clipToCurrent(x, y, w, h)) return;
+    pixels += static_cast<int32_t>(y - src_y) * stride + (x - src_x);
+
+    // 逐行直接写入显存：16位整行拷贝，32位逐像素展开
+    const uint8_t page = backPage();
+    for (int16_t r = 0; r < h; r++) {
+        const Color* line = pixels + static_cast<int32_t>(r) * stride;
+        if (bpp_ == 16) {
+            PixelKernels::copy(reinterpret_cast<Color*>(row(page, y + r)) + x, line, w);
+        } else {
+            uint32_t* dst = reinterpret_cast<uint32_t*>(row(page, y + r)) + x;
+            for (int16_t c = 0; c < w; c++) {
+                dst[c] = pack32(line[c]);
+            }
+        }
+    }
+    markDirty(x, y, w, h);
+}
+
+void Jetson_FB_Driver::drawHLine(int16_t x, int16_t y, int16_t w, Color color) {
+    fillRect(x, y, w, 1, color);
+}
+
+void Jetson_FB_Driver::drawVLine(int16_t x, int16_t y, int16_t h, Color color) {
+    fillRect(x, y, 1, h, color);
+}
+
+void Jetson_FB_Driver::drawRect(int16_t x, int16_t y, int16_t w, int16_t h, Color color) {
+    if (Rect{x, y, w, h}.intersect(clipRect()).isEmpty()) {
+        return;
+    }
+    drawHLine(x, y, w, color);
+    drawHLine(x, y + h - 1, w, color);
+    drawVLine(x, y, h, color);
+    drawVLine(x + w - 1, y, h, color);
+}
+
+void Jetson_FB_Driver::fillCircle(int16_t x0, int16_t y0, int16_t r, Color color) {
+    Rasterizer(*this, clipRect()).fillCircle(x0, y0, r, color);
+}
+
+void Jetson_FB_Driver::clear(Color color) {
+    if (!map_) return;
+    writeRect(0, 0, width_, height_, color);
+}
+
+bool Jetson_FB_Driver::scroll(int16_t dy) {
+    if (!map_) return false;
+    if (dy == 0) return true;
+
+    // 在后台页内整行移动，新露出的行清为黑色
+    const uint8_t page = backPage();
+    const int16_t n = static_cast<int16_t>(std::min<int>(std::abs(dy), height_));
+    const size_t bytes = stride_ * static_cast<size_t>(height_ - n);
+    if (dy > 0) {
+        if (bytes > 0) memmove(row(page, 0), row(page, n), bytes);
+        fillRows(page, 0, height_ - n, width_, n, Colors::BLACK);
+    } else {
+        if (bytes > 0) memmove(row(page, n), row(page, 0), bytes);
+        fillRows(page, 0, 0, width_, n, Colors::BLACK);
+    }
+    markDirty(0, 0, width_, height_);
+    return true;
+}
+
+void Jetson_FB_Driver::display() {
+    MUI_TRACE_SCOPE("flush");
+    if (!map_ || pages_ < 2 || dirty_.isEmpty()) {
+        return;
+    }
+
+    const uint8_t back = backPage();
+    if (is_device_ && config_.wait_vsync) {
+        uint32_t crtc = 0;
+        ioctl(fd_, FBIO_WAITFORVSYNC, &crtc);
+    }
+    if (panTo(back)) {
+        front_ = back;
+        // 新的后台页缺少本帧的修改，从前台页拷回脏区
+        copyRect(front_, backPage(), dirty_);
+    } else {
+        // 翻页失败时把本帧拷贝到正在显示的页，内容仍然正确
+        FB_LOGW("FBIOPAN_DISPLAY failed: %s", strerror(errno));
+        copyRect(back, front_, dirty_);
+    }
+    dirty_ = Rect{0, 0, 0, 0};
+}
+
+} // namespace MinimalUI
@@ -0,0 +1,126 @@
+#pragma once
+
+#include "GraphicsDriver.h"
+#include <cstddef>
+#include <cstdint>
+
+namespace MinimalUI {
+
+/**
+ * @brief Linux帧缓冲驱动配置结构
+ */
+struct Jetson_FB_Config {
+    const char* device = "/dev/fb0";  // 帧缓冲设备或普通文件路径
+    bool double_buffer = true;        // 可用时使用FBIOPAN_DISPLAY双缓冲
+    bool wait_vsync = false;          // 翻页前等待垂直同步（FBIO_WAITFORVSYNC）
+
+    // 以下参数仅在device为普通文件时使用（CI中代替真实设备），文件不足时自动扩展
+    int16_t width = 0;
+    int16_t height = 0;
+    uint8_t bpp = 16;                 // 16（RGB565）或32（XRGB8888）
+};
+
+/**
+ * @class Jetson_FB_Driver
+ * @brief Linux /dev/fb* 帧缓冲驱动
+ *
+ * mmap整个显存后直接在其中按行填充和拷贝，不经过中间缓冲区。支持16/32位像素；
+ * 32位时按设备报告的通道偏移打包颜色。
+ *
+ * 双缓冲：虚拟分辨率能容纳两页时（必要时通过FBIOPUT_VSCREENINFO申请），
+ * 绘制写入后台页，display()用FBIOPAN_DISPLAY翻页，再把本帧脏区拷贝到新的后台页，
+ * 使两页内容保持一致，增量绘制无需整屏重绘。设备不支持时退化为单缓冲直接绘制。
+ *
+ * device为普通文件时按配置的尺寸mmap文件，翻页只记录前台页，便于在CI中校验像素。
+ */
+class Jetson_FB_Driver : public GraphicsDriver {
+public:
+    explicit Jetson_FB_Driver(const Jetson_FB_Config& config);
+    ~Jetson_FB_Driver() override;
+
+    /**
+     * @brief 向DriverFactory注册DriverType::JETSON_FB的创建函数
+     * @param config 创建驱动时使用的配置，device字符串须在整个程序运行期间有效
+     */
+    static void registerDriver(const Jetson_FB_Config& config);
+
+    // 实现GraphicsDriver接口
+    bool initialize() override;
+    void drawPixel(int16_t x, int16_t y, Color color) override;
+    void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, Color color) override;
+    void drawHLine(int16_t x, int16_t y, int16_t w, Color color) override;
+    void drawVLine(int16_t x, int16_t y, int16_t h, Color color) override;
+    void drawRect(int16_t x, int16_t y, int16_t w, int16_t h, Color color) override;
+    void fillCircle(int16_t x0, int16_t y0, int16_t r, Color color) override;
+    void fillSpan(int16_t x, int16_t y, int16_t w, Color color) override;
+    void drawBitmap(int16_t x, int16_t y, int16_t w, int16_t h, const Color* pixels) override;
+    void display() override;
+    void clear(Color color = Colors::BLACK) override;
+    bool scroll(int16_t dy) override;
+    int16_t width() const override { return width_; }
+    int16_t height() const override { return height_; }
+
+    // 每像素位数（16或32）
+    uint8_t bitsPerPixel() const { return bpp_; }
+
+    // 行跨度（字节）
+    size_t stride() const { return stride_; }
+
+    // 是否启用了翻页双缓冲
+    bool doubleBuffered() const { return pages_ > 1; }
+
+    // 当前显示的页（0或1）
+    uint8_t frontPage() const { return front_; }
+
+    /**
+     * @brief 获取某一页的像素起始地址
+     * @param page 页号，单缓冲时只有第0页
+     */
+    const uint8_t* page(uint8_t page) const;
+
+    /**
+     * @brief 读取当前绘制页(x, y)处的像素并转换为RGB565
+     */
+    Color readPixel(int16_t x, int16_t y) const;
+
+private:
+    Jetson_FB_Config config_;
+    int fd_;
+    bool is_device_;
+    uint8_t* map_;          // mmap的显存
+    size_t map_size_;
+    int16_t width_;
+    int16_t height_;
+    uint8_t bpp_;
+    size_t stride_;
+    uint8_t pages_;         // 1或2
+    uint8_t front_;         // 正在显示的页
+    uint32_t page_rows_;    // 相邻两页之间的行数（设备的yres）
+
+    // 32位像素的通道位置
+    uint8_t red_shift_;
+    uint8_t green_shift_;
+    uint8_t blue_shift_;
+    uint32_t alpha_bits_;   // 不透明alpha位，设备无alpha通道时为0
+
+    Rect dirty_;            // 本帧在后台页上修改过的区域
+
+    bool openDevice();
+    bool openFile();
+    void release();
+
+    // 指定页的行起始地址
+    uint8_t* row(uint8_t page, int16_t y) const;
+    uint8_t backPage() const { return pages_ > 1 ? static_cast<uint8_t>(front_ ^ 1) : 0; }
+
+    uint32_t pack32(Color color) const;
+
+    // 写入已裁剪的矩形区域
+    void writeRect(int16_t x, int16_t y, int16_t w, int16_t h, Color color);
+    void fillRows(uint8_t page, int16_t x, int16_t y, int16_t w, int16_t h, Color color);
+    void copyRect(uint8_t from, uint8_t to, const Rect& area);
+    void markDirty(int16_t x, int16_t y, int16_t w, int16_t h);
+    bool panTo(uint8_t page);
+};
+
+} // namespace MinimalUI
@@ -0,0 +1,73 @@
+#include "Linux_GPIO_Output.h"
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <linux/gpio.h>
+#include <sys/ioctl.h>
+#include <unistd.h>
+
+namespace MinimalUI {
+
+static const char* TAG = "Linux_GPIO_Output";
+
+Linux_GPIO_Output::Linux_GPIO_Output() : fd_(-1), level_(false) {
+}
+
+Linux_GPIO_Output::~Linux_GPIO_Output() {
+    close();
+}
+
+bool Linux_GPIO_Output::open(const char* chip, uint32_t line, bool initial, const char* consumer) {
+    close();
+    int chip_fd = ::open(chip, O_RDWR | O_CLOEXEC);
+    if (chip_fd < 0) {
+        fprintf(stderr, "E (%s) Failed to open %s: %s\n", TAG, chip, strerror(errno));
+        return false;
+    }
+
+    gpiohandle_request request = {};
+    request.lineoffsets[0] = line;
+    request.lines = 1;
+    request.flags = GPIOHANDLE_REQUEST_OUTPUT;
+    request.default_values[0] = initial ? 1 : 0;
+    strncpy(request.consumer_label, consumer ? consumer : "minimalui", sizeof(request.consumer_label) - 1);
+
+    int ret = ioctl(chip_fd, GPIO_GET_LINEHANDLE_IOCTL, &request);
+    ::close(chip_fd);  // 线句柄独立于芯片描述符
+    if (ret < 0) {
+        fprintf(stderr, "E (%s) Failed to request %s line %u: %s\n", TAG, chip, line, strerror(errno));
+        return false;
+    }
+
+    fd_ = request.fd;
+    level_ = initial;
+    return true;
+}
+
+void Linux_GPIO_Output::close() {
+    if (fd_ >= 0) {
+        ::close(fd_);
+        fd_ = -1;
+    }
+}
+
+bool Linux_GPIO_Output::set(bool level) {
+    if (fd_ < 0) {
+        return false;
+    }
+    if (level == level_) {
+        return true;
+    }
+
+    gpiohandle_data data = {};
+    data.values[0] = level ? 1 : 0;
+    if (ioctl(fd_, GPIOHANDLE_SET_LINE_VALUES_IOCTL, &data) < 0) {
+        fprintf(stderr, "E (%s) Failed to set line: %s\n", TAG, strerror(errno));
+        return false;
+    }
+    level_ = level;
+    return true;
+}
+
+} // namespace MinimalUI
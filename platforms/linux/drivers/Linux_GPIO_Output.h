@@ -0,0 +1,49 @@
+#pragma once
+
+#include <cstdint>
+
+namespace MinimalUI {
+
+/**
+ * @class Linux_GPIO_Output
+ * @brief 通过GPIO字符设备（/dev/gpiochipN）控制的单根输出线
+ *
+ * 使用GPIO_GET_LINEHANDLE_IOCTL申请线句柄，兼容4.8以后的内核（包括L4T的4.9内核）。
+ * 记录当前电平，电平不变时set()不发起系统调用。
+ */
+class Linux_GPIO_Output {
+public:
+    Linux_GPIO_Output();
+    ~Linux_GPIO_Output();
+
+    Linux_GPIO_Output(const Linux_GPIO_Output&) = delete;
+    Linux_GPIO_Output& operator=(const Linux_GPIO_Output&) = delete;
+
+    /**
+     * @brief 申请输出线
+     * @param chip GPIO芯片设备路径
+     * @param line 芯片内的线号
+     * @param initial 初始电平
+     * @param consumer 在内核中显示的使用者名称
+     */
+    bool open(const char* chip, uint32_t line, bool initial, const char* consumer = "minimalui");
+
+    // 释放输出线
+    void close();
+
+    bool valid() const { return fd_ >= 0; }
+
+    /**
+     * @brief 设置电平
+     * @return 系统调用失败时返回false
+     */
+    bool set(bool level);
+
+    bool level() const { return level_; }
+
+private:
+    int fd_;
+    bool level_;
+};
+
+} // namespace MinimalUI
@@ -0,0 +1,505 @@
+#include "Linux_SPI_Driver.h"
+#include "DisplayController.h"
+#include "Dither.h"
+#include "Rasterizer.h"
+#include "ScreenCache.h"
+#include "Trace.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <linux/spi/spidev.h>
+#include <sys/ioctl.h>
+#include <unistd.h>
+
+namespace MinimalUI {
+
+static const char* TAG = "Linux_SPI_Driver";
+
+#define SPI_LOGE(fmt, ...) fprintf(stderr, "E (%s) " fmt "\n", TAG, ##__VA_ARGS__)
+
+// 帧内暂存超过该大小时提前发出，避免大位图占用过多内存
+static constexpr size_t STAGING_LIMIT = 64 * 1024;
+
+Linux_SPI_Driver::Linux_SPI_Driver(const Linux_SPI_Config& config, std::unique_ptr<DisplayController> controller)
+    : config_(config), fd_(-1), controller_(std::move(controller)), frame_depth_(0),
+      dc_level_(true), fill_color_(0), fill_pixel_size_(0) {
+    if (config_.max_transfer == 0) {
+        config_.max_transfer = 4096;
+    }
+    if (config_.max_message < config_.max_transfer) {
+        config_.max_message = config_.max_transfer;
+    }
+}
+
+Linux_SPI_Driver::~Linux_SPI_Driver() {
+    closeSPI();
+}
+
+bool Linux_SPI_Driver::initialize() {
+    if (!controller_) {
+        SPI_LOGE("No display controller provided");
+        return false;
+    }
+    if (!openSPI()) {
+        return false;
+    }
+    reset();
+    return controller_->initialize(this);
+}
+
+bool Linux_SPI_Driver::openSPI() {
+    closeSPI();
+    if (!config_.device) {
+        SPI_LOGE("No SPI device given");
+        return false;
+    }
+
+    if (config_.capture) {
+        // 记录文件、FIFO或socket代替spidev，DC电平写入记录头
+        fd_ = open(config_.device, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+        dc_level_ = true;
+        if (fd_ < 0) {
+            SPI_LOGE("Failed to open capture %s: %s", config_.device, strerror(errno));
+            return false;
+        }
+        return true;
+    }
+
+    fd_ = open(config_.device, O_RDWR | O_CLOEXEC);
+    if (fd_ < 0) {
+        SPI_LOGE("Failed to open %s: %s", config_.device, strerror(errno));
+        return false;
+    }
+
+    uint8_t mode = config_.spi_mode;
+    uint8_t bits = 8;
+    uint32_t speed = config_.freq;
+    if (ioctl(fd_, SPI_IOC_WR_MODE, &mode) < 0 ||
+        ioctl(fd_, SPI_IOC_WR_BITS_PER_WORD, &bits) < 0 ||
+        ioctl(fd_, SPI_IOC_WR_MAX_SPEED_HZ, &speed) < 0) {
+        SPI_LOGE("Failed to configure %s: %s", config_.device, strerror(errno));
+        closeSPI();
+        return false;
+    }
+
+    if (config_.dc_line < 0) {
+        SPI_LOGE("A DC line is required");
+        closeSPI();
+        return false;
+    }
+    if (!dc_.open(config_.gpio_chip, static_cast<uint32_t>(config_.dc_line), true, "minimalui-dc")) {
+        closeSPI();
+        return false;
+    }
+    dc_level_ = true;
+    if (config_.rst_line >= 0 &&
+        !rst_.open(config_.gpio_chip, static_cast<uint32_t>(config_.rst_line), true, "minimalui-rst")) {
+        closeSPI();
+        return false;
+    }
+    return true;
+}
+
+void Linux_SPI_Driver::closeSPI() {
+    dc_.close();
+    rst_.close();
+    if (fd_ >= 0) {
+        close(fd_);
+        fd_ = -1;
+    }
+}
+
+void Linux_SPI_Driver::reset() {
+    if (!rst_.valid()) {
+        return;
+    }
+    // 硬件复位：低电平脉冲只需数微秒，恢复时间由控制器给出
+    rst_.set(false);
+    usleep(10);
+    rst_.set(true);
+    usleep(static_cast<useconds_t>(controller_->resetRecoveryMs()) * 1000);
+}
+
+Linux_SPI_Stats Linux_SPI_Driver::stats() const {
+    std::lock_guard<std::recursive_mutex> lock(mutex_);
+    return stats_;
+}
+
+void Linux_SPI_Driver::resetStats() {
+    std::lock_guard<std::recursive_mutex> lock(mutex_);
+    stats_ = Linux_SPI_Stats();
+}
+
+void Linux_SPI_Driver::beginFrame() {
+    mutex_.lock();
+    frame_depth_++;
+}
+
+void Linux_SPI_Driver::endFrame() {
+    if (frame_depth_ == 0) {
+        return;
+    }
+    if (--frame_depth_ == 0) {
+        flush(true);
+        stats_.frames++;
+    }
+    mutex_.unlock();
+}
+
+void Linux_SPI_Driver::sendCommand(uint8_t cmd) {
+    queue(false, &cmd, 1);
+}
+
+void Linux_SPI_Driver::sendCommands(const uint8_t* cmds, size_t count) {
+    if (cmds && count > 0) {
+        queue(false, cmds, count);
+    }
+}
+
+void Linux_SPI_Driver::sendData(uint8_t data) {
+    queue(true, &data, 1);
+}
+
+void Linux_SPI_Driver::sendBuffer(const uint8_t* buffer, size_t size) {
+    if (buffer && size > 0) {
+        queue(true, buffer, size);
+    }
+}
+
+void Linux_SPI_Driver::queue(bool dc, const uint8_t* data, size_t size) {
+    beginFrame();
+    stats_.calls++;
+    if (!segments_.empty() && segments_.back().dc == dc) {
+        segments_.back().length += size;
+    } else {
+        segments_.push_back(Segment{dc, staging_.size(), size});
+    }
+    staging_.insert(staging_.end(), data, data + size);
+    if (staging_.size() >= STAGING_LIMIT) {
+        flush(false);
+    }
+    endFrame();
+}
+
+void Linux_SPI_Driver::flush(bool end_of_frame) {
+    if (segments_.empty() || fd_ < 0) {
+        staging_.clear();
+        segments_.clear();
+        return;
+    }
+    MUI_TRACE_SCOPE("spi.flush");
+
+    spi_ioc_transfer transfers[MAX_TRANSFERS];
+    for (size_t s = 0; s < segments_.size(); s++) {
+        const Segment& segment = segments_[s];
+        if (segment.dc != dc_level_) {
+            if (!config_.capture && !dc_.set(segment.dc)) {
+                break;
+            }
+            dc_level_ = segment.dc;
+            stats_.gpio_ioctls++;
+        }
+
+        // 按消息总长和单段长度拆分，一条消息对应一次系统调用
+        const uint8_t* data = staging_.data() + segment.offset;
+        size_t remaining = segment.length;
+        while (remaining > 0) {
+            size_t count = 0;
+            size_t message_bytes = 0;
+            while (remaining > 0 && count < MAX_TRANSFERS && message_bytes < config_.max_message) {
+                size_t chunk = std::min<size_t>({remaining, config_.max_transfer,
+                                                 config_.max_message - message_bytes});
+                spi_ioc_transfer& t = transfers[count++];
+                memset(&t, 0, sizeof(t));
+                t.tx_buf = reinterpret_cast<uintptr_t>(data);
+                t.len = static_cast<uint32_t>(chunk);
+                t.speed_hz = config_.freq;
+                t.bits_per_word = 8;
+                data += chunk;
+                remaining -= chunk;
+                message_bytes += chunk;
+            }
+
+            // 段内各传输之间片选保持有效；除整帧最后一条消息外，消息结束后也保持片选
+            const bool last = remaining == 0 && s + 1 == segments_.size() && end_of_frame;
+            transfers[count - 1].cs_change = last ? 0 : 1;
+            if (!submit(transfers, count, segment.dc, message_bytes)) {
+                remaining = 0;
+            }
+        }
+    }
+    staging_.clear();
+    segments_.clear();
+}
+
+bool Linux_SPI_Driver::submit(const spi_ioc_transfer* transfers, size_t count, bool dc, size_t bytes) {
+    stats_.spi_messages++;
+    stats_.transfers += count;
+    stats_.bytes += bytes;
+
+    if (config_.capture) {
+        Linux_SPI_CaptureRecord record;
+        record.dc = dc ? 1 : 0;
+        record.cs_hold = transfers[count - 1].cs_change;
+        record.transfers = static_cast<uint16_t>(count);
+        record.bytes = static_cast<uint32_t>(bytes);
+        // 记录头与负载一起写出，FIFO/socket的读端看到完整的消息
+        std::vector<uint8_t> out(sizeof(record) + bytes);
+        memcpy(out.data(), &record, sizeof(record));
+        size_t pos = sizeof(record);
+        for (size_t i = 0; i < count; i++) {
+            memcpy(out.data() + pos, reinterpret_cast<const void*>(static_cast<uintptr_t>(transfers[i].tx_buf)),
+                   transfers[i].len);
+            pos += transfers[i].len;
+        }
+        const uint8_t* p = out.data();
+        size_t left = out.size();
+        while (left > 0) {
+            ssize_t n = write(fd_, p, left);
+            if (n < 0) {
+                if (errno == EINTR) continue;
+                SPI_LOGE("Capture write failed: %s", strerror(errno));
+                return false;
+            }
+            p += n;
+            left -= static_cast<size_t>(n);
+        }
+        return true;
+    }
+
+    MUI_TRACE_SCOPE("spi.transfer");
+    if (ioctl(fd_, SPI_IOC_MESSAGE(count), transfers) < 0) {
+        SPI_LOGE("SPI_IOC_MESSAGE(%zu) failed: %s", count, strerror(errno));
+        return false;
+    }
+    return true;
+}
+
+int16_t Linux_SPI_Driver::width() const {
+    return controller_ ? controller_->getWidth() : 0;
+}
+
+int16_t Linux_SPI_Driver::height() const {
+    return controller_ ? controller_->getHeight() : 0;
+}
+
+void Linux_SPI_Driver::drawPixel(int16_t x, int16_t y, Color color) {
+    if (!controller_ || !clipRect().contains(x, y)) {
+        return;
+    }
+    writeRect(x, y, 1, 1, color);
+}
+
+void Linux_SPI_Driver::fillRect(int16_t x, int16_t y, int16_t w, int16_t h, Color color) {
+    if (!controller_ || !clipToCurrent(x, y, w, h)) {
+        return;
+    }
+    writeRect(x, y, w, h, color);
+}
+
+void Linux_SPI_Driver::fillSpan(int16_t x, int16_t y, int16_t w, Color color) {
+    if (!controller_) return;
+
+    // 光栅化器输出的扫描段已裁剪，无需再次检查
+    writeRect(x, y, w, 1, color);
+}
+
+void Linux_SPI_Driver::drawBitmap(int16_t x, int16_t y, int16_t w, int16_t h, const Color* pixels) {
+    if (!controller_ || !pixels) return;
+
+    const int16_t src_x = x;
+    const int16_t src_y = y;
+    const int16_t stride = w;
+    if (!clipToCurrent(x, y, w, h)) return;
+    pixels += static_cast<int32_t>(y - src_y) * stride + (x - src_x);
+
+    // 持有帧缓冲区的控制器（如单色OLED）自行转换像素格式
+    if (controller_->drawBufferBitmap(x, y, w, h, pixels, stride)) {
+        return;
+    }
+    const uint8_t pixel_size = controller_->getPixelSize();
+    if (pixel_size < 2) {
+        for (int16_t row = 0; row < h; row++) {
+            GraphicsDriver::drawBitmap(x, y + row, w, 1, pixels + static_cast<int32_t>(row) * stride);
+        }
+        return;
+    }
+
+    // 整块位图作为一帧，转换后的像素暂存后随帧一起发出
+    beginFrame();
+    controller_->setAddrWindow(x, y, w, h);
+    fill_pixel_size_ = 0;  // 缓冲区内容不再是单一颜色
+
+    const size_t pixels_per_chunk = FILL_BUFFER_SIZE / pixel_size;
+    size_t used = 0;
+    for (int16_t row = 0; row < h; row++) {
+        const Color* line = pixels + static_cast<int32_t>(row) * stride;
+        for (int16_t col = 0; col < w; col++) {
+            convertColor(line[col], fill_buffer_ + used * pixel_size, pixel_size);
+            if (++used == pixels_per_chunk) {
+                controller_->writePixelData(fill_buffer_, used * pixel_size);
+                used = 0;
+            }
+        }
+    }
+    if (used > 0) {
+        controller_->writePixelData(fill_buffer_, used * pixel_size);
+    }
+    endFrame();
+}
+
+void Linux_SPI_Driver::writeRect(int16_t x, int16_t y, int16_t w, int16_t h, Color color) {
+    // 持有帧缓冲区的控制器直接在内存中整行填充
+    if (controller_->fillBufferRect(x, y, w, h, color)) {
+        return;
+    }
+
+    // 窗口设置与像素数据作为一帧，合并为尽量少的系统调用
+    beginFrame();
+    controller_->setAddrWindow(x, y, w, h);
+
+    const uint8_t pixel_size = controller_->getPixelSize();
+    const size_t pixels_per_chunk = FILL_BUFFER_SIZE / pixel_size;
+    if (fill_pixel_size_ != pixel_size || fill_color_ != color) {
+        uint8_t pixel_data[4];
+        convertColor(color, pixel_data, pixel_size);
+        for (size_t i = 0; i < pixels_per_chunk; i++) {
+            memcpy(fill_buffer_ + i * pixel_size, pixel_data, pixel_size);
+        }
+        fill_color_ = color;
+        fill_pixel_size_ = pixel_size;
+    }
+
+    uint32_t remaining_pixels = static_cast<uint32_t>(w) * h;
+    while (remaining_pixels > 0) {
+        uint32_t chunk_pixels = std::min(remaining_pixels, static_cast<uint32_t>(pixels_per_chunk));
+        controller_->writePixelData(fill_buffer_, chunk_pixels * pixel_size);
+        remaining_pixels -= chunk_pixels;
+    }
+    endFrame();
+}
+
+void Linux_SPI_Driver::drawHLine(int16_t x, int16_t y, int16_t w, Color color) {
+    fillRect(x, y, w, 1, color);
+}
+
+void Linux_SPI_Driver::drawVLine(int16_t x, int16_t y, int16_t h, Color color) {
+    fillRect(x, y, 1, h, color);
+}
+
+void Linux_SPI_Driver::drawLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, Color color) {
+    // 整条线作为一帧发出
+    beginFrame();
+    GraphicsDriver::drawLine(x0, y0, x1, y1, color);
+    endFrame();
+}
+
+void Linux_SPI_Driver::drawRect(int16_t x, int16_t y, int16_t w, int16_t h, Color color) {
+    if (Rect{x, y, w, h}.intersect(clipRect()).isEmpty()) {
+        return;
+    }
+    beginFrame();
+    drawHLine(x, y, w, color);
+    drawHLine(x, y + h - 1, w, color);
+    drawVLine(x, y, h, color);
+    drawVLine(x + w - 1, y, h, color);
+    endFrame();
+}
+
+void Linux_SPI_Driver::drawCircle(int16_t x0, int16_t y0, int16_t r, Color color) {
+    beginFrame();
+    GraphicsDriver::drawCircle(x0, y0, r, color);
+    endFrame();
+}
+
+void Linux_SPI_Driver::fillCircle(int16_t x0, int16_t y0, int16_t r, Color color) {
+    beginFrame();
+    Rasterizer(*this, clipRect()).fillCircle(x0, y0, r, color);
+    endFrame();
+}
+
+void Linux_SPI_Driver::display() {
+    MUI_TRACE_SCOPE("flush");
+    if (controller_) {
+        controller_->refresh();
+    }
+}
+
+void Linux_SPI_Driver::clear(Color color) {
+    if (!controller_) return;
+    if (color == Colors::BLACK && !hasClip()) {
+        controller_->clearScreen();
+    } else {
+        fillRect(0, 0, width(), height(), color);
+    }
+}
+
+bool Linux_SPI_Driver::scroll(int16_t dy) {
+    return controller_ ? controller_->scroll(dy) : false;
+}
+
+bool Linux_SPI_Driver::shiftRect(int16_t x, int16_t y, int16_t w, int16_t h, int16_t dx) {
+    // 区域被裁剪时移入的内容来自屏幕外，交给调用方重绘整个区域
+    int16_t cx = x;
+    int16_t cy = y;
+    int16_t cw = w;
+    int16_t ch = h;
+    if (!controller_ || !clipToCurrent(cx, cy, cw, ch) || cx != x || cy != y || cw != w || ch != h ||
+        dx >= w || dx <= -w) {
+        return false;
+    }
+    return controller_->shiftBufferRect(x, y, w, h, dx);
+}
+
+bool Linux_SPI_Driver::setRotation(Rotation rotation) {
+    return controller_ ? controller_->setRotation(rotation) : false;
+}
+
+bool Linux_SPI_Driver::captureScreen(ScreenCache& cache, uint16_t page) {
+    if (!controller_) {
+        return false;
+    }
+    size_t size = 0;
+    const uint8_t* data = controller_->snapshotData(size);
+    return data && cache.store(page, data, size);
+}
+
+bool Linux_SPI_Driver::restoreScreen(ScreenCache& cache, uint16_t page) {
+    MUI_TRACE_SCOPE("restore");
+    if (!controller_) {
+        return false;
+    }
+    // load()未命中或快照损坏时不修改帧缓冲区，调用方完整重绘即可
+    size_t size = 0;
+    uint8_t* target = controller_->snapshotTarget(size);
+    if (!target || !cache.load(page, target, size)) {
+        return false;
+    }
+    controller_->presentSnapshot();
+    return true;
+}
+
+void Linux_SPI_Driver::convertColor(Color color, uint8_t* buffer, uint8_t pixel_size) {
+    switch (pixel_size) {
+        case 1: // 单色：按亮度阈值转换
+            buffer[0] = (luminance(color) > 127) ? 0xFF : 0x00;
+            break;
+        case 2: // RGB565，高字节在前
+            buffer[0] = color >> 8;
+            buffer[1] = color & 0xFF;
+            break;
+        case 3: // RGB888
+            buffer[0] = (color >> 11) << 3;
+            buffer[1] = ((color >> 5) & 0x3F) << 2;
+            buffer[2] = (color & 0x1F) << 3;
+            break;
+        default:
+            buffer[0] = color & 0xFF;
+            break;
+    }
+}
+
+} // namespace MinimalUI
@@ -0,0 +1,161 @@
+#pragma once
+
+#include "GraphicsDriver.h"
+#include "DisplayTransport.h"
+#include "Linux_GPIO_Output.h"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+struct spi_ioc_transfer;
+
+namespace MinimalUI {
+
+// 前向声明
+class DisplayController;
+enum class Rotation : uint8_t;
+
+/**
+ * @brief Linux spidev驱动配置结构
+ */
+struct Linux_SPI_Config {
+    const char* device = "/dev/spidev0.0";   // spidev设备，capture为true时为记录文件/FIFO/socket路径
+    const char* gpio_chip = "/dev/gpiochip0"; // DC/复位所在的GPIO芯片
+    int32_t dc_line = -1;       // 数据/命令线号
+    int32_t rst_line = -1;      // 复位线号，-1表示不使用
+    uint32_t freq = 8000000;    // SPI频率
+    uint8_t spi_mode = 0;       // SPI模式
+    uint32_t max_transfer = 4096;  // 单个spi_ioc_transfer的最大字节数（控制器DMA限制）
+    uint32_t max_message = 4096;   // 单次SPI_IOC_MESSAGE的最大总字节数（spidev.bufsiz，默认4096）
+
+    // 测试用：不访问spidev和GPIO，把每条消息按Linux_SPI_CaptureRecord格式写入device
+    bool capture = false;
+};
+
+/**
+ * @brief capture模式下每条SPI消息的记录头，后跟bytes字节负载
+ */
+struct Linux_SPI_CaptureRecord {
+    uint8_t dc;          // 消息期间的DC电平
+    uint8_t cs_hold;     // 消息结束后是否保持片选（最后一个传输的cs_change）
+    uint16_t transfers;  // 消息中的spi_ioc_transfer个数
+    uint32_t bytes;      // 负载字节数
+};
+
+/**
+ * @brief 传输统计
+ */
+struct Linux_SPI_Stats {
+    uint64_t calls = 0;         // 控制器调用sendCommand/sendData/sendBuffer的次数
+    uint64_t spi_messages = 0;  // SPI_IOC_MESSAGE系统调用次数
+    uint64_t transfers = 0;     // 消息中的传输段总数
+    uint64_t gpio_ioctls = 0;   // DC电平切换的系统调用次数
+    uint64_t bytes = 0;
+    uint64_t frames = 0;        // 最外层beginFrame/endFrame次数
+};
+
+/**
+ * @class Linux_SPI_Driver
+ * @brief 通过/dev/spidevX.Y和GPIO字符设备驱动SPI屏幕
+ *
+ * 控制器在beginFrame()/endFrame()之间的命令和数据先暂存，最外层endFrame()时一次发出：
+ * DC电平相同的连续字节合并为一条SPI_IOC_MESSAGE(n)（超过max_transfer时拆成n段，
+ * 超过max_message时分为多条消息），
+ * 只在DC变化时切换GPIO。中间消息的最后一段设置cs_change，使片选在DC切换期间保持有效。
+ * 因此一次窗口更新（地址命令 + 像素数据）只需两次SPI和至多两次GPIO系统调用，
+ * 而不是每个字节一次。帧外的单次调用立即发出。
+ *
+ * 与ESP32_SPI_Driver一样支持可插拔的显示控制器；控制器通过主机兼容层编译。
+ */
+class Linux_SPI_Driver : public GraphicsDriver, public DisplayTransport {
+public:
+    Linux_SPI_Driver(const Linux_SPI_Config& config, std::unique_ptr<DisplayController> controller);
+    ~Linux_SPI_Driver() override;
+
+    // 实现GraphicsDriver接口
+    bool initialize() override;
+    void drawPixel(int16_t x, int16_t y, Color color) override;
+    void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, Color color) override;
+    void drawHLine(int16_t x, int16_t y, int16_t w, Color color) override;
+    void drawVLine(int16_t x, int16_t y, int16_t h, Color color) override;
+    void drawLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, Color color) override;
+    void drawRect(int16_t x, int16_t y, int16_t w, int16_t h, Color color) override;
+    void drawCircle(int16_t x0, int16_t y0, int16_t r, Color color) override;
+    void fillCircle(int16_t x0, int16_t y0, int16_t r, Color color) override;
+    void fillSpan(int16_t x, int16_t y, int16_t w, Color color) override;
+    void drawBitmap(int16_t x, int16_t y, int16_t w, int16_t h, const Color* pixels) override;
+    void display() override;
+    void clear(Color color = Colors::BLACK) override;
+    bool scroll(int16_t dy) override;
+    bool shiftRect(int16_t x, int16_t y, int16_t w, int16_t h, int16_t dx) override;
+    bool captureScreen(ScreenCache& cache, uint16_t page) override;
+    bool restoreScreen(ScreenCache& cache, uint16_t page) override;
+    int16_t width() const override;
+    int16_t height() const override;
+
+    /**
+     * @brief 设置显示旋转，之后width()/height()和裁剪都按旋转后的尺寸，调用方需重绘
+     * @return 控制器不支持该旋转时返回false
+     */
+    bool setRotation(Rotation rotation);
+
+    // 实现DisplayTransport接口 - 供控制器使用
+    void sendCommand(uint8_t cmd) override;
+    void sendData(uint8_t data) override;
+    void sendBuffer(const uint8_t* buffer, size_t size) override;
+    void sendCommands(const uint8_t* cmds, size_t count) override;
+    void beginFrame() override;
+    void endFrame() override;
+
+    DisplayController* controller() { return controller_.get(); }
+
+    Linux_SPI_Stats stats() const;
+    void resetStats();
+
+private:
+    // 单条消息最多包含的传输段数
+    static constexpr size_t MAX_TRANSFERS = 32;
+    // 填充缓冲区大小（字节）
+    static constexpr size_t FILL_BUFFER_SIZE = 4096;
+
+    // 暂存的一段DC电平相同的字节
+    struct Segment {
+        bool dc;
+        size_t offset;
+        size_t length;
+    };
+
+    Linux_SPI_Config config_;
+    int fd_;
+    Linux_GPIO_Output dc_;
+    Linux_GPIO_Output rst_;
+    std::unique_ptr<DisplayController> controller_;
+
+    mutable std::recursive_mutex mutex_;  // 帧期间持有，允许其他线程（如灰度任务）安全地使用传输
+    uint16_t frame_depth_;
+    bool dc_level_;               // DC线当前电平
+    std::vector<uint8_t> staging_;
+    std::vector<Segment> segments_;
+    Linux_SPI_Stats stats_;
+
+    uint8_t fill_buffer_[FILL_BUFFER_SIZE];
+    Color fill_color_;
+    uint8_t fill_pixel_size_;
+
+    bool openSPI();
+    void closeSPI();
+    void reset();
+
+    // 暂存字节，帧外立即发出
+    void queue(bool dc, const uint8_t* data, size_t size);
+    // 发出所有暂存的字节；end_of_frame为false时最后一条消息也保持片选
+    void flush(bool end_of_frame);
+    bool submit(const spi_ioc_transfer* transfers, size_t count, bool dc, size_t bytes);
+
+    void writeRect(int16_t x, int16_t y, int16_t w, int16_t h, Color color);
+    void convertColor(Color color, uint8_t* buffer, uint8_t pixel_size);
+};
+
+} // namespace MinimalUI
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <cstdio>
+
+namespace MinimalUI {
+namespace Test {
+
+// 本进程中失败的检查数
+inline int& failures() {
+    static int count = 0;
+    return count;
+}
+
+/**
+ * @brief 打印一条检查结果并累计失败数
+ * @return condition，便于调用方在失败时跳过后续依赖该结果的检查
+ */
+inline bool check(bool condition, const char* what) {
+    printf("  [%s] %s\n", condition ? " OK " : "FAIL", what);
+    if (!condition) {
+        failures()++;
+    }
+    return condition;
+}
+
+/**
+ * @brief 打印汇总并返回进程退出码（有失败时为1）
+ */
+inline int finish(const char* name) {
+    if (failures() == 0) {
+        printf("\nAll %s checks passed\n", name);
+        return 0;
+    }
+    printf("\n%s checks FAILED (%d)\n", name, failures());
+    return 1;
+}
+
+} // namespace Test
+} // namespace MinimalUI
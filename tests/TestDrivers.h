@@ -0,0 +1,113 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include "GraphicsDriver.h"
+
+namespace MinimalUI {
+namespace Test {
+
+/**
+ * @brief RGB565内存帧缓冲区，统计各类绘制调用
+ * 只实现组件和缓存实际用到的图元，其余图元为空操作
+ */
+class RasterDriver : public GraphicsDriver {
+public:
+    RasterDriver(int16_t w, int16_t h) : pixels(static_cast<size_t>(w) * h), w_(w), h_(h) {
+        clear(Colors::BLACK);
+    }
+
+    std::vector<Color> pixels;
+    uint32_t fills = 0;
+    uint32_t bitmaps = 0;
+    const Color* last_bitmap = nullptr;   // 最近一次drawBitmap读取的像素
+
+    bool initialize() override { return true; }
+    void drawPixel(int16_t x, int16_t y, Color color) override {
+        if (x >= 0 && x < w_ && y >= 0 && y < h_) {
+            pixels[y * w_ + x] = color;
+        }
+    }
+    void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, Color color) override {
+        fills++;
+        for (int16_t j = y; j < y + h; j++) {
+            for (int16_t i = x; i < x + w; i++) {
+                drawPixel(i, j, color);
+            }
+        }
+    }
+    void drawBitmap(int16_t x, int16_t y, int16_t w, int16_t h, const Color* data) override {
+        bitmaps++;
+        last_bitmap = data;
+        for (int16_t j = 0; j < h; j++) {
+            for (int16_t i = 0; i < w; i++) {
+                drawPixel(x + i, y + j, data[j * w + i]);
+            }
+        }
+    }
+    void drawHLine(int16_t x, int16_t y, int16_t w, Color color) override { fillRect(x, y, w, 1, color); }
+    void drawVLine(int16_t x, int16_t y, int16_t h, Color color) override { fillRect(x, y, 1, h, color); }
+    void drawLine(int16_t, int16_t, int16_t, int16_t, Color) override {}
+    void drawRect(int16_t x, int16_t y, int16_t w, int16_t h, Color color) override {
+        drawHLine(x, y, w, color);
+        drawHLine(x, y + h - 1, w, color);
+        drawVLine(x, y, h, color);
+        drawVLine(x + w - 1, y, h, color);
+    }
+    void drawCircle(int16_t, int16_t, int16_t, Color) override {}
+    void fillCircle(int16_t, int16_t, int16_t, Color) override {}
+    void display() override {}
+    void clear(Color color) override {
+        for (Color& pixel : pixels) {
+            pixel = color;
+        }
+    }
+    int16_t width() const override { return w_; }
+    int16_t height() const override { return h_; }
+
+    Color at(int x, int y) const { return pixels[y * w_ + x]; }
+
+    // 颜色为color的像素数
+    int count(Color color) const {
+        int n = 0;
+        for (Color pixel : pixels) {
+            n += pixel == color;
+        }
+        return n;
+    }
+
+private:
+    int16_t w_;
+    int16_t h_;
+};
+
+/**
+ * @brief 只统计填充像素数的驱动
+ */
+class NullDriver : public GraphicsDriver {
+public:
+    NullDriver(int16_t w, int16_t h) : w_(w), h_(h) {}
+
+    uint64_t pixels = 0;
+
+    bool initialize() override { return true; }
+    void drawPixel(int16_t, int16_t, Color) override { pixels++; }
+    void fillRect(int16_t, int16_t, int16_t w, int16_t h, Color) override { pixels += w * h; }
+    void drawHLine(int16_t, int16_t, int16_t w, Color) override { pixels += w; }
+    void drawVLine(int16_t, int16_t, int16_t h, Color) override { pixels += h; }
+    void drawLine(int16_t, int16_t, int16_t, int16_t, Color) override {}
+    void drawRect(int16_t, int16_t, int16_t, int16_t, Color) override {}
+    void drawCircle(int16_t, int16_t, int16_t, Color) override {}
+    void fillCircle(int16_t, int16_t, int16_t, Color) override {}
+    void display() override {}
+    void clear(Color) override {}
+    int16_t width() const override { return w_; }
+    int16_t height() const override { return h_; }
+
+private:
+    int16_t w_;
+    int16_t h_;
+};
+
+} // namespace Test
+} // namespace MinimalUI
@@ -0,0 +1,148 @@
+#include <cstdio>
+#include <cstdlib>
+#include "Animation.h"
+#include "FixedMath.h"
+#include "TestCheck.h"
+
+using namespace MinimalUI;
+using FixedMath::Q14_ONE;
+using Test::check;
+
+static const Easing ALL_EASINGS[] = {
+    Easing::LINEAR,        Easing::EASE_IN_QUAD,   Easing::EASE_OUT_QUAD,     Easing::EASE_IN_OUT_QUAD,
+    Easing::EASE_IN_CUBIC, Easing::EASE_OUT_CUBIC, Easing::EASE_IN_OUT_CUBIC, Easing::EASE_IN_OUT_SINE,
+};
+
+// 记录写回的属性值和写回次数
+class Probe : public Component {
+public:
+    uint32_t value_writes = 0;
+    uint32_t color_writes = 0;
+    int32_t value = -1;
+    Color color = 0;
+
+    Probe() : Component(0, 0, 10, 10) {}
+
+    void render(GraphicsDriver*) override {}
+    void setValue(int32_t v) override {
+        value_writes++;
+        value = v;
+    }
+    void setColor(Color c) override {
+        color_writes++;
+        color = c;
+    }
+};
+
+static void runEasing() {
+    printf("Q14 easing\n");
+    bool endpoints = true;
+    bool monotonic = true;
+    for (Easing easing : ALL_EASINGS) {
+        endpoints = endpoints && ease(easing, 0) == 0 && ease(easing, Q14_ONE) == Q14_ONE &&
+                    ease(easing, -100) == 0 && ease(easing, Q14_ONE + 100) == Q14_ONE;
+        int32_t previous = 0;
+        for (int32_t t = 0; t <= Q14_ONE; t += 64) {
+            const int32_t v = ease(easing, t);
+            monotonic = monotonic && v >= previous && v <= Q14_ONE;
+            previous = v;
+        }
+    }
+    check(endpoints, "every curve maps 0 -> 0 and 1 -> 1, out-of-range t clamped");
+    check(monotonic, "every curve is monotonic and stays within [0, 1]");
+
+    const int32_t half = Q14_ONE / 2;
+    check(ease(Easing::LINEAR, 1234) == 1234 && ease(Easing::EASE_IN_QUAD, half) == Q14_ONE / 4 &&
+          ease(Easing::EASE_OUT_QUAD, half) == Q14_ONE * 3 / 4 && ease(Easing::EASE_IN_CUBIC, half) == Q14_ONE / 8 &&
+          ease(Easing::EASE_OUT_CUBIC, half) == Q14_ONE * 7 / 8, "quadratic and cubic values at t = 0.5");
+
+    // 对称的缓入缓出曲线：f(t) + f(1 - t) = 1，中点为0.5
+    const Easing in_out[] = {Easing::EASE_IN_OUT_QUAD, Easing::EASE_IN_OUT_CUBIC, Easing::EASE_IN_OUT_SINE};
+    bool symmetric = true;
+    for (Easing easing : in_out) {
+        symmetric = symmetric && abs(ease(easing, half) - half) <= 1;
+        for (int32_t t = 0; t <= Q14_ONE; t += 256) {
+            symmetric = symmetric && abs(ease(easing, t) + ease(easing, Q14_ONE - t) - Q14_ONE) <= 2;
+        }
+    }
+    check(symmetric, "in-out curves are point-symmetric about (0.5, 0.5)");
+
+    // 正弦表按1度插值，与浮点结果相差不超过千分之一
+    const int32_t quarter = ease(Easing::EASE_IN_OUT_SINE, Q14_ONE / 4);   // (1 - cos 45°) / 2 = 0.14645
+    check(abs(quarter - 2399) <= 16, "sine in-out at t = 0.25");
+
+    check(lerpColor(Colors::RED, Colors::BLUE, 0) == Colors::RED &&
+          lerpColor(Colors::RED, Colors::BLUE, Q14_ONE) == Colors::BLUE &&
+          lerpColor(Colors::BLACK, Colors::WHITE, half) == ((15 << 11) | (31 << 5) | 15),
+          "colour interpolation per RGB565 channel");
+}
+
+static void runAnimator() {
+    printf("\nAnimator\n");
+    Animator animator;
+    Probe probe;
+
+    const int8_t handle = animator.start(&probe, TweenProperty::VALUE, 0, 1000, 1000, Easing::LINEAR, 100);
+    check(handle >= 0 && probe.value == 0 && probe.value_writes == 1 && animator.busy(), "start writes the start value");
+
+    animator.update(600);
+    check(probe.value == 500, "value follows elapsed time");
+    // 渲染循环卡顿时直接跳到应处的位置
+    animator.update(850);
+    check(probe.value == 750 && probe.value_writes == 3, "a late update skips the missed frames");
+    check(animator.update(5000) == 0 && probe.value == 1000 && !animator.isActive(handle) && !animator.busy(),
+          "finished tween lands exactly on the end value");
+
+    // 值没有变化的帧不写回，组件不会被标记为脏
+    animator.start(&probe, TweenProperty::VALUE, 0, 2, 1000, Easing::LINEAR, 0);
+    const uint32_t writes = probe.value_writes;
+    animator.update(10);
+    animator.update(20);
+    animator.update(30);
+    check(probe.value_writes == writes, "unchanged values are not written back");
+
+    // 同一组件同一属性的补间被替换，而不是并行运行
+    const int8_t first = animator.start(&probe, TweenProperty::VALUE, 0, 100, 100, Easing::LINEAR, 0);
+    const int8_t second = animator.start(&probe, TweenProperty::VALUE, 50, 60, 100, Easing::LINEAR, 0);
+    animator.update(100);
+    check(first == second && probe.value == 60 && !animator.busy(), "restarting a property replaces its tween");
+
+    // 时钟回绕
+    animator.start(&probe, TweenProperty::VALUE, 0, 1024, 1024, Easing::LINEAR, 0xFFFFFF00u);
+    animator.update(0x100);
+    check(probe.value == 512, "elapsed time survives a 32-bit clock wrap");
+    animator.cancel(&probe);
+    animator.update(0x1000);
+    check(probe.value == 512 && !animator.busy(), "cancel keeps the current value");
+
+    animator.start(&probe, TweenProperty::VALUE, 0, 7, 0, Easing::EASE_OUT_CUBIC, 0);
+    animator.update(0);
+    check(probe.value == 7 && !animator.busy(), "zero duration jumps to the end value");
+
+    animator.start(&probe, TweenProperty::COLOR, Colors::BLACK, Colors::WHITE, 100, Easing::LINEAR, 0);
+    animator.update(50);
+    check(probe.color == ((15 << 11) | (31 << 5) | 15) && probe.color_writes == 2, "colour tweens interpolate channels");
+    animator.cancel(&probe);
+
+    animator.start(&probe, TweenProperty::X, 10, 30, 100, Easing::LINEAR, 0);
+    animator.start(&probe, TweenProperty::WIDTH, 10, 20, 100, Easing::LINEAR, 0);
+    animator.update(50);
+    check(probe.getX() == 20 && probe.getWidth() == 15 && probe.getY() == 0 && probe.getHeight() == 10,
+          "geometry tweens keep the other coordinate");
+    animator.cancel(&probe);
+
+    Probe probes[Animator::MAX_TWEENS + 1];
+    bool started = true;
+    for (uint8_t i = 0; i < Animator::MAX_TWEENS; i++) {
+        started = started && animator.start(&probes[i], TweenProperty::VALUE, 0, 1, 10, Easing::LINEAR, 0) >= 0;
+    }
+    check(started && animator.start(&probes[Animator::MAX_TWEENS], TweenProperty::VALUE, 0, 1, 10, Easing::LINEAR, 0) < 0 &&
+          animator.start(nullptr, TweenProperty::VALUE, 0, 1, 10, Easing::LINEAR, 0) < 0,
+          "full table and null target rejected");
+}
+
+int main() {
+    runEasing();
+    runAnimator();
+    return Test::finish("animation");
+}
@@ -0,0 +1,138 @@
+#include <cstdio>
+#include <cstring>
+#include <vector>
+#include "AssetPack.h"
+#include "AssetPackBuilder.h"
+#include "TestCheck.h"
+#include "TestDrivers.h"
+
+using namespace MinimalUI;
+using Test::check;
+
+enum AssetId : uint16_t {
+    ASSET_FONT = 0,
+    ASSET_FONT_PROPORTIONAL = 1,
+    ASSET_ICON_RGB = 2,
+    ASSET_ICON_MONO = 3,
+};
+
+static bool inside(const AssetPack& pack, const void* pointer) {
+    const uint8_t* p = static_cast<const uint8_t*>(pointer);
+    return p >= pack.data() && p < pack.data() + pack.size();
+}
+
+// 用两个字体绘制同一段文本，比较结果
+static bool sameText(const Font& a, const Font& b, const char* text) {
+    static Test::RasterDriver first(128, 64);
+    static Test::RasterDriver second(128, 64);
+    first.clear(Colors::BLACK);
+    second.clear(Colors::BLACK);
+    first.setFont(&a);
+    second.setFont(&b);
+    first.drawText(2, 2, text, Colors::WHITE, Colors::BLUE);
+    second.drawText(2, 2, text, Colors::WHITE, Colors::BLUE);
+    first.drawText(2, 20, text, Colors::YELLOW, Colors::YELLOW, 2);
+    second.drawText(2, 20, text, Colors::YELLOW, Colors::YELLOW, 2);
+    return first.pixels == second.pixels;
+}
+
+// 资源包拷贝到4字节对齐的缓冲区，修改后用openMemory()校验
+static bool accepts(const std::vector<uint8_t>& bytes, size_t size, void (*corrupt)(uint8_t* data)) {
+    std::vector<uint32_t> copy((bytes.size() + 3) / 4);
+    uint8_t* data = reinterpret_cast<uint8_t*>(copy.data());
+    memcpy(data, bytes.data(), bytes.size());
+    if (corrupt) {
+        corrupt(data);
+    }
+    AssetPack pack;
+    return pack.openMemory(data, size);
+}
+
+static AssetEntry* entryAt(uint8_t* data, uint16_t id) {
+    const AssetPackHeader* header = reinterpret_cast<const AssetPackHeader*>(data);
+    return reinterpret_cast<AssetEntry*>(data + header->index_offset) + id;
+}
+
+int main() {
+    const char* path = "assets.bin";
+
+    // 16x16 RGB565渐变图标和12x12单色图标（MSB为最左像素）
+    Color icon[16 * 16];
+    for (int i = 0; i < 16 * 16; i++) {
+        icon[i] = static_cast<Color>(((i % 16) << 11) | ((i / 16) << 6) | 0x1F);
+    }
+    uint8_t mono[2 * 12];
+    for (int row = 0; row < 12; row++) {
+        const uint16_t bits = static_cast<uint16_t>(row == 0 || row == 11 ? 0xFFF0 : 0x8010 | (0x4000 >> row));
+        mono[row * 2] = static_cast<uint8_t>(bits >> 8);
+        mono[row * 2 + 1] = static_cast<uint8_t>(bits);
+    }
+
+    printf("Build and map\n");
+    AssetPackBuilder builder;
+    builder.addFont(FONT_5X7);
+    builder.addFont(FONT_5X7_PROPORTIONAL);
+    builder.addImage(16, 16, PixelFormat::RGB565, icon);
+    builder.addImage(12, 12, PixelFormat::MONO1, mono);
+    check(builder.write(path), "pack written");
+
+    AssetPack pack;
+    check(pack.open(path) && pack.count() == 4, "pack mapped with 4 assets");
+    printf("  %s: %zu bytes\n", path, pack.size());
+
+    Font font{};
+    Font proportional{};
+    Image rgb{};
+    Image bits{};
+    check(pack.font(ASSET_FONT, font) && pack.font(ASSET_FONT_PROPORTIONAL, proportional) &&
+          pack.image(ASSET_ICON_RGB, rgb) && pack.image(ASSET_ICON_MONO, bits), "lookup by ID");
+    check(inside(pack, font.bitmap) && !font.spacing && inside(pack, proportional.spacing) &&
+          inside(pack, rgb.data) && inside(pack, bits.data), "fonts and images point into the mapping");
+    check(!pack.image(ASSET_FONT, rgb) && !pack.font(ASSET_ICON_RGB, font) && !pack.entry(4),
+          "wrong type and unknown ID rejected");
+    pack.font(ASSET_FONT, font);
+    pack.image(ASSET_ICON_RGB, rgb);
+
+    printf("Draw from the mapping\n");
+    check(sameText(font, FONT_5X7, "Temp 23.5\xC2\xB0" "C ~{}") &&
+          sameText(proportional, FONT_5X7_PROPORTIONAL, "Illuminate 1024 lx"),
+          "mapped fonts render like the built-in fonts");
+
+    Test::RasterDriver driver(128, 64);
+    driver.drawImage(10, 10, rgb);
+    bool same = driver.last_bitmap == reinterpret_cast<const Color*>(rgb.data);
+    for (int i = 0; i < 16 * 16 && same; i++) {
+        same = driver.at(10 + i % 16, 10 + i / 16) == icon[i];
+    }
+    check(same, "RGB565 blit reads pixels straight from the mapping");
+
+    driver.clear(Colors::BLUE);
+    driver.drawImage(40, 10, bits, Colors::WHITE, Colors::WHITE);
+    same = true;
+    for (int row = 0; row < 12; row++) {
+        for (int col = 0; col < 12; col++) {
+            const bool on = (mono[row * 2 + col / 8] >> (7 - col % 8)) & 1;
+            same = same && driver.at(40 + col, 10 + row) == (on ? Colors::WHITE : Colors::BLUE);
+        }
+    }
+    check(same, "MONO1 image with transparent background");
+
+    printf("Validation\n");
+    const std::vector<uint8_t> bytes = builder.build();
+    check(accepts(bytes, bytes.size(), nullptr), "intact pack accepted");
+    check(!accepts(bytes, bytes.size(), [](uint8_t* data) { data[0] ^= 0xFF; }), "bad magic rejected");
+    check(!accepts(bytes, bytes.size(), [](uint8_t* data) {
+        reinterpret_cast<AssetPackHeader*>(data)->version = ASSET_PACK_VERSION + 1;
+    }), "unknown version rejected");
+    check(!accepts(bytes, bytes.size() - 4, nullptr), "truncated pack rejected");
+    check(!accepts(bytes, bytes.size(), [](uint8_t* data) { entryAt(data, ASSET_ICON_RGB)->offset += 2; }),
+          "misaligned asset rejected");
+    check(!accepts(bytes, bytes.size(), [](uint8_t* data) { entryAt(data, ASSET_ICON_MONO)->height = 400; }),
+          "image larger than its data rejected");
+    check(!accepts(bytes, bytes.size(), [](uint8_t* data) {
+        reinterpret_cast<AssetFontHeader*>(data + entryAt(data, ASSET_FONT)->offset)->last = 0xFF;
+    }), "font glyph table out of bounds rejected");
+    check(!AssetPack().open("/nonexistent/assets.bin"), "missing file rejected");
+
+    return Test::finish("asset pack");
+}
@@ -0,0 +1,233 @@
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "BusArbiter.h"
+#include "DisplayTransport.h"
+#include "SSD1309Controller.h"
+#include "TestCheck.h"
+
+using namespace MinimalUI;
+using Test::check;
+
+namespace {
+
+// 总线上发生的事件
+struct BusEvent {
+    enum Type { FRAME_BEGIN, TRANSFER, FRAME_END } type;
+    int8_t device;
+    int8_t owner;    // 事件发生时仲裁器记录的持有者
+    bool in_frame;   // 传输是否在该设备的beginFrame()/endFrame()之内
+};
+
+// 两个控制器共享的总线：一个仲裁器和按时间顺序记录的事件
+struct SharedBus {
+    BusArbiter arbiter;
+    std::mutex mutex;
+    std::vector<BusEvent> events;
+
+    void record(BusEvent::Type type, int8_t device, bool in_frame) {
+        std::lock_guard<std::mutex> lock(mutex);
+        events.push_back(BusEvent{type, device, arbiter.owner(), in_frame});
+    }
+};
+
+/**
+ * 模拟传输：与ESP32_SPI_Driver相同，最外层beginFrame()申请总线，帧外的单次发送自成一帧。
+ * 每次传输占用一段真实时间，使另一个控制器有机会在帧内开始等待。
+ */
+class MockTransport : public DisplayTransport {
+public:
+    MockTransport(SharedBus& bus) : bus_(bus), id_(bus.arbiter.registerDevice()) {}
+
+    int8_t id() const { return id_; }
+
+    // 释放总线前等待对端进入等待状态（对端仍有帧要发送时），使轮询交接不依赖线程调度
+    void setPeer(int8_t peer, const std::atomic<bool>* peer_active) {
+        peer_ = peer;
+        peer_active_ = peer_active;
+    }
+
+    void sendCommand(uint8_t) override { transfer(1); }
+    void sendData(uint8_t) override { transfer(1); }
+    void sendBuffer(const uint8_t*, size_t size) override { transfer(size); }
+    void sendCommands(const uint8_t*, size_t count) override { transfer(count); }
+
+    void beginFrame() override {
+        if (depth_++ > 0) {
+            return;
+        }
+        bus_.arbiter.acquire(id_);
+        bus_.record(BusEvent::FRAME_BEGIN, id_, true);
+    }
+
+    void endFrame() override {
+        if (depth_ == 0 || --depth_ > 0) {
+            return;
+        }
+        bus_.record(BusEvent::FRAME_END, id_, true);
+        if (peer_active_) {
+            const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+            while (peer_active_->load() && !bus_.arbiter.waiting(peer_) &&
+                   std::chrono::steady_clock::now() < deadline) {
+                std::this_thread::yield();
+            }
+        }
+        bus_.arbiter.release(id_);
+    }
+
+private:
+    SharedBus& bus_;
+    int8_t id_;
+    int8_t peer_ = -1;
+    const std::atomic<bool>* peer_active_ = nullptr;
+    uint16_t depth_ = 0;
+
+    void transfer(size_t bytes) {
+        const bool in_frame = depth_ > 0;
+        beginFrame();
+        bus_.record(BusEvent::TRANSFER, id_, in_frame);
+        std::this_thread::sleep_for(std::chrono::microseconds(20 + bytes / 16));
+        endFrame();
+    }
+};
+
+} // namespace
+
+// 两个SSD1309控制器在各自线程中不断刷新，检查帧不交错且两者轮流使用总线
+static void runSharedBus() {
+    printf("Two controllers on one bus\n");
+    const int FRAMES = 40;
+
+    SharedBus bus;
+    MockTransport transport_a(bus);
+    MockTransport transport_b(bus);
+    SSD1309Controller controller_a{SSD1309Config{}};
+    SSD1309Controller controller_b{SSD1309Config{}};
+    check(transport_a.id() >= 0 && transport_b.id() >= 0 && transport_a.id() != transport_b.id(),
+          "both devices registered");
+    check(controller_a.initialize(&transport_a) && controller_b.initialize(&transport_b), "controllers initialized");
+    bus.events.clear();
+
+    std::atomic<bool> active_a{true};
+    std::atomic<bool> active_b{true};
+    transport_a.setPeer(transport_b.id(), &active_b);
+    transport_b.setPeer(transport_a.id(), &active_a);
+
+    auto run = [FRAMES](SSD1309Controller& controller, std::atomic<bool>& active) {
+        for (int i = 0; i < FRAMES; i++) {
+            // 每帧整屏翻转，每页都要重新发送
+            controller.fillBufferRect(0, 0, controller.getWidth(), controller.getHeight(),
+                                      (i & 1) ? Colors::BLACK : Colors::WHITE);
+            controller.refresh();
+        }
+        active.store(false);
+    };
+    std::thread thread_a(run, std::ref(controller_a), std::ref(active_a));
+    std::thread thread_b(run, std::ref(controller_b), std::ref(active_b));
+    thread_a.join();
+    thread_b.join();
+
+    // 帧不交错：帧内的每个事件都属于当前帧的设备，且该设备持有总线
+    uint32_t outside_frame = 0;
+    uint32_t interleaved = 0;
+    uint32_t frames[2] = {};
+    int8_t current = -1;
+    std::vector<int8_t> order;
+    for (const BusEvent& event : bus.events) {
+        if (!event.in_frame) {
+            outside_frame++;
+        }
+        if (event.owner != event.device) {
+            interleaved++;
+        }
+        switch (event.type) {
+        case BusEvent::FRAME_BEGIN:
+            if (current >= 0) {
+                interleaved++;
+            }
+            current = event.device;
+            order.push_back(event.device);
+            frames[event.device == transport_a.id() ? 0 : 1]++;
+            break;
+        case BusEvent::TRANSFER:
+            if (event.device != current) {
+                interleaved++;
+            }
+            break;
+        case BusEvent::FRAME_END:
+            if (event.device != current) {
+                interleaved++;
+            }
+            current = -1;
+            break;
+        }
+    }
+    check(frames[0] == FRAMES && frames[1] == FRAMES, "every refresh is one frame");
+    check(outside_frame == 0, "controller sends everything inside beginFrame/endFrame");
+    check(interleaved == 0, "frames never interleave");
+
+    // 轮流：两个设备都还有帧要发送时，同一设备不会连续获得总线
+    uint32_t repeats = 0;
+    int remaining[2] = {FRAMES, FRAMES};
+    for (size_t i = 0; i < order.size(); i++) {
+        const int index = order[i] == transport_a.id() ? 0 : 1;
+        if (i > 0 && order[i] == order[i - 1] && remaining[1 - index] > 0) {
+            repeats++;
+        }
+        remaining[index]--;
+    }
+    check(repeats == 0, "devices take turns while both are busy");
+}
+
+// 三个设备时按轮询顺序而不是申请顺序交接
+static void runRoundRobin() {
+    printf("Round-robin order\n");
+    BusArbiter arbiter;
+    const int8_t a = arbiter.registerDevice();
+    const int8_t b = arbiter.registerDevice();
+    const int8_t c = arbiter.registerDevice();
+
+    std::mutex mutex;
+    std::vector<int8_t> grants;
+    auto take = [&](int8_t id) {
+        BusArbiter::Lock lock(arbiter, id);
+        std::lock_guard<std::mutex> guard(mutex);
+        grants.push_back(id);
+    };
+    auto waitFor = [&](int8_t id) {
+        while (!arbiter.waiting(id)) {
+            std::this_thread::yield();
+        }
+    };
+
+    arbiter.acquire(a);
+    arbiter.acquire(a);   // 嵌套申请不阻塞
+    std::thread thread_c(take, c);
+    waitFor(c);
+    std::thread thread_b(take, b);
+    waitFor(b);
+    arbiter.release(a);
+    check(arbiter.owner() == a, "nested acquire keeps the bus until the outer release");
+    arbiter.release(a);
+    thread_b.join();
+    thread_c.join();
+    check(grants.size() == 2 && grants[0] == b && grants[1] == c, "b before c although c asked first");
+    check(arbiter.owner() == -1, "bus idle after the last release");
+
+    // 未注册的设备不会获得总线，也不会阻塞
+    const int8_t unused = static_cast<int8_t>(BusArbiter::MAX_DEVICES - 1);
+    arbiter.acquire(unused);
+    check(arbiter.owner() == -1 && !arbiter.waiting(unused), "acquire with an unregistered id returns at once");
+    arbiter.release(unused);
+    arbiter.unregisterDevice(c);
+    arbiter.acquire(c);
+    check(arbiter.owner() == -1, "acquire after unregisterDevice returns at once");
+}
+
+int main() {
+    runSharedBus();
+    runRoundRobin();
+    return Test::finish("bus arbiter");
+}
@@ -0,0 +1,169 @@
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include "Chart.h"
+#include "Linux_SPI_Driver.h"
+#include "SSD1309Controller.h"
+#include "TestCheck.h"
+
+using namespace MinimalUI;
+using MinimalUI::Components::Chart;
+using MinimalUI::Components::ChartStats;
+using Test::check;
+
+static const int16_t CHART_X = 20;
+static const int16_t CHART_Y = 13;   // 上下边缘都不在页边界，覆盖按行掩码合并的路径
+static const int16_t CHART_W = 100;
+static const int16_t CHART_H = 46;
+
+// 记录写入/dev/null的SSD1309驱动，只关心帧缓冲区内容
+static std::unique_ptr<Linux_SPI_Driver> makeDriver() {
+    Linux_SPI_Config config;
+    config.device = "/dev/null";
+    config.capture = true;
+    std::unique_ptr<Linux_SPI_Driver> driver(
+        new Linux_SPI_Driver(config, std::unique_ptr<DisplayController>(new SSD1309Controller(SSD1309Config{}))));
+    if (!driver->initialize()) {
+        return nullptr;
+    }
+    return driver;
+}
+
+static const uint8_t* frameBuffer(Linux_SPI_Driver& driver) {
+    return static_cast<SSD1309Controller*>(driver.controller())->getFrameBuffer();
+}
+
+// 正弦波加噪声，偶尔超出纵轴范围以覆盖截断
+static int16_t wave(uint32_t n) {
+    static uint32_t seed = 1;
+    seed = seed * 1103515245u + 12345u;
+    if (n % 97 == 0) {
+        return 130;
+    }
+    return static_cast<int16_t>(50 + 40 * std::sin(n * 0.15) + static_cast<int32_t>((seed >> 16) % 17) - 8);
+}
+
+/**
+ * 同一组采样分别用增量绘制和每次整区重绘（repaint）画到两个帧缓冲区，逐帧比较
+ */
+static void runMatch(const char* label, int16_t x, uint16_t window, int per_render, bool expect_shift) {
+    auto incremental = makeDriver();
+    auto reference = makeDriver();
+    if (!check(incremental && reference, "capture drivers initialized")) {
+        return;
+    }
+    Chart chart(x, CHART_Y, CHART_W, CHART_H, 0, 100);
+    Chart expected(x, CHART_Y, CHART_W, CHART_H, 0, 100);
+    chart.setWindow(window);
+    expected.setWindow(window);
+
+    const size_t size = SSD1309Config{}.width * SSD1309Config{}.height / 8;
+    int mismatched_frames = 0;
+    uint32_t n = 0;
+    for (int tick = 0; tick < 400; tick++) {
+        for (int i = 0; i < per_render; i++) {
+            const int16_t value = wave(n++);
+            chart.push(value);
+            expected.push(value);
+        }
+        chart.render(incremental.get());
+        incremental->display();
+        expected.repaint();
+        expected.render(reference.get());
+        mismatched_frames += memcmp(frameBuffer(*incremental), frameBuffer(*reference), size) != 0;
+    }
+
+    const ChartStats& stats = chart.stats();
+    char text[128];
+    snprintf(text, sizeof(text), "%s: %u samples/column, %d of 400 frames differ, %u shifts, %u full redraws",
+             label, chart.samplesPerColumn(), mismatched_frames, static_cast<unsigned>(stats.shifts),
+             static_cast<unsigned>(stats.full_redraws));
+    bool ok = mismatched_frames == 0;
+    if (expect_shift) {
+        ok = ok && stats.full_redraws == 1 && stats.shifts > 0;
+    } else {
+        ok = ok && stats.shifts == 0;
+    }
+    check(ok, text);
+
+    // 第一帧整区绘制，之后每个采样一列
+    if (expect_shift && per_render == 1) {
+        snprintf(text, sizeof(text), "%s: %u columns rasterized for %u later samples", label,
+                 static_cast<unsigned>(stats.columns_drawn - CHART_W), static_cast<unsigned>(n - 1));
+        check(stats.columns_drawn - CHART_W == n - 1, text);
+    }
+}
+
+// 每列合并4个采样时，列中间的单个尖峰仍应画到顶端
+static void runDecimation() {
+    auto driver = makeDriver();
+    if (!check(driver != nullptr, "capture driver initialized")) {
+        return;
+    }
+    Chart chart(CHART_X, CHART_Y, CHART_W, CHART_H, 0, 100);
+    chart.setWindow(CHART_W * 4);
+    for (int i = 0; i < 40; i++) {
+        chart.push(i == 21 ? 100 : 50);
+        chart.render(driver.get());
+    }
+
+    const uint8_t* buffer = frameBuffer(*driver);
+    const int16_t width = SSD1309Config{}.width;
+    int top = 0;
+    for (int16_t x = CHART_X; x < CHART_X + CHART_W; x++) {
+        top += (buffer[(CHART_Y / 8) * width + x] >> (CHART_Y % 8)) & 1;
+    }
+    check(chart.samplesPerColumn() == 4 && top == 1, "min/max decimation keeps a one-sample spike");
+}
+
+// 隐藏后绘图区恢复为背景色，重新显示时完整重绘
+static void runHide() {
+    auto driver = makeDriver();
+    if (!check(driver != nullptr, "capture driver initialized")) {
+        return;
+    }
+    Chart chart(CHART_X, CHART_Y, CHART_W, CHART_H, 0, 100);
+    for (uint32_t n = 0; n < 60; n++) {
+        chart.push(wave(n));
+    }
+    chart.render(driver.get());
+
+    const size_t size = SSD1309Config{}.width * SSD1309Config{}.height / 8;
+    const uint8_t* buffer = frameBuffer(*driver);
+    std::unique_ptr<uint8_t[]> shown(new uint8_t[size]);
+    memcpy(shown.get(), buffer, size);
+    bool any = false;
+    for (size_t i = 0; i < size; i++) {
+        any = any || buffer[i] != 0;
+    }
+
+    chart.setVisible(false);
+    chart.render(driver.get());
+    bool blank = true;
+    for (size_t i = 0; i < size; i++) {
+        blank = blank && buffer[i] == 0;
+    }
+    check(any && blank, "hidden chart erased with its background");
+
+    const uint32_t redraws = chart.stats().full_redraws;
+    chart.setVisible(true);
+    chart.render(driver.get());
+    check(memcmp(buffer, shown.get(), size) == 0 && chart.stats().full_redraws == redraws + 1,
+          "shown again with a full redraw");
+}
+
+int main() {
+    printf("Incremental vs full redraw (SSD1309 128x64, %dx%d plot)\n", CHART_W, CHART_H);
+    runMatch("1 sample/render", CHART_X, CHART_W, 1, true);
+    runMatch("decimated, 1 sample/render", CHART_X, CHART_W * 2, 1, true);
+    runMatch("decimated, 3 samples/render", CHART_X, CHART_W * 2, 3, true);
+    runMatch("clipped at left edge", -10, CHART_W, 1, false);
+
+    printf("\nDecimation\n");
+    runDecimation();
+
+    printf("\nVisibility\n");
+    runHide();
+    return Test::finish("chart");
+}
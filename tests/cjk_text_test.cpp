@@ -0,0 +1,317 @@
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <utility>
+#include <vector>
+#include "AssetPack.h"
+#include "AssetPackBuilder.h"
+#include "BdfFont.h"
+#include "GlyphCache.h"
+#include "Label.h"
+#include "TestCheck.h"
+#include "TestDrivers.h"
+
+using namespace MinimalUI;
+using MinimalUI::Components::Label;
+using Test::check;
+
+// 应用的全部界面文本，资源包只包含其中用到的字符
+static const char* const APP_TEXTS[] = {
+    "\xE6\xB8\xA9\xE5\xBA\xA6",                          // 温度
+    "\xE6\xB9\xBF\xE5\xBA\xA6",                          // 湿度
+    "\xE8\xAE\xBE\xE7\xBD\xAE",                          // 设置
+    "\xE8\xBF\x94\xE5\x9B\x9E",                          // 返回
+    "\xE7\x94\xB5\xE6\xB1\xA0\xE7\x94\xB5\xE9\x87\x8F",  // 电池电量
+    "\xE6\xB8\xA9\xE5\xBA\xA6 25\xC2\xB0" "C",           // 温度 25°C
+    "\xF0\x9F\x98\x80",                                  // 表情符号，字体中没有
+};
+
+static const char* const TEMPERATURE = "\xE6\xB8\xA9\xE5\xBA\xA6";  // 温度
+
+// 模拟主机上的完整CJK字体：12x12，覆盖U+4E00~U+9FFF，字形由码点确定
+class SyntheticFont : public GlyphSource {
+public:
+    static constexpr uint32_t FIRST = 0x4E00;
+    static constexpr uint32_t LAST = 0x9FFF;
+
+    uint8_t width() const override { return 12; }
+    uint8_t height() const override { return 12; }
+    uint8_t advance() const override { return 12; }
+
+    static bool pixel(uint32_t codepoint, int x, int y) {
+        if (x >= 11 || y >= 11) {
+            return false;   // 右侧和底部留一列（行）字间距
+        }
+        if (x == 0 || y == 0 || x == 10 || y == 10) {
+            return true;
+        }
+        uint32_t hash = (codepoint * 2654435761u) ^ static_cast<uint32_t>(y * 977 + x * 131);
+        hash ^= hash >> 13;
+        return (hash * 0x5bd1e995u) >> 31;
+    }
+
+    bool render(uint32_t codepoint, uint8_t* pages) const override {
+        if (codepoint < FIRST || codepoint > LAST) {
+            return false;
+        }
+        for (int y = 0; y < 12; y++) {
+            for (int x = 0; x < 12; x++) {
+                if (pixel(codepoint, x, y)) {
+                    pages[(y / 8) * 12 + x] |= static_cast<uint8_t>(1 << (y % 8));
+                }
+            }
+        }
+        return true;
+    }
+};
+
+// 8x8字符格、原点在左下角上方1行的BDF字体，两个字形
+static const char* const BDF_TEXT =
+    "STARTFONT 2.1\n"
+    "FONT -test-\n"
+    "SIZE 8 75 75\n"
+    "FONTBOUNDINGBOX 8 8 0 -1\n"
+    "CHARS 3\n"
+    "STARTCHAR uni4E00\n"
+    "ENCODING 19968\n"
+    "DWIDTH 8 0\n"
+    "BBX 8 1 0 3\n"
+    "BITMAP\n"
+    "FF\n"
+    "ENDCHAR\n"
+    "STARTCHAR uni4E2D\n"
+    "ENCODING 20013\n"
+    "DWIDTH 8 0\n"
+    "BBX 3 8 2 -1\n"
+    "BITMAP\n"
+    "40\n40\nE0\nA0\nE0\n40\n40\n40\n"
+    "ENDCHAR\n"
+    "STARTCHAR unencoded\n"
+    "ENCODING -1\n"
+    "DWIDTH 9 0\n"
+    "BBX 1 1 0 0\n"
+    "BITMAP\n"
+    "80\n"
+    "ENDCHAR\n"
+    "ENDFONT\n";
+
+// 依次解码整个字符串
+static std::vector<uint32_t> decode(const char* text) {
+    std::vector<uint32_t> out;
+    for (uint32_t cp = Font::nextCodepoint(text); cp != 0; cp = Font::nextCodepoint(text)) {
+        out.push_back(cp);
+    }
+    return out;
+}
+
+static bool decodesTo(const char* text, std::vector<uint32_t> expected) {
+    return decode(text) == expected;
+}
+
+// (x, y)处的size倍字形是否与源字体一致
+static bool matchesSource(const Test::RasterDriver& driver, int x, int y, uint32_t codepoint, Color color, Color bg,
+                          int size = 1) {
+    for (int row = 0; row < 12 * size; row++) {
+        for (int col = 0; col < 12 * size; col++) {
+            const bool on = SyntheticFont::pixel(codepoint, col / size, row / size);
+            if (driver.at(x + col, y + row) != (on ? color : bg)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+static void runDecoding() {
+    printf("UTF-8 decoding\n");
+    check(decodesTo("A\xC2\xB0\xE4\xB8\xAD\xF0\x9F\x98\x80", {0x41, 0xB0, 0x4E2D, 0x1F600}),
+          "1-, 2-, 3- and 4-byte sequences");
+    check(decodesTo("\xC0\xAF" "A", {Font::REPLACEMENT, Font::REPLACEMENT, 'A'}) &&
+          decodesTo("\xE0\x80\xAF" "A", {Font::REPLACEMENT, 'A'}),
+          "overlong encodings rejected");
+    check(decodesTo("\xE4\xB8" "A", {Font::REPLACEMENT, 'A'}) && decodesTo("\xF0\x9F\x98", {Font::REPLACEMENT}),
+          "truncated sequence keeps the next character");
+    check(decodesTo("\xED\xA0\x80", {Font::REPLACEMENT}) && decodesTo("\xF4\x90\x80\x80", {Font::REPLACEMENT}),
+          "surrogates and code points above U+10FFFF rejected");
+    const char* legacy = "25\xC2\xB0" "C\xE4\xB8\xAD";
+    uint8_t codes[5];
+    for (uint8_t& code : codes) {
+        code = Font::nextCode(legacy);
+    }
+    check(codes[0] == '2' && codes[1] == '5' && codes[2] == Font::DEGREE && codes[3] == 'C' && codes[4] == '?',
+          "nextCode() keeps the built-in font mapping");
+}
+
+// 按应用文本裁剪字体写入资源包，返回映射后的字形集
+static bool runSubset(AssetPack& pack, GlyphSet& glyphs) {
+    printf("\nSubset the font\n");
+    const size_t text_count = sizeof(APP_TEXTS) / sizeof(APP_TEXTS[0]);
+    const std::vector<uint32_t> used = AssetPackBuilder::collectCodepoints(APP_TEXTS, text_count);
+    // 温度湿设置返回电池量 + ° + 表情符号
+    check(used.size() == 12, "12 distinct non-ASCII code points in the app texts");
+
+    SyntheticFont source;
+    AssetPackBuilder builder;
+    builder.addFont(FONT_5X7);
+    std::vector<uint32_t> missing;
+    const int glyph_id = builder.addGlyphs(source, used, &missing);
+    check(glyph_id == 1 && missing.size() == 2 && missing[0] == 0xB0 && missing[1] == 0x1F600,
+          "characters the font lacks reported as missing");
+    check(builder.write("cjk.bin"), "pack written");
+    if (!check(pack.open("cjk.bin") && pack.glyphs(static_cast<uint16_t>(glyph_id), glyphs) && glyphs.count == 10 &&
+               glyphs.width == 12 && glyphs.height == 12, "glyph set mapped with 10 glyphs")) {
+        return false;
+    }
+
+    bool found = true;
+    for (uint32_t cp : used) {
+        const bool expected = cp != 0xB0 && cp != 0x1F600;
+        found = found && (glyphs.find(cp) >= 0) == expected;
+    }
+    check(found && glyphs.find(0x4E00) < 0 && glyphs.find(0) < 0 && glyphs.find(0xFFFFFFFF) < 0,
+          "binary search finds exactly the used characters");
+
+    AssetPackBuilder unsorted;
+    unsorted.addGlyphs(source, {0x6E29, 0x4E2D, 0x6E29});
+    std::vector<uint8_t> bytes = unsorted.build();
+    const AssetEntry* entry = reinterpret_cast<const AssetEntry*>(bytes.data() + sizeof(AssetPackHeader));
+    uint32_t* table = reinterpret_cast<uint32_t*>(bytes.data() + entry->offset + sizeof(AssetGlyphHeader));
+    AssetPack check_pack;
+    const bool sorted_ok = check_pack.openMemory(bytes.data(), bytes.size());
+    std::swap(table[0], table[1]);
+    check(sorted_ok && table[1] == 0x4E2D && !check_pack.openMemory(bytes.data(), bytes.size()),
+          "builder sorts code points, unsorted tables rejected");
+    return true;
+}
+
+static void runBdf() {
+    printf("\nBDF source\n");
+    BdfFont bdf;
+    FILE* out = fopen("cjk.bdf", "wb");
+    if (out) {
+        fputs(BDF_TEXT, out);
+        fclose(out);
+    }
+    check(bdf.load("cjk.bdf") && bdf.count() == 2 && bdf.width() == 8 && bdf.height() == 8 && bdf.advance() == 8,
+          "BDF parsed: 2 encoded glyphs in an 8x8 cell");
+    uint8_t pages[8] = {};
+    bdf.render(0x4E2D, pages);
+    // 中：第2~4列，竖线在第3列，第2~4行为方框（方框中间一行不含竖线）
+    const uint8_t expected[8] = {0x00, 0x00, 0x1C, 0xF7, 0x1C, 0x00, 0x00, 0x00};
+    uint8_t line[8] = {};
+    bdf.render(0x4E00, line);
+    check(memcmp(pages, expected, sizeof(pages)) == 0 && line[0] == 0x08 && line[7] == 0x08,
+          "glyphs placed by BBX offsets relative to the baseline");
+    check(!bdf.parse("STARTFONT 2.1\nENDFONT\n") && bdf.count() == 0, "font without glyphs rejected");
+}
+
+static void runDraw(GlyphCache& cache) {
+    printf("\nDraw through the glyph cache\n");
+    Test::RasterDriver driver(160, 64);
+    driver.setGlyphCache(&cache);
+    const int16_t end = driver.drawText(2, 2, APP_TEXTS[5], Colors::WHITE, Colors::BLUE);
+    // 温度各12像素，空格、2、5、°、C各6像素
+    check(end == 2 + 2 * 12 + 5 * 6 && driver.measureText(APP_TEXTS[5]) == end - 2,
+          "mixed text advances and measures consistently");
+    check(matchesSource(driver, 2, 2, 0x6E29, Colors::WHITE, Colors::BLUE) &&
+          matchesSource(driver, 14, 2, 0x5EA6, Colors::WHITE, Colors::BLUE), "CJK glyphs match the source font");
+    bool padded = true;
+    for (int y = 10; y < 14; y++) {
+        padded = padded && driver.at(26, y) == Colors::BLUE;
+    }
+    check(driver.lineHeight() == 12 && padded, "ASCII cells padded to the 12-pixel line height");
+    check(cache.stats().misses == 2 && cache.stats().hits == 0, "first draw loads 2 glyphs from flash");
+
+    const uint32_t bitmaps = driver.bitmaps;
+    driver.drawText(2, 2, APP_TEXTS[5], Colors::WHITE, Colors::BLUE);
+    check(cache.stats().misses == 2 && cache.stats().hits == 2 && driver.bitmaps == bitmaps + 2,
+          "second draw is two cached bitmap blits");
+
+    driver.clear(Colors::BLACK);
+    driver.drawText(0, 20, TEMPERATURE, Colors::GREEN, Colors::GREEN, 2);
+    check(matchesSource(driver, 0, 20, 0x6E29, Colors::GREEN, Colors::BLACK, 2) && cache.stats().rejected == 2,
+          "scaled and transparent text drawn straight from the glyph set");
+    driver.clear(Colors::BLACK);
+    driver.drawText(0, 0, TEMPERATURE, Colors::RED, Colors::RED);
+    check(matchesSource(driver, 0, 0, 0x6E29, Colors::RED, Colors::BLACK) && cache.stats().misses == 4,
+          "transparent glyphs cached as separate MONO1 masks");
+}
+
+static void runLru(const GlyphSet& glyphs) {
+    printf("\nLRU\n");
+    static GlyphCache lru(glyphs);
+    for (uint32_t i = 0; i < glyphs.count; i++) {
+        Image image;
+        lru.lookup(glyphs.codepoints[i], Colors::WHITE, static_cast<Color>(i), image);
+    }
+    check(lru.stats().misses == glyphs.count && lru.stats().evictions == 0, "distinct entries fill free slots");
+    for (uint32_t i = 0; i < GlyphCache::MAX_ENTRIES + 3; i++) {
+        Image image;
+        lru.lookup(glyphs.codepoints[i % glyphs.count], Colors::WHITE, static_cast<Color>(0x100 + i), image);
+    }
+    check(lru.stats().evictions == glyphs.count + 3, "full cache evicts the least recently used entry");
+    Image image;
+    lru.resetCounters();
+    const uint32_t last = GlyphCache::MAX_ENTRIES + 2;
+    lru.lookup(glyphs.codepoints[last % glyphs.count], Colors::WHITE, static_cast<Color>(0x100 + last), image);
+    lru.lookup(glyphs.codepoints[0], Colors::WHITE, 0, image);
+    check(lru.stats().hits == 1 && lru.stats().misses == 1, "recent entry kept, oldest one reloaded");
+    check(!lru.lookup(0x4E00, Colors::WHITE, Colors::BLACK, image) && !lru.hasGlyph(0x4E00),
+          "code points outside the subset are not cached");
+}
+
+static void runLabel(GlyphCache& cache) {
+    printf("\nLabel\n");
+    Test::RasterDriver incremental(160, 64);
+    Test::RasterDriver fresh(160, 64);
+    incremental.setGlyphCache(&cache);
+    fresh.setGlyphCache(&cache);
+    Label label(4, 30, 120, 16, APP_TEXTS[5]);
+    label.render(&incremental);
+    label.setText("\xE6\xB9\xBF\xE5\xBA\xA6 26\xC2\xB0" "C");  // 湿度 26°C
+    const uint32_t before = cache.stats().hits + cache.stats().misses;
+    label.render(&incremental);
+    const uint32_t redrawn = cache.stats().hits + cache.stats().misses - before;
+    Label reference(4, 30, 120, 16, label.getText());
+    reference.render(&fresh);
+    check(incremental.pixels == fresh.pixels, "incremental CJK label update matches a full redraw");
+    check(redrawn == 1, "only the changed CJK cell redrawn");
+    check(label.preferredSize(&incremental) == Size{54, 12}, "preferred size uses the CJK line height");
+
+    // 文本按字节截断：容量为MAX_LENGTH / 3个汉字
+    std::string cjk;
+    for (int i = 0; i < Label::MAX_LENGTH / 3; i++) {
+        cjk += "\xE6\xB8\xA9";   // 温
+    }
+    label.setText(cjk.c_str());
+    check(strlen(label.getText()) == cjk.size(), "MAX_LENGTH / 3 CJK characters fit into a label");
+}
+
+// 更换字形集后同一地址的GlyphSet内容改变，驱动的测量缓存不能返回旧宽度
+static void runSwapGlyphs(const GlyphSet& glyphs) {
+    printf("\nSwap the glyph set\n");
+    Test::RasterDriver driver(160, 64);
+    GlyphCache cache(glyphs);
+    driver.setGlyphCache(&cache);
+    const int16_t with_glyphs = driver.measureText(TEMPERATURE);
+    cache.setGlyphs(GlyphSet{nullptr, nullptr, 0, 0, 0, 0});
+    const int16_t without = driver.measureText(TEMPERATURE);
+    cache.setGlyphs(glyphs);
+    check(with_glyphs == 24 && without == 2 * driver.font().advance(Font::codeFor(0x6E29)) &&
+          driver.measureText(TEMPERATURE) == 24, "setGlyphs() invalidates cached text widths");
+}
+
+int main() {
+    runDecoding();
+    runBdf();
+    AssetPack pack;
+    GlyphSet glyphs{};
+    if (runSubset(pack, glyphs)) {
+        static GlyphCache cache(glyphs);
+        runDraw(cache);
+        runLru(glyphs);
+        runLabel(cache);
+        runSwapGlyphs(glyphs);
+    }
+    return Test::finish("CJK text");
+}
@@ -0,0 +1,72 @@
+#include <cstring>
+#include <string>
+#include "Label.h"
+#include "ProgressBar.h"
+#include "TestCheck.h"
+#include "TestDrivers.h"
+
+using namespace MinimalUI;
+using MinimalUI::Components::Label;
+using MinimalUI::Components::ProgressBar;
+using Test::check;
+
+static void runLabel() {
+    printf("Label\n");
+    Test::RasterDriver driver(128, 32);
+    Label label(0, 0, 128, 16);
+
+    // 超长文本截断后再次设置同一文本，不应重绘
+    const std::string ascii(Label::MAX_LENGTH + 8, 'x');
+    label.setText(ascii.c_str());
+    check(strlen(label.getText()) == Label::MAX_LENGTH, "ASCII text truncated to MAX_LENGTH");
+    label.render(&driver);
+    label.setText(ascii.c_str());
+    check(!label.isDirty(), "same over-long ASCII text does not invalidate");
+
+    // 截断落在多字节字符中间时退回到字符边界，比较应使用截断后的长度
+    std::string cjk;
+    while (cjk.size() <= Label::MAX_LENGTH) {
+        cjk += "\xE6\xB8\xA9";   // 温
+    }
+    label.setText(cjk.c_str());
+    const size_t kept = strlen(label.getText());
+    check(kept <= Label::MAX_LENGTH && kept % 3 == 0, "UTF-8 text truncated at a character boundary");
+    label.render(&driver);
+    label.setText(cjk.c_str());
+    check(!label.isDirty(), "same over-long UTF-8 text does not invalidate");
+
+    label.setText(cjk.substr(0, kept - 3).c_str());
+    check(label.isDirty(), "shorter prefix invalidates");
+}
+
+static void runProgressBar() {
+    printf("ProgressBar\n");
+    Test::RasterDriver driver(64, 16);
+    ProgressBar bar(4, 4, 40, 8, Colors::BLUE, Colors::WHITE, Colors::RED);
+    bar.setValue(ProgressBar::MAX_VALUE / 2);
+    bar.render(&driver);
+    check(driver.count(Colors::BLUE) > 0 && driver.count(Colors::RED) > 0, "bar drawn");
+
+    // 隐藏后边框、轨道和进度都被屏幕背景色覆盖，不留下轨道色的色块
+    bar.setVisible(false);
+    bar.render(&driver);
+    check(driver.count(Colors::BLUE) == 0 && driver.count(Colors::RED) == 0 && driver.count(Colors::WHITE) == 0 &&
+          driver.count(Colors::BLACK) == 64 * 16, "hidden bar erased with the screen background");
+
+    bar.setEraseColor(Colors::GREEN);
+    bar.setVisible(true);
+    bar.render(&driver);
+    bar.setVisible(false);
+    bar.render(&driver);
+    check(driver.count(Colors::GREEN) == 40 * 8 && driver.count(Colors::WHITE) == 0, "custom erase colour");
+
+    bar.setVisible(true);
+    bar.render(&driver);
+    check(driver.count(Colors::RED) > 0 && !bar.isDirty(), "shown again with a full redraw");
+}
+
+int main() {
+    runLabel();
+    runProgressBar();
+    return Test::finish("components");
+}
@@ -0,0 +1,264 @@
+#include <cstdio>
+#include <vector>
+#include "Compositor.h"
+#include "PixelKernels.h"
+#include "TestCheck.h"
+#include "TestDrivers.h"
+
+using namespace MinimalUI;
+using Test::check;
+
+static const int16_t W = 64;
+static const int16_t H = 48;
+
+// 固定种子的xorshift，结果可复现
+static uint32_t nextRandom() {
+    static uint32_t state = 0x9E3779B9;
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return state;
+}
+
+// 逐通道的标量混合：d + floor((s - d) * a / 32)，a取0~32
+static Color referenceBlend(Color s, Color d, uint32_t a) {
+    auto channel = [a](int32_t sc, int32_t dc) { return dc + (((sc - dc) * static_cast<int32_t>(a)) >> 5); };
+    const int32_t r = channel(s >> 11, d >> 11);
+    const int32_t g = channel((s >> 5) & 0x3F, (d >> 5) & 0x3F);
+    const int32_t b = channel(s & 0x1F, d & 0x1F);
+    return static_cast<Color>((r << 11) | (g << 5) | b);
+}
+
+/**
+ * @brief 逐像素的参考合成，不经过PixelKernels
+ * 与Compositor相同的规则：背景色打底，图层按顺序自下而上
+ */
+static Color referencePixel(int16_t x, int16_t y, Color background, const Layer* const* layers, int count) {
+    Color out = background;
+    for (int i = 0; i < count; i++) {
+        const Layer& layer = *layers[i];
+        if (!layer.visible || !layer.bounds().contains(x, y)) {
+            continue;
+        }
+        const int32_t offset = static_cast<int32_t>(y - layer.y) * layer.w + (x - layer.x);
+        const Color src = layer.pixels ? layer.pixels[offset] : layer.color;
+        switch (layer.mode) {
+        case BlendMode::OPAQUE:
+            out = src;
+            break;
+        case BlendMode::COLOR_KEY:
+            out = layer.pixels && src == layer.key ? out : src;
+            break;
+        case BlendMode::ALPHA:
+            if (layer.opacity == 0) {
+                break;
+            }
+            if (!layer.pixels && layer.opacity == 255) {
+                out = src;
+            } else if (layer.alpha) {
+                const uint32_t a = (layer.alpha[offset] * (layer.opacity + 1u)) >> 8;
+                out = referenceBlend(src, out, PixelKernels::alpha5(a));
+            } else {
+                out = referenceBlend(src, out, PixelKernels::alpha5(layer.opacity));
+            }
+            break;
+        }
+    }
+    return out;
+}
+
+static bool matchesReference(const Test::RasterDriver& driver, const Rect& area, Color background,
+                             const Layer* const* layers, int count) {
+    for (int16_t y = area.y; y < area.bottom(); y++) {
+        for (int16_t x = area.x; x < area.right(); x++) {
+            if (driver.at(x, y) != referencePixel(x, y, background, layers, count)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+static Layer solid(int16_t x, int16_t y, int16_t w, int16_t h, Color color) {
+    Layer layer;
+    layer.color = color;
+    layer.x = x;
+    layer.y = y;
+    layer.w = w;
+    layer.h = h;
+    return layer;
+}
+
+static void runOrder() {
+    printf("Layer order\n");
+    Test::RasterDriver driver(W, H);
+    std::vector<Color> band(W * H);
+    Compositor compositor(Colors::BLUE);
+    const int8_t red = compositor.addLayer(solid(0, 0, 30, 30, Colors::RED));
+    const int8_t green = compositor.addLayer(solid(10, 10, 30, 30, Colors::GREEN));
+    compositor.addLayer(solid(20, 20, 30, 20, Colors::WHITE));
+    compositor.render(driver, band.data(), band.size());
+    check(driver.at(5, 5) == Colors::RED && driver.at(15, 15) == Colors::GREEN && driver.at(25, 25) == Colors::WHITE &&
+          driver.at(45, 5) == Colors::BLUE, "later layers drawn on top, background elsewhere");
+    check(driver.at(0, 0) == Colors::RED && driver.at(55, 45) == Colors::BLACK,
+          "only the damaged area is composed");
+
+    compositor.removeLayer(green);
+    compositor.render(driver, band.data(), band.size());
+    check(driver.at(15, 15) == Colors::RED && driver.at(35, 15) == Colors::BLUE && driver.at(25, 25) == Colors::WHITE,
+          "removing a layer reveals the layers below");
+
+    // 移除后新加入的图层占用空出的ID，但叠放在最上层
+    const int8_t top = compositor.addLayer(solid(0, 0, 8, 8, Colors::YELLOW));
+    compositor.render(driver, band.data(), band.size());
+    check(top == green && driver.at(4, 4) == Colors::YELLOW, "new layer reuses the free id and goes on top");
+
+    Layer hidden = *compositor.layer(red);
+    hidden.visible = false;
+    compositor.updateLayer(red, hidden);
+    compositor.render(driver, band.data(), band.size());
+    check(driver.at(15, 15) == Colors::BLUE && driver.at(4, 4) == Colors::YELLOW, "hidden layer skipped");
+}
+
+static void runClip() {
+    printf("\nClip and banding\n");
+    Test::RasterDriver driver(W, H);
+    std::vector<Color> band(W * H);
+    Compositor compositor(Colors::BLUE);
+    compositor.addLayer(solid(-10, -5, 40, 30, Colors::RED));   // 部分在屏幕外
+    compositor.addLayer(solid(50, 40, 30, 30, Colors::GREEN));
+
+    // 裁剪区外是驱动直接绘制的内容，合成器不能覆盖
+    driver.clear(Colors::MAGENTA);
+    const Rect clip = {5, 3, 41, 29};
+    driver.pushClip(clip);
+    check(compositor.render(driver, band.data(), band.size()), "render inside a clip");
+    driver.popClip();
+    bool outside = true;
+    bool inside = true;
+    for (int16_t y = 0; y < H; y++) {
+        for (int16_t x = 0; x < W; x++) {
+            if (!clip.contains(x, y)) {
+                outside = outside && driver.at(x, y) == Colors::MAGENTA;
+            } else {
+                inside = inside && driver.at(x, y) == (x < 30 && y < 25 ? Colors::RED : Colors::BLUE);
+            }
+        }
+    }
+    check(outside, "pixels outside the clip untouched");
+    check(inside, "layers partly off screen composed inside the clip");
+
+    // 条带缓冲区小于损坏区时分多次输出，结果与一次输出相同
+    Test::RasterDriver banded(W, H);
+    Test::RasterDriver whole(W, H);
+    compositor.invalidate(Rect{0, 0, W, H});
+    compositor.render(whole, band.data(), band.size());
+    const uint32_t whole_bitmaps = whole.bitmaps;
+    compositor.invalidate(Rect{0, 0, W, H});
+    compositor.render(banded, band.data(), W * 5 + 7);
+    check(whole_bitmaps == 1 && banded.bitmaps == (H + 4) / 5 && banded.pixels == whole.pixels,
+          "5-row bands give the same frame as one full band");
+
+    compositor.invalidate(Rect{0, 0, W, H});
+    check(!compositor.render(banded, band.data(), W - 1) && compositor.render(banded, band.data(), W),
+          "band smaller than one row rejected");
+
+    // 移动图层只重新合成新旧位置的包围盒
+    compositor.moveLayer(1, 40, 30);
+    const Rect damage = compositor.damage();
+    check(damage.x == 40 && damage.y == 30 && damage.right() == 80 && damage.bottom() == 70,
+          "move damages old and new bounds");
+    banded.bitmaps = 0;
+    compositor.render(banded, band.data(), band.size());
+    check(banded.bitmaps == 1 && banded.at(45, 35) == Colors::GREEN && banded.at(39, 35) == Colors::BLUE &&
+          compositor.damage().isEmpty(), "only the damaged area redrawn, damage cleared");
+}
+
+static void runBlending() {
+    printf("\nBlending\n");
+    // 奇数宽度和奇数起点，覆盖内核的向量主循环、像素对和尾部
+    std::vector<Color> sprite(37 * 21);
+    std::vector<Color> keyed(23 * 17);
+    std::vector<Color> overlay(41 * 19);
+    std::vector<uint8_t> alpha(41 * 19);
+    for (Color& pixel : sprite) {
+        pixel = static_cast<Color>(nextRandom());
+    }
+    for (Color& pixel : keyed) {
+        pixel = nextRandom() & 1 ? Colors::MAGENTA : static_cast<Color>(nextRandom());
+    }
+    for (size_t i = 0; i < overlay.size(); i++) {
+        overlay[i] = static_cast<Color>(nextRandom());
+        const uint32_t r = nextRandom();
+        alpha[i] = static_cast<uint8_t>((r & 0x300) == 0 ? 0 : (r & 0x300) == 0x100 ? 255 : r);
+    }
+
+    Layer layers[5];
+    layers[0] = solid(3, 1, 37, 21, Colors::BLACK);
+    layers[0].pixels = sprite.data();
+    layers[1] = solid(11, 9, 23, 17, Colors::BLACK);
+    layers[1].pixels = keyed.data();
+    layers[1].mode = BlendMode::COLOR_KEY;
+    layers[2] = solid(-7, 13, 41, 19, Colors::BLACK);
+    layers[2].pixels = overlay.data();
+    layers[2].alpha = alpha.data();
+    layers[2].mode = BlendMode::ALPHA;
+    layers[2].opacity = 200;
+    layers[3] = solid(25, 5, 39, 40, Colors::BLACK);
+    layers[3].pixels = nullptr;
+    layers[3].color = Colors::CYAN;
+    layers[3].mode = BlendMode::ALPHA;
+    layers[3].opacity = 77;
+    layers[4] = solid(30, 20, 37, 21, Colors::BLACK);
+    layers[4].pixels = sprite.data();
+    layers[4].mode = BlendMode::ALPHA;
+    layers[4].opacity = 128;
+    const Layer* stack[5] = {&layers[0], &layers[1], &layers[2], &layers[3], &layers[4]};
+
+    Test::RasterDriver driver(W, H);
+    std::vector<Color> band(W * 7);
+    Compositor compositor(static_cast<Color>(0x4208));
+    for (const Layer& layer : layers) {
+        compositor.addLayer(layer);
+    }
+    // 图层没有覆盖的行也要铺上背景色
+    const Rect screen = {0, 0, W, H};
+    compositor.invalidate(screen);
+    compositor.render(driver, band.data(), band.size());
+    check(matchesReference(driver, screen, 0x4208, stack, 5),
+          "opaque, colour key, per-pixel alpha, solid alpha and uniform alpha match the scalar reference");
+
+    // 整体不透明度为0的图层不参与，255的纯色图层直接覆盖
+    layers[4].opacity = 0;
+    layers[3].opacity = 255;
+    compositor.updateLayer(4, layers[4]);
+    compositor.updateLayer(3, layers[3]);
+    compositor.render(driver, band.data(), band.size());
+    check(matchesReference(driver, screen, 0x4208, stack, 5) && driver.at(50, 10) == Colors::CYAN,
+          "opacity 0 skipped, opaque solid layer covers");
+
+    // 裁剪到奇数位置的窄条，图层源偏移也跟着变化
+    layers[4].opacity = 90;
+    compositor.updateLayer(4, layers[4]);
+    driver.clear(Colors::BLACK);
+    const Rect clip = {13, 7, 9, 30};
+    driver.pushClip(clip);
+    compositor.invalidate(screen);
+    compositor.render(driver, band.data(), band.size());
+    driver.popClip();
+    check(matchesReference(driver, clip, 0x4208, stack, 5), "clipped composition matches the reference");
+}
+
+int main() {
+#if defined(__AVX2__)
+    printf("Kernels: AVX2 + SWAR\n");
+#elif defined(__SSE2__)
+    printf("Kernels: SSE2 + SWAR\n");
+#else
+    printf("Kernels: SWAR\n");
+#endif
+    runOrder();
+    runClip();
+    runBlending();
+    return Test::finish("compositor");
+}
@@ -0,0 +1,168 @@
+#include <cstdio>
+#include <cstdlib>
+#include "Dither.h"
+#include "TestCheck.h"
+
+using namespace MinimalUI;
+using Test::check;
+
+// 8位灰度转RGB565
+static Color grey(uint8_t v) {
+    return static_cast<Color>(((v >> 3) << 11) | ((v >> 2) << 5) | (v >> 3));
+}
+
+static int bits(uint8_t byte) {
+    int n = 0;
+    for (; byte; byte &= static_cast<uint8_t>(byte - 1)) {
+        n++;
+    }
+    return n;
+}
+
+// 8x8图案中点亮的像素数
+static int litPixels(MonoDither& dither, Color color) {
+    const uint8_t* pattern = dither.pattern(color);
+    int n = 0;
+    for (int col = 0; col < 8; col++) {
+        n += bits(pattern[col]);
+    }
+    return n;
+}
+
+static void runThreshold() {
+    printf("Threshold\n");
+    MonoDither dither(DitherMode::THRESHOLD);
+    check(luminance(Colors::BLACK) == 0 && luminance(Colors::WHITE) == 255, "black and white span the full range");
+
+    // 平坦灰度：亮度不超过127的整块全灭，高于127的整块全亮，没有图案
+    bool flat = true;
+    for (int v = 0; v < 256; v += 5) {
+        const Color color = grey(static_cast<uint8_t>(v));
+        const uint8_t expected = luminance(color) > 127 ? 0xFF : 0x00;
+        const uint8_t* pattern = dither.pattern(color);
+        for (int col = 0; col < 8; col++) {
+            flat = flat && pattern[col] == expected;
+        }
+    }
+    check(flat, "flat grey levels give all-off or all-on page bytes");
+
+    uint8_t lum[8] = {127, 128, 0, 255, 127, 128, 200, 50};
+    check(dither.pageByte(0, lum) == 0x6A && dither.pageByte(127, lum) == 0x6A,
+          "pageByte thresholds each row at 50% in every column");
+}
+
+static void runOrdered() {
+    printf("\nOrdered dither\n");
+    MonoDither bayer8(DitherMode::BAYER8);
+    MonoDither bayer4(DitherMode::BAYER4);
+
+    check(litPixels(bayer8, Colors::BLACK) == 0 && litPixels(bayer8, Colors::WHITE) == 64 &&
+          litPixels(bayer4, Colors::BLACK) == 0 && litPixels(bayer4, Colors::WHITE) == 64,
+          "pure black all off, pure white all on");
+
+    // 点亮比例随灰度单调增加，并与亮度成正比（误差不超过一个像素）
+    bool monotonic = true;
+    bool proportional = true;
+    int last = 0;
+    for (int v = 0; v < 256; v++) {
+        const Color color = grey(static_cast<uint8_t>(v));
+        const int lit = litPixels(bayer8, color);
+        monotonic = monotonic && lit >= last;
+        proportional = proportional && abs(lit - luminance(color) * 64 / 255) <= 1;
+        last = lit;
+    }
+    check(monotonic && proportional, "BAYER8: lit pixels track luminance over 65 levels");
+
+    // 4x4矩阵在8x8图案中重复：第x列与第x+4列相同，上下两个半页相同
+    bool periodic = true;
+    int levels = 0;
+    last = -1;
+    for (int v = 0; v < 256; v++) {
+        const uint8_t* pattern = bayer4.pattern(grey(static_cast<uint8_t>(v)));
+        for (int col = 0; col < 4; col++) {
+            periodic = periodic && pattern[col] == pattern[col + 4] && (pattern[col] >> 4) == (pattern[col] & 0x0F);
+        }
+        const int lit = litPixels(bayer4, grey(static_cast<uint8_t>(v)));
+        levels += lit != last ? 1 : 0;
+        last = lit;
+    }
+    check(periodic && levels == 17, "BAYER4: 4x4 tile repeats, 17 grey levels");
+
+    // 图案缓存按颜色和模式失效
+    const uint8_t before = bayer4.pattern(grey(100))[1];
+    bayer4.setMode(DitherMode::THRESHOLD);
+    check(bayer4.pattern(grey(100))[1] == 0x00 && before != 0x00, "setMode invalidates the cached pattern");
+}
+
+static void runEdges() {
+    printf("\nScreen and page edges\n");
+    // 有序抖动没有误差传播，边界处的要求是图案以屏幕坐标为基准连续：
+    // 任意一列上的页字节只取决于列号 & 7，跨页（第7行到第8行）按矩阵行继续
+    MonoDither dither(DitherMode::BAYER8);
+    const Color color = grey(96);
+    uint8_t lum[8];
+    for (uint8_t& l : lum) {
+        l = luminance(color);
+    }
+    const uint8_t* pattern = dither.pattern(color);
+    bool columns = true;
+    for (int16_t x = -16; x < 136; x++) {
+        columns = columns && dither.pageByte(x, lum) == pattern[x & 7];
+    }
+    check(columns, "page bytes match the solid pattern at columns 0, 127 and across 8-column tiles");
+    check(dither.pageByte(127, lum) == pattern[7] && dither.pageByte(128, lum) == pattern[0] &&
+          dither.pageByte(-1, lum) == pattern[7], "right screen edge continues the tile, negative columns wrap");
+
+    bool rows = true;
+    for (int16_t row = 0; row < 64; row++) {
+        for (int16_t x = 0; x < 8; x++) {
+            rows = rows && dither.threshold(x, row) == dither.threshold(x, row & 7) &&
+                   dither.threshold(x + 128, row) == dither.threshold(x, row);
+        }
+    }
+    check(rows, "thresholds repeat every page, so page boundaries do not seam");
+
+    // 一列内各行亮度不同：每一位只由本行亮度决定，不受相邻行影响
+    uint8_t column[8] = {0, 255, 0, 255, 0, 255, 0, 255};
+    check(dither.pageByte(0, column) == 0xAA && dither.pageByte(127, column) == 0xAA,
+          "neighbouring rows do not bleed into each other");
+}
+
+static void runGrey2() {
+    printf("\n4-level grey\n");
+    MonoDither dither(DitherMode::BAYER8);
+    bool exact = true;
+    bool adjacent = true;
+    for (int16_t row = 0; row < 8; row++) {
+        for (int16_t x = 0; x < 8; x++) {
+            exact = exact && dither.level2(0, x, row) == 0 && dither.level2(85, x, row) == 1 &&
+                    dither.level2(170, x, row) == 2 && dither.level2(255, x, row) == 3;
+            const uint8_t level = dither.level2(128, x, row);
+            adjacent = adjacent && (level == 1 || level == 2);
+        }
+    }
+    check(exact, "grey levels 0, 85, 170, 255 map to a single level without dithering");
+    check(adjacent, "in-between luminance mixes only the two neighbouring levels");
+
+    uint8_t lsb[8];
+    uint8_t msb[8];
+    dither.pattern2(Colors::WHITE, lsb, msb);
+    bool white = true;
+    for (int col = 0; col < 8; col++) {
+        white = white && lsb[col] == 0xFF && msb[col] == 0xFF;
+    }
+    dither.pattern2(Colors::BLACK, lsb, msb);
+    bool black = true;
+    for (int col = 0; col < 8; col++) {
+        black = black && lsb[col] == 0 && msb[col] == 0;
+    }
+    check(white && black, "pattern2 planes for black and white");
+}
+
+int main() {
+    runThreshold();
+    runOrdered();
+    runEdges();
+    runGrey2();
+    return Test::finish("dither");
+}
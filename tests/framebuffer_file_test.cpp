@@ -0,0 +1,70 @@
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include "Jetson_FB_Driver.h"
+#include "TestCheck.h"
+
+using namespace MinimalUI;
+using Test::check;
+
+// 两页在整个屏幕范围内是否逐字节相同
+static bool pagesMatch(const Jetson_FB_Driver& driver) {
+    if (!driver.doubleBuffered()) {
+        return true;
+    }
+    const size_t bytes = driver.stride() * driver.height();
+    return memcmp(driver.page(0), driver.page(1), bytes) == 0;
+}
+
+// 用普通文件代替/dev/fb0，校验像素、裁剪和双缓冲翻页
+static void runFramebuffer(const std::string& path, uint8_t bpp) {
+    printf("%u bpp, %s\n", bpp, path.c_str());
+    Jetson_FB_Config config;
+    config.device = path.c_str();
+    config.width = 320;
+    config.height = 240;
+    config.bpp = bpp;
+
+    Jetson_FB_Driver driver(config);
+    if (!check(driver.initialize(), "initialize regular file")) {
+        return;
+    }
+    check(driver.doubleBuffered() && driver.frontPage() == 0, "two pages, page 0 shown");
+
+    driver.fillRect(10, 10, 100, 50, Colors::RED);
+    driver.fillCircle(200, 120, 30, Colors::GREEN);
+    driver.drawLine(0, 239, 319, 0, Colors::WHITE);
+    Color bitmap[8 * 8];
+    for (int i = 0; i < 64; i++) {
+        bitmap[i] = (i & 1) ? Colors::BLUE : Colors::YELLOW;
+    }
+    driver.drawBitmap(316, 236, 8, 8, bitmap);  // 右下角部分超出屏幕，被裁剪
+
+    check(driver.readPixel(50, 30) == Colors::RED, "fillRect pixel");
+    check(driver.readPixel(200, 120) == Colors::GREEN, "fillCircle centre");
+    check(driver.readPixel(317, 236) == Colors::BLUE && driver.readPixel(316, 239) == Colors::YELLOW,
+          "clipped bitmap");
+
+    // 翻页后前台页为刚绘制的页，两页内容一致
+    driver.display();
+    check(driver.frontPage() == 1, "display() flips to page 1");
+    check(pagesMatch(driver), "dirty region copied to new back page");
+
+    // 增量绘制只修改后台页，翻页后再次一致
+    driver.fillRect(150, 200, 20, 20, Colors::CYAN);
+    check(!pagesMatch(driver), "incremental draw touches back page only");
+    driver.display();
+    check(driver.frontPage() == 0 && pagesMatch(driver), "second flip keeps pages in sync");
+
+    driver.scroll(10);
+    check(driver.readPixel(50, 20) == Colors::RED && driver.readPixel(50, 235) == Colors::BLACK,
+          "scroll moves rows and clears exposed lines");
+    driver.display();
+    check(pagesMatch(driver), "pages in sync after scroll");
+}
+
+int main() {
+    runFramebuffer("framebuffer16.raw", 16);
+    runFramebuffer("framebuffer32.raw", 32);
+    return Test::finish("framebuffer");
+}
@@ -0,0 +1,117 @@
+#include <cstdio>
+#include <vector>
+#include "IndexedFramebuffer.h"
+#include "TestCheck.h"
+
+using namespace MinimalUI;
+using Test::check;
+
+static const Color ORANGE = 0xFD20;   // 不在默认调色板中
+
+// 面板字节序（大端）RGB565
+static Color panelPixel(const uint8_t* bytes, int i) {
+    return static_cast<Color>((bytes[i * 2] << 8) | bytes[i * 2 + 1]);
+}
+
+// 按display()的方式刷新脏区：逐行展开后与调色板逐像素比较
+static bool flushMatches(const IndexedFramebuffer& fb) {
+    const Rect area = fb.dirty();
+    std::vector<uint8_t> row(static_cast<size_t>(area.w) * 2 + 2, 0xA5);
+    for (int16_t y = area.y; y < area.bottom(); y++) {
+        fb.expandRow(y, area.x, area.w, row.data());
+        for (int16_t i = 0; i < area.w; i++) {
+            if (panelPixel(row.data(), i) != fb.paletteEntry(fb.pixel(area.x + i, y))) {
+                return false;
+            }
+        }
+        // 不写出w个像素之外的字节
+        if (row[area.w * 2] != 0xA5 || row[area.w * 2 + 1] != 0xA5) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static void runPacking() {
+    printf("Packing\n");
+    IndexedFramebuffer fb4(15, 4, 4);
+    IndexedFramebuffer fb8(15, 4, 8);
+    IndexedFramebuffer fb1(15, 4, 1);
+    check(fb4.valid() && fb4.bpp() == 4 && fb4.bufferSize() == 8 * 4 && fb4.paletteSize() == 16 &&
+          fb8.bpp() == 8 && fb8.bufferSize() == 15 * 4 && fb8.paletteSize() == 256,
+          "4bpp rows round up to whole bytes, 8bpp one byte per pixel");
+    check(fb1.bpp() == 8 && fb1.bufferSize() == 15 * 4, "unsupported depths fall back to 8bpp");
+
+    // 奇数起点和终点：首尾各半个字节，高4位为左侧像素
+    fb4.fillRect(0, 0, 15, 4, 2);
+    fb4.fillRect(3, 1, 6, 1, 0x1B);
+    const uint8_t* row = fb4.data() + 8;
+    check(row[0] == 0x22 && row[1] == 0x2B && row[2] == 0xBB && row[3] == 0xBB && row[4] == 0xB2 && row[5] == 0x22,
+          "4bpp nibbles packed high-first, index masked to 4 bits");
+    bool rest = true;
+    for (int16_t x = 0; x < 15; x++) {
+        for (int16_t y = 0; y < 4; y++) {
+            const bool inside = y == 1 && x >= 3 && x < 9;
+            rest = rest && fb4.pixel(x, y) == (inside ? 0x0B : 2);
+        }
+    }
+    check(rest && fb4.pixel(-1, 0) == 0 && fb4.pixel(15, 0) == 0, "neighbouring pixels untouched, out of range reads 0");
+
+    fb8.fillRect(5, 2, 3, 2, 200);
+    check(fb8.pixel(5, 2) == 200 && fb8.pixel(7, 3) == 200 && fb8.pixel(4, 2) == 0 && fb8.pixel(8, 3) == 0,
+          "8bpp fill");
+}
+
+static void runPalette() {
+    printf("\nPalette lookup\n");
+    IndexedFramebuffer fb(16, 16, 4);
+    check(fb.paletteEntry(0) == Colors::BLACK && fb.paletteEntry(1) == Colors::WHITE &&
+          fb.indexOf(Colors::RED) == 2 && fb.indexOf(Colors::WHITE) == 1, "default palette, exact matches");
+
+    // 不在调色板中的颜色取最接近的一项
+    check(fb.indexOf(0xF801) == 2 && fb.indexOf(0x0841) == 0 && fb.indexOf(0xFFDF) == 1, "nearest colour");
+
+    // 修改调色板后，刚查询过的颜色不能命中旧的缓存结果
+    fb.indexOf(Colors::BLUE);
+    fb.setPaletteEntry(9, Colors::BLUE);
+    fb.setPaletteEntry(4, ORANGE);
+    check(fb.indexOf(Colors::BLUE) == 9 && fb.indexOf(ORANGE) == 4, "lookup cache invalidated by palette edits");
+
+    const Color ramp[] = {0x0000, 0x1111, 0x2222, 0x3333};
+    fb.setPalette(ramp, 4);
+    check(fb.paletteEntry(3) == 0x3333 && fb.paletteEntry(9) == Colors::BLUE, "setPalette replaces only count entries");
+}
+
+static void runDirtyAndFlush() {
+    printf("\nDirty tracking and flush\n");
+    IndexedFramebuffer fb(21, 10, 4);
+    fb.clearDirty();
+    fb.fillRect(3, 2, 4, 1, 1);
+    fb.fillRect(10, 6, 2, 3, 2);
+    const Rect dirty = fb.dirty();
+    check(dirty.x == 3 && dirty.y == 2 && dirty.w == 9 && dirty.h == 7, "dirty rectangle is the union of fills");
+    check(flushMatches(fb), "odd-aligned dirty rows expand to panel-order RGB565");
+
+    fb.clearDirty();
+    fb.setPaletteEntry(1, Colors::WHITE);
+    check(fb.dirty().isEmpty(), "unchanged palette entry does not dirty the screen");
+    fb.setPaletteEntry(1, Colors::YELLOW);
+    check(fb.dirty().w == 21 && fb.dirty().h == 10 && flushMatches(fb),
+          "palette change re-expands the whole screen without redrawing");
+
+    IndexedFramebuffer fb8(7, 3, 8);
+    fb8.fillRect(0, 0, 7, 3, fb8.indexOf(Colors::CYAN));
+    fb8.fillRect(1, 1, 5, 1, fb8.indexOf(Colors::MAGENTA));
+    uint8_t out[7 * 2];
+    fb8.expandRow(1, 0, 7, out);
+    check(panelPixel(out, 0) == Colors::CYAN && panelPixel(out, 1) == Colors::MAGENTA &&
+          panelPixel(out, 5) == Colors::MAGENTA && panelPixel(out, 6) == Colors::CYAN && flushMatches(fb8),
+          "8bpp rows expand through the LUT");
+}
+
+int main() {
+    runPacking();
+    runPalette();
+    runDirtyAndFlush();
+    return Test::finish("indexed framebuffer");
+}
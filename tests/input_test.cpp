@@ -0,0 +1,210 @@
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include "InputDriver.h"
+#include "TestCheck.h"
+
+using namespace MinimalUI;
+using Test::check;
+
+static InputEvent button(InputEventType type, uint8_t id, uint32_t time_ms = 0) {
+    return InputEvent{type, id, 0, 0, time_ms};
+}
+
+static void runQueue() {
+    printf("Event queue\n");
+    InputEventQueue queue;
+    InputEvent out[InputEventQueue::CAPACITY + 1];
+
+    // 环形队列留一个空位区分空和满
+    uint8_t accepted = 0;
+    for (uint8_t i = 0; i < InputEventQueue::CAPACITY; i++) {
+        accepted += queue.push(button(InputEventType::BUTTON_DOWN, i)) ? 1 : 0;
+    }
+    check(accepted == InputEventQueue::CAPACITY - 1 && queue.dropped() == 1, "overflow drops and counts the newest");
+
+    size_t n = queue.drain(out, 10);
+    bool ordered = n == 10;
+    n += queue.drain(out + n, sizeof(out) / sizeof(out[0]) - n);
+    for (size_t i = 0; i < n; i++) {
+        ordered = ordered && out[i].id == i;
+    }
+    check(ordered && n == InputEventQueue::CAPACITY - 1, "partial drains keep FIFO order");
+    check(queue.drain(out, 4) == 0 && queue.push(button(InputEventType::BUTTON_UP, 99)) &&
+          queue.drain(out, 4) == 1 && out[0].id == 99, "queue reusable after draining");
+
+    // 触摸移动只保留最新位置，排在同一帧的按下之后
+    queue.pushMove(1, 1, 10);
+    queue.push(InputEvent{InputEventType::TOUCH_DOWN, 0, 5, 6, 20});
+    queue.pushMove(7, 8, 21);
+    queue.pushMove(9, 10, 22);
+    n = queue.drain(out, 8);
+    check(n == 2 && out[0].type == InputEventType::TOUCH_DOWN && out[1].type == InputEventType::TOUCH_MOVE &&
+          out[1].x == 9 && out[1].y == 10 && out[1].time_ms == 22, "moves coalesce to the latest position");
+    check(queue.drain(out, 8) == 0, "no repeated move without a new sample");
+
+    // 缓冲区只够取按下时，移动留到下一次，不会排到按下前面
+    queue.push(InputEvent{InputEventType::TOUCH_UP, 0, 9, 10, 30});
+    queue.push(InputEvent{InputEventType::TOUCH_DOWN, 0, 50, 60, 40});
+    queue.pushMove(-3, 300, 41);
+    n = queue.drain(out, 2);
+    const bool deferred = n == 2 && out[1].type == InputEventType::TOUCH_DOWN;
+    n = queue.drain(out, 2);
+    check(deferred && n == 1 && out[0].type == InputEventType::TOUCH_MOVE && out[0].x == -3 && out[0].y == 300,
+          "move deferred until the queue is empty, negative coordinates kept");
+
+    queue.push(InputEvent{InputEventType::TOUCH_UP, 0, 0, 0, 50});
+    queue.pushMove(1, 2, 51);
+    n = queue.drain(out, 8);
+    check(n == 1 && out[0].type == InputEventType::TOUCH_UP, "moves after release are dropped");
+
+    // 生产者线程（代替中断）与消费者并发，不丢失、不乱序
+    InputEventQueue shared;
+    const uint32_t total = 20000;
+    std::thread producer([&shared] {
+        for (uint32_t i = 0; i < total; i++) {
+            while (!shared.push(InputEvent{InputEventType::ENCODER, 0, static_cast<int16_t>(i & 0x7FFF), 0, i})) {
+                std::this_thread::yield();
+            }
+        }
+    });
+    uint32_t expected = 0;
+    bool in_order = true;
+    while (expected < total && in_order) {
+        n = shared.drain(out, 8);
+        for (size_t i = 0; i < n; i++) {
+            in_order = in_order && out[i].time_ms == expected++;
+        }
+    }
+    producer.join();
+    check(in_order && expected == total, "concurrent producer: every event delivered in order");
+}
+
+static void runDebounce() {
+    printf("\nButton debounce\n");
+    ButtonDebouncer debouncer(5);
+    int changes = 0;
+    for (int i = 0; i < 4; i++) {
+        changes += debouncer.update(true);
+    }
+    const bool waited = changes == 0 && !debouncer.pressed();
+    check(waited && debouncer.update(true) && debouncer.pressed(), "press reported on the 5th stable sample");
+
+    // 接触抖动：按下、松开交替，计数来回摆动，不产生事件
+    changes = 0;
+    for (int i = 0; i < 50; i++) {
+        changes += debouncer.update(i % 2 == 0 ? false : true);
+    }
+    check(changes == 0 && debouncer.pressed(), "bouncing contact produces no events");
+
+    changes = 0;
+    int samples = 0;
+    while (debouncer.pressed() && samples < 20) {
+        changes += debouncer.update(false);
+        samples++;
+    }
+    check(changes == 1 && samples == 5, "release reported after 5 released samples");
+
+    ButtonDebouncer immediate(0);
+    check(immediate.update(true) && immediate.update(false), "zero samples treated as one");
+}
+
+// 依次输入两相电平序列，返回输出步数之和
+static int turn(QuadratureDecoder& decoder, const uint8_t* states, int count, int repeat = 1) {
+    int steps = 0;
+    for (int r = 0; r < repeat; r++) {
+        for (int i = 0; i < count; i++) {
+            steps += decoder.update(states[i] & 2, states[i] & 1);
+        }
+    }
+    return steps;
+}
+
+static void runQuadrature() {
+    printf("\nQuadrature decoder\n");
+    // AB: 00 -> 10 -> 11 -> 01 -> 00 为顺时针一格
+    const uint8_t cw[] = {2, 3, 1, 0};
+    const uint8_t ccw[] = {1, 3, 2, 0};
+    QuadratureDecoder decoder;
+    check(turn(decoder, cw, 4, 3) == 3, "clockwise: +1 per detent");
+    check(turn(decoder, ccw, 4, 2) == -2, "counter-clockwise: -1 per detent");
+
+    // 单相抖动：00 <-> 10 来回跳变相互抵消
+    const uint8_t bounce[] = {2, 0};
+    check(turn(decoder, bounce, 2, 20) == 0, "contact bounce cancels out");
+
+    // 两相同时变化的非法跳变不计数
+    const uint8_t illegal[] = {3, 0, 3, 0};
+    check(turn(decoder, illegal, 4, 10) == 0, "illegal transitions ignored");
+    const uint8_t half[] = {2, 3};
+    const uint8_t rest[] = {1, 0};
+    const int first = turn(decoder, half, 2);
+    // 半格之后的非法跳变不会清除已累计的四分之一步
+    decoder.update(false, false);
+    decoder.update(true, true);
+    check(first == 0 && turn(decoder, rest, 2) == 1, "illegal jump keeps the partial detent");
+
+    QuadratureDecoder fine(1);
+    check(turn(fine, cw, 4) == 4, "one step per quarter with steps_per_detent = 1");
+}
+
+// 三次采样相同
+static void touch(TouchFilter& filter, uint16_t rx, uint16_t ry, int16_t& x, int16_t& y) {
+    const uint16_t sx[3] = {rx, rx, rx};
+    const uint16_t sy[3] = {ry, ry, ry};
+    filter.update(sx, sy, x, y);
+}
+
+static void runTouchFilter() {
+    printf("\nTouch filter\n");
+    TouchFilter filter;
+    int16_t x = 0;
+    int16_t y = 0;
+    touch(filter, 2000, 1000, x, y);
+    check(x == 2000 && y == 1000, "first point after press is not smoothed");
+
+    // 单个尖峰被三点中值去掉
+    const uint16_t spike_x[3] = {2001, 4095, 1999};
+    const uint16_t spike_y[3] = {0, 1000, 1002};
+    filter.update(spike_x, spike_y, x, y);
+    check(abs(x - 2000) <= 1 && abs(y - 1000) <= 1, "median rejects a single-sample spike");
+
+    // ±8的抖动经低通后幅度明显减小
+    int16_t low = 32767;
+    int16_t high = -32768;
+    for (int i = 0; i < 40; i++) {
+        touch(filter, i % 2 ? 2008 : 1992, 1000, x, y);
+        if (i >= 10) {
+            low = x < low ? x : low;
+            high = x > high ? x : high;
+        }
+    }
+    check(high - low <= 6 && low >= 1995 && high <= 2005, "jitter attenuated by the low-pass filter");
+
+    int i = 0;
+    for (; i < 50 && x != 2500; i++) {
+        touch(filter, 2500, 1000, x, y);
+    }
+    check(x == 2500 && i > 1, "steady position reached after a move");
+
+    filter.reset();
+    touch(filter, 100, 3000, x, y);
+    check(x == 100 && y == 3000, "reset restarts without dragging from the last point");
+
+    // 反向、互换X/Y的校准
+    TouchFilter mapped(255);
+    mapped.setCalibration(TouchCalibration::fromRange(3900, 200, 300, 3800, 240, 320, true));
+    touch(mapped, 3900, 300, x, y);
+    mapped.reset();
+    const bool origin = x == 0 && y == 0;
+    touch(mapped, 200, 3800, x, y);
+    check(origin && abs(x - 239) <= 1 && abs(y - 319) <= 1, "calibration maps corners with swapped, inverted axes");
+}
+
+int main() {
+    runQueue();
+    runDebounce();
+    runQuadrature();
+    runTouchFilter();
+    return Test::finish("input");
+}
@@ -0,0 +1,154 @@
+#include <cstdio>
+#include "Label.h"
+#include "Layout.h"
+#include "Panel.h"
+#include "ProgressBar.h"
+#include "TestCheck.h"
+#include "TestDrivers.h"
+#include "WidgetPool.h"
+
+using namespace MinimalUI;
+using namespace MinimalUI::Components;
+using Test::check;
+
+using Pool = WidgetPool<>;
+using Handle = Pool::Handle;
+
+// 界面中需要访问的组件
+struct Screen {
+    Handle root, title, row, name, value, progress, body, buttons, ok, cancel;
+};
+
+static LayoutParams params(LayoutKind kind, SizeMode width_mode, SizeMode height_mode, uint8_t padding = 0,
+                           uint8_t gap = 0, LayoutAlign align = LayoutAlign::START) {
+    LayoutParams p;
+    p.kind = kind;
+    p.width_mode = width_mode;
+    p.height_mode = height_mode;
+    p.padding = padding;
+    p.gap = gap;
+    p.align = align;
+    return p;
+}
+
+// 没有任何手算坐标：所有组件以0尺寸创建，由布局引擎放置
+static Screen build(Pool& pool, LayoutEngine<Pool>& layout) {
+    Screen s;
+    s.root = pool.create<Panel>(Pool::NONE, 0, 0, 0, 0, Colors::BLACK);
+    layout.set(s.root, params(LayoutKind::COLUMN, SizeMode::FILL, SizeMode::FILL, 2, 2));
+
+    s.title = pool.create<Panel>(s.root, 0, 0, 0, 0, Colors::BLUE);
+    layout.set(s.title, params(LayoutKind::STACK, SizeMode::FILL, SizeMode::CONTENT, 1, 0, LayoutAlign::CENTER));
+    pool.create<Label>(s.title, 0, 0, 0, 0, "MinimalUI", Colors::WHITE, Colors::BLUE);
+
+    s.row = pool.create<Panel>(s.root, 0, 0, 0, 0, Colors::BLACK);
+    layout.set(s.row, params(LayoutKind::ROW, SizeMode::FILL, SizeMode::CONTENT, 0, 4, LayoutAlign::CENTER));
+    s.name = pool.create<Label>(s.row, 0, 0, 0, 0, "Temp");
+    s.value = pool.create<Label>(s.row, 0, 0, 0, 0, "23.4 C");
+    pool.get<Label>(s.value)->setAlign(Label::Align::RIGHT);
+    pool.get<Label>(s.value)->setTabularDigits(true);
+    layout.set(s.value, params(LayoutKind::NONE, SizeMode::FILL, SizeMode::CONTENT));
+
+    s.progress = pool.create<ProgressBar>(s.root, 0, 0, 0, 0);
+    LayoutParams bar = params(LayoutKind::NONE, SizeMode::FILL, SizeMode::FIXED);
+    bar.height = 6;
+    layout.set(s.progress, bar);
+
+    s.body = pool.create<Panel>(s.root, 0, 0, 0, 0, Colors::GRAY);
+    layout.set(s.body, params(LayoutKind::NONE, SizeMode::FILL, SizeMode::FILL));
+
+    s.buttons = pool.create<Panel>(s.root, 0, 0, 0, 0, Colors::BLACK);
+    layout.set(s.buttons, params(LayoutKind::ROW, SizeMode::FILL, SizeMode::CONTENT, 0, 2));
+    const Handle buttons[2] = {s.ok = pool.create<Panel>(s.buttons, 0, 0, 0, 0, Colors::GREEN, Colors::WHITE),
+                               s.cancel = pool.create<Panel>(s.buttons, 0, 0, 0, 0, Colors::RED, Colors::WHITE)};
+    const char* captions[2] = {"OK", "Cancel"};
+    for (int i = 0; i < 2; i++) {
+        LayoutParams button = params(LayoutKind::STACK, SizeMode::FILL, SizeMode::CONTENT, 2, 0, LayoutAlign::CENTER);
+        button.weight = static_cast<uint8_t>(i + 1);
+        layout.set(buttons[i], button);
+        Color bg = pool.get<Panel>(buttons[i])->getColor();
+        pool.create<Label>(buttons[i], 0, 0, 0, 0, captions[i], Colors::WHITE, bg);
+    }
+    return s;
+}
+
+static bool inside(const Rect& inner, const Rect& outer) {
+    return inner.x >= outer.x && inner.y >= outer.y && inner.right() <= outer.right() &&
+           inner.bottom() <= outer.bottom();
+}
+
+static Rect boundsOf(Pool& pool, Handle h) {
+    return pool.component(h)->bounds();
+}
+
+static void runProduct(int16_t width, int16_t height) {
+    printf("%dx%d\n", width, height);
+    Pool pool;
+    LayoutEngine<Pool> layout(pool);
+    Test::NullDriver driver(width, height);
+    const Rect screen{0, 0, width, height};
+    Screen s = build(pool, layout);
+
+    layout.update(&driver, screen);
+    pool.render(&driver);
+    const Rect root = boundsOf(pool, s.root);
+    check(root.x == 0 && root.y == 0 && root.w == width && root.h == height, "root fills the screen");
+
+    // 列中的子组件自上而下排列、互不重叠且都在屏幕内
+    const Handle column[5] = {s.title, s.row, s.progress, s.body, s.buttons};
+    bool ordered = true;
+    for (int i = 0; i < 5; i++) {
+        const Rect r = boundsOf(pool, column[i]);
+        ordered = ordered && inside(r, screen) && r.x == 2 && r.w == width - 4;
+        if (i > 0) {
+            ordered = ordered && r.y == boundsOf(pool, column[i - 1]).bottom() + 2;
+        }
+    }
+    check(ordered, "column children stacked with gap and padding");
+    check(boundsOf(pool, s.buttons).bottom() == height - 2, "fill child pushes buttons to the bottom");
+
+    const Rect okb = boundsOf(pool, s.ok);
+    const Rect cancel = boundsOf(pool, s.cancel);
+    const int32_t ratio_error = cancel.w - 2 * okb.w;
+    check(okb.w + 2 + cancel.w == width - 4 && ratio_error >= -2 && ratio_error <= 2,
+          "weights split the button row 1:2");
+    check(boundsOf(pool, s.value).right() == boundsOf(pool, s.row).right(), "value label fills the row");
+
+    // 没有变化时不做任何工作
+    layout.update(&driver, screen);
+    check(layout.stats().measured == 0 && layout.stats().arranged == 0, "steady state does nothing");
+
+    // 等宽数字：数值变化不改变尺寸，只重新测量这个标签
+    pool.get<Label>(s.value)->setText("23.5 C");
+    layout.update(&driver, screen);
+    check(layout.stats().measured == 1 && layout.stats().moved == 0, "value change needs no relayout");
+    check(pool.render(&driver) == 1, "only the label repaints");
+
+    // 名称变长：只重新排列所在的行
+    const Rect progress_before = boundsOf(pool, s.progress);
+    pool.get<Label>(s.name)->setText("Temperature");
+    layout.update(&driver, screen);
+    check(layout.stats().moved == 2 && boundsOf(pool, s.name).right() + 4 == boundsOf(pool, s.value).x,
+          "row relaid out, value label shrinks");
+    const Rect progress_after = boundsOf(pool, s.progress);
+    check(progress_before.y == progress_after.y && layout.stats().arranged <= 3,
+          "siblings of the row untouched");
+    check(!pool.damage().isEmpty(), "moved widgets feed the damage rectangle");
+    pool.render(&driver);
+
+    // 隐藏填充区：按钮行上移到进度条下方
+    pool.component(s.body)->setVisible(false);
+    layout.update(&driver, screen);
+    check(boundsOf(pool, s.buttons).y == progress_after.bottom() + 2, "hidden child takes no space");
+    pool.render(&driver);
+    pool.component(s.body)->setVisible(true);
+    layout.update(&driver, screen);
+    check(boundsOf(pool, s.buttons).bottom() == height - 2, "showing it again restores the layout");
+    pool.render(&driver);
+}
+
+int main() {
+    runProduct(128, 64);
+    runProduct(240, 320);
+    return Test::finish("layout");
+}
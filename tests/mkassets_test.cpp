@@ -0,0 +1,28 @@
+#include <cstdio>
+#include "AssetPack.h"
+#include "TestCheck.h"
+
+using namespace MinimalUI;
+using Test::check;
+
+// 构建时mkassets扫描本文件的字符串字面量，从tests/data/mkassets.bdf（一、中、文三个字形）
+// 生成mkassets.bin。注释中的"文"不是界面文本，不应进入资源包
+static const char* const TEXTS[] = {
+    "\xE4" "\xB8\xAD",   // 中，UTF-8序列跨相邻字面量
+    "\u4E00",           // 一
+    "25\xC2\xB0" "C",    // °不在字体中
+};
+
+int main() {
+    printf("Asset pack generated at build time\n");
+    const char quote = '"';   // 字符字面量中的引号不开始字符串
+    AssetPack pack;
+    GlyphSet glyphs{};
+    if (check(pack.open("mkassets.bin") && pack.count() == 2 && pack.glyphs(1, glyphs), "pack opened") &&
+        check(quote == 0x22 && TEXTS[0][0] != 0, "fixture strings present")) {
+        check(glyphs.count == 2 && glyphs.width == 8 && glyphs.height == 8, "2 glyphs of the 8x8 font");
+        check(glyphs.find(0x4E2D) >= 0 && glyphs.find(0x4E00) >= 0, "escaped and concatenated literals collected");
+        check(glyphs.find(0x6587) < 0, "characters only used in comments left out");
+    }
+    return Test::finish("mkassets");
+}
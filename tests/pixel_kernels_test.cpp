@@ -0,0 +1,141 @@
+#include <cstdio>
+#include <vector>
+#include "PixelKernels.h"
+#include "TestCheck.h"
+
+using namespace MinimalUI;
+using Test::check;
+
+// 覆盖向量主循环、像素对循环和单像素尾部的所有组合
+static const size_t MAX_WIDTH = 41;
+
+// 固定种子的xorshift，结果可复现
+static uint32_t nextRandom() {
+    static uint32_t state = 0x2545F491;
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return state;
+}
+
+// 逐通道的标量参考实现：d + floor((s - d) * a / 32)，a取0~32
+static Color referenceBlend(Color s, Color d, uint32_t a) {
+    auto channel = [a](int32_t sc, int32_t dc) { return dc + (((sc - dc) * static_cast<int32_t>(a)) >> 5); };
+    const int32_t r = channel(s >> 11, d >> 11);
+    const int32_t g = channel((s >> 5) & 0x3F, (d >> 5) & 0x3F);
+    const int32_t b = channel(s & 0x1F, d & 0x1F);
+    return static_cast<Color>((r << 11) | (g << 5) | b);
+}
+
+static uint32_t referenceAlpha(uint32_t alpha, uint32_t opacity) {
+    return PixelKernels::alpha5((alpha * (opacity + 1)) >> 8);
+}
+
+static void randomize(std::vector<Color>& pixels) {
+    for (Color& pixel : pixels) {
+        pixel = static_cast<Color>(nextRandom());
+    }
+}
+
+// 每种alpha、每种宽度、4字节对齐与不对齐的起点都与参考实现逐位比较
+static void runBlend() {
+    printf("blend / blendFill\n");
+    std::vector<Color> src(MAX_WIDTH + 1);
+    std::vector<Color> dst(MAX_WIDTH + 1);
+    std::vector<Color> expected(MAX_WIDTH + 1);
+    uint32_t blend_mismatches = 0;
+    uint32_t fill_mismatches = 0;
+    uint32_t guard_writes = 0;
+
+    for (uint32_t alpha = 0; alpha <= 255; alpha++) {
+        const uint32_t a = PixelKernels::alpha5(alpha);
+        for (size_t width = 1; width <= MAX_WIDTH; width++) {
+            for (size_t offset = 0; offset <= 1; offset++) {
+                if (offset + width > MAX_WIDTH + 1) {
+                    continue;
+                }
+                randomize(src);
+                randomize(dst);
+                expected = dst;
+                for (size_t i = 0; i < width; i++) {
+                    expected[offset + i] = referenceBlend(src[offset + i], dst[offset + i], a);
+                }
+                PixelKernels::blend(dst.data() + offset, src.data() + offset, width, static_cast<uint8_t>(alpha));
+                for (size_t i = 0; i <= MAX_WIDTH; i++) {
+                    if (dst[i] != expected[i]) {
+                        (i >= offset && i < offset + width ? blend_mismatches : guard_writes)++;
+                    }
+                }
+
+                const Color color = static_cast<Color>(nextRandom());
+                randomize(dst);
+                expected = dst;
+                for (size_t i = 0; i < width; i++) {
+                    expected[offset + i] = referenceBlend(color, dst[offset + i], a);
+                }
+                PixelKernels::blendFill(dst.data() + offset, width, color, static_cast<uint8_t>(alpha));
+                for (size_t i = 0; i <= MAX_WIDTH; i++) {
+                    if (dst[i] != expected[i]) {
+                        (i >= offset && i < offset + width ? fill_mismatches : guard_writes)++;
+                    }
+                }
+            }
+        }
+    }
+    printf("  %u blend, %u blendFill mismatches\n", blend_mismatches, fill_mismatches);
+    check(blend_mismatches == 0, "blend matches the scalar reference for all alphas and widths");
+    check(fill_mismatches == 0, "blendFill matches the scalar reference for all alphas and widths");
+    check(guard_writes == 0, "no writes outside the row");
+}
+
+// 逐像素alpha取随机值并包含0和255，整体不透明度遍历全部取值
+static void runBlendAlpha() {
+    printf("blendAlpha\n");
+    std::vector<Color> src(MAX_WIDTH + 1);
+    std::vector<Color> dst(MAX_WIDTH + 1);
+    std::vector<Color> expected(MAX_WIDTH + 1);
+    std::vector<uint8_t> alpha(MAX_WIDTH + 1);
+    uint32_t mismatches = 0;
+
+    for (uint32_t opacity = 0; opacity <= 255; opacity++) {
+        for (size_t width = 1; width <= MAX_WIDTH; width++) {
+            const size_t offset = width & 1;
+            if (offset + width > MAX_WIDTH + 1) {
+                continue;
+            }
+            randomize(src);
+            randomize(dst);
+            for (size_t i = 0; i < alpha.size(); i++) {
+                const uint32_t r = nextRandom();
+                alpha[i] = static_cast<uint8_t>((r & 0x300) == 0 ? 0 : (r & 0x300) == 0x100 ? 255 : r);
+            }
+            expected = dst;
+            if (opacity > 0) {
+                for (size_t i = 0; i < width; i++) {
+                    expected[offset + i] = referenceBlend(src[offset + i], dst[offset + i],
+                                                          referenceAlpha(alpha[offset + i], opacity));
+                }
+            }
+            PixelKernels::blendAlpha(dst.data() + offset, src.data() + offset, alpha.data() + offset, width,
+                                     static_cast<uint8_t>(opacity));
+            for (size_t i = 0; i <= MAX_WIDTH; i++) {
+                mismatches += dst[i] != expected[i];
+            }
+        }
+    }
+    printf("  %u mismatches\n", mismatches);
+    check(mismatches == 0, "blendAlpha matches the scalar reference for all opacities and widths");
+}
+
+int main() {
+#if defined(__AVX2__)
+    printf("Kernels: AVX2 + SWAR\n");
+#elif defined(__SSE2__)
+    printf("Kernels: SSE2 + SWAR\n");
+#else
+    printf("Kernels: SWAR\n");
+#endif
+    runBlend();
+    runBlendAlpha();
+    return Test::finish("pixel kernel");
+}
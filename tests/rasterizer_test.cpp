@@ -0,0 +1,424 @@
+#include <cstdio>
+#include <cstdlib>
+#include <utility>
+#include <vector>
+#include "Rasterizer.h"
+#include "TestCheck.h"
+
+using namespace MinimalUI;
+using Test::check;
+
+static const int16_t W = 96;
+static const int16_t H = 96;
+
+/**
+ * @brief 记录每个像素被扫描段覆盖的次数
+ * 不做裁剪，越界写入单独计数，用来检查Rasterizer自己的裁剪
+ */
+class CoverSink : public SpanSink {
+public:
+    CoverSink() : cover(static_cast<size_t>(W) * H, 0) {}
+
+    std::vector<uint8_t> cover;
+    int outside = 0;
+
+    void fillSpan(int16_t x, int16_t y, int16_t w, Color) override {
+        for (int16_t i = x; i < x + w; i++) {
+            if (i < 0 || i >= W || y < 0 || y >= H) {
+                outside++;
+            } else {
+                cover[y * W + i]++;
+            }
+        }
+    }
+
+    int at(int x, int y) const { return cover[y * W + x]; }
+
+    int total() const {
+        int n = 0;
+        for (uint8_t c : cover) {
+            n += c;
+        }
+        return n;
+    }
+};
+
+static const Rect FULL = {0, 0, W, H};
+
+// 关于y = cy水平镜像对称
+static bool mirroredY(const CoverSink& sink, int16_t cy) {
+    for (int16_t d = 1; cy - d >= 0 && cy + d < H; d++) {
+        for (int16_t x = 0; x < W; x++) {
+            if ((sink.at(x, cy - d) > 0) != (sink.at(x, cy + d) > 0)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+// a关于x = cx镜像后与b相同
+static bool mirroredX(const CoverSink& a, const CoverSink& b, int16_t cx) {
+    for (int16_t y = 0; y < H; y++) {
+        for (int16_t d = -40; d <= 40; d++) {
+            if (cx + d < 0 || cx + d >= W || cx - d < 0 || cx - d >= W) {
+                continue;
+            }
+            if ((a.at(cx + d, y) > 0) != (b.at(cx - d, y) > 0)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+static bool samePixels(const CoverSink& a, const CoverSink& b) {
+    for (size_t i = 0; i < a.cover.size(); i++) {
+        if ((a.cover[i] > 0) != (b.cover[i] > 0)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// 每个像素最多写一次
+static bool noOverdraw(const CoverSink& sink) {
+    for (uint8_t c : sink.cover) {
+        if (c > 1) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief 同一图形分别在全屏和clip中绘制：clip内两者一致，clip外没有写入
+ */
+template <typename Draw>
+static bool clipsExactly(const Rect& clip, Draw draw) {
+    CoverSink full;
+    CoverSink clipped;
+    Rasterizer all(full, FULL);
+    Rasterizer part(clipped, clip);
+    draw(all);
+    draw(part);
+    if (clipped.outside != 0) {
+        return false;
+    }
+    for (int16_t y = 0; y < H; y++) {
+        for (int16_t x = 0; x < W; x++) {
+            const int expected = clip.contains(x, y) ? full.at(x, y) : 0;
+            if (clipped.at(x, y) != expected) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+// 原先各驱动中逐像素的Bresenham直线，作为参考
+static void referenceLine(CoverSink& sink, int16_t x0, int16_t y0, int16_t x1, int16_t y1) {
+    const bool steep = abs(y1 - y0) > abs(x1 - x0);
+    if (steep) {
+        std::swap(x0, y0);
+        std::swap(x1, y1);
+    }
+    if (x0 > x1) {
+        std::swap(x0, x1);
+        std::swap(y0, y1);
+    }
+    const int16_t dx = x1 - x0;
+    const int16_t dy = abs(y1 - y0);
+    int16_t err = dx / 2;
+    int16_t y = y0;
+    for (int16_t x = x0; x <= x1; x++) {
+        const int16_t px = steep ? y : x;
+        const int16_t py = steep ? x : y;
+        if (FULL.contains(px, py) && sink.at(px, py) == 0) {
+            sink.fillSpan(px, py, 1, Colors::WHITE);
+        }
+        err -= dy;
+        if (err < 0) {
+            y += y0 < y1 ? 1 : -1;
+            err += dx;
+        }
+    }
+}
+
+// 原先各驱动中逐像素的中点画圆，作为参考
+static void referenceCircle(CoverSink& sink, int16_t x0, int16_t y0, int16_t r) {
+    auto plot = [&sink](int16_t px, int16_t py) {
+        if (FULL.contains(px, py) && sink.at(px, py) == 0) {
+            sink.fillSpan(px, py, 1, Colors::WHITE);
+        }
+    };
+    int16_t f = 1 - r;
+    int16_t ddF_x = 1;
+    int16_t ddF_y = -2 * r;
+    int16_t x = 0;
+    int16_t y = r;
+    plot(x0, y0 + r);
+    plot(x0, y0 - r);
+    plot(x0 + r, y0);
+    plot(x0 - r, y0);
+    while (x < y) {
+        if (f >= 0) {
+            y--;
+            ddF_y += 2;
+            f += ddF_y;
+        }
+        x++;
+        ddF_x += 2;
+        f += ddF_x;
+        plot(x0 + x, y0 + y);
+        plot(x0 - x, y0 + y);
+        plot(x0 + x, y0 - y);
+        plot(x0 - x, y0 - y);
+        plot(x0 + y, y0 + x);
+        plot(x0 - y, y0 + x);
+        plot(x0 + y, y0 - x);
+        plot(x0 - y, y0 - x);
+    }
+}
+
+// 统计扫描段个数的接收器
+class CountSink : public SpanSink {
+public:
+    int spans = 0;
+    void fillSpan(int16_t, int16_t, int16_t, Color) override { spans++; }
+};
+
+static void runOutlines() {
+    printf("Lines and circles\n");
+    // 各个方向、各种斜率的直线与逐像素参考一致
+    bool lines = true;
+    for (int16_t angle = 0; angle < 64; angle++) {
+        const int16_t ex = static_cast<int16_t>(48 + ((angle * 37) % 91) - 45);
+        const int16_t ey = static_cast<int16_t>(48 + ((angle * 53) % 91) - 45);
+        CoverSink spans;
+        CoverSink pixels;
+        Rasterizer(spans, FULL).drawLine(48, 48, ex, ey, Colors::WHITE);
+        referenceLine(pixels, 48, 48, ex, ey);
+        lines = lines && spans.cover == pixels.cover;
+    }
+    check(lines, "drawLine covers the same pixels as per-pixel Bresenham, each once");
+
+    CountSink shallow;
+    Rasterizer(shallow, FULL).drawLine(0, 10, 90, 13, Colors::WHITE);
+    check(shallow.spans == 4, "shallow line emitted as one span per row");
+
+    const Rect clip = {20, 15, 33, 27};
+    check(clipsExactly(clip, [](Rasterizer& r) { r.drawLine(-30, 100, 120, -20, Colors::WHITE); }) &&
+          clipsExactly(clip, [](Rasterizer& r) { r.drawLine(25, -40, 40, 140, Colors::WHITE); }),
+          "lines running off screen clipped exactly");
+
+    bool circles = true;
+    for (int16_t r = 0; r <= 45; r++) {
+        CoverSink spans;
+        CoverSink pixels;
+        Rasterizer(spans, FULL).drawCircle(48, 47, r, Colors::WHITE);
+        referenceCircle(pixels, 48, 47, r);
+        circles = circles && spans.cover == pixels.cover;
+    }
+    check(circles, "drawCircle covers the same pixels as the midpoint circle for r = 0..45, each once");
+
+    CountSink ring;
+    CoverSink pixels_r40;
+    Rasterizer(ring, FULL).drawCircle(48, 48, 40, Colors::WHITE);
+    referenceCircle(pixels_r40, 48, 48, 40);
+    check(ring.spans < pixels_r40.total() * 3 / 4, "circle top and bottom rows merged into spans");
+    check(clipsExactly(clip, [](Rasterizer& r) { r.drawCircle(30, 30, 25, Colors::WHITE); }),
+          "circle clipped exactly");
+}
+
+static void runArcs() {
+    printf("\nArcs\n");
+    const int16_t cx = 48;
+    const int16_t cy = 48;
+
+    CoverSink ring;
+    CoverSink outer;
+    CoverSink inner;
+    Rasterizer(ring, FULL).fillArc(cx, cy, 30, 20, 0, 360, Colors::WHITE);
+    Rasterizer(outer, FULL).fillCircle(cx, cy, 30, Colors::WHITE);
+    Rasterizer(inner, FULL).fillCircle(cx, cy, 19, Colors::WHITE);
+    check(noOverdraw(ring) && ring.total() == outer.total() - inner.total(),
+          "full ring = outer disc minus inner disc, no pixel written twice");
+
+    // 跨过0度的扇段：三种写法覆盖相同像素，关于水平轴对称
+    CoverSink across0;
+    CoverSink negative;
+    CoverSink wrapped;
+    Rasterizer(across0, FULL).fillArc(cx, cy, 30, 10, 315, 45, Colors::WHITE);
+    Rasterizer(negative, FULL).fillArc(cx, cy, 30, 10, -45, 45, Colors::WHITE);
+    Rasterizer(wrapped, FULL).fillArc(cx, cy, 30, 10, 315, 405, Colors::WHITE);
+    check(across0.total() > 0 && noOverdraw(across0) && samePixels(across0, negative) && samePixels(across0, wrapped),
+          "315..45, -45..45 and 315..405 fill the same pixels");
+    check(mirroredY(across0, cy), "arc across 0 degrees is symmetric about the horizontal axis");
+    bool right_only = true;
+    for (int16_t y = 0; y < H; y++) {
+        for (int16_t x = 0; x <= cx; x++) {
+            right_only = right_only && across0.at(x, y) == 0;
+        }
+    }
+    check(right_only && across0.at(cx + 25, cy) == 1, "0-degree arc stays right of the centre, covers the 0 ray");
+
+    // 跨过180度的扇段是跨0度扇段的左右镜像
+    CoverSink across180;
+    Rasterizer(across180, FULL).fillArc(cx, cy, 30, 10, 135, 225, Colors::WHITE);
+    check(mirroredY(across180, cy) && mirroredX(across0, across180, cx) && across180.at(cx - 25, cy) == 1,
+          "arc across 180 degrees mirrors the 0-degree arc");
+
+    // 上下两个半圆互为镜像，合起来覆盖整个圆环，只有0度和180度射线上的像素重复
+    CoverSink lower;
+    CoverSink upper;
+    Rasterizer(lower, FULL).fillArc(cx, cy, 30, 20, 0, 180, Colors::WHITE);
+    Rasterizer(upper, FULL).fillArc(cx, cy, 30, 20, 180, 360, Colors::WHITE);
+    bool halves = lower.total() == upper.total();
+    for (int16_t d = 1; d <= 30; d++) {
+        for (int16_t x = 0; x < W; x++) {
+            halves = halves && (lower.at(x, cy + d) > 0) == (upper.at(x, cy - d) > 0) &&
+                     lower.at(x, cy - d) == 0 && upper.at(x, cy + d) == 0;
+        }
+    }
+    bool union_ring = true;
+    int twice = 0;
+    for (size_t i = 0; i < ring.cover.size(); i++) {
+        const int n = lower.cover[i] + upper.cover[i];
+        union_ring = union_ring && (n > 0) == (ring.cover[i] > 0);
+        twice += n > 1;
+    }
+    check(halves && union_ring && twice == 2 * (30 - 20 + 1), "half rings mirror each other and tile the full ring");
+
+    // 四个象限同样拼成整个圆环
+    CoverSink quadrants;
+    Rasterizer q(quadrants, FULL);
+    for (int16_t a = 0; a < 360; a += 90) {
+        q.fillArc(cx, cy, 30, 20, a, a + 90, Colors::WHITE);
+    }
+    check(samePixels(quadrants, ring), "four quadrants tile the full ring");
+
+    CoverSink empty;
+    Rasterizer(empty, FULL).fillArc(cx, cy, 30, 10, 90, 90, Colors::WHITE);
+    Rasterizer(empty, FULL).fillArc(cx, cy, 10, 30, 0, 90, Colors::WHITE);
+    check(empty.total() == 0, "zero sweep and inner > outer draw nothing");
+
+    check(clipsExactly(Rect{40, 30, 30, 25}, [](Rasterizer& r) { r.fillArc(48, 48, 30, 10, 315, 45, Colors::WHITE); }) &&
+          clipsExactly(Rect{0, 0, 50, 50}, [](Rasterizer& r) { r.fillArc(48, 48, 30, 0, 100, 440, Colors::WHITE); }),
+          "arcs clipped exactly");
+}
+
+static void runEllipses() {
+    printf("\nEllipses\n");
+    CoverSink circle;
+    CoverSink round;
+    Rasterizer(circle, FULL).fillCircle(48, 48, 17, Colors::WHITE);
+    Rasterizer(round, FULL).fillEllipse(48, 48, 17, 17, Colors::WHITE);
+    check(samePixels(circle, round) && noOverdraw(round), "rx == ry matches fillCircle");
+
+    CoverSink wide;
+    Rasterizer(wide, FULL).fillEllipse(48, 48, 40, 12, Colors::WHITE);
+    check(mirroredY(wide, 48) && mirroredX(wide, wide, 48) && wide.at(8, 48) == 1 && wide.at(7, 48) == 0 &&
+          wide.at(48, 36) == 1 && wide.at(48, 35) == 0, "ellipse symmetric, touches its axes' end points");
+
+    // 退化椭圆：一个半径为0时是一条线，两个都为0时是一个点
+    CoverSink vertical;
+    CoverSink horizontal;
+    CoverSink dot;
+    Rasterizer(vertical, FULL).fillEllipse(20, 40, 0, 9, Colors::WHITE);
+    Rasterizer(horizontal, FULL).fillEllipse(40, 20, 9, 0, Colors::WHITE);
+    Rasterizer(dot, FULL).fillEllipse(5, 6, 0, 0, Colors::WHITE);
+    bool line_v = vertical.total() == 19 && noOverdraw(vertical);
+    bool line_h = horizontal.total() == 19 && noOverdraw(horizontal);
+    for (int16_t d = -9; d <= 9; d++) {
+        line_v = line_v && vertical.at(20, 40 + d) == 1;
+        line_h = line_h && horizontal.at(40 + d, 20) == 1;
+    }
+    check(line_v && line_h, "rx = 0 or ry = 0 gives a 2r+1 pixel line");
+    check(dot.total() == 1 && dot.at(5, 6) == 1, "rx = ry = 0 gives a single pixel");
+
+    CoverSink none;
+    Rasterizer(none, FULL).fillEllipse(48, 48, -1, 5, Colors::WHITE);
+    Rasterizer(none, FULL).fillEllipse(48, 48, 5, -1, Colors::WHITE);
+    check(none.total() == 0, "negative radii draw nothing");
+
+    check(clipsExactly(Rect{10, 10, 40, 30}, [](Rasterizer& r) { r.fillEllipse(30, 30, 35, 14, Colors::WHITE); }) &&
+          clipsExactly(Rect{20, 0, 1, 96}, [](Rasterizer& r) { r.fillEllipse(20, 40, 0, 60, Colors::WHITE); }),
+          "ellipses, including degenerate ones, clipped exactly");
+}
+
+static void runPolygons() {
+    printf("\nPolygons\n");
+    // 凹的箭头（左侧有缺口），每行只有两个交点：逐行精确
+    const Point chevron[] = {{10, 10}, {50, 50}, {10, 90}, {30, 50}};
+    CoverSink arrow;
+    Rasterizer(arrow, FULL).fillConvexPolygon(chevron, 4, Colors::WHITE);
+    bool rows = arrow.outside == 0 && noOverdraw(arrow);
+    for (int16_t y = 0; y < H; y++) {
+        const int16_t d = y - 10 < 90 - y ? y - 10 : 90 - y;
+        for (int16_t x = 0; x < W; x++) {
+            // 缺口一侧 x = 10 + d/2（0.5向上取整），外侧 x = 10 + d
+            const bool inside = d >= 0 && x >= 10 + (d + 1) / 2 && x <= 10 + d;
+            rows = rows && (arrow.at(x, y) == 1) == inside;
+        }
+    }
+    check(rows, "Y-monotone concave polygon filled row by row, notch left empty");
+    check(mirroredY(arrow, 50), "concave arrow symmetric about its axis");
+
+    const Rect clip = {20, 25, 30, 40};
+    check(clipsExactly(clip, [&chevron](Rasterizer& r) { r.fillConvexPolygon(chevron, 4, Colors::WHITE); }),
+          "concave polygon clipped exactly");
+
+    // 非单调的凹多边形（U形）和自相交的8字形：结果不保证，但不超出包围盒和裁剪矩形
+    const Point u_shape[] = {{10, 10}, {30, 10}, {30, 60}, {60, 60}, {60, 10}, {80, 10}, {80, 80}, {10, 80}};
+    const Point bowtie[] = {{10, 10}, {80, 80}, {80, 10}, {10, 80}};
+    const Point* shapes[] = {u_shape, bowtie};
+    const uint8_t counts[] = {8, 4};
+    bool bounded = true;
+    bool clipped = true;
+    for (int s = 0; s < 2; s++) {
+        CoverSink sink;
+        Rasterizer(sink, FULL).fillConvexPolygon(shapes[s], counts[s], Colors::WHITE);
+        for (int16_t y = 0; y < H; y++) {
+            for (int16_t x = 0; x < W; x++) {
+                bounded = bounded && (sink.at(x, y) == 0 || (x >= 10 && x <= 80 && y >= 10 && y <= 80));
+            }
+        }
+        bounded = bounded && sink.total() > 0 && sink.outside == 0 && noOverdraw(sink);
+        const Point* points = shapes[s];
+        const uint8_t count = counts[s];
+        clipped = clipped && clipsExactly(clip, [points, count](Rasterizer& r) {
+            r.fillConvexPolygon(points, count, Colors::WHITE);
+        });
+    }
+    check(bounded, "non-monotone and self-intersecting input stays inside its bounding box");
+    check(clipped, "non-monotone and self-intersecting input clipped exactly");
+
+    // 远大于屏幕的多边形：包围盒宽度超过int16范围也不能被误判为在裁剪区外
+    const Point huge[] = {{-20000, -20000}, {20000, -20000}, {20000, 20000}, {-20000, 20000}};
+    CoverSink cover;
+    Rasterizer(cover, clip).fillConvexPolygon(huge, 4, Colors::WHITE);
+    check(cover.outside == 0 && cover.total() == clip.w * clip.h && noOverdraw(cover),
+          "polygon much larger than the screen fills exactly the clip");
+
+    // 退化输入
+    const Point line[] = {{5, 5}, {40, 5}, {20, 5}};
+    const Point spike[] = {{30, 30}, {30, 30}, {30, 60}};
+    CoverSink degenerate;
+    Rasterizer r(degenerate, FULL);
+    r.fillConvexPolygon(line, 3, Colors::WHITE);
+    const int flat = degenerate.total();
+    r.fillConvexPolygon(spike, 3, Colors::WHITE);
+    r.fillConvexPolygon(nullptr, 3, Colors::WHITE);
+    r.fillConvexPolygon(line, 0, Colors::WHITE);
+    check(flat == 36 && degenerate.total() == 36 + 31 && degenerate.at(30, 45) == 1 && degenerate.outside == 0,
+          "collinear and repeated vertices give a line, empty input draws nothing");
+}
+
+int main() {
+    runOutlines();
+    runArcs();
+    runEllipses();
+    runPolygons();
+    return Test::finish("rasterizer");
+}
@@ -0,0 +1,280 @@
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <thread>
+#include <vector>
+#include "GraphicsDriver.h"
+#include "RenderQueue.h"
+#include "TestCheck.h"
+
+using namespace MinimalUI;
+using Test::check;
+
+static const int PRODUCERS = 8;
+static const int COMMANDS_PER_PRODUCER = 100000;
+static const int DISPLAY_EVERY = 1000;
+
+// 记录收到的命令并校验每个生产者的顺序
+// 生产者编号放在x，序号拆成y（低15位）和color（高位）
+class CheckingDriver : public GraphicsDriver {
+public:
+    uint32_t next[PRODUCERS] = {};
+    uint32_t received = 0;
+    uint32_t out_of_order = 0;
+    uint32_t displays = 0;
+    int16_t right = 0;   // 所有fillRect的最右边界，用于检查文本宽度
+    std::thread::id caller;
+
+    bool initialize() override { return true; }
+    void drawPixel(int16_t, int16_t, Color) override {}
+    void fillRect(int16_t x, int16_t y, int16_t w, int16_t, Color color) override {
+        caller = std::this_thread::get_id();
+        if (x + w > right) {
+            right = static_cast<int16_t>(x + w);
+        }
+        const uint32_t sequence = (static_cast<uint32_t>(color) << 15) | static_cast<uint32_t>(y);
+        if (x < 0 || x >= PRODUCERS || sequence != next[x]) {
+            out_of_order++;
+        } else {
+            next[x]++;
+        }
+        received++;
+    }
+    void drawHLine(int16_t, int16_t, int16_t, Color) override {}
+    void drawVLine(int16_t, int16_t, int16_t, Color) override {}
+    void drawLine(int16_t, int16_t, int16_t, int16_t, Color) override {}
+    void drawRect(int16_t, int16_t, int16_t, int16_t, Color) override {}
+    void drawCircle(int16_t, int16_t, int16_t, Color) override {}
+    void fillCircle(int16_t, int16_t, int16_t, Color) override {}
+    void display() override { displays++; }
+    void clear(Color) override {}
+    int16_t width() const override { return 128; }
+    int16_t height() const override { return 64; }
+};
+
+// 队列满时让出CPU后重试，保证每个生产者的命令都能送达
+static void produce(RenderQueue& queue, int id, std::atomic<uint32_t>& retries) {
+    for (uint32_t i = 0; i < COMMANDS_PER_PRODUCER; i++) {
+        const int16_t y = static_cast<int16_t>(i & 0x7FFF);
+        const Color color = static_cast<Color>(i >> 15);
+        while (!queue.fillRect(static_cast<int16_t>(id), y, 1, 1, color)) {
+            retries.fetch_add(1, std::memory_order_relaxed);
+            std::this_thread::yield();
+        }
+        if (i % DISPLAY_EVERY == DISPLAY_EVERY - 1) {
+            while (!queue.display()) {
+                retries.fetch_add(1, std::memory_order_relaxed);
+                std::this_thread::yield();
+            }
+        }
+    }
+}
+
+static void runStress() {
+    printf("Stress: %d producers x %d commands, queue capacity %u\n", PRODUCERS, COMMANDS_PER_PRODUCER,
+           static_cast<unsigned>(RenderQueue::CAPACITY));
+    static RenderQueue queue;
+    CheckingDriver driver;
+    std::atomic<uint32_t> retries{0};
+    std::atomic<int> running{PRODUCERS};
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> producers;
+    for (int id = 0; id < PRODUCERS; id++) {
+        producers.emplace_back([&, id] {
+            produce(queue, id, retries);
+            running.fetch_sub(1, std::memory_order_release);
+        });
+    }
+    // 渲染线程：唯一接触驱动的线程
+    size_t batches = 0;
+    for (;;) {
+        const bool done = running.load(std::memory_order_acquire) == 0;
+        if (queue.drain(&driver) > 0) {
+            batches++;
+        } else if (done) {
+            break;
+        } else {
+            std::this_thread::yield();
+        }
+    }
+    for (std::thread& producer : producers) {
+        producer.join();
+    }
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    check(driver.received == PRODUCERS * COMMANDS_PER_PRODUCER, "every command executed once");
+    check(driver.out_of_order == 0, "per-producer order preserved");
+    bool complete = true;
+    for (int id = 0; id < PRODUCERS; id++) {
+        complete = complete && driver.next[id] == COMMANDS_PER_PRODUCER;
+    }
+    check(complete, "no gaps in any producer's sequence");
+    check(driver.caller == std::this_thread::get_id(), "driver touched only by the render thread");
+    check(queue.dropped() == retries.load(), "full queue rejects without blocking");
+    const uint32_t requested = PRODUCERS * (COMMANDS_PER_PRODUCER / DISPLAY_EVERY);
+    check(driver.displays == queue.presented() && driver.displays >= 1 && driver.displays <= requested,
+          "display requests coalesced");
+    printf("         %.1f M commands/s, %zu batches, %u display() for %u requests, %u full-queue retries\n",
+           driver.received / seconds / 1e6, batches, driver.displays, requested, retries.load());
+}
+
+// 检查帧边界：两次display()之间每个生产者最多执行一条命令
+class FrameDriver : public GraphicsDriver {
+public:
+    bool drawn[PRODUCERS] = {};
+    bool pending = false;      // 有命令已执行但尚未刷新
+    uint32_t received = 0;
+    uint32_t displays = 0;
+    uint32_t crossed = 0;      // 同一生产者的下一帧命令在本帧刷新前被执行的次数
+
+    bool initialize() override { return true; }
+    void drawPixel(int16_t, int16_t, Color) override {}
+    void fillRect(int16_t x, int16_t, int16_t, int16_t, Color) override {
+        if (x < 0 || x >= PRODUCERS || drawn[x]) {
+            crossed++;
+        } else {
+            drawn[x] = true;
+        }
+        pending = true;
+        received++;
+    }
+    void drawHLine(int16_t, int16_t, int16_t, Color) override {}
+    void drawVLine(int16_t, int16_t, int16_t, Color) override {}
+    void drawLine(int16_t, int16_t, int16_t, int16_t, Color) override {}
+    void drawRect(int16_t, int16_t, int16_t, int16_t, Color) override {}
+    void drawCircle(int16_t, int16_t, int16_t, Color) override {}
+    void fillCircle(int16_t, int16_t, int16_t, Color) override {}
+    void display() override {
+        for (bool& d : drawn) {
+            d = false;
+        }
+        pending = false;
+        displays++;
+    }
+    void clear(Color) override {}
+    int16_t width() const override { return 128; }
+    int16_t height() const override { return 64; }
+};
+
+// 每个生产者每条命令后都请求刷新：一帧不能混入同一生产者下一帧的命令，
+// 紧邻的请求合并，最后一条命令也被刷新
+static void runFrames() {
+    const uint32_t FRAMES = 20000;
+    printf("Stress: %d producers x %u frames of one command + display\n", PRODUCERS, FRAMES);
+    static RenderQueue queue;
+    FrameDriver driver;
+    std::atomic<int> running{PRODUCERS};
+
+    std::vector<std::thread> producers;
+    for (int id = 0; id < PRODUCERS; id++) {
+        producers.emplace_back([&, id] {
+            for (uint32_t i = 0; i < FRAMES; i++) {
+                while (!queue.fillRect(static_cast<int16_t>(id), 0, 1, 1, 0)) {
+                    std::this_thread::yield();
+                }
+                while (!queue.display()) {
+                    std::this_thread::yield();
+                }
+            }
+            running.fetch_sub(1, std::memory_order_release);
+        });
+    }
+    for (;;) {
+        const bool done = running.load(std::memory_order_acquire) == 0;
+        if (queue.drain(&driver, 1 + (driver.received & 15)) == 0) {
+            if (done) {
+                break;
+            }
+            std::this_thread::yield();
+        }
+    }
+    for (std::thread& producer : producers) {
+        producer.join();
+    }
+
+    const uint32_t requested = PRODUCERS * FRAMES;
+    check(driver.received == requested, "every command executed once");
+    check(driver.crossed == 0, "a frame never contains a producer's next frame");
+    check(!driver.pending, "the last command is presented");
+    check(driver.displays == queue.presented() && driver.displays <= requested &&
+          driver.displays >= requested / PRODUCERS, "only adjacent display requests merge");
+    printf("         %u display() for %u requests\n", driver.displays, requested);
+}
+
+static void setFlag(GraphicsDriver*, void* context) {
+    *static_cast<std::thread::id*>(context) = std::this_thread::get_id();
+}
+
+static void runCommands() {
+    printf("Commands\n");
+    static RenderQueue queue;
+    CheckingDriver driver;
+
+    // 文本按值拷贝：入队后修改原缓冲区不影响绘制结果
+    char buffer[32];
+    snprintf(buffer, sizeof(buffer), "%s", "temperature 23.4 C");
+    queue.drawText(0, 0, buffer, Colors::WHITE, Colors::BLACK);
+    memset(buffer, 'x', sizeof(buffer) - 1);
+    std::thread::id invoked;
+    std::thread([&] { queue.invoke(setFlag, &invoked); }).join();
+    queue.display();
+    queue.display();
+    check(queue.drain(&driver) == 4, "commands drained in one batch");
+    check(driver.right == driver.measureText("temperature 23."), "text copied inline and truncated");
+    check(invoked == std::this_thread::get_id(), "invoke runs on the render thread");
+    check(driver.displays == 1, "two display requests, one display()");
+
+    // DISPLAY结束当前批：其后的命令属于下一帧，不会在这次刷新前执行
+    const uint32_t received = driver.received;
+    queue.fillRect(0, 0, 1, 1, 0);
+    queue.display();
+    queue.fillRect(0, 1, 1, 1, 0);
+    queue.display();
+    check(queue.drain(&driver) == 2 && driver.received == received + 1 && driver.displays == 2,
+          "display ends the batch");
+    check(queue.drain(&driver) == 2 && driver.received == received + 2 && driver.displays == 3,
+          "next frame drained by the next call");
+    check(queue.drain(&driver) == 0 && driver.displays == 3, "nothing left to present");
+
+    size_t accepted = 0;
+    while (queue.drawPixel(0, 0, Colors::WHITE)) {
+        accepted++;
+    }
+    check(accepted == RenderQueue::CAPACITY && queue.dropped() == 1, "capacity is fixed");
+    check(queue.drain(&driver, 10) == 10 && queue.drain(&driver) == RenderQueue::CAPACITY - 10,
+          "drain limit leaves the rest queued");
+}
+
+static void runTruncation() {
+    printf("Text truncation\n");
+    static RenderQueue queue;
+    CheckingDriver driver;
+
+    // 截断点落在多字节字符中间时去掉整个字符，不留下半个UTF-8序列（会绘制成替换字符）
+    const char* cut_3byte = "abcdefghijklm\xE4\xB8\xAD";   // 13 + 3字节
+    const char* fits = "abcdefghijkl\xE4\xB8\xAD";         // 正好15字节
+    const char* cut_2byte = "abcdefghijklmn\xC2\xB0";       // 14 + 2字节
+    const char* cut_4byte = "abcdefghijk\xF0\x9F\x98\x80x";  // 11 + 4 + 1字节
+    const char* texts[] = {cut_3byte, fits, cut_2byte, cut_4byte};
+    const char* expected[] = {"abcdefghijklm", fits, "abcdefghijklmn", "abcdefghijk\xF0\x9F\x98\x80"};
+    bool whole = true;
+    for (int i = 0; i < 4; i++) {
+        driver.right = 0;
+        queue.drawText(0, 0, texts[i], Colors::WHITE, Colors::BLACK);
+        queue.display();
+        queue.drain(&driver);
+        whole = whole && driver.right == driver.measureText(expected[i]);
+    }
+    check(whole && driver.measureText(cut_3byte) > driver.measureText("abcdefghijklm"),
+          "truncation backs off to the last complete UTF-8 character");
+}
+
+int main() {
+    runCommands();
+    runTruncation();
+    runStress();
+    runFrames();
+    return Test::finish("render queue");
+}
@@ -0,0 +1,242 @@
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <vector>
+#include "EmulatedBus.h"
+#include "Linux_SPI_Driver.h"
+#include "SSD1309Controller.h"
+#include "SSD1309Model.h"
+#include "TestCheck.h"
+
+using namespace MinimalUI;
+using Test::check;
+
+static const int16_t PANEL_W = SSD1309Model::WIDTH;
+static const int16_t PANEL_H = SSD1309Model::HEIGHT;
+
+static int degrees(Rotation rotation) {
+    return static_cast<int>(rotation) * 90;
+}
+
+// 逻辑坐标在面板上的位置（顺时针旋转，之后再叠加水平翻转）
+static void panelPosition(Rotation rotation, bool flip_horizontal, int16_t x, int16_t y,
+                          int16_t& px, int16_t& py) {
+    switch (rotation) {
+        case Rotation::ROTATE_0:   px = x;                py = y;                break;
+        case Rotation::ROTATE_90:  px = PANEL_W - 1 - y;  py = x;                break;
+        case Rotation::ROTATE_180: px = PANEL_W - 1 - x;  py = PANEL_H - 1 - y;  break;
+        case Rotation::ROTATE_270: px = y;                py = PANEL_H - 1 - x;  break;
+    }
+    if (flip_horizontal) {
+        px = PANEL_W - 1 - px;
+    }
+}
+
+// 帧缓冲区中的每个逻辑像素都应出现在面板的对应位置
+static int countMismatches(SSD1309Controller& controller, const SSD1309Model& model, bool flip_horizontal) {
+    const int16_t w = controller.getWidth();
+    const int16_t h = controller.getHeight();
+    const uint8_t* buffer = controller.getFrameBuffer();
+    int mismatches = 0;
+    for (int16_t y = 0; y < h; y++) {
+        for (int16_t x = 0; x < w; x++) {
+            const bool on = (buffer[(y / 8) * w + x] >> (y % 8)) & 1;
+            int16_t px = 0;
+            int16_t py = 0;
+            panelPosition(controller.getRotation(), flip_horizontal, x, y, px, py);
+            mismatches += model.pixel(px, py) != on;
+        }
+    }
+    return mismatches;
+}
+
+// 不对称的图案：上边线、左半边线、靠近左上角的方块和右下角的点
+static void drawMarker(SSD1309Controller& controller) {
+    const int16_t w = controller.getWidth();
+    const int16_t h = controller.getHeight();
+    controller.fillBufferRect(0, 0, w, 1, Colors::WHITE);
+    controller.fillBufferRect(0, 0, 1, h / 2, Colors::WHITE);
+    controller.fillBufferRect(3, 5, 7, 11, Colors::WHITE);
+    controller.fillBufferRect(w / 3, h / 3, w / 4, h / 5, Colors::GRAY);
+    controller.setPixel(w - 2, h - 3, true);
+}
+
+static void runTranspose() {
+    printf("8x8 bit transpose\n");
+    uint32_t seed = 1;
+    int wrong = 0;
+    for (int block = 0; block < 10000; block++) {
+        uint8_t in[8];
+        uint8_t out[8];
+        for (uint8_t& byte : in) {
+            seed = seed * 1103515245u + 12345u;
+            byte = static_cast<uint8_t>(seed >> 24);
+        }
+        SSD1309Controller::transpose8x8(in, out);
+        for (int i = 0; i < 8; i++) {
+            for (int j = 0; j < 8; j++) {
+                wrong += ((in[i] >> j) & 1) != ((out[j] >> i) & 1);
+            }
+        }
+    }
+    check(wrong == 0, "matches bit-by-bit transpose on 10000 random blocks");
+}
+
+static void runRotation(Rotation rotation, bool flip_horizontal) {
+    SSD1309Model model;
+    EmulatedBus bus(model, BusTiming());
+    SSD1309Config config;
+    config.rotation = rotation;
+    config.flip_horizontal = flip_horizontal;
+    SSD1309Controller controller(config);
+
+    char label[96];
+    bool ok = controller.initialize(&bus) && model.protocolErrors() == 0;
+    const bool swapped = rotation == Rotation::ROTATE_90 || rotation == Rotation::ROTATE_270;
+    ok = ok && controller.getWidth() == (swapped ? PANEL_H : PANEL_W) &&
+         controller.getHeight() == (swapped ? PANEL_W : PANEL_H);
+    drawMarker(controller);
+    controller.refresh();
+    const int mismatches = countMismatches(controller, model, flip_horizontal);
+    snprintf(label, sizeof(label), "%3d deg%s: %dx%d, %d mismatched pixels", degrees(rotation),
+             flip_horizontal ? " + flip" : "       ", controller.getWidth(), controller.getHeight(), mismatches);
+    check(ok && mismatches == 0, label);
+
+    // 局部更新只发送覆盖脏区的8x8块
+    const BusStats before = bus.stats();
+    controller.fillBufferRect(10, 20, 4, 4, Colors::WHITE);
+    controller.refresh();
+    const uint64_t bytes = bus.stats().data_bytes - before.data_bytes;
+    snprintf(label, sizeof(label), "%3d deg partial update: %llu data bytes", degrees(rotation),
+             static_cast<unsigned long long>(bytes));
+    check(bytes <= 16 && countMismatches(controller, model, flip_horizontal) == 0, label);
+}
+
+static void runRuntimeSwitch() {
+    printf("\nRuntime rotation\n");
+    SSD1309Model model;
+    EmulatedBus bus(model, BusTiming());
+    SSD1309Controller controller{SSD1309Config{}};
+    const bool initialized = controller.initialize(&bus);
+
+    check(initialized && controller.scroll(8), "0 deg: hardware scroll available");
+    check(controller.setRotation(Rotation::ROTATE_270) && controller.getWidth() == PANEL_H &&
+          controller.getStartLine() == 0, "switch to 270 deg resets start line");
+    drawMarker(controller);
+    controller.refresh();
+    check(countMismatches(controller, model, false) == 0 && model.comScanReversed() && !model.segmentRemap(),
+          "270 deg: COM scan reversed, panel matches");
+    check(!controller.scroll(8), "270 deg: hardware scroll refused");
+    check(controller.setRotation(Rotation::ROTATE_180), "switch to 180 deg");
+    drawMarker(controller);
+    controller.refresh();
+    check(countMismatches(controller, model, false) == 0 && model.comScanReversed() && model.segmentRemap(),
+          "180 deg: both remaps, panel matches");
+    check(model.protocolErrors() == 0, "no protocol errors");
+}
+
+static void runDriver(const char* path) {
+    printf("\nDriver size and clipping\n");
+    Linux_SPI_Config config;
+    config.device = path;
+    config.capture = true;
+    Linux_SPI_Driver driver(config, std::unique_ptr<DisplayController>(new SSD1309Controller(SSD1309Config{})));
+    if (!check(driver.initialize(), "capture driver initialized")) {
+        return;
+    }
+    auto* controller = static_cast<SSD1309Controller*>(driver.controller());
+    check(driver.setRotation(Rotation::ROTATE_90) && driver.width() == PANEL_H && driver.height() == PANEL_W,
+          "width()/height() follow the rotation");
+
+    // 超出屏幕的填充被裁剪到旋转后的尺寸
+    driver.clear(Colors::BLACK);
+    driver.fillRect(-20, 100, 500, 500, Colors::WHITE);
+    driver.drawText(2, 2, "Portrait", Colors::WHITE, Colors::BLACK);
+    driver.display();
+    const uint8_t* buffer = controller->getFrameBuffer();
+    bool clipped = true;
+    for (int16_t y = 100; y < PANEL_W; y++) {
+        for (int16_t x = 0; x < PANEL_H; x++) {
+            clipped = clipped && ((buffer[(y / 8) * PANEL_H + x] >> (y % 8)) & 1);
+        }
+    }
+    check(clipped, "fill clipped to the rotated screen");
+
+    // 回放记录，面板像素应与旋转后的帧缓冲区一致
+    SSD1309Model model;
+    FILE* in = fopen(path, "rb");
+    Linux_SPI_CaptureRecord record;
+    std::vector<uint8_t> payload;
+    while (in && fread(&record, sizeof(record), 1, in) == 1) {
+        payload.resize(record.bytes);
+        if (record.bytes > 0 && fread(payload.data(), 1, record.bytes, in) != record.bytes) {
+            break;
+        }
+        if (record.dc) {
+            model.data(payload.data(), payload.size(), 0, 0);
+        } else {
+            for (uint8_t byte : payload) {
+                model.command(byte, 0);
+            }
+        }
+    }
+    if (in) {
+        fclose(in);
+    }
+    check(in && model.protocolErrors() == 0 && countMismatches(*controller, model, false) == 0,
+          "panel matches after replay");
+}
+
+// 驱动使用的8x8块转置路径与逐像素重映射得到相同的面板数据
+static void runBlockPath() {
+    printf("\nFull-frame conversion\n");
+    std::vector<uint8_t> logical(PANEL_W * PANEL_H / 8);
+    std::vector<uint8_t> panel(logical.size());
+    uint32_t seed = 3;
+    for (uint8_t& byte : logical) {
+        seed = seed * 1103515245u + 12345u;
+        byte = static_cast<uint8_t>(seed >> 24);
+    }
+    const int16_t lw = PANEL_H;   // 旋转后的宽度
+    auto byBlock = [&]() {
+        uint8_t* out = panel.data();
+        for (int16_t page = 0; page < PANEL_H / 8; page++) {
+            for (int16_t col = 0; col < PANEL_W; col += 8) {
+                SSD1309Controller::transpose8x8(logical.data() + (col / 8) * lw + page * 8, out);
+                out += 8;
+            }
+        }
+    };
+    auto byPixel = [&]() {
+        memset(panel.data(), 0, panel.size());
+        for (int16_t py = 0; py < PANEL_H; py++) {
+            for (int16_t px = 0; px < PANEL_W; px++) {
+                // 面板(px, py)对应转置后的逻辑像素(py, px)
+                if ((logical[(px / 8) * lw + py] >> (px % 8)) & 1) {
+                    panel[(py / 8) * PANEL_W + px] |= static_cast<uint8_t>(1 << (py % 8));
+                }
+            }
+        }
+    };
+    byBlock();
+    const std::vector<uint8_t> expected = panel;
+    byPixel();
+    check(expected == panel, "block and per-pixel paths produce the same panel bytes");
+}
+
+int main() {
+    runTranspose();
+
+    printf("\nPanel pixels per rotation (SSD1309 128x64)\n");
+    const Rotation rotations[] = {Rotation::ROTATE_0, Rotation::ROTATE_90, Rotation::ROTATE_180,
+                                  Rotation::ROTATE_270};
+    for (Rotation rotation : rotations) {
+        runRotation(rotation, false);
+    }
+    runRotation(Rotation::ROTATE_90, true);
+
+    runRuntimeSwitch();
+    runDriver("rotation.capture");
+    runBlockPath();
+    return Test::finish("rotation");
+}
@@ -0,0 +1,208 @@
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <vector>
+#include "Linux_SPI_Driver.h"
+#include "SSD1309Controller.h"
+#include "SSD1309Model.h"
+#include "ScreenCache.h"
+#include "TestCheck.h"
+
+using namespace MinimalUI;
+using Test::check;
+
+static const uint16_t PAGES = 3;
+
+// 菜单页面的静态内容：标题栏、图标、列表项和分隔线
+static void drawPage(GraphicsDriver& driver, uint16_t page) {
+    static const char* const TITLES[PAGES] = {"Settings", "Sensors", "Network"};
+    static const char* const ITEMS[PAGES][4] = {
+        {"Brightness", "Contrast", "Sleep", "About"},
+        {"Temperature", "Humidity", "Pressure", "Light"},
+        {"WiFi", "Bluetooth", "MQTT", "Status"},
+    };
+    driver.clear(Colors::BLACK);
+    driver.fillRect(0, 0, 128, 11, Colors::WHITE);
+    driver.drawText(2, 2, TITLES[page], Colors::BLACK, Colors::WHITE);
+    for (int16_t i = 0; i < 4; i++) {
+        const int16_t y = static_cast<int16_t>(14 + i * 12);
+        if (page == 0) {
+            driver.fillRoundRect(2, y, 8, 8, 2, Colors::WHITE);
+        } else if (page == 1) {
+            driver.drawCircle(6, y + 4, 4, Colors::WHITE);
+        } else {
+            driver.fillTriangle(2, y + 8, 6, y, 10, y + 8, Colors::WHITE);
+        }
+        driver.drawText(14, y, ITEMS[page][i], Colors::WHITE, Colors::BLACK);
+        driver.drawHLine(14, y + 10, 112, Colors::GRAY);
+    }
+}
+
+// 动态组件：右上角的时钟
+static void drawClock(GraphicsDriver& driver, uint32_t seconds) {
+    char text[12];
+    snprintf(text, sizeof(text), "%02u:%02u", static_cast<unsigned>(seconds / 60 % 60),
+             static_cast<unsigned>(seconds % 60));
+    driver.fillRect(96, 1, 31, 9, Colors::WHITE);
+    driver.drawText(97, 2, text, Colors::BLACK, Colors::WHITE);
+}
+
+// 切换到页面：命中时恢复快照，未命中时完整重绘并保存快照
+static bool showPage(Linux_SPI_Driver& driver, ScreenCache& cache, uint16_t page, uint32_t seconds) {
+    const bool hit = driver.restoreScreen(cache, page);
+    if (!hit) {
+        drawPage(driver, page);
+        driver.captureScreen(cache, page);
+    }
+    drawClock(driver, seconds);
+    driver.display();
+    return hit;
+}
+
+static void runCodec() {
+    printf("Run-length codec\n");
+    std::vector<uint8_t> data(1024);
+    uint32_t seed = 1;
+    for (size_t i = 0; i < data.size(); i++) {
+        seed = seed * 1103515245u + 12345u;
+        // 随机长度的重复段与随机字节交替
+        data[i] = (i / 37) % 2 ? static_cast<uint8_t>(seed >> 24) : static_cast<uint8_t>(i / 37);
+    }
+    std::vector<uint8_t> encoded(ScreenCache::encodeBound(data.size()));
+    std::vector<uint8_t> decoded(data.size());
+    const size_t n = ScreenCache::encode(data.data(), data.size(), encoded.data(), encoded.size());
+    check(n > 0 && ScreenCache::decode(encoded.data(), n, decoded.data(), decoded.size()) && decoded == data,
+          "round trip");
+    // 缓存先只计算长度，再按该长度分配快照内存并直接编码进去，不使用临时缓冲区
+    check(ScreenCache::encode(data.data(), data.size(), nullptr, encoded.size()) == n &&
+          ScreenCache::encode(data.data(), data.size(), encoded.data(), n) == n &&
+          ScreenCache::encode(data.data(), data.size(), encoded.data(), n - 1) == 0,
+          "measuring pass matches, exact capacity is enough");
+    check(ScreenCache::decode(encoded.data(), n, nullptr, data.size()) &&
+          !ScreenCache::decode(encoded.data(), n, nullptr, data.size() - 1), "validation pass without output");
+
+    std::vector<uint8_t> noise(1024);
+    for (uint8_t& byte : noise) {
+        seed = seed * 1103515245u + 12345u;
+        byte = static_cast<uint8_t>(seed >> 24);
+    }
+    const size_t worst = ScreenCache::encode(noise.data(), noise.size(), encoded.data(), encoded.size());
+    check(worst > 0 && worst <= ScreenCache::encodeBound(noise.size()), "incompressible data within bound");
+    check(!ScreenCache::decode(encoded.data(), worst - 1, decoded.data(), decoded.size()) &&
+          !ScreenCache::decode(encoded.data(), worst - 1, nullptr, decoded.size()),
+          "truncated input rejected");
+}
+
+static void runPages() {
+    const char* path = "screen_cache.capture";
+
+    Linux_SPI_Config config;
+    config.device = path;
+    config.capture = true;
+    Linux_SPI_Driver driver(config, std::unique_ptr<DisplayController>(new SSD1309Controller(SSD1309Config{})));
+    if (!check(driver.initialize(), "capture driver initialized")) {
+        return;
+    }
+    auto* controller = static_cast<SSD1309Controller*>(driver.controller());
+    const size_t frame_size = 128 * 64 / 8;
+
+    // 参考画面：每页完整重绘的帧缓冲区
+    std::vector<uint8_t> reference[PAGES];
+    for (uint16_t page = 0; page < PAGES; page++) {
+        drawPage(driver, page);
+        drawClock(driver, 42);
+        reference[page].assign(controller->getFrameBuffer(), controller->getFrameBuffer() + frame_size);
+    }
+    driver.display();
+
+    // 容量可以同时保存任意两页（含第0页）的压缩快照，但放不下全部三页
+    size_t compressed[PAGES];
+    std::vector<uint8_t> scratch(ScreenCache::encodeBound(frame_size));
+    for (uint16_t page = 0; page < PAGES; page++) {
+        drawPage(driver, page);
+        compressed[page] = ScreenCache::encode(controller->getFrameBuffer(), frame_size, scratch.data(),
+                                               scratch.size());
+    }
+    const size_t budget = compressed[0] + std::max(compressed[1], compressed[2]);
+    printf("Page switching (SSD1309 128x64)\n");
+
+    ScreenCache cache(budget);
+    bool first_visits_missed = true;
+    for (uint16_t page = 0; page < 2; page++) {
+        first_visits_missed = !showPage(driver, cache, page, 42) && first_visits_missed;
+    }
+    check(first_visits_missed && cache.stats().misses == 2 && cache.stats().stores == 2,
+          "first visit misses and stores");
+
+    driver.resetStats();
+    const bool hit = driver.restoreScreen(cache, 0);
+    const Linux_SPI_Stats restore = driver.stats();
+    drawClock(driver, 42);
+    driver.display();
+    check(hit && memcmp(controller->getFrameBuffer(), reference[0].data(), frame_size) == 0,
+          "restored page + dynamic widget matches a full redraw");
+    check(restore.spi_messages <= 3 && restore.bytes <= frame_size + 16, "restore is one window write");
+
+    // 第三页放不下：淘汰最久未使用的第1页，第0页刚被使用过而保留
+    showPage(driver, cache, 2, 42);
+    check(cache.stats().evictions == 1 && cache.contains(0) && !cache.contains(1) && cache.contains(2),
+          "LRU eviction under the byte budget");
+    check(cache.stats().used_bytes <= budget, "stored bytes within budget");
+
+    // 滚动后不能保存快照；恢复快照会复位起始行
+    driver.scroll(8);
+    check(!driver.captureScreen(cache, 7), "scrolled frame is not captured");
+    check(driver.restoreScreen(cache, 2) && controller->getStartLine() == 0, "restore resets start line");
+    drawClock(driver, 42);
+    driver.display();
+    check(memcmp(controller->getFrameBuffer(), reference[2].data(), frame_size) == 0,
+          "restore after scroll matches a full redraw");
+
+    // 未命中时帧缓冲区保持不变，调用方在此基础上完整重绘
+    drawPage(driver, 1);
+    const std::vector<uint8_t> before(controller->getFrameBuffer(), controller->getFrameBuffer() + frame_size);
+    check(!driver.restoreScreen(cache, 1) && !cache.load(2, controller->getFrameBuffer(), frame_size - 1) &&
+          memcmp(controller->getFrameBuffer(), before.data(), frame_size) == 0,
+          "miss leaves the frame buffer unchanged");
+    driver.display();
+
+    // 回放记录，模拟器中的显存应与帧缓冲区一致
+    uint8_t* target = controller->getFrameBuffer();
+    driver.restoreScreen(cache, 2);
+    SSD1309Model model;
+    FILE* in = fopen(path, "rb");
+    Linux_SPI_CaptureRecord record;
+    std::vector<uint8_t> payload;
+    while (in && fread(&record, sizeof(record), 1, in) == 1) {
+        payload.resize(record.bytes);
+        if (record.bytes > 0 && fread(payload.data(), 1, record.bytes, in) != record.bytes) {
+            break;
+        }
+        if (record.dc) {
+            model.data(payload.data(), payload.size(), 0, 0);
+        } else {
+            for (uint8_t byte : payload) {
+                model.command(byte, 0);
+            }
+        }
+    }
+    if (in) {
+        fclose(in);
+    }
+    int mismatches = 0;
+    for (int16_t page = 0; page < SSD1309Model::PAGES; page++) {
+        for (int16_t col = 0; col < SSD1309Model::WIDTH; col++) {
+            mismatches += model.ram(page, col) != target[page * SSD1309Model::WIDTH + col];
+        }
+    }
+    check(in && mismatches == 0 && model.protocolErrors() == 0 && model.startLine() == 0,
+          "panel GDDRAM matches after replay");
+
+}
+
+int main() {
+    runCodec();
+    runPages();
+    return Test::finish("screen cache");
+}
@@ -0,0 +1,114 @@
+#include <cstdio>
+#include <memory>
+#include <vector>
+#include "Linux_SPI_Driver.h"
+#include "SSD1309Controller.h"
+#include "SSD1309Model.h"
+#include "TestCheck.h"
+
+using namespace MinimalUI;
+using Test::check;
+
+// 把记录的消息按DC电平回放到模拟器，返回记录条数；cs_released统计释放片选的消息数
+static int replay(const char* path, SSD1309Model& model, uint32_t& cs_released) {
+    FILE* in = fopen(path, "rb");
+    if (!in) {
+        return -1;
+    }
+    int records = 0;
+    Linux_SPI_CaptureRecord record;
+    std::vector<uint8_t> payload;
+    while (fread(&record, sizeof(record), 1, in) == 1) {
+        payload.resize(record.bytes);
+        if (record.bytes > 0 && fread(payload.data(), 1, record.bytes, in) != record.bytes) {
+            break;
+        }
+        if (record.dc) {
+            model.data(payload.data(), payload.size(), 0, 0);
+        } else {
+            for (uint8_t byte : payload) {
+                model.command(byte, 0);
+            }
+        }
+        if (!record.cs_hold) {
+            cs_released++;
+        }
+        records++;
+    }
+    fclose(in);
+    return records;
+}
+
+// capture模式下绘制几帧，把记录的SPI消息回放到模拟器，显存应与控制器帧缓冲区一致
+int main() {
+    const char* path = "spidev.capture";
+
+    Linux_SPI_Config config;
+    config.device = path;
+    config.capture = true;
+    Linux_SPI_Driver driver(config, std::unique_ptr<DisplayController>(new SSD1309Controller(SSD1309Config{})));
+    if (!check(driver.initialize(), "capture driver initialized")) {
+        return Test::finish("spidev");
+    }
+    auto* controller = static_cast<SSD1309Controller*>(driver.controller());
+
+    driver.fillRect(0, 0, 128, 12, Colors::WHITE);
+    driver.drawText(4, 2, "spidev", Colors::BLACK, Colors::WHITE);
+    driver.drawCircle(100, 40, 15, Colors::WHITE);
+    driver.drawLine(0, 63, 127, 16, Colors::WHITE);
+    driver.display();
+
+    driver.fillRect(4, 30, 40, 8, Colors::BLACK);
+    driver.drawText(4, 30, "42.5", Colors::WHITE, Colors::BLACK);
+    driver.display();
+
+    // 整屏更新：地址命令一条消息，1024字节像素数据一条消息，DC各切换一次
+    driver.resetStats();
+    driver.fillRect(0, 0, 128, 64, Colors::BLACK);
+    driver.drawText(30, 28, "frame", Colors::WHITE, Colors::BLACK);
+    driver.display();
+    Linux_SPI_Stats full = driver.stats();
+    printf("  full frame: %llu calls -> %llu SPI messages, %llu GPIO ioctls, %llu bytes\n",
+           static_cast<unsigned long long>(full.calls), static_cast<unsigned long long>(full.spi_messages),
+           static_cast<unsigned long long>(full.gpio_ioctls), static_cast<unsigned long long>(full.bytes));
+    check(full.frames == 1 && full.spi_messages == 2 && full.gpio_ioctls <= 2 && full.bytes >= 1024 &&
+          full.bytes <= 1024 + 16, "full frame: 2 SPI messages, at most 2 GPIO ioctls");
+
+    // 单个窗口更新（一页内的几列）同样是两条消息：6字节地址命令合在一条消息里，而不是每个命令一次ioctl
+    driver.resetStats();
+    driver.fillRect(60, 16, 8, 8, Colors::WHITE);
+    driver.display();
+    Linux_SPI_Stats window = driver.stats();
+    printf("  window update: %llu calls -> %llu SPI messages, %llu GPIO ioctls, %llu bytes\n",
+           static_cast<unsigned long long>(window.calls), static_cast<unsigned long long>(window.spi_messages),
+           static_cast<unsigned long long>(window.gpio_ioctls), static_cast<unsigned long long>(window.bytes));
+    check(window.frames == 1 && window.spi_messages == 2 && window.gpio_ioctls <= 2 && window.bytes >= 8 &&
+          window.bytes <= 8 + 16,
+          "window update: 2 SPI messages, at most 2 GPIO ioctls");
+
+    driver.scroll(8);
+    driver.display();
+
+    SSD1309Model model;
+    uint32_t cs_released = 0;
+    const int records = replay(path, model, cs_released);
+    printf("  replay: %d messages, %u protocol errors, %u unknown commands\n", records, model.protocolErrors(),
+           model.unknownCommands());
+    check(records > 0, "capture file recorded");
+    check(model.protocolErrors() == 0 && model.unknownCommands() == 0, "capture decodes cleanly");
+    check(cs_released > 0 && cs_released <= static_cast<uint32_t>(records), "chip select released between frames");
+
+    const uint8_t* buffer = controller->getFrameBuffer();
+    int mismatches = 0;
+    for (int16_t page = 0; page < SSD1309Model::PAGES; page++) {
+        for (int16_t col = 0; col < SSD1309Model::WIDTH; col++) {
+            if (model.ram(page, col) != buffer[page * SSD1309Model::WIDTH + col]) {
+                mismatches++;
+            }
+        }
+    }
+    printf("  GDDRAM vs frame buffer: %d mismatching bytes\n", mismatches);
+    check(mismatches == 0, "replayed GDDRAM matches the frame buffer");
+    check(model.startLine() == controller->getStartLine(), "start line follows the controller");
+    return Test::finish("spidev");
+}
@@ -0,0 +1,159 @@
+#include <chrono>
+#include <cstdio>
+#include <thread>
+#include "EmulatedBus.h"
+#include "SSD1309Model.h"
+#include "SSD1309Controller.h"
+#include "TestCheck.h"
+
+using namespace MinimalUI;
+using Test::check;
+
+// 8位灰度转换为RGB565
+static Color grayColor(uint8_t level) {
+    return static_cast<Color>(((level >> 3) << 11) | ((level >> 2) << 5) | (level >> 3));
+}
+
+// 比较控制器帧缓冲区与模拟器GDDRAM
+static bool verifyRam(SSD1309Controller& controller, const SSD1309Model& model, const char* step) {
+    const uint8_t* buffer = controller.getFrameBuffer();
+    for (int16_t page = 0; page < SSD1309Model::PAGES; page++) {
+        for (int16_t col = 0; col < SSD1309Model::WIDTH; col++) {
+            uint8_t expected = buffer[page * SSD1309Model::WIDTH + col];
+            uint8_t actual = model.ram(page, col);
+            if (expected != actual) {
+                printf("  %s: page %d column %d: GDDRAM 0x%02X, frame buffer 0x%02X\n", step, page, col, actual,
+                       expected);
+                return check(false, step);
+            }
+        }
+    }
+    return check(true, step);
+}
+
+static void runProtocol() {
+    printf("Protocol and partial updates\n");
+    SSD1309Model model;
+    EmulatedBus bus(model, BusTiming());
+    SSD1309Controller controller(SSD1309Config{});
+
+    check(controller.initialize(&bus), "controller initialized");
+    check(model.protocolErrors() == 0 && model.unknownCommands() == 0, "init sequence decodes cleanly");
+    check(model.memoryMode() == 0 && model.displayOn(), "horizontal addressing, display on");
+    verifyRam(controller, model, "clear screen");
+
+    controller.fillBufferRect(10, 5, 40, 20, Colors::WHITE);
+    controller.fillBufferRect(60, 30, 50, 30, grayColor(128));
+    controller.refresh();
+    verifyRam(controller, model, "fill rectangles");
+
+    // 局部更新只发送脏列：6列只涉及一页
+    BusStats before = bus.stats();
+    controller.fillBufferRect(100, 2, 6, 4, Colors::WHITE);
+    controller.refresh();
+    BusStats after = bus.stats();
+    verifyRam(controller, model, "partial update");
+    check(after.data_bytes - before.data_bytes == 6, "partial update sends only the dirty columns");
+
+    Color bitmap[16 * 12];
+    for (int i = 0; i < 16 * 12; i++) {
+        bitmap[i] = grayColor(static_cast<uint8_t>(i * 255 / (16 * 12)));
+    }
+    controller.drawBufferBitmap(3, 40, 16, 12, bitmap, 16);
+    controller.refresh();
+    verifyRam(controller, model, "bitmap");
+
+    controller.scroll(12);
+    controller.refresh();
+    verifyRam(controller, model, "hardware scroll");
+    check(model.startLine() == controller.getStartLine(), "start line follows the controller");
+    check(model.protocolErrors() == 0, "no protocol errors");
+}
+
+// 初始化表一次突发发送，非阻塞初始化在第一次轮询内完成第一帧
+static void runBoot() {
+    printf("Boot to first frame\n");
+    SSD1309Config config;
+    const SSD1309Controller::InitTable table = SSD1309Controller::buildInitSequence(config);
+    const size_t command_bytes = SSD1309Controller::INIT_SEQUENCE_LENGTH - 2;  // 去掉头字节和END
+
+    SSD1309Model table_model;
+    EmulatedBus table_bus(table_model, BusTiming());
+    InitSequencer sequencer;
+    uint32_t wait_ms = 0;
+    sequencer.start(table.data());
+    sequencer.step(table_bus, wait_ms);
+    check(table_bus.stats().command_bytes == command_bytes, "init table sent completely");
+    check(table_bus.stats().transactions < command_bytes, "init table sent as a command burst");
+    check(table_model.protocolErrors() == 0 && table_model.unknownCommands() == 0, "init table decodes cleanly");
+
+    SSD1309Model model;
+    EmulatedBus bus(model, BusTiming());
+    SSD1309Controller controller(config);
+    if (!check(controller.beginInit(&bus), "non-blocking init started")) {
+        return;
+    }
+    uint32_t polls = 0;
+    while (!controller.pollInit(wait_ms) && polls < 100) {
+        polls++;
+    }
+    check(polls == 0, "first poll completes init and the first frame");
+    check(model.displayOn() && model.protocolErrors() == 0, "display on, no protocol errors");
+}
+
+// 灰度位平面轮换：实时总线上运行约1秒，检查发送速率和人眼积分后的灰度
+static void runGrayscale() {
+    printf("Grayscale bit planes (realtime bus, 8 MHz)\n");
+    SSD1309Model model;
+    BusTiming timing;
+    timing.freq = 8000000;
+    EmulatedBus bus(model, timing);
+    bus.setRealtime(true);
+
+    SSD1309Config config;
+    config.grayscale = true;
+    SSD1309Controller controller(config);
+    if (!check(controller.initialize(&bus), "grayscale controller initialized")) {
+        return;
+    }
+
+    const uint8_t levels[4] = {0, 85, 170, 255};
+    for (int i = 0; i < 4; i++) {
+        controller.fillBufferRect(i * 32, 0, 32, 64, grayColor(levels[i]));
+    }
+    controller.refresh();
+    if (!check(controller.startGrayscale(), "grayscale started")) {
+        return;
+    }
+    controller.refresh();
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    model.resetExposure(bus.now());
+    std::this_thread::sleep_for(std::chrono::milliseconds(1100));
+    const uint64_t now = bus.now();
+    const uint16_t pps = controller.planesPerSecond();
+    controller.stopGrayscale();
+    check(!controller.grayscaleRunning(), "grayscale stopped");
+
+    printf("  planes/s: configured %u, measured %u\n", config.plane_rate, pps);
+    check(pps > config.plane_rate * 9 / 10, "plane rate within 10% of the configured rate");
+    for (int i = 0; i < 4; i++) {
+        uint32_t sum = 0;
+        for (int16_t y = 0; y < 64; y++) {
+            for (int16_t x = i * 32; x < i * 32 + 32; x++) {
+                sum += model.perceived(x, y, now);
+            }
+        }
+        const uint32_t mean = sum / (32 * 64);
+        const int32_t error = static_cast<int32_t>(mean) - levels[i];
+        printf("  band %d: target %3u, perceived %3u\n", i, levels[i], mean);
+        check(error > -12 && error < 12, "perceived band level within 12 of the target");
+    }
+}
+
+int main() {
+    runProtocol();
+    runBoot();
+    runGrayscale();
+    return Test::finish("SSD1309 emulator");
+}
@@ -0,0 +1,191 @@
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <string>
+#include <thread>
+#include <vector>
+#include "TestCheck.h"
+#include "Trace.h"
+
+using namespace MinimalUI;
+using Test::check;
+
+// 导出的一条事件
+struct Event {
+    std::string name;
+    std::string ph;
+    uint32_t ts;
+    uint32_t tid;
+    uint32_t id;
+};
+
+// 取对象中"key":后的字符串或整数
+static std::string field(const std::string& object, const char* key) {
+    const std::string pattern = std::string("\"") + key + "\":";
+    size_t pos = object.find(pattern);
+    if (pos == std::string::npos) {
+        return "";
+    }
+    pos += pattern.size();
+    if (object[pos] == '"') {
+        return object.substr(pos + 1, object.find('"', pos + 1) - pos - 1);
+    }
+    return object.substr(pos, object.find_first_of(",}", pos) - pos);
+}
+
+/**
+ * 导出到临时文件并解析
+ * 检查整体结构为{"traceEvents":[...],"displayTimeUnit":"ms"}，每个事件是一行一个对象
+ */
+static bool dumpEvents(std::vector<Event>& events, size_t& reported) {
+    FILE* file = tmpfile();
+    if (!file) {
+        return false;
+    }
+    reported = Trace::dump(file);
+    std::string text;
+    rewind(file);
+    char buffer[4096];
+    size_t n;
+    while ((n = fread(buffer, 1, sizeof(buffer), file)) > 0) {
+        text.append(buffer, n);
+    }
+    fclose(file);
+
+    const char* head = "{\"traceEvents\":[\n";
+    const char* tail = "\n],\"displayTimeUnit\":\"ms\"}\n";
+    if (text.compare(0, strlen(head), head) != 0 || text.size() < strlen(head) + strlen(tail) ||
+        text.compare(text.size() - strlen(tail), strlen(tail), tail) != 0) {
+        return false;
+    }
+
+    events.clear();
+    const std::string body = text.substr(strlen(head), text.size() - strlen(head) - strlen(tail));
+    size_t start = 0;
+    while (start < body.size()) {
+        size_t end = body.find('\n', start);
+        end = end == std::string::npos ? body.size() : end;
+        std::string line = body.substr(start, end - start);
+        start = end + 1;
+        if (line.back() == ',') {
+            line.pop_back();
+        } else if (start < body.size()) {
+            return false;   // 只有最后一个事件后面没有逗号
+        }
+        if (line.front() != '{' || line.back() != '}' || field(line, "cat") != "ui" || field(line, "pid") != "0") {
+            return false;
+        }
+        const std::string id = field(line, "id");
+        events.push_back(Event{field(line, "name"), field(line, "ph"),
+                               static_cast<uint32_t>(strtoul(field(line, "ts").c_str(), nullptr, 10)),
+                               static_cast<uint32_t>(strtoul(field(line, "tid").c_str(), nullptr, 10)),
+                               static_cast<uint32_t>(strtoul(id.c_str(), nullptr, 10))});
+    }
+    return true;
+}
+
+// 每个tid上的B/E按后进先出配对，时间不倒退
+static bool wellNested(const std::vector<Event>& events) {
+    std::map<uint32_t, std::vector<const Event*>> stacks;
+    for (const Event& e : events) {
+        std::vector<const Event*>& stack = stacks[e.tid];
+        if (e.ph == "B") {
+            stack.push_back(&e);
+        } else if (e.ph == "E") {
+            if (stack.empty() || stack.back()->name != e.name || stack.back()->ts > e.ts) {
+                return false;
+            }
+            stack.pop_back();
+        }
+    }
+    for (const auto& entry : stacks) {
+        if (!entry.second.empty()) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// 在当前线程中记录frame { layout { } paint { } }
+static void frame() {
+    Trace::Scope outer("frame");
+    { Trace::Scope inner("layout"); }
+    { Trace::Scope inner("paint"); }
+}
+
+static void runSpans() {
+    printf("Spans\n");
+    Trace::clear();
+    Trace::enable(false);
+    frame();
+    std::vector<Event> events;
+    size_t reported = 0;
+    check(dumpEvents(events, reported) && reported == 0 && events.empty(), "disabled tracing records nothing");
+
+    Trace::enable(true);
+    frame();
+    // 另一个任务的区间与本任务的区间在时间上交错，各自成行才不会错误嵌套
+    std::thread worker([] {
+        Trace::Scope scope("worker");
+        frame();
+    });
+    worker.join();
+    Trace::record("marker", Trace::Phase::INSTANT);
+    Trace::record("upload", Trace::Phase::ASYNC_BEGIN, 7);
+    Trace::record("upload", Trace::Phase::ASYNC_END, 7);
+    Trace::enable(false);
+
+    const bool parsed = dumpEvents(events, reported);
+    check(parsed && reported == events.size() && events.size() == 6 + 8 + 3, "dump is valid trace JSON");
+
+    uint32_t main_tid = 0;
+    uint32_t worker_tid = 0;
+    for (const Event& e : events) {
+        if (e.name == "frame" && main_tid == 0) {
+            main_tid = e.tid;
+        }
+        if (e.name == "worker") {
+            worker_tid = e.tid;
+        }
+    }
+    check(main_tid != 0 && worker_tid != 0 && main_tid != worker_tid, "each task gets its own tid");
+    check(wellNested(events), "B/E pairs nest per task");
+
+    bool instant = false;
+    bool async = false;
+    for (const Event& e : events) {
+        instant = instant || (e.name == "marker" && e.ph == "i");
+        async = async || (e.name == "upload" && e.ph == "e" && e.id == 7);
+    }
+    check(instant && async, "instant and async events exported with their phase and id");
+}
+
+static void runWraparound() {
+    printf("\nRing wraparound\n");
+    Trace::clear();
+    Trace::enable(true);
+    const uint32_t extra = 10;
+    for (uint32_t i = 0; i < Trace::RING_SIZE + extra; i++) {
+        Trace::record("tick", Trace::Phase::ASYNC_BEGIN, i);
+    }
+    Trace::enable(false);
+
+    std::vector<Event> events;
+    size_t reported = 0;
+    const bool parsed = dumpEvents(events, reported);
+    bool oldest_dropped = parsed && events.size() == Trace::RING_SIZE;
+    for (size_t i = 0; oldest_dropped && i < events.size(); i++) {
+        oldest_dropped = events[i].id == extra + i;
+    }
+    check(oldest_dropped && reported == Trace::RING_SIZE, "full ring keeps the newest RING_SIZE records in order");
+
+    Trace::clear();
+    check(dumpEvents(events, reported) && reported == 0, "clear empties every ring");
+}
+
+int main() {
+    runSpans();
+    runWraparound();
+    return Test::finish("trace");
+}
@@ -0,0 +1,218 @@
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+#include "IconCache.h"
+#include "Rasterizer.h"
+#include "TestCheck.h"
+#include "TestDrivers.h"
+#include "VectorIcon.h"
+
+using namespace MinimalUI;
+using Test::check;
+
+static Test::RasterDriver first(240, 320);
+static Test::RasterDriver second(240, 320);
+
+// 测试用图形，面积可以解析计算
+static const int16_t SQUARE_PATH[] = {
+    MUI_ICON_MOVE(0, 0), MUI_ICON_LINE(256, 0), MUI_ICON_LINE(256, 256), MUI_ICON_LINE(0, 256), MUI_ICON_END,
+};
+static const int16_t DISC_PATH[] = {
+    MUI_ICON_ARC(128, 128, 128, 0, 360), MUI_ICON_END,
+};
+// 内圆逆时针，形成镂空
+static const int16_t RING_PATH[] = {
+    MUI_ICON_ARC(128, 128, 128, 0, 360), MUI_ICON_CLOSE, MUI_ICON_ARC(128, 128, 64, 360, 0), MUI_ICON_END,
+};
+// 两条二次曲线围成的透镜，面积为边长平方的1/3
+static const int16_t LENS_PATH[] = {
+    MUI_ICON_MOVE(0, 128), MUI_ICON_QUAD(128, 0, 256, 128), MUI_ICON_QUAD(128, 256, 0, 128), MUI_ICON_END,
+};
+// 两个同向重叠的正方形，按非零规则合并
+static const int16_t UNION_PATH[] = {
+    MUI_ICON_MOVE(0, 0), MUI_ICON_LINE(160, 0), MUI_ICON_LINE(160, 160), MUI_ICON_LINE(0, 160),
+    MUI_ICON_MOVE(96, 96), MUI_ICON_LINE(256, 96), MUI_ICON_LINE(256, 256), MUI_ICON_LINE(96, 256),
+    MUI_ICON_END,
+};
+static const VectorIcon SQUARE = {SQUARE_PATH, sizeof(SQUARE_PATH) / sizeof(SQUARE_PATH[0])};
+static const VectorIcon DISC = {DISC_PATH, sizeof(DISC_PATH) / sizeof(DISC_PATH[0])};
+static const VectorIcon RING = {RING_PATH, sizeof(RING_PATH) / sizeof(RING_PATH[0])};
+static const VectorIcon LENS = {LENS_PATH, sizeof(LENS_PATH) / sizeof(LENS_PATH[0])};
+static const VectorIcon UNION = {UNION_PATH, sizeof(UNION_PATH) / sizeof(UNION_PATH[0])};
+
+static int area(const VectorIcon& icon, int16_t size) {
+    first.clear(Colors::BLACK);
+    first.drawIcon(4, 4, icon, size, Colors::WHITE);
+    return first.count(Colors::WHITE);
+}
+
+// 面积与期望值的相对误差不超过tolerance
+static void areaCheck(const char* name, const VectorIcon& icon, int16_t size, double expected, double tolerance) {
+    const int actual = area(icon, size);
+    const double error = std::abs(actual - expected) / expected;
+    char label[96];
+    snprintf(label, sizeof(label), "%-6s %3d px: %5d pixels, expected %.0f (%.1f%%)", name, size, actual, expected,
+             error * 100);
+    check(error <= tolerance, label);
+}
+
+static bool samePixels() {
+    return first.pixels == second.pixels;
+}
+
+static void runShapes() {
+    printf("Coverage\n");
+    const double pi = 3.14159265;
+    areaCheck("square", SQUARE, 32, 32 * 32, 0.0);
+    areaCheck("union", UNION, 64, 2 * 40 * 40 - 16 * 16, 0.0);
+    const int16_t disc_sizes[] = {16, 64, 200};
+    for (int16_t size : disc_sizes) {
+        areaCheck("disc", DISC, size, pi * size * size / 4, 0.05);
+    }
+    areaCheck("ring", RING, 64, pi * (32 * 32 - 16 * 16), 0.05);
+    areaCheck("lens", LENS, 96, 96.0 * 96 / 3, 0.03);
+
+    first.clear(Colors::BLACK);
+    first.drawIcon(0, 0, RING, 64, Colors::WHITE);
+    check(first.at(32, 32) == Colors::BLACK &&
+          first.at(4, 32) == Colors::WHITE, "ring has an empty centre");
+
+    // 内置图标面积与尺寸的平方成正比
+    printf("\nBuilt-in icons across sizes\n");
+    const VectorIcon* icons[] = {&ICON_HOME, &ICON_CHECK, &ICON_WIFI, &ICON_BELL};
+    const char* names[] = {"home", "check", "wifi", "bell"};
+    for (int i = 0; i < 4; i++) {
+        const double reference = static_cast<double>(area(*icons[i], 128)) / (128 * 128);
+        const double small = static_cast<double>(area(*icons[i], 24)) / (24 * 24);
+        const double medium = static_cast<double>(area(*icons[i], 48)) / (48 * 48);
+        char label[96];
+        snprintf(label, sizeof(label), "%-5s coverage 24px %.2f, 48px %.2f, 128px %.2f", names[i], small, medium,
+                 reference);
+        check(reference > 0.1 && std::abs(small - reference) < 0.1 && std::abs(medium - reference) < 0.05, label);
+    }
+
+    // 裁剪后的绘制与完整绘制在可见部分一致
+    first.clear(Colors::BLACK);
+    second.clear(Colors::BLACK);
+    first.drawIcon(-20, -10, ICON_BELL, 64, Colors::YELLOW);
+    second.pushClip(Rect{0, 0, 30, 40});
+    second.drawIcon(-20, -10, ICON_BELL, 64, Colors::YELLOW);
+    second.popClip();
+    bool clipped = true;
+    for (int16_t y = 0; y < 64; y++) {
+        for (int16_t x = 0; x < 64; x++) {
+            const Color expected = x < 30 && y < 40 ? first.at(x, y) : Colors::BLACK;
+            clipped = clipped && second.at(x, y) == expected;
+        }
+    }
+    check(clipped, "clipped draw matches the visible part");
+}
+
+static void runCache() {
+    printf("\nBitmap cache\n");
+    const size_t icon_bytes = IconCache::bitmapSize(32, false);
+    IconCache cache(icon_bytes * 2);
+
+    // 不透明：缓存的位图与直接光栅化逐像素一致
+    first.clear(Colors::BLUE);
+    second.clear(Colors::BLUE);
+    for (int i = 0; i < 100; i++) {
+        cache.draw(first, 10, 10, ICON_BELL, 32, Colors::WHITE, Colors::BLACK);
+    }
+    second.fillRect(10, 10, 32, 32, Colors::BLACK);
+    second.drawIcon(10, 10, ICON_BELL, 32, Colors::WHITE);
+    char label[128];
+    snprintf(label, sizeof(label), "opaque: 1 miss, %u hits (%u%%), %zu bytes, blitted with drawBitmap()",
+             static_cast<unsigned>(cache.stats().hits), static_cast<unsigned>(cache.stats().hitRatePercent()),
+             cache.stats().used_bytes);
+    check(samePixels() && cache.stats().misses == 1 && cache.stats().hits == 99 &&
+          cache.stats().hitRatePercent() == 99 && cache.stats().used_bytes == icon_bytes &&
+          first.bitmaps == 100, label);
+
+    // 透明：MONO1掩码，背景保持不变
+    cache.draw(first, 60, 10, ICON_WIFI, 32, Colors::GREEN, Colors::GREEN);
+    second.drawIcon(60, 10, ICON_WIFI, 32, Colors::GREEN);
+    snprintf(label, sizeof(label), "transparent: mask of %zu bytes, background untouched",
+             IconCache::bitmapSize(32, true));
+    check(samePixels() && cache.stats().used_bytes == icon_bytes + IconCache::bitmapSize(32, true), label);
+
+    // 颜色是键的一部分
+    cache.draw(first, 100, 10, ICON_BELL, 32, Colors::RED, Colors::BLACK);
+    check(cache.stats().misses == 3, "different colour is a separate entry");
+
+    // LRU：容量为两个位图，A、B、A之后加入C淘汰的是B
+    IconCache lru(icon_bytes * 2);
+    lru.draw(first, 10, 10, ICON_BELL, 32, Colors::WHITE, Colors::BLACK);
+    lru.draw(first, 50, 10, ICON_HOME, 32, Colors::WHITE, Colors::BLACK);
+    lru.draw(first, 10, 10, ICON_BELL, 32, Colors::WHITE, Colors::BLACK);
+    lru.draw(first, 90, 10, ICON_CHECK, 32, Colors::WHITE, Colors::BLACK);
+    lru.draw(first, 10, 10, ICON_BELL, 32, Colors::WHITE, Colors::BLACK);
+    const uint32_t misses = lru.stats().misses;
+    lru.draw(first, 50, 10, ICON_HOME, 32, Colors::WHITE, Colors::BLACK);
+    snprintf(label, sizeof(label), "budget %zu bytes: %u evictions, %zu bytes used, least recent entry evicted",
+             lru.budget(), static_cast<unsigned>(lru.stats().evictions), lru.stats().used_bytes);
+    check(misses == 3 && lru.stats().hits == 2 && lru.stats().misses == 4 &&
+          lru.stats().used_bytes <= lru.budget(), label);
+
+    // 超过容量的位图直接光栅化
+    first.clear(Colors::BLACK);
+    second.clear(Colors::BLACK);
+    cache.draw(first, 100, 100, ICON_CHECK, 64, Colors::CYAN, Colors::GRAY);
+    second.fillRect(100, 100, 64, 64, Colors::GRAY);
+    second.drawIcon(100, 100, ICON_CHECK, 64, Colors::CYAN);
+    check(samePixels() && cache.stats().rejected == 1, "oversized icon rejected and drawn directly");
+}
+
+// 交点超过CONFIG_UI_VECTOR_MAX_CROSSINGS的图标被拒绝，而不是丢掉部分交点后填充错乱
+static void runCrossingLimit() {
+    printf("\nCrossing limit\n");
+    bool builtin_fit = true;
+    for (const VectorIcon* icon : {&ICON_HOME, &ICON_CHECK, &ICON_WIFI, &ICON_BELL}) {
+        builtin_fit = Rasterizer(first, Rect{0, 0, 240, 320}).fillIcon(*icon, 0, 0, 128, Colors::WHITE) && builtin_fit;
+    }
+    check(builtin_fit && Rasterizer::rejectedIcons() == 0, "built-in icons stay within the limit");
+
+    // 梳子：每个齿贡献两个交点。第一个齿贯穿上下，其余齿只在下半部分，
+    // 上半部分的行放得下而下半部分的行比上限多两个交点
+    const int teeth = CONFIG_UI_VECTOR_MAX_CROSSINGS / 2 + 1;
+    const int16_t pitch = static_cast<int16_t>(VECTOR_ICON_GRID / teeth);
+    std::vector<int16_t> path;
+    for (int i = 0; i < teeth; i++) {
+        const int16_t left = static_cast<int16_t>(i * pitch);
+        const int16_t right = static_cast<int16_t>(left + pitch / 2);
+        const int16_t top = i == 0 ? 0 : VECTOR_ICON_GRID / 2;
+        const int16_t tooth[] = {MUI_ICON_MOVE(left, top), MUI_ICON_LINE(right, top), MUI_ICON_LINE(right, 256),
+                                 MUI_ICON_LINE(left, 256)};
+        path.insert(path.end(), tooth, tooth + sizeof(tooth) / sizeof(tooth[0]));
+    }
+    path.push_back(MUI_ICON_END);
+    const VectorIcon comb = {path.data(), static_cast<uint16_t>(path.size())};
+
+    first.clear(Colors::BLACK);
+    const bool filled = Rasterizer(first, Rect{0, 0, 240, 320}).fillIcon(comb, 0, 0, 128, Colors::WHITE);
+    const bool drawn = first.drawIcon(0, 0, comb, 128, Colors::WHITE);
+    check(!filled && !drawn && first.count(Colors::WHITE) == 0 && Rasterizer::rejectedIcons() == 2,
+          "over-limit icon rejected before any row is drawn, counted");
+
+    IconCache cache(IconCache::bitmapSize(128, false));
+    Image image;
+    const bool cached = cache.lookup(comb, 128, Colors::WHITE, Colors::BLACK, image);
+    cache.draw(first, 0, 0, comb, 128, Colors::WHITE, Colors::RED);
+    check(!cached && first.count(Colors::BLACK) == 240 * 320 && cache.stats().rejected == 2 &&
+          cache.stats().stores == 0 && cache.stats().used_bytes == 0 && Rasterizer::rejectedIcons() == 3,
+          "cache rejects it once, then skips it without rasterizing or drawing");
+
+    // 容量放不下位图时的直接绘制也不画背景
+    IconCache small(0);
+    small.draw(first, 0, 0, comb, 128, Colors::WHITE, Colors::RED);
+    small.draw(first, 0, 0, comb, 128, Colors::WHITE, Colors::RED);
+    check(first.count(Colors::BLACK) == 240 * 320 && Rasterizer::rejectedIcons() == 4,
+          "uncached fallback draws nothing and remembers the rejection");
+}
+
+int main() {
+    runShapes();
+    runCache();
+    runCrossingLimit();
+    return Test::finish("vector icon");
+}
@@ -0,0 +1,123 @@
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include "Label.h"
+#include "TestCheck.h"
+#include "TestDrivers.h"
+#include "WidgetPool.h"
+
+using namespace MinimalUI;
+using namespace MinimalUI::Components;
+using Test::check;
+
+// 统计堆分配次数，用于确认组件池操作不分配内存
+static size_t g_allocations = 0;
+
+void* operator new(size_t size) {
+    g_allocations++;
+    if (void* p = malloc(size ? size : 1)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept {
+    free(p);
+}
+
+void operator delete(void* p, size_t) noexcept {
+    free(p);
+}
+
+// 纯色方块组件，记录绘制和输入次数
+class Box : public Component {
+public:
+    uint32_t renders = 0;
+    uint32_t touches = 0;
+
+    Box(int16_t x, int16_t y, int16_t w, int16_t h, Color color) : Component(x, y, w, h), color_(color) {}
+
+    void render(GraphicsDriver* driver) override {
+        driver->fillRect(x_, y_, width_, height_, color_);
+        renders++;
+        markClean();
+    }
+
+    bool handleInput(const InputEvent& event) override {
+        if (event.type != InputEventType::TOUCH_DOWN) {
+            return false;
+        }
+        touches++;
+        return true;
+    }
+
+private:
+    Color color_;
+};
+
+static InputEvent touchAt(int16_t x, int16_t y) {
+    return InputEvent{InputEventType::TOUCH_DOWN, 0, x, y, 0};
+}
+
+static void runPool() {
+    printf("Widget pool behaviour\n");
+    using Pool = WidgetPool<8>;
+    static Pool pool(Colors::BLACK);
+    Test::NullDriver driver(1280, 720);
+
+    const size_t allocations = g_allocations;
+    const Pool::Handle panel = pool.create<Box>(Pool::NONE, 0, 0, 100, 100, Colors::GRAY);
+    const Pool::Handle button = pool.create<Box>(panel, 10, 10, 30, 20, Colors::RED);
+    const Pool::Handle label = pool.create<Label>(panel, 10, 50, 80, 12, "pool");
+    const Pool::Handle other = pool.create<Box>(Pool::NONE, 120, 0, 50, 50, Colors::BLUE);
+    check(panel != Pool::NONE && button != Pool::NONE && label != Pool::NONE && other != Pool::NONE &&
+          pool.size() == 4, "create widgets in pool slots");
+    check(pool.parent(button) == panel && pool.firstChild(panel) == button &&
+          pool.nextSibling(button) == label, "index links");
+
+    check(pool.render(&driver) == 4, "first render paints every widget");
+    check(pool.render(&driver) == 0, "clean widgets are skipped");
+
+    Box* button_box = pool.get<Box>(button);
+    check(pool.hitTest(15, 15) == button && pool.hitTest(80, 80) == panel && pool.hitTest(200, 200) == Pool::NONE,
+          "hit test returns topmost widget");
+    check(pool.dispatch(touchAt(15, 15)) && button_box->touches == 1, "touch dispatched to hit widget");
+
+    pool.get<Label>(label)->setText("pooled");
+    check(pool.render(&driver) == 1, "invalidate() reaches the pool's dirty bits");
+
+    // 移动按钮：旧区域变为损坏区，与之相交的面板和按钮都重绘
+    button_box->setPosition(50, 10);
+    const uint32_t panel_renders = pool.get<Box>(panel)->renders;
+    check(pool.render(&driver) == 2 && pool.get<Box>(panel)->renders == panel_renders + 1 &&
+          pool.get<Box>(other)->renders == 1, "moving a widget repaints what it uncovered");
+
+    // 隐藏父组件时子组件也不可见
+    pool.component(panel)->setVisible(false);
+    check(pool.hitTest(55, 15) == Pool::NONE && !pool.dispatch(touchAt(55, 15)),
+          "hidden parent hides its children");
+    pool.render(&driver);
+    pool.component(panel)->setVisible(true);
+    check(pool.render(&driver) == 3 && pool.hitTest(55, 15) == button, "showing again repaints subtree");
+
+    // 移除子树后槽位可以复用
+    pool.remove(panel);
+    check(pool.size() == 1 && !pool.valid(button) && !pool.valid(label), "remove frees the whole subtree");
+    Pool::Handle last = Pool::NONE;
+    int created = 0;
+    while ((last = pool.create<Box>(other, 0, 0, 1, 1, Colors::WHITE)) != Pool::NONE) {
+        created++;
+    }
+    check(created == 7 && pool.size() == 8, "capacity is fixed");
+    check(g_allocations == allocations, "no heap allocation");
+
+    static Box external(0, 200, 10, 10, Colors::GREEN);
+    pool.remove(other);
+    check(pool.add(external) != Pool::NONE && pool.render(&driver) == 1 && external.renders == 1,
+          "externally owned widgets");
+}
+
+int main() {
+    runPool();
+    return Test::finish("widget pool");
+}
@@ -0,0 +1,251 @@
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+#include "AssetPackBuilder.h"
+#include "BdfFont.h"
+
+using namespace MinimalUI;
+
+/**
+ * mkassets：按应用的界面文本裁剪BDF字体，生成资源包
+ *
+ *   mkassets <字体.bdf> <输出.bin> <源文件>...
+ *
+ * 源文件中的字符串字面量（跳过注释和字符字面量，处理转义和相邻字面量的拼接）
+ * 视为界面文本，.txt文件的每一行视为一条文本。资源包的资源0为内置FONT_5X7，
+ * 资源1为只含这些文本中非ASCII字符的字形集（见AssetPack::glyphs()）。
+ * 字体中没有的字符只打印警告。
+ */
+
+static bool readFile(const char* path, std::string& out) {
+    FILE* in = fopen(path, "rb");
+    if (!in) {
+        return false;
+    }
+    char buffer[4096];
+    size_t n;
+    while ((n = fread(buffer, 1, sizeof(buffer), in)) > 0) {
+        out.append(buffer, n);
+    }
+    fclose(in);
+    return true;
+}
+
+static bool endsWith(const std::string& text, const char* suffix) {
+    const size_t length = strlen(suffix);
+    return text.size() >= length && text.compare(text.size() - length, length, suffix) == 0;
+}
+
+static bool isIdentifier(char c) {
+    return (c >= '0' && c <= '9') || (c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z') || c == '_';
+}
+
+static int hexValue(char c) {
+    if (c >= '0' && c <= '9') {
+        return c - '0';
+    }
+    if (c >= 'A' && c <= 'F') {
+        return c - 'A' + 10;
+    }
+    if (c >= 'a' && c <= 'f') {
+        return c - 'a' + 10;
+    }
+    return -1;
+}
+
+static void appendUtf8(std::string& out, uint32_t cp) {
+    if (cp < 0x80) {
+        out += static_cast<char>(cp);
+    } else if (cp < 0x800) {
+        out += static_cast<char>(0xC0 | (cp >> 6));
+        out += static_cast<char>(0x80 | (cp & 0x3F));
+    } else if (cp < 0x10000) {
+        out += static_cast<char>(0xE0 | (cp >> 12));
+        out += static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+        out += static_cast<char>(0x80 | (cp & 0x3F));
+    } else {
+        out += static_cast<char>(0xF0 | (cp >> 18));
+        out += static_cast<char>(0x80 | ((cp >> 12) & 0x3F));
+        out += static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+        out += static_cast<char>(0x80 | (cp & 0x3F));
+    }
+}
+
+// 解码s[i]处（反斜杠之后）的转义序列追加到out，返回转义序列之后的位置
+static size_t unescape(const std::string& s, size_t i, std::string& out) {
+    if (i >= s.size()) {
+        return i;
+    }
+    const char c = s[i++];
+    switch (c) {
+        case 'n': out += '\n'; return i;
+        case 't': out += '\t'; return i;
+        case 'r': out += '\r'; return i;
+        case 'a': out += '\a'; return i;
+        case 'b': out += '\b'; return i;
+        case 'f': out += '\f'; return i;
+        case 'v': out += '\v'; return i;
+        case 'x': {
+            uint32_t value = 0;
+            while (i < s.size() && hexValue(s[i]) >= 0) {
+                value = (value << 4) | static_cast<uint32_t>(hexValue(s[i++]));
+            }
+            out += static_cast<char>(value & 0xFF);
+            return i;
+        }
+        case 'u':
+        case 'U': {
+            const size_t digits = c == 'u' ? 4 : 8;
+            uint32_t value = 0;
+            for (size_t n = 0; n < digits && i < s.size() && hexValue(s[i]) >= 0; n++) {
+                value = (value << 4) | static_cast<uint32_t>(hexValue(s[i++]));
+            }
+            appendUtf8(out, value);
+            return i;
+        }
+        default:
+            break;
+    }
+    if (c >= '0' && c <= '7') {
+        uint32_t value = static_cast<uint32_t>(c - '0');
+        for (int n = 0; n < 2 && i < s.size() && s[i] >= '0' && s[i] <= '7'; n++) {
+            value = (value << 3) | static_cast<uint32_t>(s[i++] - '0');
+        }
+        out += static_cast<char>(value & 0xFF);
+        return i;
+    }
+    out += c;   // \\ \" \' \?
+    return i;
+}
+
+// 收集C/C++源文件中的字符串字面量；只隔着空白和注释的相邻字面量拼接为一条
+static void scanSource(const std::string& s, std::vector<std::string>& texts) {
+    std::string current;
+    bool open = false;   // current是否可能与下一个字面量拼接
+    auto flush = [&]() {
+        if (open) {
+            texts.push_back(current);
+            current.clear();
+            open = false;
+        }
+    };
+
+    size_t i = 0;
+    while (i < s.size()) {
+        const char c = s[i];
+        if (c == '/' && i + 1 < s.size() && s[i + 1] == '/') {
+            i = s.find('\n', i);
+            i = i == std::string::npos ? s.size() : i;
+        } else if (c == '/' && i + 1 < s.size() && s[i + 1] == '*') {
+            i = s.find("*/", i + 2);
+            i = i == std::string::npos ? s.size() : i + 2;
+        } else if (c == '\'' && (i == 0 || !isIdentifier(s[i - 1]))) {
+            // 字符字面量；前面是数字时为数字分隔符
+            flush();
+            for (i++; i < s.size() && s[i] != '\''; i++) {
+                if (s[i] == '\\') {
+                    i++;
+                }
+            }
+            i++;
+        } else if (c == '"' && i > 0 && s[i - 1] == 'R' &&
+                   (i < 2 || !isIdentifier(s[i - 2]) || strchr("8LuU", s[i - 2]))) {
+            // 原始字符串R"delim(...)delim"
+            const size_t paren = s.find('(', i);
+            if (paren == std::string::npos) {
+                break;
+            }
+            const std::string end = ")" + s.substr(i + 1, paren - i - 1) + "\"";
+            const size_t close = s.find(end, paren);
+            const size_t stop = close == std::string::npos ? s.size() : close;
+            current.append(s, paren + 1, stop - paren - 1);
+            open = true;
+            i = close == std::string::npos ? s.size() : close + end.size();
+        } else if (c == '"') {
+            for (i++; i < s.size() && s[i] != '"' && s[i] != '\n';) {
+                if (s[i] == '\\') {
+                    i = unescape(s, i + 1, current);
+                } else {
+                    current += s[i++];
+                }
+            }
+            open = true;
+            i++;
+        } else {
+            if (c != ' ' && c != '\t' && c != '\r' && c != '\n') {
+                flush();
+            }
+            i++;
+        }
+    }
+    flush();
+}
+
+static void scanLines(const std::string& s, std::vector<std::string>& texts) {
+    size_t start = 0;
+    while (start < s.size()) {
+        size_t end = s.find('\n', start);
+        end = end == std::string::npos ? s.size() : end;
+        texts.push_back(s.substr(start, end - start));
+        start = end + 1;
+    }
+}
+
+int main(int argc, char** argv) {
+    if (argc < 4) {
+        fprintf(stderr, "usage: %s <font.bdf> <output.bin> <source>...\n", argv[0]);
+        return 2;
+    }
+    const char* font_path = argv[1];
+    const char* output = argv[2];
+
+    std::vector<std::string> texts;
+    for (int i = 3; i < argc; i++) {
+        std::string content;
+        if (!readFile(argv[i], content)) {
+            fprintf(stderr, "mkassets: cannot read %s\n", argv[i]);
+            return 1;
+        }
+        if (endsWith(argv[i], ".txt")) {
+            scanLines(content, texts);
+        } else {
+            scanSource(content, texts);
+        }
+    }
+
+    BdfFont font;
+    if (!font.load(font_path)) {
+        fprintf(stderr, "mkassets: cannot load BDF font %s\n", font_path);
+        return 1;
+    }
+
+    std::vector<const char*> pointers;
+    for (const std::string& text : texts) {
+        pointers.push_back(text.c_str());
+    }
+    const std::vector<uint32_t> used = AssetPackBuilder::collectCodepoints(pointers.data(), pointers.size());
+
+    AssetPackBuilder builder;
+    builder.addFont(FONT_5X7);
+    std::vector<uint32_t> missing;
+    if (builder.addGlyphs(font, used, &missing) < 0) {
+        fprintf(stderr, "mkassets: %s has an invalid glyph size\n", font_path);
+        return 1;
+    }
+    if (!builder.write(output)) {
+        fprintf(stderr, "mkassets: cannot write %s\n", output);
+        return 1;
+    }
+
+    printf("mkassets: %s: %zu strings, %zu glyphs (%ux%u) from %s\n", output, texts.size(),
+           used.size() - missing.size(), font.width(), font.height(), font_path);
+    if (!missing.empty()) {
+        fprintf(stderr, "mkassets: warning: %zu characters not in the font:", missing.size());
+        for (uint32_t cp : missing) {
+            fprintf(stderr, " U+%04X", static_cast<unsigned>(cp));
+        }
+        fprintf(stderr, "\n");
+    }
+    return 0;
+}